@@ -65,6 +65,7 @@ const options_entry cli_options::s_option_entries[] =
 	{ CLICOMMAND_VERIFYSOFTLIST ";vlist", "0",     OPTION_COMMAND,    "verify software list by name" },
 	{ CLICOMMAND_LIST_MIDI_DEVICES ";mlist", "0",  OPTION_COMMAND,    "list available MIDI I/O devices" },
 	{ CLICOMMAND_LIST_NETWORK_ADAPTERS ";nlist", "0",  OPTION_COMMAND,    "list available network adapters" },
+	{ CLICOMMAND_BENCHSUITE ";bs",      "0",       OPTION_COMMAND,    "benchmark each matching system, or each system in a .lst file, and report the results" },
 	{ CLICOMMAND_LISTGAMES,             "0",       OPTION_COMMAND,    "year, manufacturer and full name" },		// for make tp_manufact.txt
 	{ NULL }
 };
@@ -818,6 +819,208 @@ void cli_frontend::listnetworkadapters(const char *gamename)
 }
 
 
+//-------------------------------------------------
+//  benchsuite_result - outcome of benchmarking
+//  a single system
+//-------------------------------------------------
+
+struct benchsuite_result
+{
+	const game_driver * driver;             // system that was run
+	machine_run_stats   stats;              // statistics from the machine manager
+	UINT32              drc_flushes;        // number of DRC cache flushes during the run
+	size_t              drc_peak_bytes;     // largest amount of code held in a DRC cache
+};
+
+
+//-------------------------------------------------
+//  benchsuite_fps - return the number of frames
+//  drawn per host second while unthrottled
+//-------------------------------------------------
+
+static double benchsuite_fps(const benchsuite_result &result)
+{
+	double emutime = result.stats.emulated_time.as_double();
+	if (emutime == 0)
+		return 0;
+	return (double)result.stats.frames / emutime * result.stats.speed_percent / 100.0;
+}
+
+
+//-------------------------------------------------
+//  benchsuite_read_list - read system names from
+//  a driver list file in the same format as the
+//  .lst files consumed by makelist
+//-------------------------------------------------
+
+void cli_frontend::benchsuite_read_list(const char *filename, dynamic_array<int> &systems)
+{
+	dynamic_buffer buffer;
+	if (core_fload(filename, buffer) != FILERR_NONE)
+		throw emu_fatalerror(MAMERR_FATALERROR, "Unable to read system list '%s'", filename);
+
+	const char *srcptr = (const char *)&buffer[0];
+	const char *endptr = srcptr + buffer.count();
+	bool in_comment = false;
+	while (srcptr < endptr)
+	{
+		char c = *srcptr++;
+
+		// skip any spaces
+		if (isspace((UINT8)c))
+			continue;
+
+		// look for the end of a C comment, and skip anything inside one
+		if (in_comment)
+		{
+			if (c == '*' && srcptr < endptr && *srcptr == '/')
+			{
+				srcptr++;
+				in_comment = false;
+			}
+			continue;
+		}
+
+		// look for the start of a C comment
+		if (c == '/' && srcptr < endptr && *srcptr == '*')
+		{
+			srcptr++;
+			in_comment = true;
+			continue;
+		}
+
+		// C++ comments, imports and exclusions all run to the end of the line
+		if (c == '#' || c == '!' || (c == '/' && srcptr < endptr && *srcptr == '/'))
+		{
+			while (srcptr < endptr && *srcptr != 13 && *srcptr != 10)
+				srcptr++;
+			continue;
+		}
+
+		// otherwise, this is a system name
+		const char *start = srcptr - 1;
+		while (srcptr < endptr && !isspace((UINT8)*srcptr))
+			srcptr++;
+		astring name(start, srcptr - start);
+		int index = driver_list::find(name);
+		if (index == -1 || &driver_list::driver(index) == &GAME_NAME(___empty))
+			osd_printf_warning(_("Skipping unknown system '%s'\n"), name.cstr());
+		else
+			systems.append(index);
+	}
+}
+
+
+//-------------------------------------------------
+//  benchsuite - run each of a set of systems
+//  headless and unthrottled for a fixed amount
+//  of emulated time, and report how it went
+//-------------------------------------------------
+
+void cli_frontend::benchsuite(const char *gamename)
+{
+	// determine which systems to run, either from a list file or a wildcard
+	dynamic_array<int> systems;
+	const char *ext = strrchr(gamename, '.');
+	if (ext != NULL && core_stricmp(ext, ".lst") == 0)
+		benchsuite_read_list(gamename, systems);
+	else
+	{
+		driver_enumerator drivlist(m_options, gamename);
+		while (drivlist.next())
+			if ((drivlist.driver().flags & GAME_NO_STANDALONE) == 0)
+				systems.append(drivlist.current());
+	}
+	if (systems.count() == 0)
+		throw emu_fatalerror(MAMERR_NO_SUCH_GAME, "No matching games found for '%s'", gamename);
+
+	// figure out how long to run each one
+	int seconds = m_options.seconds_to_run();
+	if (seconds <= 0)
+		seconds = BENCHSUITE_DEFAULT_SECONDS;
+
+	// run them all
+	dynamic_array<benchsuite_result> results(systems.count());
+	for (int sysnum = 0; sysnum < systems.count(); sysnum++)
+	{
+		benchsuite_result &result = results[sysnum];
+		result.driver = &driver_list::driver(systems[sysnum]);
+		osd_printf_info(_("Benchmarking %s for %d seconds\n"), result.driver->name, seconds);
+
+		// configure a headless, unthrottled run; the OSD's -bench handling turns off sound and video
+		astring error_string;
+		m_options.set_system_name(result.driver->name);
+		m_options.set_value(OPTION_SECONDS_TO_RUN, seconds, OPTION_PRIORITY_MAXIMUM, error_string);
+		m_options.set_value(OPTION_THROTTLE, false, OPTION_PRIORITY_MAXIMUM, error_string);
+		m_options.set_value(OPTION_SKIP_GAMEINFO, true, OPTION_PRIORITY_MAXIMUM, error_string);
+		if (m_options.exists(OSDOPTION_BENCH))
+			m_options.set_value(OSDOPTION_BENCH, seconds, OPTION_PRIORITY_MAXIMUM, error_string);
+		assert(!error_string);
+
+		// run it, treating any fatal error as a failed run rather than the end of the suite
+		g_drc_cache_flushes = 0;
+		g_drc_cache_peak_bytes = 0;
+		machine_manager *manager = machine_manager::instance(m_options, m_osd);
+		try
+		{
+			manager->execute();
+			result.stats = manager->last_run_stats();
+		}
+		catch (emu_fatalerror &fatal)
+		{
+			astring string(fatal.string());
+			osd_printf_error("%s\n", string.trimspace().cstr());
+			result.stats = manager->last_run_stats();
+			result.stats.result = (fatal.exitcode() != 0) ? fatal.exitcode() : MAMERR_FATALERROR;
+		}
+		global_free(manager);
+
+		result.drc_flushes = g_drc_cache_flushes;
+		result.drc_peak_bytes = g_drc_cache_peak_bytes;
+	}
+
+	// the OSD only reports the high-water mark of the whole process, so
+	// there is one peak for the suite rather than one per system
+	UINT32 peak_kb = osd_get_peak_memory_usage() / 1024;
+	osd_printf_info(_("Peak resident memory for the suite: %u KB\n"), peak_kb);
+
+	// format the results; JSON if the output file asks for it, CSV otherwise
+	const char *filename = m_options.benchsuite_output();
+	ext = strrchr(filename, '.');
+	bool json = (ext != NULL && core_stricmp(ext, ".json") == 0);
+	astring output;
+	if (json)
+		output.printf("{\n\t\"peak_rss_kb\": %u,\n\t\"systems\": [\n", peak_kb);
+	else
+		output.cpy("system,result,emulated_seconds,host_seconds,speed_percent,frames_per_second,drc_flushes,drc_peak_kb\n");
+	for (int sysnum = 0; sysnum < results.count(); sysnum++)
+	{
+		const benchsuite_result &result = results[sysnum];
+		if (json)
+			output.catprintf("\t\t{ \"system\": \"%s\", \"result\": %d, \"emulated_seconds\": %.3f, \"host_seconds\": %.3f, \"speed_percent\": %.2f, \"frames_per_second\": %.2f, \"drc_flushes\": %u, \"drc_peak_kb\": %u }%s\n",
+					result.driver->name, result.stats.result, result.stats.emulated_time.as_double(), result.stats.real_seconds, result.stats.speed_percent, benchsuite_fps(result),
+					result.drc_flushes, (UINT32)(result.drc_peak_bytes / 1024), (sysnum == results.count() - 1) ? "" : ",");
+		else
+			output.catprintf("%s,%d,%.3f,%.3f,%.2f,%.2f,%u,%u\n",
+					result.driver->name, result.stats.result, result.stats.emulated_time.as_double(), result.stats.real_seconds, result.stats.speed_percent, benchsuite_fps(result),
+					result.drc_flushes, (UINT32)(result.drc_peak_bytes / 1024));
+	}
+	if (json)
+		output.cat("\t]\n}\n");
+
+	// write to the requested file, or to standard output after all the per-run chatter
+	if (filename[0] == 0)
+		osd_printf_info("%s", output.cstr());
+	else
+	{
+		emu_file file(OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+		if (file.open(filename) != FILERR_NONE)
+			throw emu_fatalerror("Unable to create file %s\n", filename);
+		file.puts(output);
+	}
+}
+
+
 //-------------------------------------------------
 //  verifyroms - verify the ROM sets of one or
 //  more games
@@ -1765,6 +1968,7 @@ void cli_frontend::execute_commands(const char *exename)
 		{ CLICOMMAND_VERIFYSOFTLIST,    &cli_frontend::verifysoftlist },
 		{ CLICOMMAND_LIST_MIDI_DEVICES, &cli_frontend::listmididevices },
 		{ CLICOMMAND_LIST_NETWORK_ADAPTERS, &cli_frontend::listnetworkadapters },
+		{ CLICOMMAND_BENCHSUITE,    &cli_frontend::benchsuite },
 		{ CLICOMMAND_LISTGAMES,	    &cli_frontend::listgames }		// for make tp_manufact.txt
 	};
 
@@ -51,8 +51,12 @@
 #define CLICOMMAND_VERIFYSOFTLIST       "verifysoftlist"
 #define CLICOMMAND_LIST_MIDI_DEVICES    "listmidi"
 #define CLICOMMAND_LIST_NETWORK_ADAPTERS "listnetwork"
+#define CLICOMMAND_BENCHSUITE           "benchsuite"
 #define CLICOMMAND_LISTGAMES            "listgames"     // for make tp_manufact.txt
 
+// number of emulated seconds -benchsuite runs each system for, absent -seconds_to_run
+const int BENCHSUITE_DEFAULT_SECONDS = 30;
+
 
 //**************************************************************************
 //  TYPE DEFINITIONS
@@ -105,6 +109,7 @@ public:
 	void verifysoftlist(const char *gamename = "*");
 	void listmididevices(const char *gamename = "*");
 	void listnetworkadapters(const char *gamename = "*");
+	void benchsuite(const char *gamename = "*");
 	void listgames(const char *gamename = "*");     // for make tp_manufact.txt
 
 private:
@@ -113,6 +118,7 @@ private:
 	void display_help();
 	void display_suggestions(const char *gamename);
 	void output_single_softlist(FILE *out, software_list_device &swlist);
+	void benchsuite_read_list(const char *filename, dynamic_array<int> &systems);
 
 	// internal state
 	cli_options &       m_options;
@@ -44,6 +44,7 @@ TODO:
 #include "arm7.h"
 #include "arm7core.h"   //include arm7 core
 #include "arm7help.h"
+#include "arm7fe.h"
 
 
 /* prototypes of coprocessor functions */
@@ -72,6 +73,7 @@ arm7_cpu_device::arm7_cpu_device(const machine_config &mconfig, const char *tag,
 	, m_archFlags(eARM_ARCHFLAGS_T)  // has Thumb
 	, m_copro_id(0x41 | (1 << 23) | (7 << 12))  // <-- where did this come from?
 	, m_pc(0)
+	, m_isdrc(mconfig.options().drc())
 {
 	memset(m_r, 0x00, sizeof(m_r));
 }
@@ -85,6 +87,7 @@ arm7_cpu_device::arm7_cpu_device(const machine_config &mconfig, device_type type
 	, m_archFlags(archFlags)
 	, m_copro_id(0x41 | (1 << 23) | (7 << 12))  // <-- where did this come from?
 	, m_pc(0)
+	, m_isdrc(mconfig.options().drc() && !(archFlags & eARM_ARCHFLAGS_MODE26))  // the recompiler doesn't handle 26-bit only cores
 {
 	memset(m_r, 0x00, sizeof(m_r));
 }
@@ -560,6 +563,16 @@ void arm7_cpu_device::device_start()
 	state_add( ARM7_USPSR, "UR16", m_r[eSPSR_UND]).formatstr("%08X");
 
 	state_add(STATE_GENFLAGS, "GENFLAGS", m_r[eCPSR]).formatstr("%13s").noshow();
+
+	if (m_isdrc)
+		arm7_drc_init();
+}
+
+
+void arm7_cpu_device::device_stop()
+{
+	if (m_isdrc)
+		arm7_drc_exit();
 }
 
 
@@ -623,141 +636,152 @@ void arm7_cpu_device::device_reset()
 	m_r[eR15] += 4; \
 	m_icount +=2; /* Any unexecuted instruction only takes 1 cycle (page 193) */
 
-void arm7_cpu_device::execute_run()
+inline void arm7_cpu_device::execute_one()
 {
 	UINT32 insn;
+	UINT32 pc = GET_PC;
 
-	do
-	{
-		UINT32 pc = GET_PC;
-
-		debugger_instruction_hook(this, pc);
+	debugger_instruction_hook(this, pc);
 
-		/* handle Thumb instructions if active */
-		if (T_IS_SET(m_r[eCPSR]))
-		{
-			offs_t raddr;
+	/* handle Thumb instructions if active */
+	if (T_IS_SET(m_r[eCPSR]))
+	{
+		offs_t raddr;
 
-			pc = m_r[eR15];
+		pc = m_r[eR15];
 
-			// "In Thumb state, bit [0] is undefined and must be ignored. Bits [31:1] contain the PC."
-			raddr = pc & (~1);
+		// "In Thumb state, bit [0] is undefined and must be ignored. Bits [31:1] contain the PC."
+		raddr = pc & (~1);
 
-			if ( m_control & COPRO_CTRL_MMU_EN )
+		if ( m_control & COPRO_CTRL_MMU_EN )
+		{
+			if (!arm7_tlb_translate(raddr, ARM7_TLB_ABORT_P | ARM7_TLB_READ))
 			{
-				if (!arm7_tlb_translate(raddr, ARM7_TLB_ABORT_P | ARM7_TLB_READ))
-				{
-					goto skip_exec;
-				}
+				goto skip_exec;
 			}
+		}
 
-			insn = m_direct->read_decrypted_word(raddr);
-			(this->*thumb_handler[(insn & 0xffc0) >> 6])(pc, insn);
+		insn = m_direct->read_decrypted_word(raddr);
+		(this->*thumb_handler[(insn & 0xffc0) >> 6])(pc, insn);
 
-		}
-		else
-		{
-			offs_t raddr;
+	}
+	else
+	{
+		offs_t raddr;
 
-			/* load 32 bit instruction */
+		/* load 32 bit instruction */
 
-			// "In ARM state, bits [1:0] of r15 are undefined and must be ignored. Bits [31:2] contain the PC."
-			raddr = pc & (~3);
+		// "In ARM state, bits [1:0] of r15 are undefined and must be ignored. Bits [31:2] contain the PC."
+		raddr = pc & (~3);
 
-			if ( m_control & COPRO_CTRL_MMU_EN )
+		if ( m_control & COPRO_CTRL_MMU_EN )
+		{
+			if (!arm7_tlb_translate(raddr, ARM7_TLB_ABORT_P | ARM7_TLB_READ))
 			{
-				if (!arm7_tlb_translate(raddr, ARM7_TLB_ABORT_P | ARM7_TLB_READ))
-				{
-					goto skip_exec;
-				}
+				goto skip_exec;
 			}
+		}
 
 #if 0
-			if (MODE26)
-			{
-				UINT32 temp1, temp2;
-				temp1 = GET_CPSR & 0xF00000C3;
-				temp2 = (R15 & 0xF0000000) | ((R15 & 0x0C000000) >> (26 - 6)) | (R15 & 0x00000003);
-				if (temp1 != temp2) fatalerror( "%08X: 32-bit and 26-bit modes are out of sync (%08X %08X)\n", pc, temp1, temp2);
-			}
+		if (MODE26)
+		{
+			UINT32 temp1, temp2;
+			temp1 = GET_CPSR & 0xF00000C3;
+			temp2 = (R15 & 0xF0000000) | ((R15 & 0x0C000000) >> (26 - 6)) | (R15 & 0x00000003);
+			if (temp1 != temp2) fatalerror( "%08X: 32-bit and 26-bit modes are out of sync (%08X %08X)\n", pc, temp1, temp2);
+		}
 #endif
 
-			insn = m_direct->read_decrypted_dword(raddr);
+		insn = m_direct->read_decrypted_dword(raddr);
 
-			/* process condition codes for this instruction */
-			switch (insn >> INSN_COND_SHIFT)
-			{
-				case COND_EQ:
-					if (Z_IS_CLEAR(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_NE:
-					if (Z_IS_SET(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_CS:
-					if (C_IS_CLEAR(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_CC:
-					if (C_IS_SET(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_MI:
-					if (N_IS_CLEAR(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_PL:
-					if (N_IS_SET(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_VS:
-					if (V_IS_CLEAR(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_VC:
-					if (V_IS_SET(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_HI:
-					if (C_IS_CLEAR(m_r[eCPSR]) || Z_IS_SET(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_LS:
-					if (C_IS_SET(m_r[eCPSR]) && Z_IS_CLEAR(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_GE:
-					if (!(m_r[eCPSR] & N_MASK) != !(m_r[eCPSR] & V_MASK)) /* Use x ^ (x >> ...) method */
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_LT:
-					if (!(m_r[eCPSR] & N_MASK) == !(m_r[eCPSR] & V_MASK))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_GT:
-					if (Z_IS_SET(m_r[eCPSR]) || (!(m_r[eCPSR] & N_MASK) != !(m_r[eCPSR] & V_MASK)))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_LE:
-					if (Z_IS_CLEAR(m_r[eCPSR]) && (!(m_r[eCPSR] & N_MASK) == !(m_r[eCPSR] & V_MASK)))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_NV:
+		/* process condition codes for this instruction */
+		switch (insn >> INSN_COND_SHIFT)
+		{
+			case COND_EQ:
+				if (Z_IS_CLEAR(m_r[eCPSR]))
 					{ UNEXECUTED();  goto skip_exec; }
-			}
-			/*******************************************************************/
-			/* If we got here - condition satisfied, so decode the instruction */
-			/*******************************************************************/
-			(this->*ops_handler[((insn & 0xF000000) >> 24)])(insn);
+				break;
+			case COND_NE:
+				if (Z_IS_SET(m_r[eCPSR]))
+					{ UNEXECUTED();  goto skip_exec; }
+				break;
+			case COND_CS:
+				if (C_IS_CLEAR(m_r[eCPSR]))
+					{ UNEXECUTED();  goto skip_exec; }
+				break;
+			case COND_CC:
+				if (C_IS_SET(m_r[eCPSR]))
+					{ UNEXECUTED();  goto skip_exec; }
+				break;
+			case COND_MI:
+				if (N_IS_CLEAR(m_r[eCPSR]))
+					{ UNEXECUTED();  goto skip_exec; }
+				break;
+			case COND_PL:
+				if (N_IS_SET(m_r[eCPSR]))
+					{ UNEXECUTED();  goto skip_exec; }
+				break;
+			case COND_VS:
+				if (V_IS_CLEAR(m_r[eCPSR]))
+					{ UNEXECUTED();  goto skip_exec; }
+				break;
+			case COND_VC:
+				if (V_IS_SET(m_r[eCPSR]))
+					{ UNEXECUTED();  goto skip_exec; }
+				break;
+			case COND_HI:
+				if (C_IS_CLEAR(m_r[eCPSR]) || Z_IS_SET(m_r[eCPSR]))
+					{ UNEXECUTED();  goto skip_exec; }
+				break;
+			case COND_LS:
+				if (C_IS_SET(m_r[eCPSR]) && Z_IS_CLEAR(m_r[eCPSR]))
+					{ UNEXECUTED();  goto skip_exec; }
+				break;
+			case COND_GE:
+				if (!(m_r[eCPSR] & N_MASK) != !(m_r[eCPSR] & V_MASK)) /* Use x ^ (x >> ...) method */
+					{ UNEXECUTED();  goto skip_exec; }
+				break;
+			case COND_LT:
+				if (!(m_r[eCPSR] & N_MASK) == !(m_r[eCPSR] & V_MASK))
+					{ UNEXECUTED();  goto skip_exec; }
+				break;
+			case COND_GT:
+				if (Z_IS_SET(m_r[eCPSR]) || (!(m_r[eCPSR] & N_MASK) != !(m_r[eCPSR] & V_MASK)))
+					{ UNEXECUTED();  goto skip_exec; }
+				break;
+			case COND_LE:
+				if (Z_IS_CLEAR(m_r[eCPSR]) && (!(m_r[eCPSR] & N_MASK) == !(m_r[eCPSR] & V_MASK)))
+					{ UNEXECUTED();  goto skip_exec; }
+				break;
+			case COND_NV:
+				{ UNEXECUTED();  goto skip_exec; }
 		}
+		/*******************************************************************/
+		/* If we got here - condition satisfied, so decode the instruction */
+		/*******************************************************************/
+		(this->*ops_handler[((insn & 0xF000000) >> 24)])(insn);
+	}
 
 skip_exec:
 
-		arm7_check_irq_state();
+	arm7_check_irq_state();
 
-		/* All instructions remove 3 cycles.. Others taking less / more will have adjusted this # prior to here */
-		m_icount -= 3;
+	/* All instructions remove 3 cycles.. Others taking less / more will have adjusted this # prior to here */
+	m_icount -= 3;
+}
+
+
+void arm7_cpu_device::execute_run()
+{
+	if (m_isdrc)
+	{
+		execute_run_drc();
+		return;
+	}
+
+	do
+	{
+		execute_one();
 	} while (m_icount > 0);
 }
 
@@ -1042,14 +1066,20 @@ WRITE32_MEMBER( arm7_cpu_device::arm7_rt_w_callback )
 				}
 			}
 #endif
+			if ((COPRO_CTRL ^ data) & COPRO_CTRL_MASK)
+				m_impstate.cache_dirty = TRUE;
 			COPRO_CTRL = data & COPRO_CTRL_MASK;
 			break;
 		case 2:             // Translation Table Base
 			LOG( ( "arm7_rt_w_callback TLB Base = %08x (%d) (%d)\n", data, op2, op3 ) );
+			if (COPRO_TLB_BASE != data)
+				m_impstate.cache_dirty = TRUE;
 			COPRO_TLB_BASE = data;
 			break;
 		case 3:             // Domain Access Control
 			LOG( ( "arm7_rt_w_callback Domain Access Control = %08x (%d) (%d)\n", data, op2, op3 ) );
+			if (COPRO_DOMAIN_ACCESS_CONTROL != data)
+				m_impstate.cache_dirty = TRUE;
 			COPRO_DOMAIN_ACCESS_CONTROL = data;
 			break;
 		case 5:             // Fault Status
@@ -1069,12 +1099,15 @@ WRITE32_MEMBER( arm7_cpu_device::arm7_rt_w_callback )
 			break;
 		case 8:             // TLB Operations
 			LOG( ( "arm7_rt_w_callback TLB Ops = %08x (%d) (%d)\n", data, op2, op3 ) );
+			m_impstate.cache_dirty = TRUE;
 			break;
 		case 9:             // Read Buffer Operations
 			LOG( ( "arm7_rt_w_callback Read Buffer Ops = %08x (%d) (%d)\n", data, op2, op3 ) );
 			break;
 		case 13:            // Write Process ID (PID)
 			LOG( ( "arm7_rt_w_callback Write PID = %08x (%d) (%d)\n", data, op2, op3 ) );
+			if (COPRO_FCSE_PID != data)
+				m_impstate.cache_dirty = TRUE;
 			COPRO_FCSE_PID = data;
 			break;
 		case 14:            // Write Breakpoint
@@ -63,6 +63,7 @@ enum
 ***************************************************************************/
 
 #define ARM7DRC_STRICT_VERIFY      0x0001          /* verify all instructions */
+#define ARM7DRC_COMPARE_INTERPRETER 0x0002         /* check each recompiled instruction against the interpreter */
 #define ARM7DRC_FLUSH_PC           0x0008          /* flush the PC value before each memory access */
 
 #define ARM7DRC_COMPATIBLE_OPTIONS (ARM7DRC_STRICT_VERIFY | ARM7DRC_FLUSH_PC)
@@ -72,8 +73,12 @@ enum
  *  PUBLIC FUNCTIONS
  ***************************************************************************************************/
 
+class arm7_frontend;
+
 class arm7_cpu_device : public cpu_device
 {
+	friend class arm7_frontend;
+
 public:
 	// construction/destruction
 	arm7_cpu_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock);
@@ -83,6 +88,7 @@ protected:
 	// device-level overrides
 	virtual void device_start();
 	virtual void device_reset();
+	virtual void device_stop();
 
 	// device_execute_interface overrides
 	virtual UINT32 execute_min_cycles() const { return 3; }
@@ -138,6 +144,9 @@ protected:
 	// For debugger
 	UINT32 m_pc;
 
+	// true if the recompiler is in use
+	bool m_isdrc;
+
 	INT64 saturate_qbit_overflow(INT64 res);
 	void SwitchMode(UINT32 cpsr_mode_val);
 	UINT32 decodeShift(UINT32 insn, UINT32 *pCarry);
@@ -171,6 +180,7 @@ protected:
 	UINT32 arm7_tlb_get_second_level_descriptor( UINT32 granularity, UINT32 first_desc, UINT32 vaddr );
 	int detect_fault(int permission, int ap, int flags);
 	void arm7_check_irq_state();
+	void execute_one();
 	void arm7_cpu_write32(UINT32 addr, UINT32 data);
 	void arm7_cpu_write16(UINT32 addr, UINT16 data);
 	void arm7_cpu_write8(UINT32 addr, UINT8 data);
@@ -319,6 +329,8 @@ protected:
 		UINT8               checkints;                  /* need to check interrupts before next instruction */
 		UINT8               checksoftints;              /* need to check software interrupts before next instruction */
 		uml::code_label  labelnum;                   /* index for local labels */
+		UINT32              mode;                       /* mode the block is compiled for */
+		uml::code_label     redispatch;                 /* label of the block's redispatch path */
 	};
 
 	/* ARM7 registers */
@@ -327,12 +339,13 @@ protected:
 		/* core state */
 		drc_cache *         cache;                      /* pointer to the DRC code cache */
 		drcuml_state *      drcuml;                     /* DRC UML generator state */
-		//arm7_frontend *     drcfe;                      /* pointer to the DRC front-end state */
+		arm7_frontend *     drcfe;                      /* pointer to the DRC front-end state */
 		UINT32              drcoptions;                 /* configurable DRC options */
 
 		/* internal stuff */
 		UINT8               cache_dirty;                /* true if we need to flush the cache */
 		UINT32              jmpdest;                    /* destination jump target */
+		UINT32              redispatch;                 /* nonzero if the last instruction must leave the block */
 
 		/* parameters for subroutines */
 		UINT64              numcycles;                  /* return value from gettotalcycles */
@@ -367,6 +380,19 @@ protected:
 		hotspot_info        hotspot[ARM7_MAX_HOTSPOTS];
 	} m_impstate;
 
+	/* state checked by ARM7DRC_COMPARE_INTERPRETER */
+	struct drc_compare_state
+	{
+		UINT32              r[/*NUM_REGS*/37];          /* all banks, CPSR and SPSRs */
+		INT32               icount;
+		UINT32              op;
+	};
+
+	drc_compare_state m_drc_before;
+	drc_compare_state m_drc_expected;
+	UINT32 m_drc_compares;
+	UINT32 m_drc_mismatches;
+
 	typedef void ( arm7_cpu_device::*arm7thumb_drcophandler)(drcuml_block*, compiler_state*, const opcode_desc*);
 	static const arm7thumb_drcophandler drcthumb_handler[0x40*0x10];
 
@@ -483,6 +509,15 @@ protected:
 	void code_compile_block(UINT8 mode, offs_t pc);
 	void cfunc_get_cycles();
 	void cfunc_unimplemented();
+public:
+	void func_execute_instruction();
+	void func_check_irq();
+	void func_compare_begin();
+	void func_compare_end();
+protected:
+	void save_compare_state(drc_compare_state &state);
+	void load_compare_state(const drc_compare_state &state);
+	void compare_register(const char *name, UINT32 expected, UINT32 actual);
 	void static_generate_entry_point();
 	void static_generate_check_irq();
 	void static_generate_nocode_handler();
@@ -494,19 +529,10 @@ protected:
 	void generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
 	void generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
 	void generate_delay_slot_and_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT8 linkreg);
-
-	typedef bool ( arm7_cpu_device::*drcarm7ops_ophandler)(drcuml_block*, compiler_state*, const opcode_desc*, UINT32);
-	static const drcarm7ops_ophandler drcops_handler[0x10];
-
-	void saturate_qbit_overflow(drcuml_block *block);
-	bool drcarm7ops_0123(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
-	bool drcarm7ops_4567(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
-	bool drcarm7ops_89(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
-	bool drcarm7ops_ab(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
-	bool drcarm7ops_cd(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
-	bool drcarm7ops_e(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
-	bool drcarm7ops_f(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
+	void generate_check_irq(drcuml_block *block, compiler_state *compiler);
+	bool generate_data_processing(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
 	int generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_unexecuted(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, uml::code_label unexecuted);
 
 };
 
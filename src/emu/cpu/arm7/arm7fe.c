@@ -0,0 +1,252 @@
+/***************************************************************************
+
+    arm7fe.c
+
+    Front-end for ARM7 recompiler
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "arm7fe.h"
+#include "arm7core.h"
+
+
+//**************************************************************************
+//  ARM7 FRONTEND
+//**************************************************************************
+
+//-------------------------------------------------
+//  arm7_frontend - constructor
+//-------------------------------------------------
+
+arm7_frontend::arm7_frontend(arm7_cpu_device &arm7, UINT32 window_start, UINT32 window_end, UINT32 max_sequence)
+	: drc_frontend(arm7, window_start, window_end, max_sequence),
+		m_arm7(arm7)
+{
+}
+
+
+//-------------------------------------------------
+//  describe - build a description of a single
+//  instruction
+//-------------------------------------------------
+
+bool arm7_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	UINT32 mode = m_arm7.m_impstate.mode;
+
+	// compute the fetch address the same way the interpreter does
+	if (mode & ARM7_DRC_MODE_THUMB)
+		desc.physpc = desc.pc & ~1;
+	else if (!(mode & SR_MODE32))
+		desc.physpc = desc.pc & 0x03fffffc;
+	else
+		desc.physpc = desc.pc & ~3;
+
+	// a page fault, or code that can't be read directly, is left to the
+	// interpreter; this ends the sequence and is stepped one instruction
+	// at a time at runtime
+	if (((m_arm7.m_control & COPRO_CTRL_MMU_EN) && !m_arm7.memory_translate(AS_PROGRAM, TRANSLATE_FETCH, desc.physpc)) ||
+		m_arm7.m_direct->read_decrypted_ptr(desc.physpc) == NULL)
+	{
+		desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_COMPILER_PAGE_FAULT | OPFLAG_VIRTUAL_NOOP | OPFLAG_END_SEQUENCE;
+		return true;
+	}
+
+	// all instructions are 1 cycle; the interpreter handlers account for the rest
+	desc.cycles = 1;
+
+	if (mode & ARM7_DRC_MODE_THUMB)
+	{
+		desc.length = 2;
+		return describe_thumb(desc.opptr.w[0] = m_arm7.m_direct->read_decrypted_word(desc.physpc), desc);
+	}
+
+	desc.length = 4;
+	return describe_arm(desc.opptr.l[0] = m_arm7.m_direct->read_decrypted_dword(desc.physpc), desc);
+}
+
+
+//-------------------------------------------------
+//  describe_arm - build a description of a
+//  32-bit ARM instruction
+//-------------------------------------------------
+
+bool arm7_frontend::describe_arm(UINT32 op, opcode_desc &desc)
+{
+	UINT32 cond = op >> INSN_COND_SHIFT;
+	UINT32 rd = (op & INSN_RD) >> INSN_RD_SHIFT;
+
+	// the interpreter never executes anything with the NV condition
+	if (cond == COND_NV)
+		return true;
+
+	// instructions that always write the PC end the sequence
+	UINT32 endflags = (cond == COND_AL) ? OPFLAG_END_SEQUENCE : 0;
+
+	// B/BL: static target, except in 26-bit mode where R15 also holds the flags
+	if ((op & 0x0e000000) == 0x0a000000)
+	{
+		desc.flags |= (cond == COND_AL) ? OPFLAG_IS_UNCONDITIONAL_BRANCH : OPFLAG_IS_CONDITIONAL_BRANCH;
+		desc.flags |= endflags;
+		if (m_arm7.m_impstate.mode & SR_MODE32)
+			desc.targetpc = desc.pc + 8 + (((INT32)(op << 8)) >> 6);
+		return true;
+	}
+
+	// SWI
+	if ((op & 0x0f000000) == 0x0f000000)
+	{
+		desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_CAN_CHANGE_MODES | endflags;
+		if (cond == COND_AL)
+			desc.flags |= OPFLAG_WILL_CAUSE_EXCEPTION;
+		return true;
+	}
+
+	// BX
+	if ((op & 0x0ffffff0) == 0x012fff10)
+	{
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_CAN_CHANGE_MODES | endflags;
+		return true;
+	}
+
+	switch ((op >> 25) & 7)
+	{
+		case 0:
+		case 1:
+			// multiplies, swaps and halfword transfers
+			if ((op & 0x0e000090) == 0x00000090)
+			{
+				if ((op & 0x60) == 0 && !(op & 0x01000000))
+					return true;
+				if ((op & 0x60) == 0)
+					desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_READS_MEMORY | OPFLAG_WRITES_MEMORY;
+				else
+					desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | ((op & INSN_SDT_L) ? OPFLAG_READS_MEMORY : OPFLAG_WRITES_MEMORY);
+				if ((op & INSN_SDT_L) && rd == 15)
+					desc.flags |= endflags;
+				return true;
+			}
+
+			// MSR can switch modes
+			if ((op & 0x0db0f000) == 0x0120f000)
+			{
+				desc.flags |= OPFLAG_CAN_CHANGE_MODES | endflags;
+				return true;
+			}
+
+			// data processing; TST/TEQ/CMP/CMN don't write Rd
+			if (((op & INSN_OPCODE) >> INSN_OPCODE_SHIFT) < 8 || ((op & INSN_OPCODE) >> INSN_OPCODE_SHIFT) > 11)
+			{
+				if (rd == 15)
+					desc.flags |= endflags | ((op & INSN_S) ? OPFLAG_CAN_CHANGE_MODES : 0);
+			}
+			return true;
+
+		case 2:
+		case 3:
+			// single data transfer
+			desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | ((op & INSN_SDT_L) ? OPFLAG_READS_MEMORY : OPFLAG_WRITES_MEMORY);
+			if ((op & INSN_SDT_L) && rd == 15)
+				desc.flags |= endflags;
+			return true;
+
+		case 4:
+			// block data transfer
+			desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | ((op & INSN_BDT_L) ? OPFLAG_READS_MEMORY : OPFLAG_WRITES_MEMORY);
+			if ((op & INSN_BDT_S) && (op & INSN_BDT_L) && (op & 0x8000))
+				desc.flags |= OPFLAG_CAN_CHANGE_MODES;
+			if ((op & INSN_BDT_L) && (op & 0x8000))
+				desc.flags |= endflags;
+			return true;
+
+		case 6:
+		case 7:
+			// coprocessor operations; register transfers to CP15 can remap the code
+			desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION;
+			if ((op & 0x0f100010) == 0x0e000010)
+				desc.flags |= OPFLAG_MODIFIES_TRANSLATION | endflags;
+			return true;
+	}
+
+	return true;
+}
+
+
+//-------------------------------------------------
+//  describe_thumb - build a description of a
+//  16-bit Thumb instruction
+//-------------------------------------------------
+
+bool arm7_frontend::describe_thumb(UINT16 op, opcode_desc &desc)
+{
+	switch (op >> 11)
+	{
+		case 0x08:
+			// hi register operations: BX/BLX, or ADD/MOV into the PC
+			if ((op & 0xfc00) == 0x4400)
+			{
+				if ((op & 0x0300) == 0x0300)
+					desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_CAN_CHANGE_MODES | OPFLAG_END_SEQUENCE;
+				else if ((op & 0x0300) != 0x0100 && ((op & 7) | ((op >> 4) & 8)) == 15)
+					desc.flags |= OPFLAG_END_SEQUENCE;
+			}
+			return true;
+
+		case 0x09:
+		case 0x0a: case 0x0b:
+		case 0x0c: case 0x0d: case 0x0e: case 0x0f:
+		case 0x10: case 0x11:
+		case 0x12: case 0x13:
+		case 0x18: case 0x19:
+			// loads and stores; the register-offset group encodes the direction in bits 9-11
+			desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION;
+			if ((op >> 11) == 0x09 || (((op >> 12) == 0x05) ? ((op & 0x0e00) >= 0x0600) : ((op & 0x0800) != 0)))
+				desc.flags |= OPFLAG_READS_MEMORY;
+			else
+				desc.flags |= OPFLAG_WRITES_MEMORY;
+			return true;
+
+		case 0x16:
+		case 0x17:
+			// PUSH/POP; POP {..., PC} is a return
+			if ((op & 0x0600) == 0x0400)
+				desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | ((op & 0x0800) ? OPFLAG_READS_MEMORY : OPFLAG_WRITES_MEMORY);
+			if ((op & 0xff00) == 0xbd00)
+				desc.flags |= OPFLAG_END_SEQUENCE;
+			else if ((op & 0xff00) == 0xbe00)
+				desc.flags |= OPFLAG_WILL_CAUSE_EXCEPTION | OPFLAG_END_SEQUENCE;
+			return true;
+
+		case 0x1a:
+		case 0x1b:
+			// conditional branches, with SWI and undefined in the holes
+			if ((op & 0x0f00) >= 0x0e00)
+			{
+				desc.flags |= OPFLAG_WILL_CAUSE_EXCEPTION | OPFLAG_CAN_CHANGE_MODES | OPFLAG_END_SEQUENCE;
+				return true;
+			}
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			desc.targetpc = desc.pc + 4 + (((INT32)((UINT32)op << 24)) >> 23);
+			return true;
+
+		case 0x1c:
+			// unconditional branch
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = desc.pc + 4 + (((INT32)((UINT32)op << 21)) >> 20);
+			return true;
+
+		case 0x1d:
+		case 0x1f:
+			// second half of BL/BLX; the target depends on the first half
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			if ((op >> 11) == 0x1d)
+				desc.flags |= OPFLAG_CAN_CHANGE_MODES;
+			return true;
+	}
+
+	return true;
+}
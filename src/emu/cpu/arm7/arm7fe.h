@@ -0,0 +1,57 @@
+/***************************************************************************
+
+    arm7fe.h
+
+    Front-end for ARM7 recompiler
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __ARM7FE_H__
+#define __ARM7FE_H__
+
+#include "arm7.h"
+#include "cpu/drcfe.h"
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// compile modes are the CPSR mode bits plus the Thumb state
+#define ARM7_DRC_MODE_MASK              0x1f
+#define ARM7_DRC_MODE_THUMB             0x20
+#define ARM7_DRC_MODES                  0x40
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+class arm7_frontend : public drc_frontend
+{
+public:
+	// construction/destruction
+	arm7_frontend(arm7_cpu_device &arm7, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
+
+protected:
+	// required overrides
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev);
+
+private:
+	// internal helpers
+	bool describe_arm(UINT32 op, opcode_desc &desc);
+	bool describe_thumb(UINT16 op, opcode_desc &desc);
+
+	// internal state
+	arm7_cpu_device &m_arm7;
+};
+
+
+
+#endif /* __ARM7FE_H__ */
@@ -32,6 +32,7 @@ DRCOBJ = \
 	$(CPUOBJ)/drcbeut.o \
 	$(CPUOBJ)/drccache.o \
 	$(CPUOBJ)/drcfe.o \
+	$(CPUOBJ)/drcpersist.o \
 	$(CPUOBJ)/drcuml.o \
 	$(CPUOBJ)/uml.o \
 	$(CPUOBJ)/i386/i386dasm.o \
@@ -44,6 +45,7 @@ DRCDEPS = \
 	$(CPUSRC)/drcbeut.h \
 	$(CPUSRC)/drccache.h \
 	$(CPUSRC)/drcfe.h \
+	$(CPUSRC)/drcpersist.h \
 	$(CPUSRC)/drcuml.h \
 	$(CPUSRC)/drcumlsh.h \
 	$(CPUSRC)/uml.h \
@@ -148,6 +150,7 @@ OBJDIRS += $(CPUOBJ)/arm7
 CPUOBJS += $(CPUOBJ)/arm7/arm7.o
 CPUOBJS += $(CPUOBJ)/arm7/arm7thmb.o
 CPUOBJS += $(CPUOBJ)/arm7/arm7ops.o
+CPUOBJS += $(CPUOBJ)/arm7/arm7fe.o $(DRCOBJ)
 DASMOBJS += $(CPUOBJ)/arm7/arm7dasm.o
 endif
 
@@ -161,7 +164,14 @@ $(CPUOBJ)/arm7/arm7.o:  $(CPUSRC)/arm7/arm7.c \
 						$(CPUSRC)/arm7/arm7ops.c \
 						$(CPUSRC)/arm7/arm7core.inc \
 						$(CPUSRC)/arm7/arm7drc.inc \
-						$(CPUSRC)/arm7/arm7tdrc.inc
+						$(CPUSRC)/arm7/arm7tdrc.inc \
+						$(CPUSRC)/arm7/arm7fe.h \
+						$(DRCDEPS)
+
+$(CPUOBJ)/arm7/arm7fe.o:    $(CPUSRC)/arm7/arm7fe.c \
+						$(CPUSRC)/arm7/arm7fe.h \
+						$(CPUSRC)/arm7/arm7.h \
+						$(CPUSRC)/arm7/arm7core.h
 
 $(CPUOBJ)/arm7/arm7ops.o:   $(CPUSRC)/arm7/arm7ops.c \
 						$(CPUSRC)/arm7/arm7.h \
@@ -758,6 +768,7 @@ $(CPUOBJ)/sh2/sh2fe.o:  $(CPUSRC)/sh2/sh2fe.c \
 ifneq ($(filter SH4,$(CPUS)),)
 OBJDIRS += $(CPUOBJ)/sh4
 CPUOBJS += $(CPUOBJ)/sh4/sh4.o $(CPUOBJ)/sh4/sh4comn.o $(CPUOBJ)/sh4/sh3comn.o $(CPUOBJ)/sh4/sh4tmu.o $(CPUOBJ)/sh4/sh4dmac.o
+CPUOBJS += $(CPUOBJ)/sh4/sh4fe.o $(CPUOBJ)/sh4/sh4drc.o $(DRCOBJ)
 DASMOBJS += $(CPUOBJ)/sh4/sh4dasm.o
 endif
 
@@ -775,6 +786,15 @@ $(CPUOBJ)/sh4/sh4comn.o:  $(CPUSRC)/sh4/sh4comn.c \
 $(CPUOBJ)/sh4/sh3comn.o:  $(CPUSRC)/sh4/sh3comn.c \
 			$(CPUSRC)/sh4/sh3comn.h \
 
+$(CPUOBJ)/sh4/sh4fe.o:  $(CPUSRC)/sh4/sh4fe.c \
+			$(CPUSRC)/sh4/sh4.h \
+			$(CPUSRC)/sh4/sh4comn.h
+
+$(CPUOBJ)/sh4/sh4drc.o: $(CPUSRC)/sh4/sh4drc.c \
+			$(CPUSRC)/sh4/sh4.h \
+			$(CPUSRC)/sh4/sh4comn.h \
+			$(DRCDEPS)
+
 $(CPUOBJ)/sh4/sh4tmu.o: $(CPUSRC)/sh4/sh4tmu.c \
 			$(CPUSRC)/sh4/sh4tmu.h \
 			$(CPUSRC)/sh4/sh3comn.c \
@@ -1010,6 +1030,7 @@ endif
 ifneq ($(filter I386,$(CPUS)),)
 OBJDIRS += $(CPUOBJ)/i386
 CPUOBJS += $(CPUOBJ)/i386/i386.o
+CPUOBJS += $(CPUOBJ)/i386/i386fe.o $(CPUOBJ)/i386/i386drc.o $(DRCOBJ)
 DASMOBJS += $(CPUOBJ)/i386/i386dasm.o
 endif
 
@@ -1037,7 +1058,20 @@ $(CPUOBJ)/i386/i386.o:  $(CPUSRC)/i386/i386.c \
 						$(CPUSRC)/i386/pentops.inc \
 						$(CPUSRC)/i386/x87ops.inc \
 						$(CPUSRC)/i386/i386ops.h \
-						$(CPUSRC)/i386/cycles.h
+						$(CPUSRC)/i386/cycles.h \
+						$(DRCDEPS)
+
+$(CPUOBJ)/i386/i386fe.o:  $(CPUSRC)/i386/i386fe.c \
+						$(CPUSRC)/i386/i386fe.h \
+						$(CPUSRC)/i386/i386.h \
+						$(CPUSRC)/i386/i386priv.h
+
+$(CPUOBJ)/i386/i386drc.o: $(CPUSRC)/i386/i386drc.c \
+						$(CPUSRC)/i386/i386.h \
+						$(CPUSRC)/i386/i386priv.h \
+						$(CPUSRC)/i386/i386fe.h \
+						$(CPUSRC)/i386/cycles.h \
+						$(DRCDEPS)
 
 
 
@@ -1225,6 +1259,7 @@ $(CPUOBJ)/mips/mips3drc.o:  $(CPUSRC)/mips/mips3drc.c \
 ifneq ($(filter PSX,$(CPUS)),)
 OBJDIRS += $(CPUOBJ)/psx
 CPUOBJS += $(CPUOBJ)/psx/psx.o $(CPUOBJ)/psx/gte.o $(CPUOBJ)/psx/dma.o $(CPUOBJ)/psx/irq.o $(CPUOBJ)/psx/mdec.o $(CPUOBJ)/psx/rcnt.o $(CPUOBJ)/psx/sio.o
+CPUOBJS += $(CPUOBJ)/psx/psxfe.o $(CPUOBJ)/psx/psxdrc.o $(DRCOBJ)
 DASMOBJS += $(CPUOBJ)/psx/psxdasm.o
 endif
 
@@ -1234,7 +1269,17 @@ $(CPUOBJ)/psx/psx.o:    $(CPUSRC)/psx/psx.c \
 			$(CPUSRC)/psx/gte.h \
 			$(CPUSRC)/psx/mdec.h \
 			$(CPUSRC)/psx/rcnt.h \
-			$(CPUSRC)/psx/sio.h
+			$(CPUSRC)/psx/sio.h \
+			$(DRCDEPS)
+
+$(CPUOBJ)/psx/psxfe.o:  $(CPUSRC)/psx/psxfe.c \
+			$(CPUSRC)/psx/psxfe.h \
+			$(CPUSRC)/psx/psx.h
+
+$(CPUOBJ)/psx/psxdrc.o: $(CPUSRC)/psx/psxdrc.c \
+			$(CPUSRC)/psx/psx.h \
+			$(CPUSRC)/psx/psxfe.h \
+			$(DRCDEPS)
 
 $(CPUOBJ)/psx/dma.o:    $(CPUSRC)/psx/dma.c \
 			$(CPUSRC)/psx/dma.h
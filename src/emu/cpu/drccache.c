@@ -68,6 +68,7 @@ void drc_cache::flush()
 
 	// just reset the top back to the base and re-seed
 	m_top = m_base;
+	g_drc_cache_flushes++;
 }
 
 
@@ -225,6 +226,10 @@ drccodeptr drc_cache::end_codegen()
 	m_top = (drccodeptr)ALIGN_PTR_UP(m_top);
 	m_codegen = NULL;
 
+	// track the high-water mark across all caches
+	if ((size_t)(m_top - m_base) > g_drc_cache_peak_bytes)
+		g_drc_cache_peak_bytes = m_top - m_base;
+
 	return result;
 }
 
@@ -0,0 +1,365 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    drcpersist.c
+
+    Persistent record of compiled DRC blocks, used to warm the code
+    cache from a previous run.
+
+****************************************************************************
+
+    The generated code itself is never written out: both the UML and
+    the native code embed host pointers to the CPU state, memory
+    handlers and C callbacks, all of which move from run to run. What
+    is kept instead is the list of (mode, pc) pairs that were compiled,
+    together with a checksum of the guest code each block covered.
+
+    On the next run of the same system, nothing is compiled up front,
+    since code that lives in RAM (N64 RDRAM, RSP IMEM, and so on) has
+    usually not been loaded yet when the CPU first runs. Instead, the
+    first time a block on a given page has to be compiled on demand,
+    the recorded blocks on that page are re-described by the front-end
+    and compiled along with it, but only those whose checksum matches
+    what is in memory now. Entries that do not match stay pending for
+    a few more misses on their page, in case the code they describe is
+    loaded later, and are then left to be compiled on demand as usual.
+
+    Files are keyed by the system name, the CPU tag and configuration,
+    and a CRC of all memory regions, so a different ROM set or BIOS
+    simply starts a fresh record.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "drcpersist.h"
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+static const char s_magic[8] = { 'M', 'A', 'M', 'E', 'D', 'R', 'C', 'P' };
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  hash_bucket - return the bucket for a mode/pc
+//  pair
+//-------------------------------------------------
+
+inline int hash_bucket(UINT8 mode, offs_t pc, int buckets)
+{
+	return ((pc >> 1) ^ (pc >> 13) ^ (mode << 7)) & (buckets - 1);
+}
+
+
+//-------------------------------------------------
+//  page_bucket - return the bucket for the page
+//  holding a mode/pc pair
+//-------------------------------------------------
+
+inline int page_bucket(UINT8 mode, offs_t page, int buckets)
+{
+	return (page ^ (page >> 10) ^ (mode << 5)) & (buckets - 1);
+}
+
+
+//-------------------------------------------------
+//  put_le32 / get_le32 - little-endian helpers
+//  for the on-disk format
+//-------------------------------------------------
+
+inline void put_le32(UINT8 *dest, UINT32 value)
+{
+	dest[0] = value >> 0;
+	dest[1] = value >> 8;
+	dest[2] = value >> 16;
+	dest[3] = value >> 24;
+}
+
+inline UINT32 get_le32(const UINT8 *src)
+{
+	return src[0] | (src[1] << 8) | (src[2] << 16) | (src[3] << 24);
+}
+
+
+
+//**************************************************************************
+//  PERSISTENT CACHE
+//**************************************************************************
+
+//-------------------------------------------------
+//  drc_persistent_cache - constructor
+//-------------------------------------------------
+
+drc_persistent_cache::drc_persistent_cache(device_t &device, drc_frontend &frontend, drc_compile_delegate compile, UINT32 confighash)
+	: m_device(device),
+		m_frontend(frontend),
+		m_compile(compile),
+		m_key(0),
+		m_dirty(false),
+		m_pending(0),
+		m_loaded(0),
+		m_warmed(0),
+		m_hash(HASH_BUCKETS, 0xff),
+		m_pagehash(PAGE_BUCKETS, 0xff)
+{
+	running_machine &machine = device.machine();
+
+	// name the file after the system and the CPU tag, like device NVRAM
+	astring tag(device.tag());
+	tag.del(0, 1).replacechr(':', '_');
+	m_filename.printf("%s\\%s.drc", machine.basename(), tag.cstr());
+
+	// key the contents on the configuration and everything that was loaded
+	astring keystring;
+	keystring.printf("%s/%s/%s/%08X", machine.system().name, device.tag(), device.shortname(), confighash);
+	crc32_creator key;
+	key.append(keystring.cstr(), keystring.len());
+	for (memory_region *region = machine.memory().first_region(); region != NULL; region = region->next())
+	{
+		key.append(region->name(), strlen(region->name()));
+		key.append(region->base(), region->bytes());
+	}
+	m_key = key.finish();
+
+	load();
+}
+
+
+//-------------------------------------------------
+//  block_compiled - note that a block has been
+//  compiled; called by the CPU core after each
+//  successful code_compile_block
+//-------------------------------------------------
+
+void drc_persistent_cache::block_compiled(UINT8 mode, offs_t pc, const opcode_desc *desclist)
+{
+	UINT32 checksum = compute_checksum(desclist);
+
+	// existing entries just track the latest version of the code
+	int index = find_entry(mode, pc);
+	if (index != -1)
+	{
+		// a pending entry is left in its page chain until the next walk
+		if (m_entries[index].retries != 0)
+		{
+			m_entries[index].retries = 0;
+			m_pending--;
+		}
+		if (m_entries[index].checksum != checksum)
+		{
+			m_entries[index].checksum = checksum;
+			m_dirty = true;
+		}
+		return;
+	}
+
+	if (add_entry(mode, pc, checksum) != -1)
+		m_dirty = true;
+}
+
+
+//-------------------------------------------------
+//  missing_code - compile the pending recorded
+//  blocks on the same page as a block the CPU
+//  core is about to compile on demand; must be
+//  called from within the CPU's execute_run,
+//  before compiling the missing block itself
+//-------------------------------------------------
+
+void drc_persistent_cache::missing_code(UINT8 mode, offs_t pc)
+{
+	if (m_pending == 0)
+		return;
+
+	offs_t page = pc >> PAGE_SHIFT;
+	int *link = &m_pagehash[page_bucket(mode, page, PAGE_BUCKETS)];
+	while (*link != -1)
+	{
+		// the chain is shared by all pages in the bucket; skip the others
+		int index = *link;
+		block_entry &entry = m_entries[index];
+		if (entry.mode != mode || (entry.pc >> PAGE_SHIFT) != page)
+		{
+			link = &entry.pagenext;
+			continue;
+		}
+
+		// entries compiled on demand since loading, and the missing block
+		// itself, need nothing more; otherwise compile if the guest code
+		// is unchanged, or keep waiting for a few more misses
+		if (entry.retries != 0 && entry.pc != pc)
+		{
+			if (compute_checksum(m_frontend.describe_code(entry.pc)) == entry.checksum)
+			{
+				// compiling may flush the cache and update this entry, but
+				// never adds or removes entries while we are walking them
+				m_compile(mode, entry.pc);
+				m_warmed++;
+			}
+			else if (entry.retries > 1)
+			{
+				entry.retries--;
+				link = &entry.pagenext;
+				continue;
+			}
+		}
+
+		// unlink the entry; it is no longer pending
+		*link = entry.pagenext;
+		entry.pagenext = -1;
+		if (entry.retries != 0)
+		{
+			entry.retries = 0;
+			m_pending--;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  save - write the record to the DRC cache
+//  directory, if anything new was compiled
+//-------------------------------------------------
+
+void drc_persistent_cache::save()
+{
+	if (m_loaded != 0)
+		logerror("%s: compiled %d of %d recorded DRC blocks ahead of need\n", m_device.tag(), m_warmed, m_loaded);
+
+	if (!m_dirty)
+		return;
+
+	emu_file file(m_device.machine().options().drccache_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(m_filename) != FILERR_NONE)
+		return;
+
+	UINT8 header[HEADER_SIZE];
+	memcpy(&header[0], s_magic, sizeof(s_magic));
+	put_le32(&header[8], FILE_VERSION);
+	put_le32(&header[12], m_key);
+	put_le32(&header[16], m_entries.count());
+	file.write(header, sizeof(header));
+
+	for (int index = 0; index < m_entries.count(); index++)
+	{
+		UINT8 data[ENTRY_SIZE];
+		put_le32(&data[0], m_entries[index].pc);
+		put_le32(&data[4], m_entries[index].checksum);
+		put_le32(&data[8], m_entries[index].mode);
+		file.write(data, sizeof(data));
+	}
+	m_dirty = false;
+}
+
+
+//-------------------------------------------------
+//  compute_checksum - checksum the guest code
+//  covered by a block, including delay slots
+//-------------------------------------------------
+
+UINT32 drc_persistent_cache::compute_checksum(const opcode_desc *desclist)
+{
+	crc32_creator crc;
+	for (const opcode_desc *desc = desclist; desc != NULL; desc = desc->next())
+	{
+		const opcode_desc *delay = desc->delay.first();
+		for (const opcode_desc *curdesc = desc; curdesc != NULL; curdesc = (curdesc == desc) ? delay : curdesc->next())
+		{
+			UINT32 info[4] = { curdesc->pc, curdesc->physpc, curdesc->flags, curdesc->length };
+			crc.append(info, sizeof(info));
+			crc.append(curdesc->opptr.b, MIN(curdesc->length, sizeof(curdesc->opptr.b)));
+		}
+	}
+	return crc.finish();
+}
+
+
+//-------------------------------------------------
+//  find_entry - return the index of the entry for
+//  a mode/pc pair, or -1
+//-------------------------------------------------
+
+int drc_persistent_cache::find_entry(UINT8 mode, offs_t pc) const
+{
+	for (int index = m_hash[hash_bucket(mode, pc, HASH_BUCKETS)]; index != -1; index = m_entries[index].hashnext)
+		if (m_entries[index].pc == pc && m_entries[index].mode == mode)
+			return index;
+	return -1;
+}
+
+
+//-------------------------------------------------
+//  add_entry - append a new entry, returning its
+//  index or -1 if the record is full
+//-------------------------------------------------
+
+int drc_persistent_cache::add_entry(UINT8 mode, offs_t pc, UINT32 checksum)
+{
+	if (m_entries.count() >= MAX_ENTRIES)
+		return -1;
+
+	int bucket = hash_bucket(mode, pc, HASH_BUCKETS);
+	int index = m_entries.count();
+	block_entry &entry = m_entries.append();
+	entry.pc = pc;
+	entry.checksum = checksum;
+	entry.mode = mode;
+	entry.retries = 0;
+	entry.hashnext = m_hash[bucket];
+	entry.pagenext = -1;
+	m_hash[bucket] = index;
+	return index;
+}
+
+
+//-------------------------------------------------
+//  load - read the record from a previous run,
+//  ignoring it entirely if the key or version
+//  does not match
+//-------------------------------------------------
+
+void drc_persistent_cache::load()
+{
+	emu_file file(m_device.machine().options().drccache_directory(), OPEN_FLAG_READ);
+	if (file.open(m_filename) != FILERR_NONE)
+		return;
+
+	UINT8 header[HEADER_SIZE];
+	if (file.read(header, sizeof(header)) != sizeof(header) || memcmp(&header[0], s_magic, sizeof(s_magic)) != 0)
+		return;
+	if (get_le32(&header[8]) != FILE_VERSION || get_le32(&header[12]) != m_key)
+	{
+		logerror("%s: discarding stale DRC block record\n", m_device.tag());
+		return;
+	}
+
+	UINT32 count = get_le32(&header[16]);
+	for (UINT32 entrynum = 0; entrynum < count; entrynum++)
+	{
+		UINT8 data[ENTRY_SIZE];
+		if (file.read(data, sizeof(data)) != sizeof(data))
+			break;
+		UINT8 mode = get_le32(&data[8]);
+		offs_t pc = get_le32(&data[0]);
+		if (find_entry(mode, pc) != -1)
+			continue;
+		int index = add_entry(mode, pc, get_le32(&data[4]));
+		if (index == -1)
+			break;
+
+		// loaded entries wait on their page for the first miss there
+		int *head = &m_pagehash[page_bucket(mode, pc >> PAGE_SHIFT, PAGE_BUCKETS)];
+		m_entries[index].retries = MAX_RETRIES;
+		m_entries[index].pagenext = *head;
+		*head = index;
+		m_pending++;
+	}
+	m_loaded = m_pending;
+}
@@ -0,0 +1,95 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    drcpersist.h
+
+    Persistent record of compiled DRC blocks, used to warm the code
+    cache from a previous run.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __DRCPERSIST_H__
+#define __DRCPERSIST_H__
+
+#include "drcfe.h"
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// callback to compile a block of the given mode at the given pc
+typedef delegate<void (UINT8, offs_t)> drc_compile_delegate;
+
+
+// drc_persistent_cache
+class drc_persistent_cache
+{
+public:
+	// construction/destruction
+	drc_persistent_cache(device_t &device, drc_frontend &frontend, drc_compile_delegate compile, UINT32 confighash);
+
+	// getters
+	int count() const { return m_entries.count(); }
+
+	// notification of a freshly compiled block
+	void block_compiled(UINT8 mode, offs_t pc, const opcode_desc *desclist);
+
+	// compile the recorded blocks sharing a page with a block about to be
+	// compiled on demand
+	void missing_code(UINT8 mode, offs_t pc);
+
+	// write the record back out
+	void save();
+
+private:
+	// an entry for each block we have compiled
+	struct block_entry
+	{
+		offs_t          pc;                 // starting PC of the block
+		UINT32          checksum;           // checksum of the guest code covered
+		UINT8           mode;               // mode the block was compiled in
+		UINT8           retries;            // validations left before giving up, 0 if not pending
+		int             hashnext;           // index of the next entry in the same bucket
+		int             pagenext;           // index of the next entry in the same page bucket
+	};
+
+	// internal helpers
+	static UINT32 compute_checksum(const opcode_desc *desclist);
+	int find_entry(UINT8 mode, offs_t pc) const;
+	int add_entry(UINT8 mode, offs_t pc, UINT32 checksum);
+	void load();
+
+	// on-disk format
+	static const UINT32 FILE_VERSION = 1;
+	static const UINT32 HEADER_SIZE = 20;
+	static const UINT32 ENTRY_SIZE = 12;
+
+	// limits
+	static const int MAX_ENTRIES = 65536;
+	static const int HASH_BUCKETS = 4096;
+	static const int PAGE_SHIFT = 10;
+	static const int PAGE_BUCKETS = 1024;
+	static const int MAX_RETRIES = 4;
+
+	// internal state
+	device_t &          m_device;           // owning CPU device
+	drc_frontend &      m_frontend;         // front-end used to re-describe blocks
+	drc_compile_delegate m_compile;         // callback to compile a block
+	astring             m_filename;         // name of the file within the cache directory
+	UINT32              m_key;              // hash of the system, device and ROM contents
+	bool                m_dirty;            // true if entries were added since loading
+	int                 m_pending;          // loaded entries not yet compiled or given up on
+	int                 m_loaded;           // number of entries read from the file
+	int                 m_warmed;           // number of loaded entries compiled ahead of need
+	dynamic_array<block_entry> m_entries;   // entries in the order they were compiled
+	dynamic_array<int>  m_hash;             // first entry index in each bucket, or -1
+	dynamic_array<int>  m_pagehash;         // first pending entry index in each page bucket, or -1
+};
+
+
+#endif /* __DRCPERSIST_H__ */
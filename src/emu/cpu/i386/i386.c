@@ -44,6 +44,13 @@ i386_device::i386_device(const machine_config &mconfig, const char *tag, device_
 	, m_program_config("program", ENDIANNESS_LITTLE, 32, 32, 0)
 	, m_io_config("io", ENDIANNESS_LITTLE, 32, 16, 0)
 	, m_smiact(*this)
+	, m_isdrc(mconfig.options().drc())
+	, m_cache(NULL)
+	, m_drcuml(NULL)
+	, m_drcfe(NULL)
+	, m_entry(NULL)
+	, m_nocode(NULL)
+	, m_out_of_cycles(NULL)
 {
 	m_program_config.m_logaddr_width = 32;
 	m_program_config.m_page_shift = 12;
@@ -55,6 +62,13 @@ i386_device::i386_device(const machine_config &mconfig, device_type type, const
 	, m_program_config("program", ENDIANNESS_LITTLE, program_data_width, program_addr_width, 0)
 	, m_io_config("io", ENDIANNESS_LITTLE, io_data_width, 16, 0)
 	, m_smiact(*this)
+	, m_isdrc(mconfig.options().drc())
+	, m_cache(NULL)
+	, m_drcuml(NULL)
+	, m_drcfe(NULL)
+	, m_entry(NULL)
+	, m_nocode(NULL)
+	, m_out_of_cycles(NULL)
 {
 	m_program_config.m_logaddr_width = 32;
 	m_program_config.m_page_shift = 12;
@@ -117,6 +131,272 @@ MODRM_TABLE i386_MODRM_table[256];
 #define FAULT(fault,error) {m_ext = 1; i386_trap_with_error(fault,0,0,error); return;}
 #define FAULT_EXP(fault,error) {m_ext = 1; i386_trap_with_error(fault,0,trap_level+1,error); return;}
 
+bool i386_device::i386_translate_address(int intention, offs_t *address, vtlb_entry *entry)
+{
+	UINT32 a = *address;
+	UINT32 pdbr = m_cr[3] & 0xfffff000;
+	UINT32 directory = (a >> 22) & 0x3ff;
+	UINT32 table = (a >> 12) & 0x3ff;
+	vtlb_entry perm = 0;
+	bool ret = false;
+	bool user = (intention & TRANSLATE_USER_MASK) ? true : false;
+	bool write = (intention & TRANSLATE_WRITE) ? true : false;
+	bool debug = (intention & TRANSLATE_DEBUG_MASK) ? true : false;
+
+	if(!(m_cr[0] & 0x80000000))
+	{
+		if(entry)
+			*entry = 0x77;
+		return true;
+	}
+
+	UINT32 page_dir = m_program->read_dword(pdbr + directory * 4);
+	if(page_dir & 1)
+	{
+		if ((page_dir & 0x80) && (m_cr[4] & 0x10))
+		{
+			a = (page_dir & 0xffc00000) | (a & 0x003fffff);
+			if(debug)
+			{
+				*address = a;
+				return true;
+			}
+			perm = get_permissions(page_dir, WP);
+			if(write && (!(perm & VTLB_WRITE_ALLOWED) || (user && !(perm & VTLB_USER_WRITE_ALLOWED))))
+				ret = false;
+			else if(user && !(perm & VTLB_USER_READ_ALLOWED))
+				ret = false;
+			else
+			{
+				if(write)
+					perm |= VTLB_FLAG_DIRTY;
+				if(!(page_dir & 0x40) && write)
+					m_program->write_dword(pdbr + directory * 4, page_dir | 0x60);
+				else if(!(page_dir & 0x20))
+					m_program->write_dword(pdbr + directory * 4, page_dir | 0x20);
+				ret = true;
+			}
+		}
+		else
+		{
+			UINT32 page_entry = m_program->read_dword((page_dir & 0xfffff000) + (table * 4));
+			if(!(page_entry & 1))
+				ret = false;
+			else
+			{
+				a = (page_entry & 0xfffff000) | (a & 0xfff);
+				if(debug)
+				{
+					*address = a;
+					return true;
+				}
+				perm = get_permissions(page_entry, WP);
+				if(write && (!(perm & VTLB_WRITE_ALLOWED) || (user && !(perm & VTLB_USER_WRITE_ALLOWED))))
+					ret = false;
+				else if(user && !(perm & VTLB_USER_READ_ALLOWED))
+					ret = false;
+				else
+				{
+					if(write)
+						perm |= VTLB_FLAG_DIRTY;
+					if(!(page_dir & 0x20))
+						m_program->write_dword(pdbr + directory * 4, page_dir | 0x20);
+					if(!(page_entry & 0x40) && write)
+						m_program->write_dword((page_dir & 0xfffff000) + (table * 4), page_entry | 0x60);
+					else if(!(page_entry & 0x20))
+						m_program->write_dword((page_dir & 0xfffff000) + (table * 4), page_entry | 0x20);
+					ret = true;
+				}
+			}
+		}
+	}
+	else
+		ret = false;
+	if(entry)
+		*entry = perm;
+	if(ret)
+		*address = a;
+	return ret;
+}
+
+/***********************************************************************************
+    MSR ACCESS
+***********************************************************************************/
+
+// Pentium MSR handling
+UINT64 i386_device::pentium_msr_read(UINT32 offset,UINT8 *valid_msr)
+{
+	switch(offset)
+	{
+	// Machine Check Exception (TODO)
+	case 0x00:
+		*valid_msr = 1;
+		popmessage("RDMSR: Reading P5_MC_ADDR");
+		return 0;
+	case 0x01:
+		*valid_msr = 1;
+		popmessage("RDMSR: Reading P5_MC_TYPE");
+		return 0;
+	// Time Stamp Counter
+	case 0x10:
+		*valid_msr = 1;
+		popmessage("RDMSR: Reading TSC");
+		return m_tsc;
+	// Event Counters (TODO)
+	case 0x11:  // CESR
+		*valid_msr = 1;
+		popmessage("RDMSR: Reading CESR");
+		return 0;
+	case 0x12:  // CTR0
+		*valid_msr = 1;
+		return m_perfctr[0];
+	case 0x13:  // CTR1
+		*valid_msr = 1;
+		return m_perfctr[1];
+	default:
+		if(!(offset & ~0xf)) // 2-f are test registers
+		{
+			*valid_msr = 1;
+			logerror("RDMSR: Reading test MSR %x", offset);
+			return 0;
+		}
+		logerror("RDMSR: invalid P5 MSR read %08x at %08x\n",offset,m_pc-2);
+		*valid_msr = 0;
+		return 0;
+	}
+	return -1;
+}
+
+void i386_device::pentium_msr_write(UINT32 offset, UINT64 data, UINT8 *valid_msr)
+{
+	switch(offset)
+	{
+	// Machine Check Exception (TODO)
+	case 0x00:
+		popmessage("WRMSR: Writing P5_MC_ADDR");
+		*valid_msr = 1;
+		break;
+	case 0x01:
+		popmessage("WRMSR: Writing P5_MC_TYPE");
+		*valid_msr = 1;
+		break;
+	// Time Stamp Counter
+	case 0x10:
+		m_tsc = data;
+		popmessage("WRMSR: Writing to TSC");
+		*valid_msr = 1;
+		break;
+	// Event Counters (TODO)
+	case 0x11:  // CESR
+		popmessage("WRMSR: Writing to CESR");
+		*valid_msr = 1;
+		break;
+	case 0x12:  // CTR0
+		m_perfctr[0] = data;
+		*valid_msr = 1;
+		break;
+	case 0x13:  // CTR1
+		m_perfctr[1] = data;
+		*valid_msr = 1;
+		break;
+	default:
+		if(!(offset & ~0xf)) // 2-f are test registers
+		{
+			*valid_msr = 1;
+			logerror("WRMSR: Writing test MSR %x", offset);
+			break;
+		}
+		logerror("WRMSR: invalid MSR write %08x (%08x%08x) at %08x\n",offset,(UINT32)(data >> 32),(UINT32)data,m_pc-2);
+		*valid_msr = 0;
+		break;
+	}
+}
+
+// P6 (Pentium Pro, Pentium II, Pentium III) MSR handling
+UINT64 i386_device::p6_msr_read(UINT32 offset,UINT8 *valid_msr)
+{
+	switch(offset)
+	{
+	// Machine Check Exception (TODO)
+	case 0x00:
+		*valid_msr = 1;
+		popmessage("RDMSR: Reading P5_MC_ADDR");
+		return 0;
+	case 0x01:
+		*valid_msr = 1;
+		popmessage("RDMSR: Reading P5_MC_TYPE");
+		return 0;
+	// Time Stamp Counter
+	case 0x10:
+		*valid_msr = 1;
+		popmessage("RDMSR: Reading TSC");
+		return m_tsc;
+	// Performance Counters (TODO)
+	case 0xc1:  // PerfCtr0
+		*valid_msr = 1;
+		return m_perfctr[0];
+	case 0xc2:  // PerfCtr1
+		*valid_msr = 1;
+		return m_perfctr[1];
+	default:
+		logerror("RDMSR: unimplemented register called %08x at %08x\n",offset,m_pc-2);
+		*valid_msr = 1;
+		return 0;
+	}
+	return -1;
+}
+
+void i386_device::p6_msr_write(UINT32 offset, UINT64 data, UINT8 *valid_msr)
+{
+	switch(offset)
+	{
+	// Time Stamp Counter
+	case 0x10:
+		m_tsc = data;
+		popmessage("WRMSR: Writing to TSC");
+		*valid_msr = 1;
+		break;
+	// Performance Counters (TODO)
+	case 0xc1:  // PerfCtr0
+		m_perfctr[0] = data;
+		*valid_msr = 1;
+		break;
+	case 0xc2:  // PerfCtr1
+		m_perfctr[1] = data;
+		*valid_msr = 1;
+		break;
+	default:
+		logerror("WRMSR: unimplemented register called %08x (%08x%08x) at %08x\n",offset,(UINT32)(data >> 32),(UINT32)data,m_pc-2);
+		*valid_msr = 1;
+		break;
+	}
+}
+
+
+// PIV (Pentium 4+)
+UINT64 i386_device::piv_msr_read(UINT32 offset,UINT8 *valid_msr)
+{
+	switch(offset)
+	{
+	default:
+		logerror("RDMSR: unimplemented register called %08x at %08x\n",offset,m_pc-2);
+		*valid_msr = 1;
+		return 0;
+	}
+	return -1;
+}
+
+void i386_device::piv_msr_write(UINT32 offset, UINT64 data, UINT8 *valid_msr)
+{
+	switch(offset)
+	{
+	default:
+		logerror("WRMSR: unimplemented register called %08x (%08x%08x) at %08x\n",offset,(UINT32)(data >> 32),(UINT32)data,m_pc-2);
+		*valid_msr = 1;
+		break;
+	}
+}
+
 /*************************************************************************/
 
 UINT32 i386_device::i386_load_protected_mode_segment(I386_SREG *seg, UINT64 *desc )
@@ -3220,6 +3500,9 @@ void i386_device::i386_common_init(int tlbsize)
 	m_smiact.resolve_safe();
 
 	m_icountptr = &m_cycles;
+
+	if (m_isdrc)
+		i386drc_init();
 }
 
 void i386_device::device_start()
@@ -3233,6 +3516,12 @@ void i386_device::device_start()
 	register_state_i386();
 }
 
+void i386_device::device_stop()
+{
+	if (m_isdrc)
+		i386drc_exit();
+}
+
 void i386_device::register_state_i386()
 {
 	state_add( I386_PC,         "PC", m_pc).formatstr("%08X");
@@ -3801,51 +4090,59 @@ void i386_device::execute_run()
 		return;
 	}
 
-	while( m_cycles > 0 )
+	if (m_isdrc)
+		execute_run_drc();
+	else
 	{
-		i386_check_irq_line();
-		m_operand_size = m_sreg[CS].d;
-		m_xmm_operand_size = 0;
-		m_address_size = m_sreg[CS].d;
-		m_operand_prefix = 0;
-		m_address_prefix = 0;
+		while( m_cycles > 0 )
+			i386_execute_one();
+	}
+	m_tsc += (cycles - m_cycles);
+}
 
-		m_ext = 1;
-		int old_tf = m_TF;
+void i386_device::i386_execute_one()
+{
+	i386_check_irq_line();
+	m_operand_size = m_sreg[CS].d;
+	m_xmm_operand_size = 0;
+	m_address_size = m_sreg[CS].d;
+	m_operand_prefix = 0;
+	m_address_prefix = 0;
 
-		m_segment_prefix = 0;
-		m_prev_eip = m_eip;
+	m_ext = 1;
+	int old_tf = m_TF;
 
-		debugger_instruction_hook(this, m_pc);
+	m_segment_prefix = 0;
+	m_prev_eip = m_eip;
 
-		if(m_delayed_interrupt_enable != 0)
-		{
-			m_IF = 1;
-			m_delayed_interrupt_enable = 0;
-		}
+	debugger_instruction_hook(this, m_pc);
+
+	if(m_delayed_interrupt_enable != 0)
+	{
+		m_IF = 1;
+		m_delayed_interrupt_enable = 0;
+	}
 #ifdef DEBUG_MISSING_OPCODE
-		m_opcode_bytes_length = 0;
-		m_opcode_pc = m_pc;
+	m_opcode_bytes_length = 0;
+	m_opcode_pc = m_pc;
 #endif
-		try
-		{
-			i386_decode_opcode();
-			if(m_TF && old_tf)
-			{
-				m_prev_eip = m_eip;
-				m_ext = 1;
-				i386_trap(1,0,0);
-			}
-			if(m_lock && (m_opcode != 0xf0))
-				m_lock = false;
-		}
-		catch(UINT64 e)
+	try
+	{
+		i386_decode_opcode();
+		if(m_TF && old_tf)
 		{
+			m_prev_eip = m_eip;
 			m_ext = 1;
-			i386_trap_with_error(e&0xffffffff,0,0,e>>32);
+			i386_trap(1,0,0);
 		}
+		if(m_lock && (m_opcode != 0xf0))
+			m_lock = false;
+	}
+	catch(UINT64 e)
+	{
+		m_ext = 1;
+		i386_trap_with_error(e&0xffffffff,0,0,e>>32);
 	}
-	m_tsc += (cycles - m_cycles);
 }
 
 /*************************************************************************/
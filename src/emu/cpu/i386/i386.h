@@ -9,6 +9,8 @@
 #include "../../../lib/softfloat/softfloat.h"
 #include "debug/debugcpu.h"
 #include "cpu/vtlb.h"
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
 
 
 #define INPUT_LINE_A20      1
@@ -23,8 +25,12 @@
 	i386_device::set_smiact(*device, DEVCB_##_devcb);
 
 
+class i386_frontend;
+
 class i386_device : public cpu_device
 {
+	friend class i386_frontend;
+
 public:
 	// construction/destruction
 	i386_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock);
@@ -38,10 +44,20 @@ public:
 	UINT64 debug_segofftovirt(symbol_table &table, int params, const UINT64 *param);
 	UINT64 debug_virttophys(symbol_table &table, int params, const UINT64 *param);
 
+	// recompiler callbacks
+	void func_execute_one();
+	void func_read8();
+	void func_read16();
+	void func_read32();
+	void func_write8();
+	void func_write16();
+	void func_write32();
+
 protected:
 	// device-level overrides
 	virtual void device_start();
 	virtual void device_reset();
+	virtual void device_stop();
 	virtual void device_debug_setup();
 
 	// device_execute_interface overrides
@@ -1241,6 +1257,60 @@ struct I386_CALL_GATE
 	void pentium_smi();
 	void zero_state();
 	void i386_set_a20_line(int state);
+	void i386_execute_one();
+
+	// recompiler state
+	struct compiler_state
+	{
+		UINT32 cycles; // accumulated cycles
+		UINT8 mode; // mode the code is compiled for
+		uml::code_label labelnum; // index for local labels
+		uml::code_label redispatch; // shared exit for a changed eip
+	};
+
+	bool m_isdrc;
+	drc_cache *m_cache;
+	drcuml_state *m_drcuml;
+	i386_frontend *m_drcfe;
+	UINT8 m_cache_dirty;
+	UINT32 m_drc_mode;
+	UINT8 m_drc_leave;
+	UINT8 m_drc_fault;
+	UINT32 m_drc_address;
+	UINT32 m_drc_data;
+	uml::code_handle *m_entry;
+	uml::code_handle *m_nocode;
+	uml::code_handle *m_out_of_cycles;
+	uml::code_handle *m_read8[4];
+	uml::code_handle *m_read16[4];
+	uml::code_handle *m_read32[4];
+	uml::code_handle *m_write8[4];
+	uml::code_handle *m_write16[4];
+	uml::code_handle *m_write32[4];
+
+	void i386drc_init();
+	void i386drc_exit();
+	int i386drc_get_mode();
+	void execute_run_drc();
+	void code_flush_cache();
+	void code_compile_block(UINT8 mode, offs_t pc);
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+	void static_generate_memory_accessor(int mode, int size, int iswrite, const char *name, uml::code_handle *&handleptr);
+	void generate_update_cycles(drcuml_block *block, compiler_state *compiler);
+	void generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
+	void generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_interpret(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_checkpoint(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_condition(drcuml_block *block, int cond, uml::code_label label);
+	int generate_ea(drcuml_block *block, const opcode_desc *desc, int offs);
+	void generate_alu(drcuml_block *block, int aluop, uml::parameter dst, uml::parameter src);
+	int generate_alu_modrm(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, int aluop, int todreg);
+	int generate_alu_group(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_push(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, uml::parameter value);
+	int generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
 
 };
 
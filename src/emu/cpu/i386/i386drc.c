@@ -0,0 +1,1567 @@
+// license:BSD-3-Clause
+// copyright-holders:Ville Linde, Barry Rodewald, Carl, Phil Bennett
+/*
+    i386drc.c
+
+    Universal machine language-based x86 emulator.
+
+    Only code running in flat 32-bit protected mode is compiled: CS, DS,
+    ES and SS must have a base of 0 and a 4GB limit, so no segment checks
+    are needed. Paging goes through the vtlb inline, with misses and
+    anything unaligned handed to the interpreter's memory helpers. The
+    common integer instructions and near branches are generated natively;
+    everything else, including any prefixed instruction, is stepped
+    through the interpreter one instruction at a time. Faults are raised
+    by re-executing the faulting instruction in the interpreter.
+*/
+
+#include "emu.h"
+#include "debugger.h"
+#include "i386priv.h"
+#include "i386fe.h"
+#include "cycles.h"
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
+#include "cpu/drcumlsh.h"
+
+using namespace uml;
+
+
+/***************************************************************************
+    DEBUGGING
+***************************************************************************/
+
+#define SINGLE_INSTRUCTION_MODE         (0)
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* size of the execution code cache */
+#define CACHE_SIZE                      (32 * 1024 * 1024)
+
+/* compilation boundaries -- how far back/forward does the analysis extend? */
+#define COMPILE_BACKWARDS_BYTES         128
+#define COMPILE_FORWARDS_BYTES          512
+#define COMPILE_MAX_SEQUENCE            64
+
+/* exit codes */
+#define EXECUTE_OUT_OF_CYCLES           0
+#define EXECUTE_MISSING_CODE            1
+#define EXECUTE_UNMAPPED_CODE           2
+#define EXECUTE_INTERPRET               4
+
+/* compiled modes; each has its own memory handlers */
+#define MODE_USER                       0x01        /* CPL 3 */
+#define MODE_PAGING                     0x02        /* CR0.PG set */
+#define MODE_COUNT                      4
+
+/* ALU operations, in the order of the /r field of groups 80-83 */
+#define ALU_ADD                         0
+#define ALU_OR                          1
+#define ALU_ADC                         2
+#define ALU_SBB                         3
+#define ALU_AND                         4
+#define ALU_SUB                         5
+#define ALU_XOR                         6
+#define ALU_CMP                         7
+#define ALU_TEST                        8
+
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+#define R32(reg)                        mem(&m_reg.d[reg])
+#define R8(reg)                         (&m_reg.b[s_byte_regs[reg]])
+#define R16(reg)                        (&m_reg.w[s_word_regs[reg]])
+#define PM_CYCLES(x)                    (m_cycle_table_pm[x])
+
+/* true if a segment maps all 4GB as writable data */
+#define IS_FLAT_DATA(seg)               ((seg).valid && (seg).base == 0 && (seg).limit == 0xffffffff && ((seg).flags & 0x0e) == 0x02)
+
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+/* register numbers as encoded in the ModRM byte */
+static const UINT8 s_byte_regs[8] = { AL, CL, DL, BL, AH, CH, DH, BH };
+static const UINT8 s_word_regs[8] = { AX, CX, DX, BX, SP, BP, SI, DI };
+
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    alloc_handle - allocate a handle if not
+    already allocated
+-------------------------------------------------*/
+
+INLINE void alloc_handle(drcuml_state *drcuml, code_handle **handleptr, const char *name)
+{
+	if (*handleptr == NULL)
+		*handleptr = drcuml->handle_alloc(name);
+}
+
+
+/*-------------------------------------------------
+    fetch_dword - read a little-endian dword from
+    the opcode bytes
+-------------------------------------------------*/
+
+INLINE UINT32 fetch_dword(const UINT8 *op)
+{
+	return op[0] | (op[1] << 8) | (op[2] << 16) | (op[3] << 24);
+}
+
+
+/*-------------------------------------------------
+    tlb_required - the vtlb flags an access needs
+    to take the fast path in the given mode
+-------------------------------------------------*/
+
+INLINE UINT32 tlb_required(int mode, int iswrite)
+{
+	if (iswrite)
+		return VTLB_FLAG_VALID | VTLB_FLAG_DIRTY | ((mode & MODE_USER) ? VTLB_USER_WRITE_ALLOWED : VTLB_WRITE_ALLOWED);
+	return VTLB_FLAG_VALID | ((mode & MODE_USER) ? VTLB_USER_READ_ALLOWED : VTLB_READ_ALLOWED);
+}
+
+
+/*-------------------------------------------------
+    cfunc_execute_one - C wrapper for
+    func_execute_one
+-------------------------------------------------*/
+
+static void cfunc_execute_one(void *param)
+{
+	((i386_device *)param)->func_execute_one();
+}
+
+
+/*-------------------------------------------------
+    cfunc_read8 - C wrapper for func_read8
+-------------------------------------------------*/
+
+static void cfunc_read8(void *param)
+{
+	((i386_device *)param)->func_read8();
+}
+
+
+/*-------------------------------------------------
+    cfunc_read16 - C wrapper for func_read16
+-------------------------------------------------*/
+
+static void cfunc_read16(void *param)
+{
+	((i386_device *)param)->func_read16();
+}
+
+
+/*-------------------------------------------------
+    cfunc_read32 - C wrapper for func_read32
+-------------------------------------------------*/
+
+static void cfunc_read32(void *param)
+{
+	((i386_device *)param)->func_read32();
+}
+
+
+/*-------------------------------------------------
+    cfunc_write8 - C wrapper for func_write8
+-------------------------------------------------*/
+
+static void cfunc_write8(void *param)
+{
+	((i386_device *)param)->func_write8();
+}
+
+
+/*-------------------------------------------------
+    cfunc_write16 - C wrapper for func_write16
+-------------------------------------------------*/
+
+static void cfunc_write16(void *param)
+{
+	((i386_device *)param)->func_write16();
+}
+
+
+/*-------------------------------------------------
+    cfunc_write32 - C wrapper for func_write32
+-------------------------------------------------*/
+
+static void cfunc_write32(void *param)
+{
+	((i386_device *)param)->func_write32();
+}
+
+
+
+/***************************************************************************
+    CORE CALLBACKS
+***************************************************************************/
+
+/*-------------------------------------------------
+    i386drc_init - initialize the recompiler
+-------------------------------------------------*/
+
+void i386_device::i386drc_init()
+{
+	/* allocate enough space for the cache and the core */
+	m_cache = auto_alloc(machine(), drc_cache(CACHE_SIZE));
+
+	/* initialize the UML generator; x86 code can start at any byte */
+	m_drcuml = auto_alloc(machine(), drcuml_state(*this, *m_cache, 0, MODE_COUNT, 32, 0));
+
+	/* add symbols for our stuff */
+	static const char *const regnames[8] = { "eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi" };
+	m_drcuml->symbol_add(&m_eip, sizeof(m_eip), "eip");
+	m_drcuml->symbol_add(&m_cycles, sizeof(m_cycles), "icount");
+	for (int regnum = 0; regnum < 8; regnum++)
+		m_drcuml->symbol_add(&m_reg.d[regnum], sizeof(m_reg.d[regnum]), regnames[regnum]);
+	m_drcuml->symbol_add(&m_CF, sizeof(m_CF), "cf");
+	m_drcuml->symbol_add(&m_OF, sizeof(m_OF), "of");
+	m_drcuml->symbol_add(&m_ZF, sizeof(m_ZF), "zf");
+	m_drcuml->symbol_add(&m_SF, sizeof(m_SF), "sf");
+	m_drcuml->symbol_add(&m_PF, sizeof(m_PF), "pf");
+	m_drcuml->symbol_add(&m_AF, sizeof(m_AF), "af");
+	m_drcuml->symbol_add(&m_drc_mode, sizeof(m_drc_mode), "mode");
+
+	/* initialize the front-end helper */
+	m_drcfe = auto_alloc(machine(), i386_frontend(*this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE));
+
+	/* the memory handlers are allocated when the cache is first flushed */
+	for (int mode = 0; mode < MODE_COUNT; mode++)
+	{
+		m_read8[mode] = m_read16[mode] = m_read32[mode] = NULL;
+		m_write8[mode] = m_write16[mode] = m_write32[mode] = NULL;
+	}
+	m_drc_mode = 0;
+
+	/* mark the cache dirty so it is updated on next execute */
+	m_cache_dirty = TRUE;
+}
+
+
+/*-------------------------------------------------
+    i386drc_exit - clean up the recompiler
+-------------------------------------------------*/
+
+void i386_device::i386drc_exit()
+{
+	/* clean up the DRC */
+	auto_free(machine(), m_drcfe);
+	auto_free(machine(), m_drcuml);
+	auto_free(machine(), m_cache);
+}
+
+
+/*-------------------------------------------------
+    i386drc_get_mode - return the mode compiled
+    code runs in, or -1 if the interpreter must
+    take the next instruction
+-------------------------------------------------*/
+
+int i386_device::i386drc_get_mode()
+{
+	/* real and virtual 8086 mode, 16-bit code and the A20 gate are interpreted */
+	if (!PROTECTED_MODE || V8086_MODE || !m_sreg[CS].d || m_a20_mask != 0xffffffff)
+		return -1;
+
+	/* so is anything the interpreter looks at between instructions */
+	if (m_TF || m_delayed_interrupt_enable || m_lock || m_halted || (m_irq_state && m_IF) || (m_smi && !m_smm))
+		return -1;
+
+	/* code, data and stack must all be flat */
+	if (m_sreg[CS].base != 0 || !m_sreg[SS].d || !IS_FLAT_DATA(m_sreg[SS]) || !IS_FLAT_DATA(m_sreg[DS]) || !IS_FLAT_DATA(m_sreg[ES]))
+		return -1;
+
+	return ((m_CPL == 3) ? MODE_USER : 0) | ((m_cr[0] & 0x80000000) ? MODE_PAGING : 0);
+}
+
+
+/*-------------------------------------------------
+    execute_run_drc - execute the CPU for the
+    specified number of cycles
+-------------------------------------------------*/
+
+void i386_device::execute_run_drc()
+{
+	int execute_result;
+
+	/* reset the cache if dirty */
+	if (m_cache_dirty)
+		code_flush_cache();
+	m_cache_dirty = FALSE;
+
+	/* execute */
+	do
+	{
+		/* anything other than flat protected mode is stepped */
+		int mode = i386drc_get_mode();
+		if (mode < 0)
+			execute_result = EXECUTE_INTERPRET;
+
+		/* run as much as we can */
+		else
+		{
+			m_drc_mode = mode;
+			execute_result = m_drcuml->execute(*m_entry);
+		}
+
+		/* if we need to recompile, load the TLB entry for the code first; */
+		/* a page fault is raised by the interpreter's fetch */
+		if (execute_result == EXECUTE_MISSING_CODE)
+		{
+			UINT32 address = m_eip, error;
+			if (translate_address(m_CPL, TRANSLATE_FETCH, &address, &error))
+				code_compile_block(m_drc_mode, m_eip);
+			else
+				execute_result = EXECUTE_INTERPRET;
+		}
+		else if (execute_result == EXECUTE_UNMAPPED_CODE)
+			fatalerror("Attempted to execute unmapped code at EIP=%08X\n", m_eip);
+
+		/* code we couldn't compile or that faulted is stepped through the interpreter */
+		if (execute_result == EXECUTE_INTERPRET)
+		{
+			CHANGE_PC(m_eip);
+			if (m_cycles > 0)
+				i386_execute_one();
+			if (m_cycles <= 0)
+				execute_result = EXECUTE_OUT_OF_CYCLES;
+		}
+
+	} while (execute_result != EXECUTE_OUT_OF_CYCLES);
+}
+
+
+
+/***************************************************************************
+    CACHE MANAGEMENT
+***************************************************************************/
+
+/*-------------------------------------------------
+    code_flush_cache - flush the cache and
+    regenerate static code
+-------------------------------------------------*/
+
+void i386_device::code_flush_cache()
+{
+	/* empty the transient cache contents */
+	m_drcuml->reset();
+
+	try
+	{
+		/* generate the entry point and out-of-cycles handlers */
+		static_generate_entry_point();
+		static_generate_nocode_handler();
+		static_generate_out_of_cycles();
+
+		/* add subroutines for memory accesses */
+		for (int mode = 0; mode < MODE_COUNT; mode++)
+		{
+			static_generate_memory_accessor(mode, 1, FALSE, "read8",   m_read8[mode]);
+			static_generate_memory_accessor(mode, 1, TRUE,  "write8",  m_write8[mode]);
+			static_generate_memory_accessor(mode, 2, FALSE, "read16",  m_read16[mode]);
+			static_generate_memory_accessor(mode, 2, TRUE,  "write16", m_write16[mode]);
+			static_generate_memory_accessor(mode, 4, FALSE, "read32",  m_read32[mode]);
+			static_generate_memory_accessor(mode, 4, TRUE,  "write32", m_write32[mode]);
+		}
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unrecoverable error generating static code\n");
+	}
+}
+
+
+/*-------------------------------------------------
+    code_compile_block - compile a block of the
+    given mode at the specified pc
+-------------------------------------------------*/
+
+void i386_device::code_compile_block(UINT8 mode, offs_t pc)
+{
+	compiler_state compiler = { 0 };
+	const opcode_desc *seqlast;
+	int override = FALSE;
+
+	g_profiler.start(PROFILER_DRC_COMPILE);
+
+	/* get a description of this sequence */
+	const opcode_desc *desclist = m_drcfe->describe_code(pc);
+
+	/* if we get an error back, flush the cache and try again */
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			/* start the block */
+			drcuml_block *block = m_drcuml->begin_block(8192);
+
+			/* every instruction may leave through the same redispatch path */
+			compiler.mode = mode;
+			compiler.labelnum = 1;
+			compiler.redispatch = compiler.labelnum++;
+
+			/* loop until we get through all instruction sequences */
+			for (const opcode_desc *seqhead = desclist; seqhead != NULL; seqhead = seqlast->next())
+			{
+				const opcode_desc *curdesc;
+				UINT32 nextpc;
+
+				/* add a code log entry */
+				if (m_drcuml->logging())
+					block->append_comment("-------------------------");                     // comment
+
+				/* determine the last instruction in this sequence */
+				for (seqlast = seqhead; seqlast != NULL; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != NULL);
+
+				/* if we don't have a hash for this mode/pc, or if we are overriding all, add one */
+				if (override || !m_drcuml->hash_exists(mode, seqhead->pc))
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+
+				/* if we already have a hash, and this is the first sequence, assume that we */
+				/* are recompiling due to being out of sync and allow future overrides */
+				else if (seqhead == desclist)
+				{
+					override = TRUE;
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+				}
+
+				/* otherwise, redispatch to that fixed PC and skip the rest of the processing */
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+					UML_HASHJMP(block, mode, seqhead->pc, *m_nocode);                       // hashjmp <mode>,seqhead->pc,nocode
+					continue;
+				}
+
+				/* validate this code block */
+				compiler.cycles = 0;
+				generate_checksum_block(block, &compiler, seqhead, seqlast);
+
+				/* label this instruction, if it may be jumped to locally */
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+
+				/* iterate over instructions in the sequence and compile them */
+				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+					generate_sequence_instruction(block, &compiler, curdesc);
+
+				/* code handed to the interpreter without a known length has already left */
+				if (seqlast->flags & (OPFLAG_COMPILER_PAGE_FAULT | OPFLAG_COMPILER_UNMAPPED | OPFLAG_INVALID_OPCODE))
+					continue;
+
+				/* if we need to return to the start, do it */
+				if (seqlast->flags & OPFLAG_RETURN_TO_START)
+					nextpc = pc;
+
+				/* otherwise we just go to the next instruction */
+				else
+					nextpc = seqlast->pc + seqlast->length;
+
+				/* count off cycles and go there */
+				generate_update_cycles(block, &compiler);                                   // <subtract cycles>
+				UML_CMP(block, mem(&m_cycles), 0);                                          // cmp     icount,0
+				UML_EXHc(block, COND_LE, *m_out_of_cycles, nextpc);                         // exhle   out_of_cycles,nextpc
+				if (seqlast->next() == NULL || seqlast->next()->pc != nextpc)
+					UML_HASHJMP(block, mode, nextpc, *m_nocode);                            // hashjmp <mode>,nextpc,nocode
+			}
+
+			/* an instruction changed EIP, or handed a mode change back to the interpreter */
+			UML_LABEL(block, compiler.redispatch);                                          // redispatch:
+			UML_CMP(block, mem(&m_cycles), 0);                                              // cmp     icount,0
+			UML_EXHc(block, COND_LE, *m_out_of_cycles, mem(&m_eip));                        // exhle   out_of_cycles,[eip]
+			UML_HASHJMP(block, mode, mem(&m_eip), *m_nocode);                               // hashjmp <mode>,[eip],nocode
+
+			/* end the sequence */
+			block->end();
+			g_profiler.stop();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			code_flush_cache();
+		}
+	}
+}
+
+
+
+/***************************************************************************
+    C FUNCTION CALLBACKS
+***************************************************************************/
+
+/*-------------------------------------------------
+    func_execute_one - step one instruction with
+    the interpreter, noting if compiled code can
+    no longer carry on
+-------------------------------------------------*/
+
+void i386_device::func_execute_one()
+{
+	CHANGE_PC(m_eip);
+	i386_execute_one();
+	m_drc_leave = (i386drc_get_mode() != m_drc_mode);
+}
+
+
+/*-------------------------------------------------
+    func_read8 - read a byte through the TLB;
+    a fault leaves the instruction to the
+    interpreter
+-------------------------------------------------*/
+
+void i386_device::func_read8()
+{
+	try
+	{
+		m_drc_data = READ8(m_drc_address);
+		m_drc_fault = 0;
+	}
+	catch (UINT64)
+	{
+		m_drc_fault = 1;
+	}
+}
+
+
+/*-------------------------------------------------
+    func_read16 - read a word through the TLB
+-------------------------------------------------*/
+
+void i386_device::func_read16()
+{
+	try
+	{
+		m_drc_data = READ16(m_drc_address);
+		m_drc_fault = 0;
+	}
+	catch (UINT64)
+	{
+		m_drc_fault = 1;
+	}
+}
+
+
+/*-------------------------------------------------
+    func_read32 - read a dword through the TLB
+-------------------------------------------------*/
+
+void i386_device::func_read32()
+{
+	try
+	{
+		m_drc_data = READ32(m_drc_address);
+		m_drc_fault = 0;
+	}
+	catch (UINT64)
+	{
+		m_drc_fault = 1;
+	}
+}
+
+
+/*-------------------------------------------------
+    func_write8 - write a byte through the TLB
+-------------------------------------------------*/
+
+void i386_device::func_write8()
+{
+	try
+	{
+		WRITE8(m_drc_address, m_drc_data);
+		m_drc_fault = 0;
+	}
+	catch (UINT64)
+	{
+		m_drc_fault = 1;
+	}
+}
+
+
+/*-------------------------------------------------
+    func_write16 - write a word through the TLB
+-------------------------------------------------*/
+
+void i386_device::func_write16()
+{
+	try
+	{
+		WRITE16(m_drc_address, m_drc_data);
+		m_drc_fault = 0;
+	}
+	catch (UINT64)
+	{
+		m_drc_fault = 1;
+	}
+}
+
+
+/*-------------------------------------------------
+    func_write32 - write a dword through the TLB
+-------------------------------------------------*/
+
+void i386_device::func_write32()
+{
+	try
+	{
+		WRITE32(m_drc_address, m_drc_data);
+		m_drc_fault = 0;
+	}
+	catch (UINT64)
+	{
+		m_drc_fault = 1;
+	}
+}
+
+
+
+/***************************************************************************
+    STATIC CODEGEN
+***************************************************************************/
+
+/*-------------------------------------------------
+    static_generate_entry_point - generate a
+    static entry point
+-------------------------------------------------*/
+
+void i386_device::static_generate_entry_point()
+{
+	drcuml_block *block;
+
+	block = m_drcuml->begin_block(20);
+
+	/* forward references */
+	alloc_handle(m_drcuml, &m_nocode, "nocode");
+
+	alloc_handle(m_drcuml, &m_entry, "entry");
+	UML_HANDLE(block, *m_entry);                                                    // handle  entry
+
+	/* generate a hash jump via the current mode and EIP */
+	UML_HASHJMP(block, mem(&m_drc_mode), mem(&m_eip), *m_nocode);                   // hashjmp [mode],[eip],nocode
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_nocode_handler - generate an
+    exception handler for "out of code"
+-------------------------------------------------*/
+
+void i386_device::static_generate_nocode_handler()
+{
+	drcuml_block *block;
+
+	/* begin generating */
+	block = m_drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and EIP */
+	alloc_handle(m_drcuml, &m_nocode, "nocode");
+	UML_HANDLE(block, *m_nocode);                                                   // handle  nocode
+	UML_GETEXP(block, I0);                                                          // getexp  i0
+	UML_MOV(block, mem(&m_eip), I0);                                                // mov     [eip],i0
+	UML_MOV(block, mem(&m_pc), I0);                                                 // mov     [pc],i0
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                          // exit    EXECUTE_MISSING_CODE
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_out_of_cycles - generate an
+    out of cycles exception handler
+-------------------------------------------------*/
+
+void i386_device::static_generate_out_of_cycles()
+{
+	drcuml_block *block;
+
+	/* begin generating */
+	block = m_drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and EIP */
+	alloc_handle(m_drcuml, &m_out_of_cycles, "out_of_cycles");
+	UML_HANDLE(block, *m_out_of_cycles);                                            // handle  out_of_cycles
+	UML_GETEXP(block, I0);                                                          // getexp  i0
+	UML_MOV(block, mem(&m_eip), I0);                                                // mov     [eip],i0
+	UML_MOV(block, mem(&m_pc), I0);                                                 // mov     [pc],i0
+	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                                         // exit    EXECUTE_OUT_OF_CYCLES
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_memory_accessor - generate a
+    flat memory access, translating through the
+    TLB when paging is enabled
+-------------------------------------------------*/
+
+void i386_device::static_generate_memory_accessor(int mode, int size, int iswrite, const char *name, code_handle *&handleptr)
+{
+	/* on entry, address is in I0; data for writes is in I1 */
+	/* on exit, read result is in I0 */
+	/* routine trashes I2-I3 */
+	static void (*const slow_funcs[2][5])(void *) =
+	{
+		{ NULL, cfunc_read8, cfunc_read16, NULL, cfunc_read32 },
+		{ NULL, cfunc_write8, cfunc_write16, NULL, cfunc_write32 }
+	};
+	operand_size opsize = (size == 1) ? SIZE_BYTE : (size == 2) ? SIZE_WORD : SIZE_DWORD;
+	drcuml_block *block;
+	int slow = 1;
+	char buf[20];
+
+	/* begin generating */
+	block = m_drcuml->begin_block(64);
+
+	/* add a global entry for this */
+	sprintf(buf, "%s_%d", name, mode);
+	alloc_handle(m_drcuml, &handleptr, buf);
+	UML_HANDLE(block, *handleptr);                                                  // handle  *handleptr
+
+	/* misaligned accesses are split by the interpreter's helpers */
+	if (size != 1)
+	{
+		UML_TEST(block, I0, size - 1);                                              // test    i0,size-1
+		UML_JMPc(block, COND_NZ, slow);                                             // jmpnz   slow
+	}
+
+	/* translate through the TLB; misses and permission failures take the slow path */
+	if (mode & MODE_PAGING)
+	{
+		UINT32 required = tlb_required(mode, iswrite);
+		UML_SHR(block, I2, I0, 12);                                                 // shr     i2,i0,12
+		UML_LOAD(block, I2, (void *)vtlb_table(m_vtlb), I2, SIZE_DWORD, SCALE_x4);  // load    i2,[vtlb_table],i2,dword
+		UML_AND(block, I3, I2, required);                                           // and     i3,i2,required
+		UML_CMP(block, I3, required);                                               // cmp     i3,required
+		UML_JMPc(block, COND_NE, slow);                                             // jmpne   slow
+		UML_ROLINS(block, I0, I2, 0, 0xfffff000);                                   // rolins  i0,i2,0,0xfffff000
+	}
+
+	if (!iswrite)
+		UML_READ(block, I0, I0, opsize, SPACE_PROGRAM);                             // read    i0,i0,size,program
+	else
+		UML_WRITE(block, I0, I1, opsize, SPACE_PROGRAM);                            // write   i0,i1,size,program
+	UML_RET(block);                                                                 // ret
+
+	/* the interpreter's helpers set any dirty and accessed bits, or fault */
+	UML_LABEL(block, slow);                                                         // slow:
+	UML_MOV(block, mem(&m_drc_address), I0);                                        // mov     [drc_address],i0
+	if (iswrite)
+		UML_MOV(block, mem(&m_drc_data), I1);                                       // mov     [drc_data],i1
+	UML_CALLC(block, slow_funcs[iswrite][size], this);                              // callc   slow_func,this
+	UML_CMP(block, mem(&m_drc_fault), 0);                                           // cmp     [drc_fault],0
+	UML_EXITc(block, COND_NE, EXECUTE_INTERPRET);                                   // exitne  EXECUTE_INTERPRET
+	if (!iswrite)
+		UML_MOV(block, I0, mem(&m_drc_data));                                       // mov     i0,[drc_data]
+	UML_RET(block);                                                                 // ret
+
+	block->end();
+}
+
+
+
+/***************************************************************************
+    CODE GENERATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    generate_update_cycles - subtract the cycles
+    accumulated so far from the icount
+-------------------------------------------------*/
+
+void i386_device::generate_update_cycles(drcuml_block *block, compiler_state *compiler)
+{
+	if (compiler->cycles != 0)
+	{
+		UML_SUB(block, mem(&m_cycles), mem(&m_cycles), compiler->cycles);           // sub     icount,icount,cycles
+		compiler->cycles = 0;
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_checksum_block - generate code to
+    validate a sequence of opcodes
+-------------------------------------------------*/
+
+void i386_device::generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast)
+{
+	const opcode_desc *curdesc;
+	UINT32 sum = 0;
+	int loaded = FALSE;
+	int summed = (m_program->get_write_ptr(seqhead->physpc) != NULL);
+	offs_t lastpage = ~0;
+	offs_t lastaddr = ~0;
+
+	if (m_drcuml->logging())
+		block->append_comment("[Validation for %08X]", seqhead->pc);                // comment
+
+	/* instructions handed to the interpreter are fetched afresh, so only the rest are checked */
+	for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+	{
+		if (curdesc->flags & (OPFLAG_VIRTUAL_NOOP | OPFLAG_INVALID_OPCODE))
+			continue;
+
+		/* a page mapped elsewhere since holds different code */
+		if ((compiler->mode & MODE_PAGING) && (curdesc->pc >> 12) != lastpage)
+		{
+			UINT32 required = tlb_required(compiler->mode, FALSE);
+			lastpage = curdesc->pc >> 12;
+			UML_LOAD(block, I1, (void *)vtlb_table(m_vtlb), lastpage, SIZE_DWORD, SCALE_x4); // load    i1,[vtlb_table],page,dword
+			UML_AND(block, I1, I1, 0xfffff000 | required);                          // and     i1,i1,0xfffff000 | required
+			UML_CMP(block, I1, (curdesc->physpc & 0xfffff000) | required);          // cmp     i1,physpage | required
+			UML_EXHc(block, COND_NE, *m_nocode, seqhead->pc);                       // exne    nocode,seqhead->pc
+		}
+
+		/* sum the aligned dwords the opcode covers, sharing any with the previous one */
+		if (summed)
+			for (offs_t addr = curdesc->physpc & ~3; addr < curdesc->physpc + curdesc->length; addr += 4)
+			{
+				if (addr == lastaddr)
+					continue;
+				lastaddr = addr;
+
+				const UINT32 *base = (const UINT32 *)m_direct->read_decrypted_ptr(addr);
+				if (base == NULL)
+					continue;
+				UML_LOAD(block, loaded ? I1 : I0, base, 0, SIZE_DWORD, SCALE_x4);   // load    i0,base,dword
+				if (loaded)
+					UML_ADD(block, I0, I0, I1);                                     // add     i0,i0,i1
+				sum += *base;
+				loaded = TRUE;
+			}
+	}
+
+	if (loaded)
+	{
+		UML_CMP(block, I0, sum);                                                    // cmp     i0,sum
+		UML_EXHc(block, COND_NE, *m_nocode, seqhead->pc);                           // exne    nocode,seqhead->pc
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_sequence_instruction - generate code
+    for a single instruction in a sequence
+-------------------------------------------------*/
+
+void i386_device::generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	/* code that couldn't be fetched or sized is stepped by the interpreter, which raises any fault */
+	if (desc->flags & (OPFLAG_COMPILER_PAGE_FAULT | OPFLAG_COMPILER_UNMAPPED | OPFLAG_INVALID_OPCODE))
+	{
+		generate_interpret(block, compiler, desc);
+		UML_JMP(block, compiler->redispatch);                                       // jmp     redispatch
+		return;
+	}
+
+	/* with the debugger active everything is stepped, so its hook sees each instruction once */
+	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0 || !generate_opcode(block, compiler, desc))
+	{
+		generate_interpret(block, compiler, desc);
+		UML_CMP(block, mem(&m_eip), desc->pc + desc->length);                       // cmp     [eip],desc->pc + desc->length
+		UML_JMPc(block, COND_NE, compiler->redispatch);                             // jmpne   redispatch
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_interpret - generate a call to the
+    interpreter for a single instruction
+-------------------------------------------------*/
+
+void i386_device::generate_interpret(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	UML_MOV(block, mem(&m_eip), desc->pc);                                          // mov     [eip],desc->pc
+	generate_update_cycles(block, compiler);                                        // <subtract cycles>
+	UML_CALLC(block, cfunc_execute_one, this);                                      // callc   cfunc_execute_one,this
+
+	/* leave if the instruction switched out of the compiled mode */
+	UML_CMP(block, mem(&m_drc_leave), 0);                                           // cmp     [drc_leave],0
+	UML_EXITc(block, COND_NE, EXECUTE_INTERPRET);                                   // exitne  EXECUTE_INTERPRET
+}
+
+
+/*-------------------------------------------------
+    generate_checkpoint - bring EIP and the icount
+    up to date ahead of a memory access, so a
+    fault can restart the instruction in the
+    interpreter
+-------------------------------------------------*/
+
+void i386_device::generate_checkpoint(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	UML_MOV(block, mem(&m_eip), desc->pc);                                          // mov     [eip],desc->pc
+	generate_update_cycles(block, compiler);                                        // <subtract cycles>
+}
+
+
+/*-------------------------------------------------
+    generate_branch - count off cycles and jump
+    to the target; dynamic targets are already
+    in EIP
+-------------------------------------------------*/
+
+void i386_device::generate_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	generate_update_cycles(block, compiler);                                        // <subtract cycles>
+	if (desc->targetpc == BRANCH_TARGET_DYNAMIC)
+	{
+		UML_JMP(block, compiler->redispatch);                                       // jmp     redispatch
+		return;
+	}
+
+	UML_CMP(block, mem(&m_cycles), 0);                                              // cmp     icount,0
+	UML_EXHc(block, COND_LE, *m_out_of_cycles, desc->targetpc);                     // exhle   out_of_cycles,targetpc
+	if (desc->flags & OPFLAG_INTRABLOCK_BRANCH)
+		UML_JMP(block, desc->targetpc | 0x80000000);                                // jmp     targetpc | 0x80000000
+	else
+		UML_HASHJMP(block, compiler->mode, desc->targetpc, *m_nocode);              // hashjmp <mode>,targetpc,nocode
+}
+
+
+/*-------------------------------------------------
+    generate_condition - jump to a label if an x86
+    condition code holds
+-------------------------------------------------*/
+
+void i386_device::generate_condition(drcuml_block *block, int cond, code_label label)
+{
+	switch (cond >> 1)
+	{
+		case 0: /* O */
+			UML_LOAD(block, I0, &m_OF, 0, SIZE_BYTE, SCALE_x1);                     // load    i0,of,byte
+			break;
+
+		case 1: /* B */
+			UML_LOAD(block, I0, &m_CF, 0, SIZE_BYTE, SCALE_x1);                     // load    i0,cf,byte
+			break;
+
+		case 2: /* Z */
+			UML_LOAD(block, I0, &m_ZF, 0, SIZE_BYTE, SCALE_x1);                     // load    i0,zf,byte
+			break;
+
+		case 3: /* BE */
+			UML_LOAD(block, I0, &m_CF, 0, SIZE_BYTE, SCALE_x1);                     // load    i0,cf,byte
+			UML_LOAD(block, I1, &m_ZF, 0, SIZE_BYTE, SCALE_x1);                     // load    i1,zf,byte
+			UML_OR(block, I0, I0, I1);                                              // or      i0,i0,i1
+			break;
+
+		case 4: /* S */
+			UML_LOAD(block, I0, &m_SF, 0, SIZE_BYTE, SCALE_x1);                     // load    i0,sf,byte
+			break;
+
+		case 5: /* P */
+			UML_LOAD(block, I0, &m_PF, 0, SIZE_BYTE, SCALE_x1);                     // load    i0,pf,byte
+			break;
+
+		case 6: /* L */
+			UML_LOAD(block, I0, &m_SF, 0, SIZE_BYTE, SCALE_x1);                     // load    i0,sf,byte
+			UML_LOAD(block, I1, &m_OF, 0, SIZE_BYTE, SCALE_x1);                     // load    i1,of,byte
+			UML_XOR(block, I0, I0, I1);                                             // xor     i0,i0,i1
+			break;
+
+		case 7: /* LE */
+			UML_LOAD(block, I0, &m_SF, 0, SIZE_BYTE, SCALE_x1);                     // load    i0,sf,byte
+			UML_LOAD(block, I1, &m_OF, 0, SIZE_BYTE, SCALE_x1);                     // load    i1,of,byte
+			UML_XOR(block, I0, I0, I1);                                             // xor     i0,i0,i1
+			UML_LOAD(block, I1, &m_ZF, 0, SIZE_BYTE, SCALE_x1);                     // load    i1,zf,byte
+			UML_OR(block, I0, I0, I1);                                              // or      i0,i0,i1
+			break;
+	}
+
+	/* odd conditions are the inverse of the even ones */
+	UML_CMP(block, I0, 0);                                                          // cmp     i0,0
+	UML_JMPc(block, (cond & 1) ? COND_E : COND_NE, label);                          // jmp<cc> label
+}
+
+
+/*-------------------------------------------------
+    generate_ea - compute a 32-bit ModRM effective
+    address into I0, returning the offset of the
+    byte following it
+-------------------------------------------------*/
+
+int i386_device::generate_ea(drcuml_block *block, const opcode_desc *desc, int offs)
+{
+	const UINT8 *op = desc->opptr.b;
+	UINT8 modrm = op[offs++];
+	int mod = modrm >> 6;
+	int base = modrm & 7;
+	int index = -1;
+	int scale = 0;
+	UINT32 disp = 0;
+
+	/* SIB byte; an index of ESP means none */
+	if (base == 4)
+	{
+		UINT8 sib = op[offs++];
+		base = sib & 7;
+		index = (sib >> 3) & 7;
+		scale = sib >> 6;
+		if (index == 4)
+			index = -1;
+	}
+
+	/* EBP with no displacement means an absolute address instead */
+	if (mod == 0 && base == 5)
+	{
+		base = -1;
+		disp = fetch_dword(&op[offs]);
+		offs += 4;
+	}
+	else if (mod == 1)
+		disp = (INT8)op[offs++];
+	else if (mod == 2)
+	{
+		disp = fetch_dword(&op[offs]);
+		offs += 4;
+	}
+
+	/* segment bases are all zero in flat mode */
+	if (index != -1)
+	{
+		if (scale != 0)
+			UML_SHL(block, I0, R32(index), scale);                                  // shl     i0,index,scale
+		else
+			UML_MOV(block, I0, R32(index));                                         // mov     i0,index
+		if (base != -1)
+			UML_ADD(block, I0, I0, R32(base));                                      // add     i0,i0,base
+		if (disp != 0)
+			UML_ADD(block, I0, I0, disp);                                           // add     i0,i0,disp
+	}
+	else if (base != -1)
+	{
+		if (disp != 0)
+			UML_ADD(block, I0, R32(base), disp);                                    // add     i0,base,disp
+		else
+			UML_MOV(block, I0, R32(base));                                          // mov     i0,base
+	}
+	else
+		UML_MOV(block, I0, disp);                                                   // mov     i0,disp
+	return offs;
+}
+
+
+/*-------------------------------------------------
+    generate_alu - compute dst <op> src into I2
+    and set the flags the way the interpreter
+    does; trashes I3-I4
+-------------------------------------------------*/
+
+void i386_device::generate_alu(drcuml_block *block, int aluop, parameter dst, parameter src)
+{
+	switch (aluop)
+	{
+		case ALU_ADD:
+			UML_ADD(block, I2, dst, src);                                           // add     i2,dst,src
+			break;
+
+		case ALU_OR:
+			UML_OR(block, I2, dst, src);                                            // or      i2,dst,src
+			break;
+
+		case ALU_AND:
+		case ALU_TEST:
+			UML_AND(block, I2, dst, src);                                           // and     i2,dst,src
+			break;
+
+		case ALU_SUB:
+		case ALU_CMP:
+			UML_SUB(block, I2, dst, src);                                           // sub     i2,dst,src
+			break;
+
+		case ALU_XOR:
+			UML_XOR(block, I2, dst, src);                                           // xor     i2,dst,src
+			break;
+	}
+
+	/* arithmetic sets CF, OF and AF; UML's carry after SUB is the x86 borrow */
+	if (aluop == ALU_ADD || aluop == ALU_SUB || aluop == ALU_CMP)
+	{
+		UML_GETFLGS(block, I3, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);                  // getflgs i3,czvs
+		UML_ROLAND(block, I4, I3, 0, 1);                                            // roland  i4,i3,0,1
+		UML_STORE(block, &m_CF, 0, I4, SIZE_BYTE, SCALE_x1);                        // store   cf,i4,byte
+		UML_ROLAND(block, I4, I3, 31, 1);                                           // roland  i4,i3,31,1
+		UML_STORE(block, &m_OF, 0, I4, SIZE_BYTE, SCALE_x1);                        // store   of,i4,byte
+		UML_XOR(block, I4, dst, src);                                               // xor     i4,dst,src
+		UML_XOR(block, I4, I4, I2);                                                 // xor     i4,i4,i2
+		UML_ROLAND(block, I4, I4, 28, 1);                                           // roland  i4,i4,28,1
+		UML_STORE(block, &m_AF, 0, I4, SIZE_BYTE, SCALE_x1);                        // store   af,i4,byte
+	}
+
+	/* logical operations clear CF and OF and leave AF alone */
+	else
+	{
+		UML_GETFLGS(block, I3, FLAG_Z | FLAG_S);                                    // getflgs i3,zs
+		UML_STORE(block, &m_CF, 0, 0, SIZE_BYTE, SCALE_x1);                         // store   cf,0,byte
+		UML_STORE(block, &m_OF, 0, 0, SIZE_BYTE, SCALE_x1);                         // store   of,0,byte
+	}
+
+	UML_ROLAND(block, I4, I3, 30, 1);                                               // roland  i4,i3,30,1
+	UML_STORE(block, &m_ZF, 0, I4, SIZE_BYTE, SCALE_x1);                            // store   zf,i4,byte
+	UML_ROLAND(block, I4, I3, 29, 1);                                               // roland  i4,i3,29,1
+	UML_STORE(block, &m_SF, 0, I4, SIZE_BYTE, SCALE_x1);                            // store   sf,i4,byte
+	UML_AND(block, I4, I2, 0xff);                                                   // and     i4,i2,0xff
+	UML_LOAD(block, I4, i386_parity_table, I4, SIZE_DWORD, SCALE_x4);               // load    i4,parity_table,i4,dword
+	UML_STORE(block, &m_PF, 0, I4, SIZE_BYTE, SCALE_x1);                            // store   pf,i4,byte
+}
+
+
+/*-------------------------------------------------
+    generate_alu_modrm - generate an ALU operation
+    between a register and a 32-bit ModRM operand
+-------------------------------------------------*/
+
+int i386_device::generate_alu_modrm(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, int aluop, int todreg)
+{
+	const UINT8 *op = desc->opptr.b;
+	UINT8 modrm = op[1];
+	int reg = (modrm >> 3) & 7;
+	int writeback = (aluop != ALU_CMP && aluop != ALU_TEST);
+
+	if (modrm >= 0xc0)
+	{
+		int rm = modrm & 7;
+		int dst = todreg ? reg : rm;
+		generate_alu(block, aluop, R32(dst), R32(todreg ? rm : reg));               // <alu>   i2,dst,src
+		if (writeback)
+			UML_MOV(block, R32(dst), I2);                                           // mov     dst,i2
+		compiler->cycles += PM_CYCLES((aluop == ALU_CMP) ? CYCLES_CMP_REG_REG : (aluop == ALU_TEST) ? CYCLES_TEST_REG_REG : CYCLES_ALU_REG_REG);
+		return TRUE;
+	}
+
+	generate_checkpoint(block, compiler, desc);
+	generate_ea(block, desc, 1);                                                    // <ea>    i0
+	if (!todreg && writeback)
+		UML_MOV(block, I6, I0);                                                     // mov     i6,i0
+	UML_CALLH(block, *m_read32[compiler->mode]);                                    // callh   read32
+
+	if (todreg)
+	{
+		generate_alu(block, aluop, R32(reg), I0);                                   // <alu>   i2,reg,i0
+		if (writeback)
+			UML_MOV(block, R32(reg), I2);                                           // mov     reg,i2
+		compiler->cycles += PM_CYCLES((aluop == ALU_CMP) ? CYCLES_CMP_MEM_REG : CYCLES_ALU_MEM_REG);
+	}
+	else
+	{
+		generate_alu(block, aluop, I0, R32(reg));                                   // <alu>   i2,i0,reg
+		if (writeback)
+		{
+			UML_MOV(block, I0, I6);                                                 // mov     i0,i6
+			UML_MOV(block, I1, I2);                                                 // mov     i1,i2
+			UML_CALLH(block, *m_write32[compiler->mode]);                           // callh   write32
+		}
+		compiler->cycles += PM_CYCLES((aluop == ALU_CMP) ? CYCLES_CMP_REG_MEM : (aluop == ALU_TEST) ? CYCLES_TEST_REG_MEM : CYCLES_ALU_REG_MEM);
+	}
+	return TRUE;
+}
+
+
+/*-------------------------------------------------
+    generate_alu_group - generate groups 81 and 83,
+    ALU operations with an immediate; returns
+    FALSE for ADC and SBB
+-------------------------------------------------*/
+
+int i386_device::generate_alu_group(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	const UINT8 *op = desc->opptr.b;
+	UINT8 modrm = op[1];
+	int aluop = (modrm >> 3) & 7;
+	int writeback = (aluop != ALU_CMP);
+	UINT32 imm;
+
+	if (aluop == ALU_ADC || aluop == ALU_SBB)
+		return FALSE;
+
+	if (modrm >= 0xc0)
+	{
+		int rm = modrm & 7;
+		imm = (op[0] == 0x81) ? fetch_dword(&op[2]) : (UINT32)(INT8)op[2];
+		generate_alu(block, aluop, R32(rm), imm);                                   // <alu>   i2,rm,imm
+		if (writeback)
+			UML_MOV(block, R32(rm), I2);                                            // mov     rm,i2
+		compiler->cycles += PM_CYCLES((aluop == ALU_CMP) ? CYCLES_CMP_REG_REG : CYCLES_ALU_REG_REG);
+		return TRUE;
+	}
+
+	generate_checkpoint(block, compiler, desc);
+	int offs = generate_ea(block, desc, 1);                                         // <ea>    i0
+	imm = (op[0] == 0x81) ? fetch_dword(&op[offs]) : (UINT32)(INT8)op[offs];
+	if (writeback)
+		UML_MOV(block, I6, I0);                                                     // mov     i6,i0
+	UML_CALLH(block, *m_read32[compiler->mode]);                                    // callh   read32
+	generate_alu(block, aluop, I0, imm);                                            // <alu>   i2,i0,imm
+	if (writeback)
+	{
+		UML_MOV(block, I0, I6);                                                     // mov     i0,i6
+		UML_MOV(block, I1, I2);                                                     // mov     i1,i2
+		UML_CALLH(block, *m_write32[compiler->mode]);                               // callh   write32
+	}
+	compiler->cycles += PM_CYCLES((aluop == ALU_CMP) ? CYCLES_CMP_REG_MEM : CYCLES_ALU_REG_MEM);
+	return TRUE;
+}
+
+
+/*-------------------------------------------------
+    generate_push - push a dword; ESP only moves
+    once the write has succeeded
+-------------------------------------------------*/
+
+void i386_device::generate_push(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, parameter value)
+{
+	UML_SUB(block, I6, R32(ESP), 4);                                                // sub     i6,esp,4
+	UML_MOV(block, I1, value);                                                      // mov     i1,value
+	UML_MOV(block, I0, I6);                                                         // mov     i0,i6
+	UML_CALLH(block, *m_write32[compiler->mode]);                                   // callh   write32
+	UML_MOV(block, R32(ESP), I6);                                                   // mov     esp,i6
+}
+
+
+/*-------------------------------------------------
+    generate_opcode - generate code for a single
+    unprefixed instruction; returns FALSE for
+    anything that must be interpreted
+-------------------------------------------------*/
+
+int i386_device::generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	const UINT8 *op = desc->opptr.b;
+	UINT32 nextpc = desc->pc + desc->length;
+	UINT8 opcode = op[0];
+	UINT8 modrm = op[1];
+	int reg = (modrm >> 3) & 7;
+	int rm = modrm & 7;
+	int offs;
+
+	switch (opcode)
+	{
+		/* ALU between a register and r/m32 */
+		case 0x01:  case 0x03:  case 0x09:  case 0x0b:  case 0x21:  case 0x23:
+		case 0x29:  case 0x2b:  case 0x31:  case 0x33:  case 0x39:  case 0x3b:
+			return generate_alu_modrm(block, compiler, desc, opcode >> 3, (opcode & 2) != 0);
+
+		case 0x85:  /* TEST r/m32,r32 */
+			return generate_alu_modrm(block, compiler, desc, ALU_TEST, FALSE);
+
+		/* ALU with EAX and an immediate */
+		case 0x05:  case 0x0d:  case 0x25:  case 0x2d:  case 0x35:  case 0x3d:
+			generate_alu(block, opcode >> 3, R32(EAX), fetch_dword(&op[1]));        // <alu>   i2,eax,imm
+			if ((opcode >> 3) != ALU_CMP)
+				UML_MOV(block, R32(EAX), I2);                                       // mov     eax,i2
+			compiler->cycles += PM_CYCLES(((opcode >> 3) == ALU_CMP) ? CYCLES_CMP_IMM_ACC : CYCLES_ALU_IMM_ACC);
+			return TRUE;
+
+		case 0xa9:  /* TEST EAX,imm32 */
+			generate_alu(block, ALU_TEST, R32(EAX), fetch_dword(&op[1]));           // and     i2,eax,imm
+			compiler->cycles += PM_CYCLES(CYCLES_TEST_IMM_ACC);
+			return TRUE;
+
+		case 0x81:  /* group 1 r/m32,imm32 */
+		case 0x83:  /* group 1 r/m32,imm8 */
+			return generate_alu_group(block, compiler, desc);
+
+		/* INC/DEC r32 leave CF alone */
+		case 0x40:  case 0x41:  case 0x42:  case 0x43:  case 0x44:  case 0x45:  case 0x46:  case 0x47:
+		case 0x48:  case 0x49:  case 0x4a:  case 0x4b:  case 0x4c:  case 0x4d:  case 0x4e:  case 0x4f:
+			if (opcode < 0x48)
+				UML_ADD(block, I2, R32(opcode & 7), 1);                             // add     i2,reg,1
+			else
+				UML_SUB(block, I2, R32(opcode & 7), 1);                             // sub     i2,reg,1
+			UML_GETFLGS(block, I3, FLAG_V | FLAG_Z | FLAG_S);                       // getflgs i3,vzs
+			UML_ROLAND(block, I4, I3, 31, 1);                                       // roland  i4,i3,31,1
+			UML_STORE(block, &m_OF, 0, I4, SIZE_BYTE, SCALE_x1);                    // store   of,i4,byte
+			UML_ROLAND(block, I4, I3, 30, 1);                                       // roland  i4,i3,30,1
+			UML_STORE(block, &m_ZF, 0, I4, SIZE_BYTE, SCALE_x1);                    // store   zf,i4,byte
+			UML_ROLAND(block, I4, I3, 29, 1);                                       // roland  i4,i3,29,1
+			UML_STORE(block, &m_SF, 0, I4, SIZE_BYTE, SCALE_x1);                    // store   sf,i4,byte
+			UML_XOR(block, I4, R32(opcode & 7), I2);                                // xor     i4,reg,i2
+			UML_ROLAND(block, I4, I4, 28, 1);                                       // roland  i4,i4,28,1
+			UML_STORE(block, &m_AF, 0, I4, SIZE_BYTE, SCALE_x1);                    // store   af,i4,byte
+			UML_AND(block, I4, I2, 0xff);                                           // and     i4,i2,0xff
+			UML_LOAD(block, I4, i386_parity_table, I4, SIZE_DWORD, SCALE_x4);       // load    i4,parity_table,i4,dword
+			UML_STORE(block, &m_PF, 0, I4, SIZE_BYTE, SCALE_x1);                    // store   pf,i4,byte
+			UML_MOV(block, R32(opcode & 7), I2);                                    // mov     reg,i2
+			compiler->cycles += PM_CYCLES((opcode < 0x48) ? CYCLES_INC_REG : CYCLES_DEC_REG);
+			return TRUE;
+
+		/* PUSH r32 pushes the old ESP for ESP */
+		case 0x50:  case 0x51:  case 0x52:  case 0x53:  case 0x54:  case 0x55:  case 0x56:  case 0x57:
+			generate_checkpoint(block, compiler, desc);
+			generate_push(block, compiler, desc, R32(opcode & 7));                  // <push>  reg
+			compiler->cycles += PM_CYCLES(CYCLES_PUSH_REG_SHORT);
+			return TRUE;
+
+		/* POP r32 leaves ESP holding the popped value for ESP */
+		case 0x58:  case 0x59:  case 0x5a:  case 0x5b:  case 0x5c:  case 0x5d:  case 0x5e:  case 0x5f:
+			generate_checkpoint(block, compiler, desc);
+			UML_MOV(block, I0, R32(ESP));                                           // mov     i0,esp
+			UML_CALLH(block, *m_read32[compiler->mode]);                            // callh   read32
+			UML_ADD(block, R32(ESP), R32(ESP), 4);                                  // add     esp,esp,4
+			UML_MOV(block, R32(opcode & 7), I0);                                    // mov     reg,i0
+			compiler->cycles += PM_CYCLES(CYCLES_POP_REG_SHORT);
+			return TRUE;
+
+		case 0x68:  /* PUSH imm32 */
+		case 0x6a:  /* PUSH imm8 */
+			generate_checkpoint(block, compiler, desc);
+			generate_push(block, compiler, desc, (opcode == 0x68) ? fetch_dword(&op[1]) : (UINT32)(INT8)op[1]); // <push>  imm
+			compiler->cycles += PM_CYCLES(CYCLES_PUSH_IMM);
+			return TRUE;
+
+		case 0x88:  /* MOV r/m8,r8 */
+			if (modrm >= 0xc0)
+			{
+				UML_LOAD(block, I0, R8(reg), 0, SIZE_BYTE, SCALE_x1);               // load    i0,reg,byte
+				UML_STORE(block, R8(rm), 0, I0, SIZE_BYTE, SCALE_x1);               // store   rm,i0,byte
+				compiler->cycles += PM_CYCLES(CYCLES_MOV_REG_REG);
+				return TRUE;
+			}
+			generate_checkpoint(block, compiler, desc);
+			generate_ea(block, desc, 1);                                            // <ea>    i0
+			UML_LOAD(block, I1, R8(reg), 0, SIZE_BYTE, SCALE_x1);                   // load    i1,reg,byte
+			UML_CALLH(block, *m_write8[compiler->mode]);                            // callh   write8
+			compiler->cycles += PM_CYCLES(CYCLES_MOV_REG_MEM);
+			return TRUE;
+
+		case 0x89:  /* MOV r/m32,r32 */
+			if (modrm >= 0xc0)
+			{
+				UML_MOV(block, R32(rm), R32(reg));                                  // mov     rm,reg
+				compiler->cycles += PM_CYCLES(CYCLES_MOV_REG_REG);
+				return TRUE;
+			}
+			generate_checkpoint(block, compiler, desc);
+			generate_ea(block, desc, 1);                                            // <ea>    i0
+			UML_MOV(block, I1, R32(reg));                                           // mov     i1,reg
+			UML_CALLH(block, *m_write32[compiler->mode]);                           // callh   write32
+			compiler->cycles += PM_CYCLES(CYCLES_MOV_REG_MEM);
+			return TRUE;
+
+		case 0x8a:  /* MOV r8,r/m8 */
+			if (modrm >= 0xc0)
+			{
+				UML_LOAD(block, I0, R8(rm), 0, SIZE_BYTE, SCALE_x1);                // load    i0,rm,byte
+				UML_STORE(block, R8(reg), 0, I0, SIZE_BYTE, SCALE_x1);              // store   reg,i0,byte
+				compiler->cycles += PM_CYCLES(CYCLES_MOV_REG_REG);
+				return TRUE;
+			}
+			generate_checkpoint(block, compiler, desc);
+			generate_ea(block, desc, 1);                                            // <ea>    i0
+			UML_CALLH(block, *m_read8[compiler->mode]);                             // callh   read8
+			UML_STORE(block, R8(reg), 0, I0, SIZE_BYTE, SCALE_x1);                  // store   reg,i0,byte
+			compiler->cycles += PM_CYCLES(CYCLES_MOV_MEM_REG);
+			return TRUE;
+
+		case 0x8b:  /* MOV r32,r/m32 */
+			if (modrm >= 0xc0)
+			{
+				UML_MOV(block, R32(reg), R32(rm));                                  // mov     reg,rm
+				compiler->cycles += PM_CYCLES(CYCLES_MOV_REG_REG);
+				return TRUE;
+			}
+			generate_checkpoint(block, compiler, desc);
+			generate_ea(block, desc, 1);                                            // <ea>    i0
+			UML_CALLH(block, *m_read32[compiler->mode]);                            // callh   read32
+			UML_MOV(block, R32(reg), I0);                                           // mov     reg,i0
+			compiler->cycles += PM_CYCLES(CYCLES_MOV_MEM_REG);
+			return TRUE;
+
+		case 0x8d:  /* LEA r32,m */
+			if (modrm >= 0xc0)
+				return FALSE;
+			generate_ea(block, desc, 1);                                            // <ea>    i0
+			UML_MOV(block, R32(reg), I0);                                           // mov     reg,i0
+			compiler->cycles += PM_CYCLES(CYCLES_LEA);
+			return TRUE;
+
+		case 0x90:  /* NOP */
+			compiler->cycles += PM_CYCLES(CYCLES_NOP);
+			return TRUE;
+
+		/* MOV r8,imm8 */
+		case 0xb0:  case 0xb1:  case 0xb2:  case 0xb3:  case 0xb4:  case 0xb5:  case 0xb6:  case 0xb7:
+			UML_STORE(block, R8(opcode & 7), 0, op[1], SIZE_BYTE, SCALE_x1);        // store   reg,imm,byte
+			compiler->cycles += PM_CYCLES(CYCLES_MOV_IMM_REG);
+			return TRUE;
+
+		/* MOV r32,imm32 */
+		case 0xb8:  case 0xb9:  case 0xba:  case 0xbb:  case 0xbc:  case 0xbd:  case 0xbe:  case 0xbf:
+			UML_MOV(block, R32(opcode & 7), fetch_dword(&op[1]));                   // mov     reg,imm
+			compiler->cycles += PM_CYCLES(CYCLES_MOV_IMM_REG);
+			return TRUE;
+
+		case 0xc6:  /* MOV r/m8,imm8 */
+			if (reg != 0)
+				return FALSE;
+			if (modrm >= 0xc0)
+			{
+				UML_STORE(block, R8(rm), 0, op[2], SIZE_BYTE, SCALE_x1);            // store   rm,imm,byte
+				compiler->cycles += PM_CYCLES(CYCLES_MOV_IMM_REG);
+				return TRUE;
+			}
+			generate_checkpoint(block, compiler, desc);
+			offs = generate_ea(block, desc, 1);                                     // <ea>    i0
+			UML_MOV(block, I1, op[offs]);                                           // mov     i1,imm
+			UML_CALLH(block, *m_write8[compiler->mode]);                            // callh   write8
+			compiler->cycles += PM_CYCLES(CYCLES_MOV_IMM_MEM);
+			return TRUE;
+
+		case 0xc7:  /* MOV r/m32,imm32 */
+			if (reg != 0)
+				return FALSE;
+			if (modrm >= 0xc0)
+			{
+				UML_MOV(block, R32(rm), fetch_dword(&op[2]));                       // mov     rm,imm
+				compiler->cycles += PM_CYCLES(CYCLES_MOV_IMM_REG);
+				return TRUE;
+			}
+			generate_checkpoint(block, compiler, desc);
+			offs = generate_ea(block, desc, 1);                                     // <ea>    i0
+			UML_MOV(block, I1, fetch_dword(&op[offs]));                             // mov     i1,imm
+			UML_CALLH(block, *m_write32[compiler->mode]);                           // callh   write32
+			compiler->cycles += PM_CYCLES(CYCLES_MOV_IMM_MEM);
+			return TRUE;
+
+		/* Jcc rel8 */
+		case 0x70:  case 0x71:  case 0x72:  case 0x73:  case 0x74:  case 0x75:  case 0x76:  case 0x77:
+		case 0x78:  case 0x79:  case 0x7a:  case 0x7b:  case 0x7c:  case 0x7d:  case 0x7e:  case 0x7f:
+		{
+			code_label skip = compiler->labelnum++;
+			compiler_state compiler_temp = *compiler;
+
+			generate_condition(block, (opcode & 0x0f) ^ 1, skip);                   // <jump to skip if not taken>
+			compiler_temp.cycles += PM_CYCLES(CYCLES_JCC_DISP8);
+			generate_branch(block, &compiler_temp, desc);                           // <branch>
+			UML_LABEL(block, skip);                                                 // skip:
+			compiler->cycles += PM_CYCLES(CYCLES_JCC_DISP8_NOBRANCH);
+			return TRUE;
+		}
+
+		case 0xc2:  /* RET imm16 */
+		case 0xc3:  /* RET */
+			generate_checkpoint(block, compiler, desc);
+			UML_MOV(block, I0, R32(ESP));                                           // mov     i0,esp
+			UML_CALLH(block, *m_read32[compiler->mode]);                            // callh   read32
+			if (opcode == 0xc2)
+				UML_ADD(block, R32(ESP), R32(ESP), (UINT32)(4 + (INT16)(op[1] | (op[2] << 8)))); // add     esp,esp,4+imm
+			else
+				UML_ADD(block, R32(ESP), R32(ESP), 4);                              // add     esp,esp,4
+			UML_MOV(block, mem(&m_eip), I0);                                        // mov     [eip],i0
+			compiler->cycles += PM_CYCLES((opcode == 0xc2) ? CYCLES_RET_IMM : CYCLES_RET);
+			generate_branch(block, compiler, desc);                                 // <branch>
+			return TRUE;
+
+		case 0xe8:  /* CALL rel32 */
+			generate_checkpoint(block, compiler, desc);
+			generate_push(block, compiler, desc, nextpc);                           // <push>  nextpc
+			compiler->cycles += PM_CYCLES(CYCLES_CALL);
+			generate_branch(block, compiler, desc);                                 // <branch>
+			return TRUE;
+
+		case 0xe9:  /* JMP rel32 */
+		case 0xeb:  /* JMP rel8 */
+			compiler->cycles += PM_CYCLES((opcode == 0xeb) ? CYCLES_JMP_SHORT : CYCLES_JMP);
+			generate_branch(block, compiler, desc);                                 // <branch>
+			return TRUE;
+
+		case 0xff:  /* CALL/JMP r/m32 */
+			if (reg != 2 && reg != 4)
+				return FALSE;
+			generate_checkpoint(block, compiler, desc);
+			if (modrm >= 0xc0)
+				UML_MOV(block, I5, R32(rm));                                        // mov     i5,rm
+			else
+			{
+				generate_ea(block, desc, 1);                                        // <ea>    i0
+				UML_CALLH(block, *m_read32[compiler->mode]);                        // callh   read32
+				UML_MOV(block, I5, I0);                                             // mov     i5,i0
+			}
+			if (reg == 2)
+				generate_push(block, compiler, desc, nextpc);                       // <push>  nextpc
+			UML_MOV(block, mem(&m_eip), I5);                                        // mov     [eip],i5
+			if (reg == 2)
+				compiler->cycles += PM_CYCLES((modrm >= 0xc0) ? CYCLES_CALL_REG : CYCLES_CALL_MEM);
+			else
+				compiler->cycles += PM_CYCLES((modrm >= 0xc0) ? CYCLES_JMP_REG : CYCLES_JMP_MEM);
+			generate_branch(block, compiler, desc);                                 // <branch>
+			return TRUE;
+
+		case 0x0f:
+			switch (op[1])
+			{
+				/* Jcc rel32 */
+				case 0x80:  case 0x81:  case 0x82:  case 0x83:  case 0x84:  case 0x85:  case 0x86:  case 0x87:
+				case 0x88:  case 0x89:  case 0x8a:  case 0x8b:  case 0x8c:  case 0x8d:  case 0x8e:  case 0x8f:
+				{
+					code_label skip = compiler->labelnum++;
+					compiler_state compiler_temp = *compiler;
+
+					generate_condition(block, (op[1] & 0x0f) ^ 1, skip);            // <jump to skip if not taken>
+					compiler_temp.cycles += PM_CYCLES(CYCLES_JCC_FULL_DISP);
+					generate_branch(block, &compiler_temp, desc);                   // <branch>
+					UML_LABEL(block, skip);                                         // skip:
+					compiler->cycles += PM_CYCLES(CYCLES_JCC_FULL_DISP_NOBRANCH);
+					return TRUE;
+				}
+
+				/* MOVZX/MOVSX r32,r/m8 and r32,r/m16 */
+				case 0xb6:
+				case 0xb7:
+				case 0xbe:
+				case 0xbf:
+				{
+					UINT8 modrm2 = op[2];
+					int size = (op[1] & 1) ? 2 : 1;
+					int issigned = (op[1] >= 0xbe);
+
+					if (modrm2 >= 0xc0)
+					{
+						if (size == 1)
+							UML_LOAD(block, I0, R8(modrm2 & 7), 0, SIZE_BYTE, SCALE_x1);    // load    i0,rm,byte
+						else
+							UML_LOAD(block, I0, R16(modrm2 & 7), 0, SIZE_WORD, SCALE_x1);   // load    i0,rm,word
+					}
+					else
+					{
+						generate_checkpoint(block, compiler, desc);
+						generate_ea(block, desc, 2);                                // <ea>    i0
+						UML_CALLH(block, (size == 1) ? *m_read8[compiler->mode] : *m_read16[compiler->mode]); // callh   read8/16
+					}
+					if (issigned)
+						UML_SEXT(block, I0, I0, (size == 1) ? SIZE_BYTE : SIZE_WORD);   // sext    i0,i0,size
+					UML_MOV(block, R32((modrm2 >> 3) & 7), I0);                     // mov     reg,i0
+					if (issigned)
+						compiler->cycles += PM_CYCLES((modrm2 >= 0xc0) ? CYCLES_MOVSX_REG_REG : CYCLES_MOVSX_MEM_REG);
+					else
+						compiler->cycles += PM_CYCLES((modrm2 >= 0xc0) ? CYCLES_MOVZX_REG_REG : CYCLES_MOVZX_MEM_REG);
+					return TRUE;
+				}
+			}
+			return FALSE;
+	}
+
+	return FALSE;
+}
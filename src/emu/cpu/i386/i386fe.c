@@ -0,0 +1,378 @@
+// license:BSD-3-Clause
+// copyright-holders:Ville Linde, Barry Rodewald, Carl, Phil Bennett
+/*
+    i386fe.c
+
+    Front-end for the x86 recompiler
+
+    Only the instruction length and the flow of control are worked out
+    here; the code generator decides for itself which instructions it
+    can handle and steps everything else through the interpreter.
+*/
+
+#include "emu.h"
+#include "i386priv.h"
+#include "i386fe.h"
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// what follows an opcode byte
+#define OPERAND_MODRM       0x01    // ModRM, plus any SIB and displacement
+#define OPERAND_IMM8        0x02    // 8-bit immediate
+#define OPERAND_IMMZ        0x04    // 16 or 32-bit immediate, by operand size
+#define OPERAND_IMM16       0x08    // 16-bit immediate
+#define OPERAND_MOFFS       0x10    // offset the size of an address
+#define OPERAND_FAR         0x20    // far pointer: offset and selector
+#define OPERAND_PREFIX      0x40    // not an opcode but a prefix
+#define OPERAND_UNKNOWN     0x80    // length not known here
+
+#define M   OPERAND_MODRM
+#define B   OPERAND_IMM8
+#define Z   OPERAND_IMMZ
+#define W   OPERAND_IMM16
+#define O   OPERAND_MOFFS
+#define F   OPERAND_FAR
+#define P   OPERAND_PREFIX
+#define U   OPERAND_UNKNOWN
+
+static const UINT8 s_onebyte[256] =
+{
+	/*      0    1    2    3    4    5    6    7    8    9    A    B    C    D    E    F   */
+	/* 0 */ M,   M,   M,   M,   B,   Z,   0,   0,   M,   M,   M,   M,   B,   Z,   0,   0,
+	/* 1 */ M,   M,   M,   M,   B,   Z,   0,   0,   M,   M,   M,   M,   B,   Z,   0,   0,
+	/* 2 */ M,   M,   M,   M,   B,   Z,   P,   0,   M,   M,   M,   M,   B,   Z,   P,   0,
+	/* 3 */ M,   M,   M,   M,   B,   Z,   P,   0,   M,   M,   M,   M,   B,   Z,   P,   0,
+	/* 4 */ 0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+	/* 5 */ 0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+	/* 6 */ 0,   0,   M,   M,   P,   P,   P,   P,   Z,   M|Z, B,   M|B, 0,   0,   0,   0,
+	/* 7 */ B,   B,   B,   B,   B,   B,   B,   B,   B,   B,   B,   B,   B,   B,   B,   B,
+	/* 8 */ M|B, M|Z, M|B, M|B, M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,
+	/* 9 */ 0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   F,   0,   0,   0,   0,   0,
+	/* A */ O,   O,   O,   O,   0,   0,   0,   0,   B,   Z,   0,   0,   0,   0,   0,   0,
+	/* B */ B,   B,   B,   B,   B,   B,   B,   B,   Z,   Z,   Z,   Z,   Z,   Z,   Z,   Z,
+	/* C */ M|B, M|B, W,   0,   M,   M,   M|B, M|Z, W|B, 0,   W,   0,   0,   B,   0,   0,
+	/* D */ M,   M,   M,   M,   B,   B,   0,   0,   M,   M,   M,   M,   M,   M,   M,   M,
+	/* E */ B,   B,   B,   B,   B,   B,   B,   B,   Z,   Z,   F,   B,   0,   0,   0,   0,
+	/* F */ P,   0,   P,   P,   0,   0,   M,   M,   0,   0,   0,   0,   0,   0,   M,   M
+};
+
+static const UINT8 s_twobyte[256] =
+{
+	/*      0    1    2    3    4    5    6    7    8    9    A    B    C    D    E    F   */
+	/* 0 */ M,   M,   M,   M,   U,   U,   0,   U,   0,   0,   U,   0,   U,   M,   U,   U,
+	/* 1 */ M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,
+	/* 2 */ M,   M,   M,   M,   M,   U,   M,   U,   M,   M,   M,   M,   M,   M,   M,   M,
+	/* 3 */ 0,   0,   0,   0,   0,   0,   U,   U,   U,   U,   U,   U,   U,   U,   U,   U,
+	/* 4 */ M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,
+	/* 5 */ M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,
+	/* 6 */ M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,
+	/* 7 */ M|B, M|B, M|B, M|B, M,   M,   M,   0,   M,   M,   M,   M,   M,   M,   M,   M,
+	/* 8 */ Z,   Z,   Z,   Z,   Z,   Z,   Z,   Z,   Z,   Z,   Z,   Z,   Z,   Z,   Z,   Z,
+	/* 9 */ M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,
+	/* A */ 0,   0,   0,   M,   M|B, M,   U,   U,   0,   0,   0,   M,   M|B, M,   M,   M,
+	/* B */ M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M|B, M,   M,   M,   M,   M,
+	/* C */ M,   M,   M|B, M,   M|B, M|B, M|B, M,   0,   0,   0,   0,   0,   0,   0,   0,
+	/* D */ M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,
+	/* E */ M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,
+	/* F */ M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M,   M
+};
+
+#undef M
+#undef B
+#undef Z
+#undef W
+#undef O
+#undef F
+#undef P
+#undef U
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  skip_prefixes - return the offset of the
+//  opcode, noting any operand and address size
+//  overrides
+//-------------------------------------------------
+
+INLINE int skip_prefixes(const UINT8 *op, int avail, int *opsize, int *addrsize)
+{
+	int offs = 0;
+
+	*opsize = *addrsize = 4;
+	while (offs < avail && (s_onebyte[op[offs]] & OPERAND_PREFIX))
+	{
+		if (op[offs] == 0x66)
+			*opsize = 2;
+		else if (op[offs] == 0x67)
+			*addrsize = 2;
+		offs++;
+	}
+	return offs;
+}
+
+
+//-------------------------------------------------
+//  fetch_dword - read a little-endian dword from
+//  the opcode bytes
+//-------------------------------------------------
+
+INLINE UINT32 fetch_dword(const UINT8 *op)
+{
+	return op[0] | (op[1] << 8) | (op[2] << 16) | (op[3] << 24);
+}
+
+
+
+//**************************************************************************
+//  I386 FRONTEND
+//**************************************************************************
+
+//-------------------------------------------------
+//  i386_frontend - constructor
+//-------------------------------------------------
+
+i386_frontend::i386_frontend(i386_device &i386, UINT32 window_start, UINT32 window_end, UINT32 max_sequence)
+	: drc_frontend(i386, window_start, window_end, max_sequence),
+		m_i386(i386)
+{
+}
+
+
+//-------------------------------------------------
+//  describe - build a description of a single
+//  instruction
+//-------------------------------------------------
+
+bool i386_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	UINT8 bytes[32];
+	int avail;
+
+	// with paging enabled the code is found through the TLB; a miss is left to
+	// the interpreter's fetch, which loads the entry or raises the page fault
+	if (m_i386.m_cr[0] & 0x80000000)
+	{
+		vtlb_entry required = VTLB_FLAG_VALID | ((m_i386.m_CPL == 3) ? VTLB_USER_READ_ALLOWED : VTLB_READ_ALLOWED);
+		vtlb_entry entry = vtlb_table(m_i386.m_vtlb)[desc.pc >> 12];
+		if ((entry & required) != required)
+		{
+			desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_COMPILER_PAGE_FAULT | OPFLAG_VIRTUAL_NOOP | OPFLAG_END_SEQUENCE;
+			return true;
+		}
+		desc.physpc = (entry & 0xfffff000) | (desc.pc & 0xfff);
+	}
+
+	// fetch up to the longest possible instruction, stopping at the end of the page
+	// or of directly readable memory
+	memset(bytes, 0, sizeof(bytes));
+	for (avail = 0; avail < MIN(15, 0x1000 - (desc.pc & 0xfff)); avail++)
+	{
+		if (m_i386.m_direct->read_decrypted_ptr(desc.physpc + avail) == NULL)
+			break;
+		bytes[avail] = m_i386.m_direct->read_decrypted_byte(desc.physpc + avail);
+	}
+
+	// an instruction we can't see all of is stepped by the interpreter
+	int length = decode_length(bytes, avail);
+	if (avail == 0 || length > avail)
+	{
+		desc.flags |= OPFLAG_COMPILER_UNMAPPED | OPFLAG_VIRTUAL_NOOP | OPFLAG_END_SEQUENCE;
+		return true;
+	}
+	memcpy(desc.opptr.b, bytes, sizeof(desc.opptr.b));
+
+	// so is one we can't size; nothing after it can be described
+	if (length < 0)
+	{
+		desc.length = 1;
+		desc.flags |= OPFLAG_INVALID_OPCODE | OPFLAG_END_SEQUENCE;
+		return true;
+	}
+
+	desc.length = length;
+	describe_branch(desc);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  decode_length - return the length of the
+//  instruction, which may exceed the bytes
+//  available, or -1 if it is not known
+//-------------------------------------------------
+
+int i386_frontend::decode_length(const UINT8 *op, int avail)
+{
+	int opsize, addrsize;
+	int offs = skip_prefixes(op, avail, &opsize, &addrsize);
+	if (offs >= avail)
+		return avail + 1;
+
+	// look up the opcode in the one, two or three-byte map
+	UINT8 opcode = op[offs++];
+	UINT8 flags;
+	if (opcode != 0x0f)
+	{
+		flags = s_onebyte[opcode];
+
+		// the TEST forms of group 3 carry an immediate
+		if ((opcode == 0xf6 || opcode == 0xf7) && (op[offs] & 0x30) == 0)
+			flags |= (opcode == 0xf6) ? OPERAND_IMM8 : OPERAND_IMMZ;
+	}
+	else
+	{
+		opcode = op[offs++];
+		if (opcode == 0x38)
+		{
+			offs++;
+			flags = OPERAND_MODRM;
+		}
+		else if (opcode == 0x3a)
+		{
+			offs++;
+			flags = OPERAND_MODRM | OPERAND_IMM8;
+		}
+		else
+			flags = s_twobyte[opcode];
+	}
+	if (flags & OPERAND_UNKNOWN)
+		return -1;
+
+	// ModRM, SIB and displacement
+	if (flags & OPERAND_MODRM)
+	{
+		UINT8 modrm = op[offs++];
+		int mod = modrm >> 6;
+		int rm = modrm & 7;
+
+		if (mod != 3 && addrsize == 4)
+		{
+			if (rm == 4 && mod == 0 && (op[offs] & 7) == 5)
+				offs += 4;
+			if (rm == 4)
+				offs++;
+			else if (mod == 0 && rm == 5)
+				offs += 4;
+			offs += (mod == 1) ? 1 : (mod == 2) ? 4 : 0;
+		}
+		else if (mod != 3)
+		{
+			if (mod == 0 && rm == 6)
+				offs += 2;
+			offs += (mod == 1) ? 1 : (mod == 2) ? 2 : 0;
+		}
+	}
+
+	// immediates
+	if (flags & OPERAND_IMM8)
+		offs += 1;
+	if (flags & OPERAND_IMM16)
+		offs += 2;
+	if (flags & OPERAND_IMMZ)
+		offs += opsize;
+	if (flags & OPERAND_MOFFS)
+		offs += addrsize;
+	if (flags & OPERAND_FAR)
+		offs += opsize + 2;
+	return offs;
+}
+
+
+//-------------------------------------------------
+//  describe_branch - flag instructions that
+//  change the flow of control
+//-------------------------------------------------
+
+void i386_frontend::describe_branch(opcode_desc &desc)
+{
+	const UINT8 *op = desc.opptr.b;
+	UINT32 nextpc = desc.pc + desc.length;
+	int opsize, addrsize;
+	int offs = skip_prefixes(op, desc.length, &opsize, &addrsize);
+	UINT8 opcode = op[offs++];
+
+	// a 16-bit operand size truncates EIP, so those targets are left dynamic
+	switch (opcode)
+	{
+		// conditional branches carry on with the sequence when not taken
+		case 0x70:  case 0x71:  case 0x72:  case 0x73:  case 0x74:  case 0x75:  case 0x76:  case 0x77:
+		case 0x78:  case 0x79:  case 0x7a:  case 0x7b:  case 0x7c:  case 0x7d:  case 0x7e:  case 0x7f:
+		case 0xe0:  case 0xe1:  case 0xe2:  case 0xe3:
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			if (opsize == 4)
+				desc.targetpc = nextpc + (INT8)op[offs];
+			break;
+
+		case 0xeb:
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			if (opsize == 4)
+				desc.targetpc = nextpc + (INT8)op[offs];
+			break;
+
+		case 0xe8:
+		case 0xe9:
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			if (opsize == 4)
+				desc.targetpc = nextpc + fetch_dword(&op[offs]);
+			break;
+
+		case 0xc2:
+		case 0xc3:
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			break;
+
+		// indirect near branches, and far ones which may change modes
+		case 0xff:
+			switch ((op[offs] >> 3) & 7)
+			{
+				case 2:
+				case 4:
+					desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+					break;
+
+				case 3:
+				case 5:
+					desc.flags |= OPFLAG_END_SEQUENCE | OPFLAG_CAN_CHANGE_MODES;
+					break;
+			}
+			break;
+
+		// far branches, interrupts and their returns
+		case 0x9a:
+		case 0xca:
+		case 0xcb:
+		case 0xcc:
+		case 0xcd:
+		case 0xce:
+		case 0xcf:
+		case 0xea:
+			desc.flags |= OPFLAG_END_SEQUENCE | OPFLAG_CAN_CHANGE_MODES;
+			break;
+
+		// HLT stops until the next interrupt
+		case 0xf4:
+			desc.flags |= OPFLAG_END_SEQUENCE;
+			break;
+
+		case 0x0f:
+			opcode = op[offs++];
+			if (opcode >= 0x80 && opcode <= 0x8f)
+			{
+				desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+				if (opsize == 4)
+					desc.targetpc = nextpc + fetch_dword(&op[offs]);
+			}
+
+			// SYSENTER and SYSEXIT
+			else if (opcode == 0x34 || opcode == 0x35)
+				desc.flags |= OPFLAG_END_SEQUENCE | OPFLAG_CAN_CHANGE_MODES;
+			break;
+	}
+}
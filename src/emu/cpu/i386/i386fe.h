@@ -0,0 +1,43 @@
+// license:BSD-3-Clause
+// copyright-holders:Ville Linde, Barry Rodewald, Carl, Phil Bennett
+/*
+    i386fe.h
+
+    Front-end for the x86 recompiler
+*/
+
+#pragma once
+
+#ifndef __I386FE_H__
+#define __I386FE_H__
+
+#include "i386.h"
+#include "cpu/drcfe.h"
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+class i386_frontend : public drc_frontend
+{
+public:
+	// construction/destruction
+	i386_frontend(i386_device &i386, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
+
+protected:
+	// required overrides
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev);
+
+private:
+	// internal helpers
+	int decode_length(const UINT8 *op, int avail);
+	void describe_branch(opcode_desc &desc);
+
+	// internal state
+	i386_device &m_i386;
+};
+
+
+
+#endif /* __I386FE_H__ */
@@ -155,6 +155,7 @@ mips3_device::mips3_device(const machine_config &mconfig, device_type type, cons
 	, m_cache(CACHE_SIZE + sizeof(internal_mips3_state))
 	, m_drcuml(NULL)
 	, m_drcfe(NULL)
+	, m_drcpersist(NULL)
 	, m_drcoptions(0)
 	, m_cache_dirty(0)
 	, m_entry(NULL)
@@ -202,6 +203,12 @@ void mips3_device::device_stop()
 		m_vtlb = NULL;
 	}
 
+	if (m_drcpersist != NULL)
+	{
+		m_drcpersist->save();
+		auto_free(machine(), m_drcpersist);
+		m_drcpersist = NULL;
+	}
 	if (m_drcfe != NULL)
 	{
 		auto_free(machine(), m_drcfe);
@@ -403,6 +410,10 @@ void mips3_device::device_start()
 	/* initialize the front-end helper */
 	m_drcfe = auto_alloc(machine(), mips3_frontend(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE));
 
+	/* optionally record compiled blocks, and recompile those from a previous run */
+	if (m_isdrc && machine().options().drc_persist())
+		m_drcpersist = auto_alloc(machine(), drc_persistent_cache(*this, *m_drcfe, drc_compile_delegate(FUNC(mips3_device::code_compile_block), this), m_flavor | (m_bigendian << 8)));
+
 	/* allocate memory for cache-local state and initialize it */
 	memcpy(m_fpmode, fpmode_source, sizeof(fpmode_source));
 
@@ -2519,6 +2530,9 @@ void mips3_device::execute_run()
 			/* if we need to recompile, do it */
 			if (execute_result == EXECUTE_MISSING_CODE)
 			{
+				/* along with any blocks recorded on this page on a previous run */
+				if (m_drcpersist != NULL)
+					m_drcpersist->missing_code(m_core->mode, m_core->pc);
 				code_compile_block(m_core->mode, m_core->pc);
 			}
 			else if (execute_result == EXECUTE_UNMAPPED_CODE)
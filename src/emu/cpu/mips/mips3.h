@@ -17,6 +17,7 @@
 
 #include "cpu/vtlb.h"
 #include "cpu/drcfe.h"
+#include "cpu/drcpersist.h"
 #include "cpu/drcuml.h"
 #include "cpu/drcumlsh.h"
 
@@ -410,6 +411,7 @@ private:
 	drc_cache           m_cache;                      /* pointer to the DRC code cache */
 	drcuml_state *      m_drcuml;                     /* DRC UML generator state */
 	mips3_frontend *    m_drcfe;                      /* pointer to the DRC front-end state */
+	drc_persistent_cache *m_drcpersist;               /* record of compiled blocks kept across runs */
 	UINT32              m_drcoptions;                 /* configurable DRC options */
 
 	/* internal stuff */
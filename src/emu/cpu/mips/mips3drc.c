@@ -360,6 +360,10 @@ void mips3_device::code_compile_block(UINT8 mode, offs_t pc)
 			block->end();
 			g_profiler.stop();
 			succeeded = true;
+
+			/* note the block so it can be recompiled ahead of need next run */
+			if (m_drcpersist != NULL)
+				m_drcpersist->block_compiled(mode, pc, desclist);
 		}
 		catch (drcuml_block::abort_compilation &)
 		{
@@ -220,6 +220,7 @@ ppc_device::ppc_device(const machine_config &mconfig, device_type type, const ch
 	, m_cache(CACHE_SIZE + sizeof(internal_ppc_state))
 	, m_drcuml(NULL)
 	, m_drcfe(NULL)
+	, m_drcpersist(NULL)
 	, m_drcoptions(0)
 {
 	m_program_config.m_logaddr_width = 32;
@@ -928,6 +929,10 @@ void ppc_device::device_start()
 	/* initialize the front-end helper */
 	m_drcfe = auto_alloc(machine(), ppc_frontend(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE));
 
+	/* optionally record compiled blocks, and recompile those from a previous run */
+	if (machine().options().drc_persist())
+		m_drcpersist = auto_alloc(machine(), drc_persistent_cache(*this, *m_drcfe, drc_compile_delegate(FUNC(ppc_device::code_compile_block), this), m_flavor | (m_cap << 8)));
+
 	/* compute the register parameters */
 	for (int regnum = 0; regnum < 32; regnum++)
 	{
@@ -1151,6 +1156,12 @@ void ppc_device::device_stop()
 	m_vtlb = NULL;
 
 	/* clean up the DRC */
+	if (m_drcpersist != NULL)
+	{
+		m_drcpersist->save();
+		auto_free(machine(), m_drcpersist);
+		m_drcpersist = NULL;
+	}
 	auto_free(machine(), m_drcfe);
 	auto_free(machine(), m_drcuml);
 }
@@ -221,7 +221,12 @@ void ppc_device::execute_run()
 
 		/* if we need to recompile, do it */
 		if (execute_result == EXECUTE_MISSING_CODE)
+		{
+			/* along with any blocks recorded on this page on a previous run */
+			if (m_drcpersist != NULL)
+				m_drcpersist->missing_code(m_core->mode, m_core->pc);
 			code_compile_block(m_core->mode, m_core->pc);
+		}
 		else if (execute_result == EXECUTE_UNMAPPED_CODE)
 			fatalerror("Attempted to execute unmapped code at PC=%08X\n", m_core->pc);
 		else if (execute_result == EXECUTE_RESET_CACHE)
@@ -450,6 +455,10 @@ void ppc_device::code_compile_block(UINT8 mode, offs_t pc)
 			block->end();
 			g_profiler.stop();
 			succeeded = true;
+
+			/* note the block so it can be recompiled ahead of need next run */
+			if (m_drcpersist != NULL)
+				m_drcpersist->block_compiled(mode, pc, desclist);
 		}
 		catch (drcuml_block::abort_compilation &)
 		{
@@ -18,6 +18,8 @@
 #include "gte.h"
 #include "irq.h"
 #include "sio.h"
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
 
 //**************************************************************************
 //  CONSTANTS
@@ -37,6 +39,13 @@
 #define PSXCPU_IRQ4 ( 4 )
 #define PSXCPU_IRQ5 ( 5 )
 
+// recompiler options
+
+#define PSXDRC_STRICT_VERIFY ( 0x0001 ) // verify all instructions
+#define PSXDRC_COMPARE_INTERPRETER ( 0x0002 ) // check each recompiled instruction against the interpreter
+
+#define PSXDRC_COMPATIBLE_OPTIONS ( PSXDRC_STRICT_VERIFY )
+
 // register enumeration
 
 enum
@@ -133,6 +142,8 @@ enum
 //  TYPE DEFINITIONS
 //**************************************************************************
 
+class psx_frontend;
+
 class psxcpu_state
 {
 public:
@@ -149,6 +160,8 @@ public:
 class psxcpu_device : public cpu_device,
 	psxcpu_state
 {
+	friend class psx_frontend;
+
 public:
 	// construction/destruction
 	psxcpu_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock);
@@ -197,12 +210,19 @@ public:
 
 	static psxcpu_device *getcpu( device_t &device, const char *cputag );
 
+	// recompiler interfaces
+	void psxdrc_set_options( UINT32 options );
+	void func_execute_one();
+	void func_compare_begin();
+	void func_compare_end();
+
 protected:
 	psxcpu_device(const machine_config &mconfig, device_type type, const char *name, const char *tag, device_t *owner, UINT32 clock, const char *shortname, const char *source);
 
 	// device-level overrides
 	virtual void device_start();
 	virtual void device_reset();
+	virtual void device_stop();
 	virtual void device_post_load();
 	virtual machine_config_constructor device_mconfig_additions() const;
 
@@ -336,6 +356,68 @@ protected:
 	UINT32 getcp3cr( int reg );
 	void setcp3cr( int reg, UINT32 value );
 
+	void execute_one();
+
+	// recompiler state
+	struct compiler_state
+	{
+		UINT32 cycles; // accumulated cycles
+		UINT8 pipeline; // what is known about the delay pipeline
+		uml::code_label labelnum; // index for local labels
+		uml::code_label redispatch; // shared exit for a changed pc
+	};
+
+	struct drc_compare_state
+	{
+		UINT32 pc;
+		UINT32 op;
+		UINT32 delayr;
+		UINT32 delayv;
+		UINT32 hi;
+		UINT32 lo;
+		UINT32 r[ 32 ];
+		UINT32 cp0r[ 16 ];
+		UINT32 berr;
+		int bus_attached;
+		UINT32 bad_byte_address_mask;
+		UINT32 bad_half_address_mask;
+		UINT32 bad_word_address_mask;
+	};
+
+	bool m_isdrc;
+	drc_cache *m_cache;
+	drcuml_state *m_drcuml;
+	psx_frontend *m_drcfe;
+	UINT32 m_drcoptions;
+	UINT8 m_cache_dirty;
+	uml::code_handle *m_entry;
+	uml::code_handle *m_nocode;
+	uml::code_handle *m_out_of_cycles;
+	drc_compare_state m_drc_before;
+	drc_compare_state m_drc_expected;
+	UINT32 m_drc_compares;
+	UINT32 m_drc_mismatches;
+
+	void psxdrc_init();
+	void psxdrc_exit();
+	void execute_run_drc();
+	void code_flush_cache();
+	void code_compile_block( UINT8 mode, offs_t pc );
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+	void generate_update_cycles( drcuml_block *block, compiler_state *compiler );
+	void generate_checksum_block( drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast );
+	void generate_sequence_instruction( drcuml_block *block, compiler_state *compiler, const opcode_desc *desc );
+	void generate_interpret( drcuml_block *block, compiler_state *compiler, const opcode_desc *desc );
+	void generate_advance_pc( drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, uml::code_label slow );
+	int generate_opcode( drcuml_block *block, compiler_state *compiler, const opcode_desc *desc );
+	void generate_branch( drcuml_block *block, compiler_state *compiler, const opcode_desc *desc );
+	void generate_delay_slot( drcuml_block *block, compiler_state *compiler, const opcode_desc *desc );
+	void save_compare_state( drc_compare_state &state );
+	void load_compare_state( const drc_compare_state &state );
+	void compare_register( const char *name, UINT32 expected, UINT32 actual );
+
 	gte m_gte;
 
 	devcb_read32 m_gpu_read_handler;
@@ -0,0 +1,1193 @@
+/***************************************************************************
+
+    psxdrc.c
+
+    Universal machine language-based PlayStation CPU emulator.
+
+    ALU instructions and branches are generated natively, with the load
+    and branch delay slots tracked exactly as the interpreter does.
+    Everything else, including loads, stores and the GTE, is stepped
+    through the interpreter's execute_one().
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "debugger.h"
+#include "psx.h"
+#include "psxfe.h"
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
+#include "cpu/drcumlsh.h"
+
+using namespace uml;
+
+
+/***************************************************************************
+    DEBUGGING
+***************************************************************************/
+
+#define SINGLE_INSTRUCTION_MODE         (0)
+#define COMPARE_WITH_INTERPRETER        (0)
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* size of the execution code cache */
+#define CACHE_SIZE                      (16 * 1024 * 1024)
+
+/* compilation boundaries -- how far back/forward does the analysis extend? */
+#define COMPILE_BACKWARDS_BYTES         128
+#define COMPILE_FORWARDS_BYTES          512
+#define COMPILE_MAX_SEQUENCE            64
+
+/* exit codes */
+#define EXECUTE_OUT_OF_CYCLES           0
+#define EXECUTE_MISSING_CODE            1
+#define EXECUTE_UNMAPPED_CODE           2
+#define EXECUTE_INTERPRET               4
+
+/* what is known about the delay pipeline when an instruction starts */
+#define PIPELINE_UNKNOWN                0           /* a load may be pending */
+#define PIPELINE_CLEAR                  1           /* nothing is pending */
+#define PIPELINE_TAKEN                  2           /* in the delay slot of a taken branch */
+#define PIPELINE_NOT_TAKEN              3           /* in the delay slot of a branch not taken */
+
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+#define R32(reg)                        ((reg) == 0 ? parameter((UINT64)0) : mem(&m_r[reg]))
+
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    alloc_handle - allocate a handle if not
+    already allocated
+-------------------------------------------------*/
+
+INLINE void alloc_handle(drcuml_state *drcuml, code_handle **handleptr, const char *name)
+{
+	if (*handleptr == NULL)
+		*handleptr = drcuml->handle_alloc(name);
+}
+
+
+/*-------------------------------------------------
+    is_native_branch - return true if a branch
+    is generated inline rather than interpreted
+-------------------------------------------------*/
+
+INLINE int is_native_branch(UINT32 op)
+{
+	/* coprocessor branches depend on the CU bits and are interpreted */
+	switch (INS_OP(op))
+	{
+		case OP_SPECIAL:
+		case OP_REGIMM:
+		case OP_J:
+		case OP_JAL:
+		case OP_BEQ:
+		case OP_BNE:
+		case OP_BLEZ:
+		case OP_BGTZ:
+			return TRUE;
+	}
+	return FALSE;
+}
+
+
+/*-------------------------------------------------
+    cfunc_execute_one - C wrapper for
+    func_execute_one
+-------------------------------------------------*/
+
+static void cfunc_execute_one(void *param)
+{
+	((psxcpu_device *)param)->func_execute_one();
+}
+
+
+/*-------------------------------------------------
+    cfunc_compare_begin - C wrapper for
+    func_compare_begin
+-------------------------------------------------*/
+
+static void cfunc_compare_begin(void *param)
+{
+	((psxcpu_device *)param)->func_compare_begin();
+}
+
+
+/*-------------------------------------------------
+    cfunc_compare_end - C wrapper for
+    func_compare_end
+-------------------------------------------------*/
+
+static void cfunc_compare_end(void *param)
+{
+	((psxcpu_device *)param)->func_compare_end();
+}
+
+
+
+/***************************************************************************
+    CORE CALLBACKS
+***************************************************************************/
+
+/*-------------------------------------------------
+    psxdrc_init - initialize the recompiler
+-------------------------------------------------*/
+
+void psxcpu_device::psxdrc_init()
+{
+	/* allocate enough space for the cache and the core */
+	m_cache = auto_alloc(machine(), drc_cache(CACHE_SIZE));
+
+	/* initialize the UML generator */
+	m_drcuml = auto_alloc(machine(), drcuml_state(*this, *m_cache, 0, 1, 32, 2));
+
+	/* add symbols for our stuff */
+	m_drcuml->symbol_add(&m_pc, sizeof(m_pc), "pc");
+	m_drcuml->symbol_add(&m_icount, sizeof(m_icount), "icount");
+	for (int regnum = 0; regnum < 32; regnum++)
+	{
+		char buf[10];
+		sprintf(buf, "r%d", regnum);
+		m_drcuml->symbol_add(&m_r[regnum], sizeof(m_r[regnum]), buf);
+	}
+	m_drcuml->symbol_add(&m_hi, sizeof(m_hi), "hi");
+	m_drcuml->symbol_add(&m_lo, sizeof(m_lo), "lo");
+	m_drcuml->symbol_add(&m_delayr, sizeof(m_delayr), "delayr");
+	m_drcuml->symbol_add(&m_delayv, sizeof(m_delayv), "delayv");
+
+	/* initialize the front-end helper */
+	m_drcfe = auto_alloc(machine(), psx_frontend(*this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE));
+
+	/* verify every instruction of a block by default */
+	m_drcoptions = PSXDRC_COMPATIBLE_OPTIONS;
+	if (COMPARE_WITH_INTERPRETER)
+		m_drcoptions |= PSXDRC_COMPARE_INTERPRETER;
+	m_drc_compares = 0;
+	m_drc_mismatches = 0;
+
+	/* mark the cache dirty so it is updated on next execute */
+	m_cache_dirty = TRUE;
+}
+
+
+/*-------------------------------------------------
+    psxdrc_exit - clean up the recompiler
+-------------------------------------------------*/
+
+void psxcpu_device::psxdrc_exit()
+{
+	if (m_drcoptions & PSXDRC_COMPARE_INTERPRETER)
+		osd_printf_info("%s: %u instructions compared with the interpreter, %u mismatches\n", tag(), m_drc_compares, m_drc_mismatches);
+
+	/* clean up the DRC */
+	auto_free(machine(), m_drcfe);
+	auto_free(machine(), m_drcuml);
+	auto_free(machine(), m_cache);
+}
+
+
+/*-------------------------------------------------
+    psxdrc_set_options - configure DRC options
+-------------------------------------------------*/
+
+void psxcpu_device::psxdrc_set_options(UINT32 options)
+{
+	m_drcoptions = options;
+	m_cache_dirty = TRUE;
+}
+
+
+/*-------------------------------------------------
+    execute_run_drc - execute the CPU for the
+    specified number of cycles
+-------------------------------------------------*/
+
+void psxcpu_device::execute_run_drc()
+{
+	int execute_result;
+
+	/* reset the cache if dirty */
+	if (m_cache_dirty)
+		code_flush_cache();
+	m_cache_dirty = FALSE;
+
+	/* execute */
+	do
+	{
+		/* blocks never start inside a branch delay slot; step those */
+		if (m_delayr == PSXCPU_DELAYR_PC || m_delayr == PSXCPU_DELAYR_NOTPC)
+			execute_result = EXECUTE_INTERPRET;
+
+		/* run as much as we can */
+		else
+			execute_result = m_drcuml->execute(*m_entry);
+
+		/* if we need to recompile, do it */
+		if (execute_result == EXECUTE_MISSING_CODE)
+			code_compile_block(0, m_pc);
+		else if (execute_result == EXECUTE_UNMAPPED_CODE)
+			fatalerror("Attempted to execute unmapped code at PC=%08X\n", m_pc);
+
+		/* code we couldn't compile is stepped through the interpreter */
+		else if (execute_result == EXECUTE_INTERPRET)
+		{
+			debugger_instruction_hook(this, m_pc);
+			execute_one();
+			m_icount--;
+			if (m_icount <= 0)
+				execute_result = EXECUTE_OUT_OF_CYCLES;
+		}
+
+	} while (execute_result != EXECUTE_OUT_OF_CYCLES);
+}
+
+
+
+/***************************************************************************
+    CACHE MANAGEMENT
+***************************************************************************/
+
+/*-------------------------------------------------
+    code_flush_cache - flush the cache and
+    regenerate static code
+-------------------------------------------------*/
+
+void psxcpu_device::code_flush_cache()
+{
+	/* empty the transient cache contents */
+	m_drcuml->reset();
+
+	try
+	{
+		/* generate the entry point and out-of-cycles handlers */
+		static_generate_entry_point();
+		static_generate_nocode_handler();
+		static_generate_out_of_cycles();
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unrecoverable error generating static code\n");
+	}
+}
+
+
+/*-------------------------------------------------
+    code_compile_block - compile a block of the
+    given mode at the specified pc
+-------------------------------------------------*/
+
+void psxcpu_device::code_compile_block(UINT8 mode, offs_t pc)
+{
+	compiler_state compiler = { 0 };
+	const opcode_desc *seqlast;
+	int override = FALSE;
+
+	g_profiler.start(PROFILER_DRC_COMPILE);
+
+	/* get a description of this sequence */
+	const opcode_desc *desclist = m_drcfe->describe_code(pc);
+
+	/* if we get an error back, flush the cache and try again */
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			/* start the block */
+			drcuml_block *block = m_drcuml->begin_block(4096);
+
+			/* every instruction may leave through the same redispatch path */
+			compiler.labelnum = 1;
+			compiler.redispatch = compiler.labelnum++;
+
+			/* loop until we get through all instruction sequences */
+			for (const opcode_desc *seqhead = desclist; seqhead != NULL; seqhead = seqlast->next())
+			{
+				const opcode_desc *curdesc;
+				UINT32 nextpc;
+
+				/* add a code log entry */
+				if (m_drcuml->logging())
+					block->append_comment("-------------------------");                     // comment
+
+				/* determine the last instruction in this sequence */
+				for (seqlast = seqhead; seqlast != NULL; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != NULL);
+
+				/* if we don't have a hash for this mode/pc, or if we are overriding all, add one */
+				if (override || !m_drcuml->hash_exists(mode, seqhead->pc))
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+
+				/* if we already have a hash, and this is the first sequence, assume that we */
+				/* are recompiling due to being out of sync and allow future overrides */
+				else if (seqhead == desclist)
+				{
+					override = TRUE;
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+				}
+
+				/* otherwise, redispatch to that fixed PC and skip the rest of the processing */
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+					UML_HASHJMP(block, 0, seqhead->pc, *m_nocode);                          // hashjmp <mode>,seqhead->pc,nocode
+					continue;
+				}
+
+				/* nothing is known about a pending load at the start of a sequence */
+				compiler.cycles = 0;
+				compiler.pipeline = PIPELINE_UNKNOWN;
+
+				/* validate this code block if we're not pointing into ROM */
+				if (m_program->get_write_ptr(seqhead->physpc) != NULL)
+					generate_checksum_block(block, &compiler, seqhead, seqlast);
+
+				/* label this instruction, if it may be jumped to locally */
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+
+				/* iterate over instructions in the sequence and compile them */
+				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+					generate_sequence_instruction(block, &compiler, curdesc);
+
+				/* branches and code handed to the interpreter have already left */
+				if (seqlast->flags & (OPFLAG_IS_BRANCH | OPFLAG_COMPILER_PAGE_FAULT))
+					continue;
+
+				/* if we need to return to the start, do it */
+				if (seqlast->flags & OPFLAG_RETURN_TO_START)
+					nextpc = pc;
+
+				/* otherwise we just go to the next instruction */
+				else
+					nextpc = seqlast->pc + seqlast->length;
+
+				/* count off cycles and go there */
+				generate_update_cycles(block, &compiler);                                   // <subtract cycles>
+				UML_CMP(block, mem(&m_icount), 0);                                          // cmp     icount,0
+				UML_EXHc(block, COND_LE, *m_out_of_cycles, nextpc);                         // exhle   out_of_cycles,nextpc
+				if (seqlast->next() == NULL || seqlast->next()->pc != nextpc)
+					UML_HASHJMP(block, 0, nextpc, *m_nocode);                               // hashjmp <mode>,nextpc,nocode
+			}
+
+			/* an instruction changed the PC; code in a delay slot is stepped */
+			UML_LABEL(block, compiler.redispatch);                                          // redispatch:
+			UML_CMP(block, mem(&m_icount), 0);                                              // cmp     icount,0
+			UML_EXHc(block, COND_LE, *m_out_of_cycles, mem(&m_pc));                         // exhle   out_of_cycles,[pc]
+			UML_CMP(block, mem(&m_delayr), PSXCPU_DELAYR_PC);                               // cmp     [delayr],PSXCPU_DELAYR_PC
+			UML_EXITc(block, COND_AE, EXECUTE_INTERPRET);                                   // exitae  EXECUTE_INTERPRET
+			UML_HASHJMP(block, 0, mem(&m_pc), *m_nocode);                                   // hashjmp <mode>,[pc],nocode
+
+			/* end the sequence */
+			block->end();
+			g_profiler.stop();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			code_flush_cache();
+		}
+	}
+}
+
+
+
+/***************************************************************************
+    C FUNCTION CALLBACKS
+***************************************************************************/
+
+/*-------------------------------------------------
+    func_execute_one - step one instruction with
+    the interpreter
+-------------------------------------------------*/
+
+void psxcpu_device::func_execute_one()
+{
+	execute_one();
+}
+
+
+/*-------------------------------------------------
+    save_compare_state - snapshot everything a
+    natively generated instruction can touch
+-------------------------------------------------*/
+
+void psxcpu_device::save_compare_state(drc_compare_state &state)
+{
+	state.pc = m_pc;
+	state.op = m_op;
+	state.delayr = m_delayr;
+	state.delayv = m_delayv;
+	state.hi = m_hi;
+	state.lo = m_lo;
+	memcpy(state.r, m_r, sizeof(state.r));
+	memcpy(state.cp0r, m_cp0r, sizeof(state.cp0r));
+	state.berr = m_berr;
+	state.bus_attached = m_bus_attached;
+	state.bad_byte_address_mask = m_bad_byte_address_mask;
+	state.bad_half_address_mask = m_bad_half_address_mask;
+	state.bad_word_address_mask = m_bad_word_address_mask;
+}
+
+
+/*-------------------------------------------------
+    load_compare_state - restore a snapshot
+-------------------------------------------------*/
+
+void psxcpu_device::load_compare_state(const drc_compare_state &state)
+{
+	m_pc = state.pc;
+	m_op = state.op;
+	m_delayr = state.delayr;
+	m_delayv = state.delayv;
+	m_hi = state.hi;
+	m_lo = state.lo;
+	memcpy(m_r, state.r, sizeof(m_r));
+	memcpy(m_cp0r, state.cp0r, sizeof(m_cp0r));
+	m_berr = state.berr;
+	m_bus_attached = state.bus_attached;
+	m_bad_byte_address_mask = state.bad_byte_address_mask;
+	m_bad_half_address_mask = state.bad_half_address_mask;
+	m_bad_word_address_mask = state.bad_word_address_mask;
+}
+
+
+/*-------------------------------------------------
+    func_compare_begin - run the interpreter over
+    the next instruction to get the expected
+    result, then put the state back
+-------------------------------------------------*/
+
+void psxcpu_device::func_compare_begin()
+{
+	save_compare_state(m_drc_before);
+	execute_one();
+	save_compare_state(m_drc_expected);
+	load_compare_state(m_drc_before);
+
+	/* an overflow or address exception rewrites the status register, which remaps memory */
+	if (memcmp(m_drc_before.cp0r, m_drc_expected.cp0r, sizeof(m_cp0r)) != 0)
+		update_memory_handlers();
+}
+
+
+/*-------------------------------------------------
+    compare_register - check one register against
+    the interpreter's result
+-------------------------------------------------*/
+
+void psxcpu_device::compare_register(const char *name, UINT32 expected, UINT32 actual)
+{
+	if (expected != actual)
+	{
+		logerror("%08x: %08x DRC/interpreter mismatch in %s: expected %08x, got %08x\n", m_drc_before.pc, m_drc_before.op, name, expected, actual);
+		m_drc_mismatches++;
+	}
+}
+
+
+/*-------------------------------------------------
+    func_compare_end - check the state left by the
+    generated code against the interpreter's
+-------------------------------------------------*/
+
+void psxcpu_device::func_compare_end()
+{
+	UINT32 mismatches = m_drc_mismatches;
+
+	compare_register("pc", m_drc_expected.pc, m_pc);
+	compare_register("delayr", m_drc_expected.delayr, m_delayr);
+	compare_register("delayv", m_drc_expected.delayv, m_delayv);
+	compare_register("hi", m_drc_expected.hi, m_hi);
+	compare_register("lo", m_drc_expected.lo, m_lo);
+	for (int regnum = 0; regnum < 32; regnum++)
+	{
+		char buf[10];
+		sprintf(buf, "r%d", regnum);
+		compare_register(buf, m_drc_expected.r[regnum], m_r[regnum]);
+	}
+	for (int regnum = 0; regnum < 16; regnum++)
+	{
+		char buf[10];
+		sprintf(buf, "cp0r%d", regnum);
+		compare_register(buf, m_drc_expected.cp0r[regnum], m_cp0r[regnum]);
+	}
+	m_drc_compares++;
+
+	/* carry on from the interpreter's result so one bug is reported once */
+	if (m_drc_mismatches != mismatches)
+		load_compare_state(m_drc_expected);
+}
+
+
+
+/***************************************************************************
+    STATIC CODEGEN
+***************************************************************************/
+
+/*-------------------------------------------------
+    static_generate_entry_point - generate a
+    static entry point
+-------------------------------------------------*/
+
+void psxcpu_device::static_generate_entry_point()
+{
+	drcuml_block *block;
+
+	block = m_drcuml->begin_block(20);
+
+	/* forward references */
+	alloc_handle(m_drcuml, &m_nocode, "nocode");
+
+	alloc_handle(m_drcuml, &m_entry, "entry");
+	UML_HANDLE(block, *m_entry);                                                    // handle  entry
+
+	/* generate a hash jump via the current mode and PC */
+	UML_HASHJMP(block, 0, mem(&m_pc), *m_nocode);                                   // hashjmp <mode>,<pc>,nocode
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_nocode_handler - generate an
+    exception handler for "out of code"
+-------------------------------------------------*/
+
+void psxcpu_device::static_generate_nocode_handler()
+{
+	drcuml_block *block;
+
+	/* begin generating */
+	block = m_drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(m_drcuml, &m_nocode, "nocode");
+	UML_HANDLE(block, *m_nocode);                                                   // handle  nocode
+	UML_GETEXP(block, I0);                                                          // getexp  i0
+	UML_MOV(block, mem(&m_pc), I0);                                                 // mov     [pc],i0
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                          // exit    EXECUTE_MISSING_CODE
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_out_of_cycles - generate an
+    out of cycles exception handler
+-------------------------------------------------*/
+
+void psxcpu_device::static_generate_out_of_cycles()
+{
+	drcuml_block *block;
+
+	/* begin generating */
+	block = m_drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(m_drcuml, &m_out_of_cycles, "out_of_cycles");
+	UML_HANDLE(block, *m_out_of_cycles);                                            // handle  out_of_cycles
+	UML_GETEXP(block, I0);                                                          // getexp  i0
+	UML_MOV(block, mem(&m_pc), I0);                                                 // mov     [pc],i0
+	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                                         // exit    EXECUTE_OUT_OF_CYCLES
+
+	block->end();
+}
+
+
+
+/***************************************************************************
+    CODE GENERATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    generate_update_cycles - subtract the cycles
+    accumulated so far from the icount
+-------------------------------------------------*/
+
+void psxcpu_device::generate_update_cycles(drcuml_block *block, compiler_state *compiler)
+{
+	if (compiler->cycles != 0)
+	{
+		UML_SUB(block, mem(&m_icount), mem(&m_icount), compiler->cycles);           // sub     icount,icount,cycles
+		compiler->cycles = 0;
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_checksum_block - generate code to
+    validate a sequence of opcodes
+-------------------------------------------------*/
+
+void psxcpu_device::generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast)
+{
+	const opcode_desc *curdesc;
+	UINT32 sum = 0;
+	int loaded = FALSE;
+
+	if (m_drcuml->logging())
+		block->append_comment("[Validation for %08X]", seqhead->pc);                // comment
+
+	/* loose verify covers the head and its delay slot; strict verify sums everything */
+	const opcode_desc *last = (m_drcoptions & PSXDRC_STRICT_VERIFY) ? seqlast : seqhead;
+	for (curdesc = seqhead; curdesc != last->next(); curdesc = curdesc->next())
+	{
+		const opcode_desc *delay = curdesc->delay.first();
+
+		for (int slot = 0; slot < 2; slot++)
+		{
+			const opcode_desc *desc = (slot == 0) ? curdesc : delay;
+
+			/* delay slots are summed where they don't also appear in the sequence */
+			if (slot == 1 && (delay == NULL || (curdesc != last && curdesc->next() != NULL && curdesc->next()->physpc == delay->physpc)))
+				break;
+			if (desc->flags & OPFLAG_VIRTUAL_NOOP)
+				continue;
+
+			void *base = m_direct->read_decrypted_ptr(desc->physpc);
+			assert(base != NULL);
+			UML_LOAD(block, loaded ? I1 : I0, base, 0, SIZE_DWORD, SCALE_x4);       // load    i1,base,dword
+			if (loaded)
+				UML_ADD(block, I0, I0, I1);                                         // add     i0,i0,i1
+			sum += desc->opptr.l[0];
+			loaded = TRUE;
+		}
+	}
+
+	if (loaded)
+	{
+		UML_CMP(block, I0, sum);                                                    // cmp     i0,sum
+		UML_EXHc(block, COND_NE, *m_nocode, seqhead->pc);                           // exne    nocode,seqhead->pc
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_sequence_instruction - generate code
+    for a single instruction in a sequence
+-------------------------------------------------*/
+
+void psxcpu_device::generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	/* code that couldn't be fetched is stepped by the interpreter, which raises the exception */
+	if (desc->flags & OPFLAG_COMPILER_PAGE_FAULT)
+	{
+		UML_MOV(block, mem(&m_pc), desc->pc);                                       // mov     [pc],desc->pc
+		generate_update_cycles(block, compiler);                                    // <subtract cycles>
+		UML_EXIT(block, EXECUTE_INTERPRET);                                         // exit    EXECUTE_INTERPRET
+		return;
+	}
+
+	/* if we are debugging, call the debugger */
+	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+	{
+		UML_MOV(block, mem(&m_pc), desc->pc);                                       // mov     [pc],desc->pc
+		generate_update_cycles(block, compiler);                                    // <subtract cycles>
+		UML_DEBUG(block, desc->pc);                                                 // debug   desc->pc
+	}
+
+	/* branches generate their delay slot too */
+	if (desc->flags & OPFLAG_IS_BRANCH)
+	{
+		generate_branch(block, compiler, desc);
+		return;
+	}
+
+	/* anything else we can't do natively is interpreted, leaving if the PC moved */
+	if (!generate_opcode(block, compiler, desc))
+	{
+		generate_interpret(block, compiler, desc);
+		UML_CMP(block, mem(&m_pc), desc->pc + 4);                                   // cmp     [pc],desc->pc + 4
+		UML_JMPc(block, COND_NE, compiler->redispatch);                             // jmpne   redispatch
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_interpret - generate a call to the
+    interpreter for a single instruction
+-------------------------------------------------*/
+
+void psxcpu_device::generate_interpret(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	UML_MOV(block, mem(&m_pc), desc->pc);                                           // mov     [pc],desc->pc
+	generate_update_cycles(block, compiler);                                        // <subtract cycles>
+	UML_CALLC(block, cfunc_execute_one, this);                                      // callc   cfunc_execute_one,this
+	UML_SUB(block, mem(&m_icount), mem(&m_icount), 1);                              // sub     icount,icount,1
+
+	/* the instruction may have loaded a register */
+	compiler->pipeline = PIPELINE_UNKNOWN;
+}
+
+
+/*-------------------------------------------------
+    generate_advance_pc - generate the pipeline
+    update the interpreter's advance_pc() makes,
+    jumping to 'slow' where it would raise an
+    exception
+-------------------------------------------------*/
+
+void psxcpu_device::generate_advance_pc(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, code_label slow)
+{
+	switch (compiler->pipeline)
+	{
+		/* commit any pending load; loads into r0 are discarded */
+		case PIPELINE_UNKNOWN:
+			UML_MOV(block, I1, mem(&m_delayr));                                     // mov     i1,[delayr]
+			UML_STORE(block, m_r, I1, mem(&m_delayv), SIZE_DWORD, SCALE_x4);        // store   r,i1,[delayv],dword
+			UML_MOV(block, mem(&m_r[0]), 0);                                        // mov     [r0],0
+			UML_CMP(block, I1, 0);                                                  // cmp     i1,0
+			UML_MOVc(block, COND_NE, mem(&m_delayv), 0);                            // movne   [delayv],0
+			UML_MOV(block, mem(&m_delayr), 0);                                      // mov     [delayr],0
+			break;
+
+		/* jump to the branch target, which faults if misaligned or out of bounds */
+		case PIPELINE_TAKEN:
+			if (desc->branch->targetpc != BRANCH_TARGET_DYNAMIC)
+			{
+				UML_TEST(block, mem(&m_bad_word_address_mask), desc->branch->targetpc); // test    [bad_word_address_mask],targetpc
+				UML_JMPc(block, COND_NZ, slow);                                     // jmpnz   slow
+				UML_MOV(block, mem(&m_pc), desc->branch->targetpc);                 // mov     [pc],targetpc
+			}
+			else
+			{
+				UML_MOV(block, I1, mem(&m_delayv));                                 // mov     i1,[delayv]
+				UML_TEST(block, I1, mem(&m_bad_word_address_mask));                 // test    i1,[bad_word_address_mask]
+				UML_JMPc(block, COND_NZ, slow);                                     // jmpnz   slow
+				UML_MOV(block, mem(&m_pc), I1);                                     // mov     [pc],i1
+			}
+			UML_MOV(block, mem(&m_delayr), 0);                                      // mov     [delayr],0
+			UML_MOV(block, mem(&m_delayv), 0);                                      // mov     [delayv],0
+			break;
+
+		case PIPELINE_NOT_TAKEN:
+			UML_MOV(block, mem(&m_delayr), 0);                                      // mov     [delayr],0
+			UML_MOV(block, mem(&m_delayv), 0);                                      // mov     [delayv],0
+			break;
+	}
+
+	compiler->pipeline = PIPELINE_CLEAR;
+}
+
+
+/*-------------------------------------------------
+    generate_opcode - generate code for an ALU
+    instruction; returns FALSE for anything that
+    must be interpreted
+-------------------------------------------------*/
+
+int psxcpu_device::generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	UINT32 op = desc->opptr.l[0];
+	UINT8 rs = INS_RS(op);
+	UINT8 rt = INS_RT(op);
+	UINT32 simm = PSXCPU_WORD_EXTEND(INS_IMMEDIATE(op));
+	UINT32 uimm = INS_IMMEDIATE(op);
+	int overflow = FALSE;
+	UINT8 dst;
+
+	/* decide before emitting anything */
+	switch (INS_OP(op))
+	{
+		case OP_SPECIAL:
+			switch (INS_FUNCT(op))
+			{
+				case FUNCT_ADD:
+				case FUNCT_SUB:
+					overflow = TRUE;
+					/* fall through */
+				case FUNCT_SLL:     case FUNCT_SRL:     case FUNCT_SRA:
+				case FUNCT_SLLV:    case FUNCT_SRLV:    case FUNCT_SRAV:
+				case FUNCT_ADDU:    case FUNCT_SUBU:
+				case FUNCT_AND:     case FUNCT_OR:      case FUNCT_XOR:     case FUNCT_NOR:
+				case FUNCT_SLT:     case FUNCT_SLTU:
+					dst = INS_RD(op);
+					break;
+
+				default:
+					return FALSE;
+			}
+			break;
+
+		case OP_ADDI:
+			overflow = TRUE;
+			/* fall through */
+		case OP_ADDIU:  case OP_SLTI:   case OP_SLTIU:
+		case OP_ANDI:   case OP_ORI:    case OP_XORI:   case OP_LUI:
+			dst = rt;
+			break;
+
+		default:
+			return FALSE;
+	}
+
+	/* overflow and a bad branch target are left to the interpreter */
+	int taken = (compiler->pipeline == PIPELINE_TAKEN);
+	int hasslow = (overflow || taken);
+	code_label slow = hasslow ? compiler->labelnum++ : 0;
+	UINT32 cycles = compiler->cycles;
+
+	if (m_drcoptions & PSXDRC_COMPARE_INTERPRETER)
+	{
+		UML_MOV(block, mem(&m_pc), desc->pc);                                       // mov     [pc],desc->pc
+		UML_CALLC(block, cfunc_compare_begin, this);                                // callc   cfunc_compare_begin,this
+	}
+
+	/* operands are read before the pipeline advances */
+	if (dst != 0 || overflow)
+	{
+		switch (INS_OP(op))
+		{
+			case OP_SPECIAL:
+				switch (INS_FUNCT(op))
+				{
+					case FUNCT_SLL:
+						UML_SHL(block, I0, R32(rt), INS_SHAMT(op));                 // shl     i0,<rt>,shamt
+						break;
+
+					case FUNCT_SRL:
+						UML_SHR(block, I0, R32(rt), INS_SHAMT(op));                 // shr     i0,<rt>,shamt
+						break;
+
+					case FUNCT_SRA:
+						UML_SAR(block, I0, R32(rt), INS_SHAMT(op));                 // sar     i0,<rt>,shamt
+						break;
+
+					case FUNCT_SLLV:
+						UML_AND(block, I1, R32(rs), 31);                            // and     i1,<rs>,31
+						UML_SHL(block, I0, R32(rt), I1);                            // shl     i0,<rt>,i1
+						break;
+
+					case FUNCT_SRLV:
+						UML_AND(block, I1, R32(rs), 31);                            // and     i1,<rs>,31
+						UML_SHR(block, I0, R32(rt), I1);                            // shr     i0,<rt>,i1
+						break;
+
+					case FUNCT_SRAV:
+						UML_AND(block, I1, R32(rs), 31);                            // and     i1,<rs>,31
+						UML_SAR(block, I0, R32(rt), I1);                            // sar     i0,<rt>,i1
+						break;
+
+					case FUNCT_ADD:
+						UML_ADD(block, I0, R32(rs), R32(rt));                       // add     i0,<rs>,<rt>
+						UML_JMPc(block, COND_V, slow);                              // jmpv    slow
+						break;
+
+					case FUNCT_ADDU:
+						UML_ADD(block, I0, R32(rs), R32(rt));                       // add     i0,<rs>,<rt>
+						break;
+
+					case FUNCT_SUB:
+						UML_SUB(block, I0, R32(rs), R32(rt));                       // sub     i0,<rs>,<rt>
+						UML_JMPc(block, COND_V, slow);                              // jmpv    slow
+						break;
+
+					case FUNCT_SUBU:
+						UML_SUB(block, I0, R32(rs), R32(rt));                       // sub     i0,<rs>,<rt>
+						break;
+
+					case FUNCT_AND:
+						UML_AND(block, I0, R32(rs), R32(rt));                       // and     i0,<rs>,<rt>
+						break;
+
+					case FUNCT_OR:
+						UML_OR(block, I0, R32(rs), R32(rt));                        // or      i0,<rs>,<rt>
+						break;
+
+					case FUNCT_XOR:
+						UML_XOR(block, I0, R32(rs), R32(rt));                       // xor     i0,<rs>,<rt>
+						break;
+
+					case FUNCT_NOR:
+						UML_OR(block, I0, R32(rs), R32(rt));                        // or      i0,<rs>,<rt>
+						UML_XOR(block, I0, I0, ~0);                                 // xor     i0,i0,~0
+						break;
+
+					case FUNCT_SLT:
+						UML_CMP(block, R32(rs), R32(rt));                           // cmp     <rs>,<rt>
+						UML_SETc(block, COND_L, I0);                                // setl    i0
+						break;
+
+					case FUNCT_SLTU:
+						UML_CMP(block, R32(rs), R32(rt));                           // cmp     <rs>,<rt>
+						UML_SETc(block, COND_B, I0);                                // setb    i0
+						break;
+				}
+				break;
+
+			case OP_ADDI:
+				UML_ADD(block, I0, R32(rs), simm);                                  // add     i0,<rs>,simm
+				UML_JMPc(block, COND_V, slow);                                      // jmpv    slow
+				break;
+
+			case OP_ADDIU:
+				UML_ADD(block, I0, R32(rs), simm);                                  // add     i0,<rs>,simm
+				break;
+
+			case OP_SLTI:
+				UML_CMP(block, R32(rs), simm);                                      // cmp     <rs>,simm
+				UML_SETc(block, COND_L, I0);                                        // setl    i0
+				break;
+
+			case OP_SLTIU:
+				UML_CMP(block, R32(rs), simm);                                      // cmp     <rs>,simm
+				UML_SETc(block, COND_B, I0);                                        // setb    i0
+				break;
+
+			case OP_ANDI:
+				UML_AND(block, I0, R32(rs), uimm);                                  // and     i0,<rs>,uimm
+				break;
+
+			case OP_ORI:
+				UML_OR(block, I0, R32(rs), uimm);                                   // or      i0,<rs>,uimm
+				break;
+
+			case OP_XORI:
+				UML_XOR(block, I0, R32(rs), uimm);                                  // xor     i0,<rs>,uimm
+				break;
+
+			case OP_LUI:
+				UML_MOV(block, I0, uimm << 16);                                     // mov     i0,uimm << 16
+				break;
+		}
+	}
+
+	/* the result lands after any pending load, as load() does */
+	generate_advance_pc(block, compiler, desc, slow);
+	if (dst != 0)
+		UML_MOV(block, mem(&m_r[dst]), I0);                                         // mov     <dst>,i0
+
+	if (m_drcoptions & PSXDRC_COMPARE_INTERPRETER)
+	{
+		if (!taken)
+			UML_MOV(block, mem(&m_pc), desc->pc + 4);                               // mov     [pc],desc->pc + 4
+		UML_CALLC(block, cfunc_compare_end, this);                                  // callc   cfunc_compare_end,this
+	}
+	compiler->cycles++;
+
+	/* faulting cases are stepped with the interpreter from the original state */
+	if (hasslow)
+	{
+		code_label skip = compiler->labelnum++;
+		UML_JMP(block, skip);                                                       // jmp     skip
+		UML_LABEL(block, slow);                                                     // slow:
+		UML_MOV(block, mem(&m_pc), desc->pc);                                       // mov     [pc],desc->pc
+		if (cycles != 0)
+			UML_SUB(block, mem(&m_icount), mem(&m_icount), cycles);                 // sub     icount,icount,cycles
+		UML_CALLC(block, cfunc_execute_one, this);                                  // callc   cfunc_execute_one,this
+		UML_SUB(block, mem(&m_icount), mem(&m_icount), 1);                          // sub     icount,icount,1
+		UML_JMP(block, compiler->redispatch);                                       // jmp     redispatch
+		UML_LABEL(block, skip);                                                     // skip:
+	}
+	return TRUE;
+}
+
+
+/*-------------------------------------------------
+    generate_branch - generate code for a branch
+    and its delay slot
+-------------------------------------------------*/
+
+void psxcpu_device::generate_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	UINT32 op = desc->opptr.l[0];
+	UINT8 rs = INS_RS(op);
+	UINT8 rt = INS_RT(op);
+	UINT8 link = 0;
+	int always = FALSE;
+
+	/* coprocessor branches are interpreted; the delay slot is then stepped too */
+	if (!is_native_branch(op))
+	{
+		generate_interpret(block, compiler, desc);
+		UML_JMP(block, compiler->redispatch);                                       // jmp     redispatch
+		return;
+	}
+
+	if (m_drcoptions & PSXDRC_COMPARE_INTERPRETER)
+	{
+		UML_MOV(block, mem(&m_pc), desc->pc);                                       // mov     [pc],desc->pc
+		UML_CALLC(block, cfunc_compare_begin, this);                                // callc   cfunc_compare_begin,this
+	}
+
+	/* the condition and target are evaluated before the pipeline advances */
+	switch (INS_OP(op))
+	{
+		case OP_SPECIAL:
+			UML_MOV(block, I2, R32(rs));                                            // mov     i2,<rs>
+			if (INS_FUNCT(op) == FUNCT_JALR)
+				link = INS_RD(op);
+			always = TRUE;
+			break;
+
+		case OP_REGIMM:
+			UML_CMP(block, R32(rs), 0);                                             // cmp     <rs>,0
+			UML_SETc(block, (INS_RT_REGIMM(op) == RT_BLTZ) ? COND_L : COND_GE, I3); // setl/setge i3
+			if (rt == RT_BLTZAL || rt == RT_BGEZAL)
+				link = 31;
+			break;
+
+		case OP_J:
+			always = TRUE;
+			break;
+
+		case OP_JAL:
+			link = 31;
+			always = TRUE;
+			break;
+
+		case OP_BEQ:
+			if (rs == rt)
+				always = TRUE;
+			else
+			{
+				UML_CMP(block, R32(rs), R32(rt));                                   // cmp     <rs>,<rt>
+				UML_SETc(block, COND_E, I3);                                        // sete    i3
+			}
+			break;
+
+		case OP_BNE:
+			UML_CMP(block, R32(rs), R32(rt));                                       // cmp     <rs>,<rt>
+			UML_SETc(block, COND_NE, I3);                                           // setne   i3
+			break;
+
+		case OP_BLEZ:
+			UML_CMP(block, R32(rs), 0);                                             // cmp     <rs>,0
+			UML_SETc(block, COND_L, I3);                                            // setl    i3
+			UML_CMP(block, R32(rs), R32(rt));                                       // cmp     <rs>,<rt>
+			UML_SETc(block, COND_E, I1);                                            // sete    i1
+			UML_OR(block, I3, I3, I1);                                              // or      i3,i3,i1
+			break;
+
+		case OP_BGTZ:
+			UML_CMP(block, R32(rs), 0);                                             // cmp     <rs>,0
+			UML_SETc(block, COND_GE, I3);                                           // setge   i3
+			UML_CMP(block, R32(rs), R32(rt));                                       // cmp     <rs>,<rt>
+			UML_SETc(block, COND_NE, I1);                                           // setne   i1
+			UML_AND(block, I3, I3, I1);                                             // and     i3,i3,i1
+			break;
+	}
+
+	/* the pipeline moves on, then the return address is written */
+	generate_advance_pc(block, compiler, desc, 0);
+	if (link != 0)
+		UML_MOV(block, mem(&m_r[link]), desc->pc + 8);                              // mov     <link>,desc->pc + 8
+	if (m_drcoptions & PSXDRC_COMPARE_INTERPRETER)
+		UML_MOV(block, mem(&m_pc), desc->pc + 4);                                   // mov     [pc],desc->pc + 4
+	compiler->cycles++;
+
+	code_label nottaken = 0;
+	if (!always)
+	{
+		nottaken = compiler->labelnum++;
+		UML_CMP(block, I3, 0);                                                      // cmp     i3,0
+		UML_JMPc(block, COND_E, nottaken);                                          // jmpe    nottaken
+	}
+
+	/* taken: the target is applied after the delay slot */
+	UML_MOV(block, mem(&m_delayr), PSXCPU_DELAYR_PC);                               // mov     [delayr],PSXCPU_DELAYR_PC
+	if (desc->targetpc != BRANCH_TARGET_DYNAMIC)
+		UML_MOV(block, mem(&m_delayv), desc->targetpc);                             // mov     [delayv],desc->targetpc
+	else
+		UML_MOV(block, mem(&m_delayv), I2);                                         // mov     [delayv],i2
+	if (m_drcoptions & PSXDRC_COMPARE_INTERPRETER)
+		UML_CALLC(block, cfunc_compare_end, this);                                  // callc   cfunc_compare_end,this
+
+	compiler_state compiler_temp = *compiler;
+	compiler_temp.pipeline = PIPELINE_TAKEN;
+	generate_delay_slot(block, &compiler_temp, desc);
+	compiler->labelnum = compiler_temp.labelnum;
+
+	/* not taken: the delay slot runs and execution carries on after it */
+	if (!always)
+	{
+		UML_LABEL(block, nottaken);                                                 // nottaken:
+		UML_MOV(block, mem(&m_delayr), PSXCPU_DELAYR_NOTPC);                        // mov     [delayr],PSXCPU_DELAYR_NOTPC
+		UML_MOV(block, mem(&m_delayv), 0);                                          // mov     [delayv],0
+		if (m_drcoptions & PSXDRC_COMPARE_INTERPRETER)
+			UML_CALLC(block, cfunc_compare_end, this);                              // callc   cfunc_compare_end,this
+
+		compiler_temp = *compiler;
+		compiler_temp.pipeline = PIPELINE_NOT_TAKEN;
+		generate_delay_slot(block, &compiler_temp, desc);
+		compiler->labelnum = compiler_temp.labelnum;
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_delay_slot - generate code for the
+    delay slot of a branch and leave the block
+-------------------------------------------------*/
+
+void psxcpu_device::generate_delay_slot(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	const opcode_desc *delay = desc->delay.first();
+	int taken = (compiler->pipeline == PIPELINE_TAKEN);
+	int dynamic = (taken && desc->targetpc == BRANCH_TARGET_DYNAMIC);
+	UINT32 nextpc = taken ? desc->targetpc : desc->pc + 8;
+
+	/* a delay slot that couldn't be fetched is stepped by the interpreter */
+	if (delay == NULL || (delay->flags & OPFLAG_COMPILER_PAGE_FAULT))
+	{
+		UML_MOV(block, mem(&m_pc), desc->pc + 4);                                   // mov     [pc],desc->pc + 4
+		generate_update_cycles(block, compiler);                                    // <subtract cycles>
+		UML_EXIT(block, EXECUTE_INTERPRET);                                         // exit    EXECUTE_INTERPRET
+		return;
+	}
+
+	/* if we are debugging, call the debugger */
+	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+	{
+		UML_MOV(block, mem(&m_pc), delay->pc);                                      // mov     [pc],delay->pc
+		generate_update_cycles(block, compiler);                                    // <subtract cycles>
+		UML_DEBUG(block, delay->pc);                                                // debug   delay->pc
+	}
+
+	/* a branch in a delay slot is interpreted, as is anything else we can't generate */
+	if ((delay->flags & OPFLAG_IS_BRANCH) || !generate_opcode(block, compiler, delay))
+	{
+		generate_interpret(block, compiler, delay);
+		if (dynamic || (delay->flags & OPFLAG_IS_BRANCH))
+		{
+			UML_JMP(block, compiler->redispatch);                                   // jmp     redispatch
+			return;
+		}
+		UML_CMP(block, mem(&m_pc), nextpc);                                         // cmp     [pc],nextpc
+		UML_JMPc(block, COND_NE, compiler->redispatch);                             // jmpne   redispatch
+	}
+
+	/* a register target is only known at runtime */
+	else if (dynamic)
+	{
+		generate_update_cycles(block, compiler);                                    // <subtract cycles>
+		UML_JMP(block, compiler->redispatch);                                       // jmp     redispatch
+		return;
+	}
+
+	/* count off cycles and go to the target */
+	generate_update_cycles(block, compiler);                                        // <subtract cycles>
+	UML_CMP(block, mem(&m_icount), 0);                                              // cmp     icount,0
+	UML_EXHc(block, COND_LE, *m_out_of_cycles, nextpc);                             // exhle   out_of_cycles,nextpc
+	UML_HASHJMP(block, 0, nextpc, *m_nocode);                                       // hashjmp <mode>,nextpc,nocode
+}
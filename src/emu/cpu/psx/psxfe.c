@@ -0,0 +1,224 @@
+/***************************************************************************
+
+    psxfe.c
+
+    Front-end for PlayStation CPU recompiler
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "psxfe.h"
+
+
+//**************************************************************************
+//  PSX FRONTEND
+//**************************************************************************
+
+//-------------------------------------------------
+//  psx_frontend - constructor
+//-------------------------------------------------
+
+psx_frontend::psx_frontend(psxcpu_device &psx, UINT32 window_start, UINT32 window_end, UINT32 max_sequence)
+	: drc_frontend(psx, window_start, window_end, max_sequence),
+		m_psx(psx)
+{
+}
+
+
+//-------------------------------------------------
+//  describe - build a description of a single
+//  instruction
+//-------------------------------------------------
+
+bool psx_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	// misaligned code, or code that can't be read directly, is left to the
+	// interpreter; this ends the sequence and is stepped one instruction
+	// at a time at runtime
+	if ((desc.pc & 3) != 0 || m_psx.m_direct->read_decrypted_ptr(desc.physpc) == NULL)
+	{
+		desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_COMPILER_PAGE_FAULT | OPFLAG_VIRTUAL_NOOP | OPFLAG_END_SEQUENCE;
+		return true;
+	}
+
+	// fetch the opcode
+	UINT32 op = desc.opptr.l[0] = m_psx.m_direct->read_decrypted_dword(desc.physpc);
+
+	// all instructions are 4 bytes and take 1 cycle; the multiplier keeps its own time
+	desc.length = 4;
+	desc.cycles = 1;
+
+	switch (INS_OP(op))
+	{
+		case OP_SPECIAL:
+			return describe_special(op, desc);
+
+		case OP_REGIMM:
+			// BLTZ/BGEZ and the linking forms; only bit 16 of rt is decoded
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = desc.pc + 4 + (PSXCPU_WORD_EXTEND(INS_IMMEDIATE(op)) << 2);
+			desc.delayslots = 1;
+			return true;
+
+		case OP_J:
+		case OP_JAL:
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = ((desc.pc + 4) & 0xf0000000) + (INS_TARGET(op) << 2);
+			desc.delayslots = 1;
+			return true;
+
+		case OP_BEQ:
+		case OP_BNE:
+		case OP_BLEZ:
+		case OP_BGTZ:
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = desc.pc + 4 + (PSXCPU_WORD_EXTEND(INS_IMMEDIATE(op)) << 2);
+			desc.delayslots = 1;
+			return true;
+
+		case OP_ADDI:
+			desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION;
+			return true;
+
+		case OP_ADDIU:
+		case OP_SLTI:
+		case OP_SLTIU:
+		case OP_ANDI:
+		case OP_ORI:
+		case OP_XORI:
+		case OP_LUI:
+			return true;
+
+		case OP_COP0:
+		case OP_COP1:
+		case OP_COP2:
+		case OP_COP3:
+			return describe_cop(op, desc);
+
+		case OP_LB:
+		case OP_LH:
+		case OP_LWL:
+		case OP_LW:
+		case OP_LBU:
+		case OP_LHU:
+		case OP_LWR:
+		case OP_LWC0:
+		case OP_LWC1:
+		case OP_LWC2:
+		case OP_LWC3:
+			desc.flags |= OPFLAG_READS_MEMORY | OPFLAG_CAN_CAUSE_EXCEPTION;
+			return true;
+
+		case OP_SB:
+		case OP_SH:
+		case OP_SWL:
+		case OP_SW:
+		case OP_SWR:
+		case OP_SWC0:
+		case OP_SWC1:
+		case OP_SWC2:
+		case OP_SWC3:
+			desc.flags |= OPFLAG_WRITES_MEMORY | OPFLAG_CAN_CAUSE_EXCEPTION;
+			return true;
+	}
+
+	return false;
+}
+
+
+//-------------------------------------------------
+//  describe_special - build a description of an
+//  instruction in the SPECIAL group
+//-------------------------------------------------
+
+bool psx_frontend::describe_special(UINT32 op, opcode_desc &desc)
+{
+	switch (INS_FUNCT(op))
+	{
+		case FUNCT_SLL:
+		case FUNCT_SRL:
+		case FUNCT_SRA:
+		case FUNCT_SLLV:
+		case FUNCT_SRLV:
+		case FUNCT_SRAV:
+		case FUNCT_ADDU:
+		case FUNCT_SUBU:
+		case FUNCT_AND:
+		case FUNCT_OR:
+		case FUNCT_XOR:
+		case FUNCT_NOR:
+		case FUNCT_SLT:
+		case FUNCT_SLTU:
+		case FUNCT_MFHI:
+		case FUNCT_MTHI:
+		case FUNCT_MFLO:
+		case FUNCT_MTLO:
+		case FUNCT_MULT:
+		case FUNCT_MULTU:
+		case FUNCT_DIV:
+		case FUNCT_DIVU:
+			return true;
+
+		case FUNCT_ADD:
+		case FUNCT_SUB:
+			desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION;
+			return true;
+
+		case FUNCT_JR:
+		case FUNCT_JALR:
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.delayslots = 1;
+			return true;
+
+		case FUNCT_SYSCALL:
+		case FUNCT_BREAK:
+			desc.flags |= OPFLAG_WILL_CAUSE_EXCEPTION | OPFLAG_END_SEQUENCE;
+			return true;
+	}
+
+	return false;
+}
+
+
+//-------------------------------------------------
+//  describe_cop - build a description of a
+//  coprocessor instruction
+//-------------------------------------------------
+
+bool psx_frontend::describe_cop(UINT32 op, opcode_desc &desc)
+{
+	// every coprocessor instruction can raise a coprocessor unusable or
+	// reserved instruction exception
+	desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION;
+
+	switch (INS_RS(op))
+	{
+		case RS_MFC:
+		case RS_CFC:
+			// COP1/COP3 reads return the next word of the instruction stream
+			if (INS_OP(op) == OP_COP1 || INS_OP(op) == OP_COP3)
+				desc.flags |= OPFLAG_READS_MEMORY;
+			return true;
+
+		case RS_MTC:
+			// status and cause writes can expose an interrupt
+			if (INS_OP(op) == OP_COP0)
+				desc.flags |= OPFLAG_CAN_EXPOSE_EXTERNAL_INT | OPFLAG_CAN_CHANGE_MODES;
+			return true;
+
+		case RS_BC:
+		case RS_BC_ALT:
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = desc.pc + 4 + (PSXCPU_WORD_EXTEND(INS_IMMEDIATE(op)) << 2);
+			desc.delayslots = 1;
+			return true;
+	}
+
+	// RFE restores the previous interrupt enable and mode
+	if (INS_OP(op) == OP_COP0 && INS_CO(op) && INS_CF(op) == CF_RFE)
+		desc.flags |= OPFLAG_CAN_EXPOSE_EXTERNAL_INT | OPFLAG_CAN_CHANGE_MODES;
+	return true;
+}
@@ -0,0 +1,46 @@
+/***************************************************************************
+
+    psxfe.h
+
+    Front-end for PlayStation CPU recompiler
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __PSXFE_H__
+#define __PSXFE_H__
+
+#include "psx.h"
+#include "cpu/drcfe.h"
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+class psx_frontend : public drc_frontend
+{
+public:
+	// construction/destruction
+	psx_frontend(psxcpu_device &psx, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
+
+protected:
+	// required overrides
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev);
+
+private:
+	// internal helpers
+	bool describe_special(UINT32 op, opcode_desc &desc);
+	bool describe_cop(UINT32 op, opcode_desc &desc);
+
+	// internal state
+	psxcpu_device &m_psx;
+};
+
+
+
+#endif /* __PSXFE_H__ */
@@ -103,6 +103,7 @@ rsp_device::rsp_device(const machine_config &mconfig, const char *tag, device_t
 	, m_drcuml(NULL)
 //  , m_drcuml(*this, m_cache, 0, 8, 32, 2)
 	, m_drcfe(NULL)
+	, m_drcpersist(NULL)
 	, m_drcoptions(0)
 	, m_cache_dirty(TRUE)
 	, m_numcycles(0)
@@ -411,6 +412,10 @@ void rsp_device::device_start()
 	/* initialize the front-end helper */
 	m_drcfe = auto_alloc(machine(), rsp_frontend(*this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE));
 
+	/* optionally record compiled blocks, and recompile those from a previous run */
+	if (m_isdrc && machine().options().drc_persist())
+		m_drcpersist = auto_alloc(machine(), drc_persistent_cache(*this, *m_drcfe, drc_compile_delegate(FUNC(rsp_device::code_compile_persisted_block), this), 0));
+
 	/* compute the register parameters */
 	for (int regnum = 0; regnum < 32; regnum++)
 	{
@@ -600,6 +605,12 @@ void rsp_device::device_stop()
 	{
 		auto_free(machine(), m_drcuml);
 	}
+	if (m_drcpersist != NULL)
+	{
+		m_drcpersist->save();
+		auto_free(machine(), m_drcpersist);
+		m_drcpersist = NULL;
+	}
 	if (m_drcfe)
 	{
 		auto_free(machine(), m_drcfe);
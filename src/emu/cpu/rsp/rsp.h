@@ -17,6 +17,7 @@
 #define __RSP_H__
 
 #include "cpu/drcfe.h"
+#include "cpu/drcpersist.h"
 #include "cpu/drcuml.h"
 
 /***************************************************************************
@@ -219,6 +220,7 @@ private:
 	drc_cache           m_cache;                      /* pointer to the DRC code cache */
 	drcuml_state *      m_drcuml;                     /* DRC UML generator state */
 	rsp_frontend *      m_drcfe;                      /* pointer to the DRC front-end state */
+	drc_persistent_cache *m_drcpersist;               /* record of compiled blocks kept across runs */
 	UINT32              m_drcoptions;                 /* configurable DRC options */
 
 	/* internal stuff */
@@ -308,6 +310,7 @@ private:
 	void execute_run_drc();
 	void code_flush_cache();
 	void code_compile_block(offs_t pc);
+	void code_compile_persisted_block(UINT8 mode, offs_t pc);
 	void static_generate_entry_point();
 	void static_generate_nocode_handler();
 	void static_generate_out_of_cycles();
@@ -286,6 +286,9 @@ void rsp_device::execute_run_drc()
 		/* if we need to recompile, do it */
 		if (execute_result == EXECUTE_MISSING_CODE)
 		{
+			/* along with any blocks recorded on this page on a previous run */
+			if (m_drcpersist != NULL)
+				m_drcpersist->missing_code(0, m_rsp_state->pc);
 			code_compile_block(m_rsp_state->pc);
 		}
 		else if (execute_result == EXECUTE_UNMAPPED_CODE)
@@ -442,6 +445,10 @@ void rsp_device::code_compile_block(offs_t pc)
 			block->end();
 			g_profiler.stop();
 			succeeded = true;
+
+			/* note the block so it can be recompiled ahead of need next run */
+			if (m_drcpersist != NULL)
+				m_drcpersist->block_compiled(0, pc, desclist);
 		}
 		catch (drcuml_block::abort_compilation &)
 		{
@@ -450,6 +457,19 @@ void rsp_device::code_compile_block(offs_t pc)
 	}
 }
 
+/*-------------------------------------------------
+    code_compile_persisted_block - compile a block
+    recorded on a previous run; the RSP has only
+    one mode
+-------------------------------------------------*/
+
+void rsp_device::code_compile_persisted_block(UINT8 mode, offs_t pc)
+{
+	code_compile_block(pc);
+}
+
+
+
 /***************************************************************************
     C FUNCTION CALLBACKS
 ***************************************************************************/
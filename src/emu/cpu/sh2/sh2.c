@@ -169,6 +169,7 @@ sh2_device::sh2_device(const machine_config &mconfig, const char *tag, device_t
 	, m_drcuml(NULL)
 //  , m_drcuml(*this, m_cache, 0, 1, 32, 1)
 	, m_drcfe(NULL)
+	, m_drcpersist(NULL)
 	, m_drcoptions(0)
 	, m_sh2_state(NULL)
 	, m_entry(NULL)
@@ -190,6 +191,12 @@ sh2_device::sh2_device(const machine_config &mconfig, const char *tag, device_t
 void sh2_device::device_stop()
 {
 	/* clean up the DRC */
+	if (m_drcpersist != NULL)
+	{
+		m_drcpersist->save();
+		auto_free(machine(), m_drcpersist);
+		m_drcpersist = NULL;
+	}
 	if ( m_drcuml )
 	{
 		auto_free(machine(), m_drcuml);
@@ -206,6 +213,7 @@ sh2_device::sh2_device(const machine_config &mconfig, device_type type, const ch
 	, m_drcuml(NULL)
 //  , m_drcuml(*this, m_cache, 0, 1, 32, 1)
 	, m_drcfe(NULL)
+	, m_drcpersist(NULL)
 	, m_drcoptions(0)
 	, m_sh2_state(NULL)
 	, m_entry(NULL)
@@ -2579,6 +2587,10 @@ void sh2_device::device_start()
 	/* initialize the front-end helper */
 	m_drcfe = auto_alloc(machine(), sh2_frontend(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE));
 
+	/* optionally record compiled blocks, and recompile those from a previous run */
+	if (m_isdrc && machine().options().drc_persist())
+		m_drcpersist = auto_alloc(machine(), drc_persistent_cache(*this, *m_drcfe, drc_compile_delegate(FUNC(sh2_device::code_compile_block), this), m_cpu_type));
+
 	/* compute the register parameters */
 	for (int regnum = 0; regnum < 16; regnum++)
 	{
@@ -31,6 +31,7 @@
 #define __SH2_H__
 
 #include "cpu/drcfe.h"
+#include "cpu/drcpersist.h"
 #include "cpu/drcuml.h"
 
 
@@ -246,6 +247,7 @@ private:
 	drc_cache           m_cache;                  /* pointer to the DRC code cache */
 	drcuml_state *      m_drcuml;                 /* DRC UML generator state */
 	sh2_frontend *      m_drcfe;                  /* pointer to the DRC front-end state */
+	drc_persistent_cache *m_drcpersist;           /* record of compiled blocks kept across runs */
 	UINT32              m_drcoptions;         /* configurable DRC options */
 
 	internal_sh2_state *m_sh2_state;
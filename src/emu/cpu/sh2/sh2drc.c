@@ -644,6 +644,9 @@ void sh2_device::execute_run_drc()
 		/* if we need to recompile, do it */
 		if (execute_result == EXECUTE_MISSING_CODE)
 		{
+			/* along with any blocks recorded on this page on a previous run */
+			if (m_drcpersist != NULL)
+				m_drcpersist->missing_code(0, m_sh2_state->pc);
 			code_compile_block(0, m_sh2_state->pc);
 		}
 		else if (execute_result == EXECUTE_UNMAPPED_CODE)
@@ -765,6 +768,10 @@ void sh2_device::code_compile_block(UINT8 mode, offs_t pc)
 			block->end();
 			g_profiler.stop();
 			succeeded = true;
+
+			/* note the block so it can be recompiled ahead of need next run */
+			if (m_drcpersist != NULL)
+				m_drcpersist->block_compiled(mode, pc, desclist);
 		}
 		catch (drcuml_block::abort_compilation &)
 		{
@@ -19,23 +19,23 @@ WRITE32_MEMBER( sh3_base_device::sh3_internal_high_w )
 		case SH3_ICR0_IPRA_ADDR:
 			if (mem_mask & 0xffff0000)
 			{
-				logerror("'%s' (%08x): INTC internal write to %08x = %08x & %08x (SH3_ICR0_IPRA_ADDR - ICR0)\n",tag(), m_pc & AM,(offset *4)+SH3_UPPER_REGBASE,data,mem_mask);
+				logerror("'%s' (%08x): INTC internal write to %08x = %08x & %08x (SH3_ICR0_IPRA_ADDR - ICR0)\n",tag(), m_sh4_state->pc & AM,(offset *4)+SH3_UPPER_REGBASE,data,mem_mask);
 			}
 
 			if (mem_mask & 0x0000ffff)
 			{
-				logerror("'%s' (%08x): INTC internal write to %08x = %08x & %08x (SH3_ICR0_IPRA_ADDR - IPRA)\n",tag(), m_pc & AM,(offset *4)+SH3_UPPER_REGBASE,data,mem_mask);
+				logerror("'%s' (%08x): INTC internal write to %08x = %08x & %08x (SH3_ICR0_IPRA_ADDR - IPRA)\n",tag(), m_sh4_state->pc & AM,(offset *4)+SH3_UPPER_REGBASE,data,mem_mask);
 				sh4_handler_ipra_w(data&0xffff,mem_mask&0xffff);
 			}
 
 			break;
 
 		case SH3_IPRB_ADDR:
-			logerror("'%s' (%08x): INTC internal write to %08x = %08x & %08x (SH3_IPRB_ADDR)\n",tag(), m_pc & AM,(offset *4)+SH3_UPPER_REGBASE,data,mem_mask);
+			logerror("'%s' (%08x): INTC internal write to %08x = %08x & %08x (SH3_IPRB_ADDR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+SH3_UPPER_REGBASE,data,mem_mask);
 		break;
 
 		case SH3_TOCR_TSTR_ADDR:
-			logerror("'%s' (%08x): TMU internal write to %08x = %08x & %08x (SH3_TOCR_TSTR_ADDR)\n",tag(), m_pc & AM,(offset *4)+SH3_UPPER_REGBASE,data,mem_mask);
+			logerror("'%s' (%08x): TMU internal write to %08x = %08x & %08x (SH3_TOCR_TSTR_ADDR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+SH3_UPPER_REGBASE,data,mem_mask);
 			if (mem_mask&0xff000000)
 			{
 				sh4_handle_tocr_addr_w((data>>24)&0xffff, (mem_mask>>24)&0xff);
@@ -61,7 +61,7 @@ WRITE32_MEMBER( sh3_base_device::sh3_internal_high_w )
 		case SH3_TCPR2_ADDR:  sh4_handle_tcpr2_addr_w(data,  mem_mask);break;
 
 		default:
-			logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (unk)\n",tag(), m_pc & AM,(offset *4)+SH3_UPPER_REGBASE,data,mem_mask);
+			logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (unk)\n",tag(), m_sh4_state->pc & AM,(offset *4)+SH3_UPPER_REGBASE,data,mem_mask);
 			break;
 
 	}
@@ -78,11 +78,11 @@ READ32_MEMBER( sh3_base_device::sh3_internal_high_r )
 	switch (offset)
 	{
 		case SH3_ICR0_IPRA_ADDR:
-			logerror("'%s' (%08x): INTC internal read from %08x mask %08x (SH3_ICR0_IPRA_ADDR - %08x)\n",tag(), m_pc & AM,(offset *4)+SH3_UPPER_REGBASE,mem_mask, m_sh3internal_upper[offset]);
+			logerror("'%s' (%08x): INTC internal read from %08x mask %08x (SH3_ICR0_IPRA_ADDR - %08x)\n",tag(), m_sh4_state->pc & AM,(offset *4)+SH3_UPPER_REGBASE,mem_mask, m_sh3internal_upper[offset]);
 			return (m_sh3internal_upper[offset] & 0xffff0000) | (m_SH4_IPRA & 0xffff);
 
 		case SH3_IPRB_ADDR:
-			logerror("'%s' (%08x): INTC internal read from %08x mask %08x (SH3_IPRB_ADDR - %08x)\n",tag(), m_pc & AM,(offset *4)+SH3_UPPER_REGBASE,mem_mask, m_sh3internal_upper[offset]);
+			logerror("'%s' (%08x): INTC internal read from %08x mask %08x (SH3_IPRB_ADDR - %08x)\n",tag(), m_sh4_state->pc & AM,(offset *4)+SH3_UPPER_REGBASE,mem_mask, m_sh3internal_upper[offset]);
 			return m_sh3internal_upper[offset];
 
 		case SH3_TOCR_TSTR_ADDR:
@@ -113,22 +113,22 @@ READ32_MEMBER( sh3_base_device::sh3_internal_high_r )
 
 
 		case SH3_TRA_ADDR:
-			logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (SH3 TRA - %08x)\n",tag(), m_pc & AM,(offset *4)+SH3_UPPER_REGBASE,mem_mask, m_sh3internal_upper[offset]);
+			logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (SH3 TRA - %08x)\n",tag(), m_sh4_state->pc & AM,(offset *4)+SH3_UPPER_REGBASE,mem_mask, m_sh3internal_upper[offset]);
 			return m_sh3internal_upper[offset];
 
 		case SH3_EXPEVT_ADDR:
-			logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (SH3 EXPEVT - %08x)\n",tag(), m_pc & AM,(offset *4)+SH3_UPPER_REGBASE,mem_mask, m_sh3internal_upper[offset]);
+			logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (SH3 EXPEVT - %08x)\n",tag(), m_sh4_state->pc & AM,(offset *4)+SH3_UPPER_REGBASE,mem_mask, m_sh3internal_upper[offset]);
 			return m_sh3internal_upper[offset];
 
 		case SH3_INTEVT_ADDR:
-			logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (SH3 INTEVT - %08x)\n",tag(), m_pc & AM,(offset *4)+SH3_UPPER_REGBASE,mem_mask, m_sh3internal_upper[offset]);
+			logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (SH3 INTEVT - %08x)\n",tag(), m_sh4_state->pc & AM,(offset *4)+SH3_UPPER_REGBASE,mem_mask, m_sh3internal_upper[offset]);
 			fatalerror("INTEVT unsupported on SH3\n");
 			// never executed
 			//return m_sh3internal_upper[offset];
 
 
 		default:
-			logerror("'%s' (%08x): unmapped internal read from %08x mask %08x\n",tag(), m_pc & AM,(offset *4)+SH3_UPPER_REGBASE,mem_mask);
+			logerror("'%s' (%08x): unmapped internal read from %08x mask %08x\n",tag(), m_sh4_state->pc & AM,(offset *4)+SH3_UPPER_REGBASE,mem_mask);
 			return m_sh3internal_upper[offset];
 	}
 }
@@ -161,7 +161,7 @@ READ32_MEMBER( sh3_base_device::sh3_internal_r )
 
 			case INTEVT2:
 				{
-				//  logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (INTEVT2)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+				//  logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (INTEVT2)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 					return m_sh3internal_lower[offset];
 				}
 
@@ -171,17 +171,17 @@ READ32_MEMBER( sh3_base_device::sh3_internal_r )
 					{
 						if (mem_mask & 0xff000000)
 						{
-							logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (IRR0)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+							logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (IRR0)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 							return m_sh3internal_lower[offset];
 						}
 
 						if (mem_mask & 0x0000ff00)
 						{
-							logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (IRR1)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+							logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (IRR1)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 							return m_sh3internal_lower[offset];
 						}
 
-						fatalerror("'%s' (%08x): unmapped internal read from %08x mask %08x (IRR0/1 unused bits)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+						fatalerror("'%s' (%08x): unmapped internal read from %08x mask %08x (IRR0/1 unused bits)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 					}
 				}
 
@@ -189,13 +189,13 @@ READ32_MEMBER( sh3_base_device::sh3_internal_r )
 				{
 					if (mem_mask & 0xffff0000)
 					{
-						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PADR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PADR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 						return m_io->read_qword(SH3_PORT_A)<<24;
 					}
 
 					if (mem_mask & 0x0000ffff)
 					{
-						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PBDR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PBDR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 						return m_io->read_qword(SH3_PORT_B)<<8;
 					}
 				}
@@ -205,13 +205,13 @@ READ32_MEMBER( sh3_base_device::sh3_internal_r )
 				{
 					if (mem_mask & 0xffff0000)
 					{
-						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PCDR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PCDR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 						return m_io->read_qword(SH3_PORT_C)<<24;
 					}
 
 					if (mem_mask & 0x0000ffff)
 					{
-						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PDDR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PDDR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 						return m_io->read_qword(SH3_PORT_D)<<8;
 					}
 				}
@@ -221,13 +221,13 @@ READ32_MEMBER( sh3_base_device::sh3_internal_r )
 				{
 					if (mem_mask & 0xffff0000)
 					{
-						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PEDR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PEDR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 						return m_io->read_qword(SH3_PORT_E)<<24;
 					}
 
 					if (mem_mask & 0x0000ffff)
 					{
-						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PFDR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PFDR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 						return m_io->read_qword(SH3_PORT_F)<<8;
 					}
 				}
@@ -237,13 +237,13 @@ READ32_MEMBER( sh3_base_device::sh3_internal_r )
 				{
 					if (mem_mask & 0xffff0000)
 					{
-						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PGDR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PGDR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 						return m_io->read_qword(SH3_PORT_G)<<24;
 					}
 
 					if (mem_mask & 0x0000ffff)
 					{
-						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PHDR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PHDR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 						return m_io->read_qword(SH3_PORT_H)<<8;
 					}
 				}
@@ -253,13 +253,13 @@ READ32_MEMBER( sh3_base_device::sh3_internal_r )
 				{
 					if (mem_mask & 0xffff0000)
 					{
-						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PJDR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PJDR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 						return m_io->read_qword(SH3_PORT_J)<<24;
 					}
 
 					if (mem_mask & 0x0000ffff)
 					{
-						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PKDR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PKDR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 						return m_io->read_qword(SH3_PORT_K)<<8;
 					}
 				}
@@ -269,13 +269,13 @@ READ32_MEMBER( sh3_base_device::sh3_internal_r )
 				{
 					if (mem_mask & 0xffff0000)
 					{
-						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PLDR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+						//logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (PLDR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 						return m_io->read_qword(SH3_PORT_L)<<24;
 					}
 
 					if (mem_mask & 0x0000ffff)
 					{
-						logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (SCPDR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+						logerror("'%s' (%08x): unmapped internal read from %08x mask %08x (SCPDR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 						//return m_io->read_qword(SH3_PORT_K)<<8;
 					}
 				}
@@ -286,13 +286,13 @@ READ32_MEMBER( sh3_base_device::sh3_internal_r )
 				{
 					if (mem_mask & 0xff000000)
 					{
-						logerror("'%s' (%08x): SCIF internal read from %08x mask %08x (SCSMR2 - Serial Mode Register 2)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+						logerror("'%s' (%08x): SCIF internal read from %08x mask %08x (SCSMR2 - Serial Mode Register 2)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 						return m_sh3internal_lower[offset];
 					}
 
 					if (mem_mask & 0x0000ff00)
 					{
-						logerror("'%s' (%08x): SCIF internal read from %08x mask %08x (SCBRR2 - Bit Rate Register 2)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+						logerror("'%s' (%08x): SCIF internal read from %08x mask %08x (SCBRR2 - Bit Rate Register 2)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 						return m_sh3internal_lower[offset];
 					}
 				}
@@ -302,13 +302,13 @@ READ32_MEMBER( sh3_base_device::sh3_internal_r )
 				{
 					if (mem_mask & 0xff000000)
 					{
-						logerror("'%s' (%08x): SCIF internal read from %08x mask %08x (SCSCR2 - Serial Control Register 2)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+						logerror("'%s' (%08x): SCIF internal read from %08x mask %08x (SCSCR2 - Serial Control Register 2)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 						return m_sh3internal_lower[offset];
 					}
 
 					if (mem_mask & 0x0000ff00)
 					{
-						logerror("'%s' (%08x): SCIF internal read from %08x mask %08x (SCFTDR2 - Transmit FIFO Data Register 2)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+						logerror("'%s' (%08x): SCIF internal read from %08x mask %08x (SCFTDR2 - Transmit FIFO Data Register 2)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 						return m_sh3internal_lower[offset];
 					}
 				}
@@ -318,13 +318,13 @@ READ32_MEMBER( sh3_base_device::sh3_internal_r )
 				{
 					if (mem_mask & 0xffff0000)
 					{
-						logerror("'%s' (%08x): SCIF internal read from %08x mask %08x (SCSSR2 - Serial Status Register 2)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+						logerror("'%s' (%08x): SCIF internal read from %08x mask %08x (SCSSR2 - Serial Status Register 2)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 						return m_sh3internal_lower[offset];
 					}
 
 					if (mem_mask & 0x0000ff00)
 					{
-						logerror("'%s' (%08x): SCIF internal read from %08x mask %08x (SCFRDR2 - Receive FIFO Data Register 2)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+						logerror("'%s' (%08x): SCIF internal read from %08x mask %08x (SCFRDR2 - Receive FIFO Data Register 2)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 						return m_sh3internal_lower[offset];
 					}
 				}
@@ -334,13 +334,13 @@ READ32_MEMBER( sh3_base_device::sh3_internal_r )
 				{
 					if (mem_mask & 0xff000000)
 					{
-						logerror("'%s' (%08x): SCIF internal read from %08x mask %08x (SCFCR2 - Fifo Control Register 2)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+						logerror("'%s' (%08x): SCIF internal read from %08x mask %08x (SCFCR2 - Fifo Control Register 2)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 						return m_sh3internal_lower[offset];
 					}
 
 					if (mem_mask & 0x0000ffff)
 					{
-						logerror("'%s' (%08x): SCIF internal read from %08x mask %08x (SCFDR2 - Fifo Data Count Register 2)\n",tag(), m_pc & AM,(offset *4)+0x4000000,mem_mask);
+						logerror("'%s' (%08x): SCIF internal read from %08x mask %08x (SCFDR2 - Fifo Data Count Register 2)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,mem_mask);
 						return m_sh3internal_lower[offset];
 					}
 				}
@@ -350,7 +350,7 @@ READ32_MEMBER( sh3_base_device::sh3_internal_r )
 			default:
 				{
 					logerror("'%s' (%08x): unmapped internal read from %08x mask %08x\n",
-						tag(), m_pc & AM,
+						tag(), m_sh4_state->pc & AM,
 						(offset *4)+0x4000000,
 						mem_mask);
 				}
@@ -362,7 +362,7 @@ READ32_MEMBER( sh3_base_device::sh3_internal_r )
 	else
 	{
 		logerror("'%s' (%08x): unmapped internal read from %08x mask %08x\n",
-			tag(), m_pc & AM,
+			tag(), m_sh4_state->pc & AM,
 			(offset *4)+0x4000000,
 			mem_mask);
 	}
@@ -405,7 +405,7 @@ WRITE32_MEMBER( sh3_base_device::sh3_internal_w )
 					{
 						if (mem_mask & 0xff000000)
 						{
-							logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (IRR0)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+							logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (IRR0)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 							// not sure if this is how we should clear lines in this core...
 							if (!(data & 0x01000000)) execute_set_input(0, CLEAR_LINE);
 							if (!(data & 0x02000000)) execute_set_input(1, CLEAR_LINE);
@@ -415,11 +415,11 @@ WRITE32_MEMBER( sh3_base_device::sh3_internal_w )
 						}
 						if (mem_mask & 0x0000ff00)
 						{
-							logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (IRR1)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+							logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (IRR1)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 						}
 						if (mem_mask & 0x00ff00ff)
 						{
-							fatalerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (IRR0/1 unused bits)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+							fatalerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (IRR0/1 unused bits)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 						}
 					}
 				}
@@ -429,14 +429,14 @@ WRITE32_MEMBER( sh3_base_device::sh3_internal_w )
 				{
 					if (mem_mask & 0xffff0000)
 					{
-						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PINTER)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PINTER)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 
 					if (mem_mask & 0x0000ffff)
 					{
 						data &= 0xffff; mem_mask &= 0xffff;
 						COMBINE_DATA(&m_SH4_IPRC);
-						logerror("'%s' (%08x): INTC internal write to %08x = %08x & %08x (IPRC)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+						logerror("'%s' (%08x): INTC internal write to %08x = %08x & %08x (IPRC)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 						m_exception_priority[SH4_INTC_IRL0]     = INTPRI((m_SH4_IPRC & 0x000f)>>0, SH4_INTC_IRL0);
 						m_exception_priority[SH4_INTC_IRL1]     = INTPRI((m_SH4_IPRC & 0x00f0)>>4, SH4_INTC_IRL1);
 						m_exception_priority[SH4_INTC_IRL2]     = INTPRI((m_SH4_IPRC & 0x0f00)>>8, SH4_INTC_IRL2);
@@ -450,12 +450,12 @@ WRITE32_MEMBER( sh3_base_device::sh3_internal_w )
 				{
 					if (mem_mask & 0xffff0000)
 					{
-						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PCCR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PCCR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 
 					if (mem_mask & 0x0000ffff)
 					{
-						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PDCR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PDCR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 				}
 				break;
@@ -464,12 +464,12 @@ WRITE32_MEMBER( sh3_base_device::sh3_internal_w )
 				{
 					if (mem_mask & 0xffff0000)
 					{
-						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PECR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PECR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 
 					if (mem_mask & 0x0000ffff)
 					{
-						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PFCR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PFCR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 				}
 				break;
@@ -479,12 +479,12 @@ WRITE32_MEMBER( sh3_base_device::sh3_internal_w )
 				{
 					if (mem_mask & 0xffff0000)
 					{
-						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PGCR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PGCR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 
 					if (mem_mask & 0x0000ffff)
 					{
-						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PHCR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PHCR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 				}
 				break;
@@ -494,12 +494,12 @@ WRITE32_MEMBER( sh3_base_device::sh3_internal_w )
 				{
 					if (mem_mask & 0xffff0000)
 					{
-						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PJCR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PJCR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 
 					if (mem_mask & 0x0000ffff)
 					{
-						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PKCR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PKCR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 				}
 				break;
@@ -509,12 +509,12 @@ WRITE32_MEMBER( sh3_base_device::sh3_internal_w )
 				{
 					if (mem_mask & 0xffff0000)
 					{
-						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PLCR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PLCR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 
 					if (mem_mask & 0x0000ffff)
 					{
-						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (SCPCR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+						logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (SCPCR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 				}
 				break;
@@ -524,13 +524,13 @@ WRITE32_MEMBER( sh3_base_device::sh3_internal_w )
 					if (mem_mask & 0xffff0000)
 					{
 						m_io->write_qword(SH3_PORT_A, (data>>24)&0xff);
-					//  logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PADR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+					//  logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PADR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 
 					if (mem_mask & 0x0000ffff)
 					{
 						m_io->write_qword(SH3_PORT_B, (data>>8)&0xff);
-					//  logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PBDR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+					//  logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PBDR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 				}
 				break;
@@ -540,13 +540,13 @@ WRITE32_MEMBER( sh3_base_device::sh3_internal_w )
 					if (mem_mask & 0xffff0000)
 					{
 						m_io->write_qword(SH3_PORT_C, (data>>24)&0xff);
-					//  logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PADR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+					//  logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PADR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 
 					if (mem_mask & 0x0000ffff)
 					{
 						m_io->write_qword(SH3_PORT_D, (data>>8)&0xff);
-					//  logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PBDR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+					//  logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PBDR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 				}
 				break;
@@ -555,13 +555,13 @@ WRITE32_MEMBER( sh3_base_device::sh3_internal_w )
 					if (mem_mask & 0xffff0000)
 					{
 						m_io->write_qword(SH3_PORT_E, (data>>24)&0xff);
-					//  logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PEDR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+					//  logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PEDR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 
 					if (mem_mask & 0x0000ffff)
 					{
 						m_io->write_qword(SH3_PORT_F, (data>>8)&0xff);
-					//  logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PFDR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+					//  logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PFDR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 				}
 				break;
@@ -571,13 +571,13 @@ WRITE32_MEMBER( sh3_base_device::sh3_internal_w )
 					if (mem_mask & 0xffff0000)
 					{
 						m_io->write_qword(SH3_PORT_G, (data>>24)&0xff);
-					//  logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PGDR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+					//  logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PGDR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 
 					if (mem_mask & 0x0000ffff)
 					{
 						m_io->write_qword(SH3_PORT_H, (data>>8)&0xff);
-					//  logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PHDR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+					//  logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PHDR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 				}
 				break;
@@ -588,13 +588,13 @@ WRITE32_MEMBER( sh3_base_device::sh3_internal_w )
 					if (mem_mask & 0xffff0000)
 					{
 						m_io->write_qword(SH3_PORT_J, (data>>24)&0xff);
-					//  logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PJDR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+					//  logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PJDR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 
 					if (mem_mask & 0x0000ffff)
 					{
 						m_io->write_qword(SH3_PORT_K, (data>>8)&0xff);
-						//logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PKDR)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+						//logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x (PKDR)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 				}
 				break;
@@ -603,12 +603,12 @@ WRITE32_MEMBER( sh3_base_device::sh3_internal_w )
 				{
 					if (mem_mask & 0xff000000)
 					{
-						logerror("'%s' (%08x): SCIF internal write to %08x = %08x & %08x (SCSMR2 - Serial Mode Register 2)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+						logerror("'%s' (%08x): SCIF internal write to %08x = %08x & %08x (SCSMR2 - Serial Mode Register 2)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 
 					if (mem_mask & 0x0000ff00)
 					{
-						logerror("'%s' (%08x): SCIF internal write to %08x = %08x & %08x (SCBRR2 - Bit Rate Register 2)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+						logerror("'%s' (%08x): SCIF internal write to %08x = %08x & %08x (SCBRR2 - Bit Rate Register 2)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 				}
 				break;
@@ -617,12 +617,12 @@ WRITE32_MEMBER( sh3_base_device::sh3_internal_w )
 				{
 					if (mem_mask & 0xff000000)
 					{
-						logerror("'%s' (%08x): SCIF internal write to %08x = %08x & %08x (SCSCR2 - Serial Control Register 2)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+						logerror("'%s' (%08x): SCIF internal write to %08x = %08x & %08x (SCSCR2 - Serial Control Register 2)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 
 					if (mem_mask & 0x0000ff00)
 					{
-						logerror("'%s' (%08x): SCIF internal write to %08x = %08x & %08x (SCFTDR2 - Transmit FIFO Data Register 2)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+						logerror("'%s' (%08x): SCIF internal write to %08x = %08x & %08x (SCFTDR2 - Transmit FIFO Data Register 2)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 				}
 				break;
@@ -631,12 +631,12 @@ WRITE32_MEMBER( sh3_base_device::sh3_internal_w )
 				{
 					if (mem_mask & 0xffff0000)
 					{
-						logerror("'%s' (%08x): SCIF internal write to %08x = %08x & %08x (SCSSR2 - Serial Status Register 2)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+						logerror("'%s' (%08x): SCIF internal write to %08x = %08x & %08x (SCSSR2 - Serial Status Register 2)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 
 					if (mem_mask & 0x0000ff00)
 					{
-						logerror("'%s' (%08x): SCIF internal write to %08x = %08x & %08x (SCFRDR2 - Receive FIFO Data Register 2)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+						logerror("'%s' (%08x): SCIF internal write to %08x = %08x & %08x (SCFRDR2 - Receive FIFO Data Register 2)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 				}
 				break;
@@ -645,12 +645,12 @@ WRITE32_MEMBER( sh3_base_device::sh3_internal_w )
 				{
 					if (mem_mask & 0xff000000)
 					{
-						logerror("'%s' (%08x): SCIF internal write to %08x = %08x & %08x (SCFCR2 - Fifo Control Register 2)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+						logerror("'%s' (%08x): SCIF internal write to %08x = %08x & %08x (SCFCR2 - Fifo Control Register 2)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 
 					if (mem_mask & 0x0000ffff)
 					{
-						logerror("'%s' (%08x): SCIF internal write to %08x = %08x & %08x (SCFDR2 - Fifo Data Count Register 2)\n",tag(), m_pc & AM,(offset *4)+0x4000000,data,mem_mask);
+						logerror("'%s' (%08x): SCIF internal write to %08x = %08x & %08x (SCFDR2 - Fifo Data Count Register 2)\n",tag(), m_sh4_state->pc & AM,(offset *4)+0x4000000,data,mem_mask);
 					}
 				}
 				break;
@@ -658,7 +658,7 @@ WRITE32_MEMBER( sh3_base_device::sh3_internal_w )
 			default:
 				{
 					logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x\n",
-							tag(), m_pc & AM,
+							tag(), m_sh4_state->pc & AM,
 							(offset *4)+0x4000000,
 							data,
 							mem_mask);
@@ -670,7 +670,7 @@ WRITE32_MEMBER( sh3_base_device::sh3_internal_w )
 	else
 	{
 		logerror("'%s' (%08x): unmapped internal write to %08x = %08x & %08x\n",
-				tag(), m_pc & AM,
+				tag(), m_sh4_state->pc & AM,
 				(offset *4)+0x4000000,
 				data,
 				mem_mask);
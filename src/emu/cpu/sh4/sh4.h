@@ -11,6 +11,9 @@
 #ifndef __SH4_H__
 #define __SH4_H__
 
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
+
 
 #define SH4_INT_NONE    -1
 enum
@@ -165,8 +168,12 @@ typedef void (*sh4_ftcsr_callback)(UINT32);
 	sh34_base_device::set_sh4_clock(*device, _clock);
 
 
+class sh4_frontend;
+
 class sh34_base_device : public cpu_device
 {
+	friend class sh4_frontend;
+
 public:
 	// construction/destruction
 	sh34_base_device(const machine_config &mconfig, device_type type, const char *name, const char *tag, device_t *owner, UINT32 clock, const char *shortname, endianness_t endianness, address_map_constructor internal);
@@ -193,10 +200,17 @@ public:
 	int sh4_dma_data(struct sh4_device_dma *s);
 	void sh4_dma_ddt(struct sh4_ddt_dma *s);
 
+	void sh4drc_set_options(UINT32 options);
+	void sh4drc_add_pcflush(offs_t address);
+
+	void func_execute_one();
+	void func_check_irq();
+
 protected:
 	// device-level overrides
 	virtual void device_start();
 	virtual void device_reset();
+	virtual void device_stop();
 
 	// device_execute_interface overrides
 	virtual UINT32 execute_min_cycles() const { return 1; }
@@ -233,28 +247,38 @@ protected:
 	int c_md8;
 	int c_clock;
 
-	UINT32  m_ppc;
-	UINT32  m_pc;
+	// Data that needs to be stored close to the generated DRC code
+	struct internal_sh4_state
+	{
+		UINT32  ppc;
+		UINT32  pc;
+		UINT32  pr;
+		UINT32  sr;
+		UINT32  gbr;
+		UINT32  vbr;
+		UINT32  mach;
+		UINT32  macl;
+		UINT32  r[16];
+		UINT32  fr[16];
+		UINT32  xf[16];
+		UINT32  ea;
+		UINT32  delay;
+		UINT32  test_irq;
+		UINT32  fpscr;
+		UINT32  fpul;
+		int     icount;
+		UINT32  opcode;             // opcode handed to func_execute_one
+		float   fzero;              // 0.0f for FLDI0/FCMP
+	};
+
+	internal_sh4_state *m_sh4_state;
+
 	UINT32  m_spc;
-	UINT32  m_pr;
-	UINT32  m_sr;
 	UINT32  m_ssr;
-	UINT32  m_gbr;
-	UINT32  m_vbr;
-	UINT32  m_mach;
-	UINT32  m_macl;
-	UINT32  m_r[16];
 	UINT32  m_rbnk[2][8];
 	UINT32  m_sgr;
-	UINT32  m_fr[16];
-	UINT32  m_xf[16];
-	UINT32  m_ea;
-	UINT32  m_delay;
 	UINT32  m_cpu_off;
 	UINT32  m_pending_irq;
-	UINT32  m_test_irq;
-	UINT32  m_fpscr;
-	UINT32  m_fpul;
 	UINT32  m_dbr;
 
 	UINT32  m_exception_priority[128];
@@ -334,7 +358,6 @@ protected:
 	int     m_dma_destination_increment[4];
 	int     m_dma_mode[4];
 
-	int     m_sh4_icount;
 	int     m_is_slave;
 	int     m_cpu_clock;
 	int     m_bus_clock;
@@ -683,6 +706,68 @@ protected:
 	UINT32 sh4_handle_chcr3_addr_r(UINT32 mem_mask) { return m_SH4_CHCR3; }
 	UINT32 sh4_handle_dmaor_addr_r(UINT32 mem_mask) { return m_SH4_DMAOR; }
 
+	void sh4_step_interpreter();
+
+	/* internal compiler state */
+	struct compiler_state
+	{
+		UINT32          cycles;                     /* accumulated cycles */
+		UINT8           mode;                       /* FPSCR SZ/PR mode of the block */
+		uml::code_label  labelnum;                   /* index for local labels */
+		uml::code_label  redispatch;                 /* shared exit for a changed pc */
+	};
+
+	drc_cache           m_cache;                  /* pointer to the DRC code cache */
+	drcuml_state *      m_drcuml;                 /* DRC UML generator state */
+	sh4_frontend *      m_drcfe;                  /* pointer to the DRC front-end state */
+	UINT32              m_drcoptions;             /* configurable DRC options */
+	UINT8               m_cache_dirty;            /* true if we need to flush the cache */
+	bool                m_isdrc;
+	UINT32              m_fetch_xor;              /* byte lane of an opcode word in a 64-bit fetch */
+
+	int m_pcfsel;                 // last pcflush entry set
+	int m_maxpcfsel;              // highest valid pcflush entry
+	UINT32 m_pcflushes[16];           // pcflush entries
+
+	uml::code_handle *  m_entry;                      /* entry point */
+	uml::code_handle *  m_nocode;                 /* nocode */
+	uml::code_handle *  m_out_of_cycles;              /* out of cycles exception handler */
+	uml::code_handle *  m_read8;                  /* read byte */
+	uml::code_handle *  m_write8;                 /* write byte */
+	uml::code_handle *  m_read16;                 /* read half */
+	uml::code_handle *  m_write16;                    /* write half */
+	uml::code_handle *  m_read32;                 /* read word */
+	uml::code_handle *  m_write32;                    /* write word */
+
+	inline void alloc_handle(drcuml_state *drcuml, uml::code_handle **handleptr, const char *name);
+
+	void sh4drc_init();
+	void code_flush_cache();
+	void execute_run_drc();
+	void code_compile_block(UINT8 mode, offs_t pc);
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+	void static_generate_memory_accessor(int size, int iswrite, const char *name, uml::code_handle **handleptr);
+	void log_add_disasm_comment(drcuml_block *block, UINT32 pc, UINT32 op);
+	void generate_update_cycles(drcuml_block *block, compiler_state *compiler);
+	void generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
+	void generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_delay_slot(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_interpret(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_irq_check(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_flush_pc(drcuml_block *block, const opcode_desc *desc);
+	int generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	int generate_group_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode);
+	int generate_group_2(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode);
+	int generate_group_3(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode);
+	int generate_group_4(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode);
+	int generate_group_6(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode);
+	int generate_group_8(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode);
+	int generate_group_12(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode);
+	int generate_group_15(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode);
+	void generate_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_conditional_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, int taken);
 };
 
 
@@ -776,4 +861,26 @@ extern const device_type SH4BE;
 void sh4drc_set_options(device_t *device, UINT32 options);
 void sh4drc_add_pcflush(device_t *device, offs_t address);
 
+
+class sh4_frontend : public drc_frontend
+{
+public:
+	sh4_frontend(sh34_base_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
+
+protected:
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev);
+
+private:
+	bool describe_group_0(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	bool describe_group_2(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	bool describe_group_3(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	bool describe_group_4(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	bool describe_group_6(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	bool describe_group_8(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	bool describe_group_12(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	bool describe_group_15(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+
+	sh34_base_device *m_sh4;
+};
+
 #endif /* __SH4_H__ */
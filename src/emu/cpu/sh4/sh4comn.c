@@ -241,16 +241,16 @@ void sh34_base_device::sh4_change_register_bank(int to)
 	{
 		for (s = 0;s < 8;s++)
 		{
-			m_rbnk[0][s] = m_r[s];
-			m_r[s] = m_rbnk[1][s];
+			m_rbnk[0][s] = m_sh4_state->r[s];
+			m_sh4_state->r[s] = m_rbnk[1][s];
 		}
 	}
 	else // 1 -> 0
 	{
 		for (s = 0;s < 8;s++)
 		{
-			m_rbnk[1][s] = m_r[s];
-			m_r[s] = m_rbnk[0][s];
+			m_rbnk[1][s] = m_sh4_state->r[s];
+			m_sh4_state->r[s] = m_rbnk[0][s];
 		}
 	}
 }
@@ -262,9 +262,9 @@ void sh34_base_device::sh4_swap_fp_registers()
 
 	for (s = 0;s <= 15;s++)
 	{
-		z = m_fr[s];
-		m_fr[s] = m_xf[s];
-		m_xf[s] = z;
+		z = m_sh4_state->fr[s];
+		m_sh4_state->fr[s] = m_sh4_state->xf[s];
+		m_sh4_state->xf[s] = z;
 	}
 }
 
@@ -275,12 +275,12 @@ void sh34_base_device::sh4_swap_fp_couples()
 
 	for (s = 0;s <= 15;s = s+2)
 	{
-		z = m_fr[s];
-		m_fr[s] = m_fr[s + 1];
-		m_fr[s + 1] = z;
-		z = m_xf[s];
-		m_xf[s] = m_xf[s + 1];
-		m_xf[s + 1] = z;
+		z = m_sh4_state->fr[s];
+		m_sh4_state->fr[s] = m_sh4_state->fr[s + 1];
+		m_sh4_state->fr[s + 1] = z;
+		z = m_sh4_state->xf[s];
+		m_sh4_state->xf[s] = m_sh4_state->xf[s + 1];
+		m_sh4_state->xf[s + 1] = z;
 	}
 }
 
@@ -290,7 +290,7 @@ void sh34_base_device::sh4_syncronize_register_bank(int to)
 
 	for (s = 0;s < 8;s++)
 	{
-		m_rbnk[to][s] = m_r[s];
+		m_rbnk[to][s] = m_sh4_state->r[s];
 	}
 }
 
@@ -314,10 +314,10 @@ void sh34_base_device::sh4_exception_recompute() // checks if there is any inter
 {
 	int a,z;
 
-	m_test_irq = 0;
-	if ((!m_pending_irq) || ((m_sr & BL) && (m_exception_requesting[SH4_INTC_NMI] == 0)))
+	m_sh4_state->test_irq = 0;
+	if ((!m_pending_irq) || ((m_sh4_state->sr & BL) && (m_exception_requesting[SH4_INTC_NMI] == 0)))
 		return;
-	z = (m_sr >> 4) & 15;
+	z = (m_sh4_state->sr >> 4) & 15;
 	for (a=0;a <= SH4_INTC_ROVI;a++)
 	{
 		if (m_exception_requesting[a])
@@ -327,7 +327,7 @@ void sh34_base_device::sh4_exception_recompute() // checks if there is any inter
 			if (pri > z)
 			{
 				//logerror("will test\n");
-				m_test_irq = 1; // will check for exception at end of instructions
+				m_sh4_state->test_irq = 1; // will check for exception at end of instructions
 				break;
 			}
 		}
@@ -375,7 +375,7 @@ void sh34_base_device::sh4_exception(const char *message, int exception) // hand
 		if (exception < SH4_INTC_NMI)
 			return; // Not yet supported
 		if (exception == SH4_INTC_NMI) {
-			if ((m_sr & BL) && (!(m_m[ICR] & 0x200)))
+			if ((m_sh4_state->sr & BL) && (!(m_m[ICR] & 0x200)))
 				return;
 
 			m_m[ICR] &= ~0x200;
@@ -388,9 +388,9 @@ void sh34_base_device::sh4_exception(const char *message, int exception) // hand
 		} else {
 	//      if ((m_m[ICR] & 0x4000) && (m_nmi_line_state == ASSERT_LINE))
 	//          return;
-			if (m_sr & BL)
+			if (m_sh4_state->sr & BL)
 				return;
-			if (((m_exception_priority[exception] >> 8) & 255) <= ((m_sr >> 4) & 15))
+			if (((m_exception_priority[exception] >> 8) & 255) <= ((m_sh4_state->sr >> 4) & 15))
 				return;
 			m_m[INTEVT] = exception_codes[exception];
 			vector = 0x600;
@@ -413,9 +413,9 @@ void sh34_base_device::sh4_exception(const char *message, int exception) // hand
 		}
 		else
 		{
-			if (m_sr & BL)
+			if (m_sh4_state->sr & BL)
 				return;
-			if (((m_exception_priority[exception] >> 8) & 255) <= ((m_sr >> 4) & 15))
+			if (((m_exception_priority[exception] >> 8) & 255) <= ((m_sh4_state->sr >> 4) & 15))
 				return;
 
 
@@ -440,21 +440,21 @@ void sh34_base_device::sh4_exception(const char *message, int exception) // hand
 	}
 	sh4_exception_checkunrequest(exception);
 
-	m_spc = m_pc;
-	m_ssr = m_sr;
-	m_sgr = m_r[15];
+	m_spc = m_sh4_state->pc;
+	m_ssr = m_sh4_state->sr;
+	m_sgr = m_sh4_state->r[15];
 
-	m_sr |= MD;
+	m_sh4_state->sr |= MD;
 	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
-		sh4_syncronize_register_bank((m_sr & sRB) >> 29);
-	if (!(m_sr & sRB))
+		sh4_syncronize_register_bank((m_sh4_state->sr & sRB) >> 29);
+	if (!(m_sh4_state->sr & sRB))
 		sh4_change_register_bank(1);
-	m_sr |= sRB;
-	m_sr |= BL;
+	m_sh4_state->sr |= sRB;
+	m_sh4_state->sr |= BL;
 	sh4_exception_recompute();
 
 	/* fetch PC */
-	m_pc = m_vbr + vector;
+	m_sh4_state->pc = m_sh4_state->vbr + vector;
 	/* wake up if a sleep opcode is triggered */
 	if(m_sleep_mode == 1) { m_sleep_mode = 2; }
 }
@@ -1016,7 +1016,7 @@ void sh34_base_device::sh4_set_frt_input(int state)
 	sh4_timer_resync();
 	m_icr = m_frc;
 	m_m[4] |= ICF;
-	logerror("SH4 '%s': ICF activated (%x)\n", tag(), m_pc & AM);
+	logerror("SH4 '%s': ICF activated (%x)\n", tag(), m_sh4_state->pc & AM);
 	sh4_recalc_irq();
 #endif
 }
@@ -1129,7 +1129,7 @@ void sh34_base_device::execute_set_input(int irqline, int state) // set state of
 				LOG(("SH-4 '%s' IRLn0-IRLn3 level #%d\n", tag(), m_irln));
 			}
 		}
-		if (m_test_irq && (!m_delay))
+		if (m_sh4_state->test_irq && (!m_sh4_state->delay))
 			sh4_check_pending_irq("sh4_set_irq_line");
 	}
 }
@@ -0,0 +1,2096 @@
+// license:BSD-3-Clause
+// copyright-holders:R. Belmont
+/***************************************************************************
+
+    sh4drc.c
+
+    Universal machine language-based SH-3/SH-4 emulator.
+
+    Integer, branch and load/store instructions are generated natively,
+    as are the single precision FPU instructions when FPSCR.PR and
+    FPSCR.SZ are both clear; the SZ/PR bits select the hash mode a block
+    is compiled for.  Control register, register bank, FPSCR and the
+    remaining FPU instructions are stepped through the interpreter's
+    execute_one().
+
+***************************************************************************/
+
+#include "emu.h"
+#include "debugger.h"
+#include "sh4.h"
+#include "sh4comn.h"
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
+#include "cpu/drcumlsh.h"
+
+using namespace uml;
+
+extern unsigned DasmSH4(char *buffer, unsigned pc, UINT16 opcode);
+
+
+/***************************************************************************
+    DEBUGGING
+***************************************************************************/
+
+#define SINGLE_INSTRUCTION_MODE         (0)
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* compilation boundaries -- how far back/forward does the analysis extend? */
+#define COMPILE_BACKWARDS_BYTES         64
+#define COMPILE_FORWARDS_BYTES          256
+#define COMPILE_MAX_SEQUENCE            64
+
+/* exit codes */
+#define EXECUTE_OUT_OF_CYCLES           0
+#define EXECUTE_MISSING_CODE            1
+#define EXECUTE_UNMAPPED_CODE           2
+#define EXECUTE_INTERPRET               4
+
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+#define R32(reg)                        mem(&m_sh4_state->r[reg])
+#define FR32(reg)                       mem(&m_sh4_state->fr[reg])
+#define XF32(reg)                       mem(&m_sh4_state->xf[reg])
+
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    alloc_handle - allocate a handle if not
+    already allocated
+-------------------------------------------------*/
+
+inline void sh34_base_device::alloc_handle(drcuml_state *drcuml, code_handle **handleptr, const char *name)
+{
+	if (*handleptr == NULL)
+		*handleptr = drcuml->handle_alloc(name);
+}
+
+
+/*-------------------------------------------------
+    cfunc_execute_one - C wrapper for
+    func_execute_one
+-------------------------------------------------*/
+
+static void cfunc_execute_one(void *param)
+{
+	((sh34_base_device *)param)->func_execute_one();
+}
+
+
+/*-------------------------------------------------
+    cfunc_check_irq - C wrapper for
+    func_check_irq
+-------------------------------------------------*/
+
+static void cfunc_check_irq(void *param)
+{
+	((sh34_base_device *)param)->func_check_irq();
+}
+
+
+
+/***************************************************************************
+    CORE CALLBACKS
+***************************************************************************/
+
+/*-------------------------------------------------
+    sh4drc_init - initialize the recompiler
+-------------------------------------------------*/
+
+void sh34_base_device::sh4drc_init()
+{
+	/* initialize the UML generator */
+	m_drcuml = auto_alloc(machine(), drcuml_state(*this, m_cache, 0, 4, 32, 1));
+
+	/* add symbols for our stuff */
+	m_drcuml->symbol_add(&m_sh4_state->pc, sizeof(m_sh4_state->pc), "pc");
+	m_drcuml->symbol_add(&m_sh4_state->icount, sizeof(m_sh4_state->icount), "icount");
+	for (int regnum = 0; regnum < 16; regnum++)
+	{
+		char buf[10];
+		sprintf(buf, "r%d", regnum);
+		m_drcuml->symbol_add(&m_sh4_state->r[regnum], sizeof(m_sh4_state->r[regnum]), buf);
+		sprintf(buf, "fr%d", regnum);
+		m_drcuml->symbol_add(&m_sh4_state->fr[regnum], sizeof(m_sh4_state->fr[regnum]), buf);
+	}
+	m_drcuml->symbol_add(&m_sh4_state->pr, sizeof(m_sh4_state->pr), "pr");
+	m_drcuml->symbol_add(&m_sh4_state->sr, sizeof(m_sh4_state->sr), "sr");
+	m_drcuml->symbol_add(&m_sh4_state->gbr, sizeof(m_sh4_state->gbr), "gbr");
+	m_drcuml->symbol_add(&m_sh4_state->vbr, sizeof(m_sh4_state->vbr), "vbr");
+	m_drcuml->symbol_add(&m_sh4_state->macl, sizeof(m_sh4_state->macl), "macl");
+	m_drcuml->symbol_add(&m_sh4_state->mach, sizeof(m_sh4_state->mach), "mach");
+	m_drcuml->symbol_add(&m_sh4_state->fpscr, sizeof(m_sh4_state->fpscr), "fpscr");
+	m_drcuml->symbol_add(&m_sh4_state->fpul, sizeof(m_sh4_state->fpul), "fpul");
+	m_drcuml->symbol_add(&m_sh4_state->delay, sizeof(m_sh4_state->delay), "delay");
+	m_drcuml->symbol_add(&m_sh4_state->test_irq, sizeof(m_sh4_state->test_irq), "test_irq");
+
+	/* initialize the front-end helper */
+	m_drcfe = auto_alloc(machine(), sh4_frontend(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE));
+
+	/* compute the register parameters */
+	m_sh4_state->fzero = 0.0f;
+
+	/* default to the safest options */
+	m_drcoptions = SH4DRC_COMPATIBLE_OPTIONS;
+
+	/* mark the cache dirty so it is updated on next execute */
+	m_cache_dirty = TRUE;
+}
+
+
+/*-------------------------------------------------
+    sh4drc_set_options - configure DRC options
+-------------------------------------------------*/
+
+void sh34_base_device::sh4drc_set_options(UINT32 options)
+{
+	if (!machine().options().drc()) return;
+	m_drcoptions = options;
+	m_cache_dirty = TRUE;
+}
+
+void sh4drc_set_options(device_t *device, UINT32 options)
+{
+	downcast<sh34_base_device *>(device)->sh4drc_set_options(options);
+}
+
+
+/*-------------------------------------------------
+    sh4drc_add_pcflush - add a new address where
+    the PC must be flushed for speedups to work
+-------------------------------------------------*/
+
+void sh34_base_device::sh4drc_add_pcflush(offs_t address)
+{
+	if (!machine().options().drc()) return;
+
+	if (m_pcfsel < ARRAY_LENGTH(m_pcflushes))
+		m_pcflushes[m_pcfsel++] = address;
+	m_cache_dirty = TRUE;
+}
+
+void sh4drc_add_pcflush(device_t *device, offs_t address)
+{
+	downcast<sh34_base_device *>(device)->sh4drc_add_pcflush(address);
+}
+
+
+/*-------------------------------------------------
+    execute_run_drc - execute the CPU for the
+    specified number of cycles
+-------------------------------------------------*/
+
+void sh34_base_device::execute_run_drc()
+{
+	int execute_result;
+
+	/* reset the cache if dirty */
+	if (m_cache_dirty)
+		code_flush_cache();
+	m_cache_dirty = FALSE;
+
+	/* execute */
+	do
+	{
+		/* blocks never start inside a delay slot, and an interrupt raised between */
+		/* timeslices is taken after one more instruction, as the interpreter does */
+		if (m_sh4_state->delay || m_sh4_state->test_irq)
+			execute_result = EXECUTE_INTERPRET;
+
+		/* run as much as we can */
+		else
+			execute_result = m_drcuml->execute(*m_entry);
+
+		/* if we need to recompile, do it */
+		if (execute_result == EXECUTE_MISSING_CODE)
+			code_compile_block((m_sh4_state->fpscr >> 19) & 3, m_sh4_state->pc);
+		else if (execute_result == EXECUTE_UNMAPPED_CODE)
+			fatalerror("Attempted to execute unmapped code at PC=%08X\n", m_sh4_state->pc);
+
+		/* otherwise step the interpreter */
+		else if (execute_result == EXECUTE_INTERPRET)
+		{
+			sh4_step_interpreter();
+			m_sh4_state->icount--;
+			if (m_sh4_state->icount <= 0)
+				execute_result = EXECUTE_OUT_OF_CYCLES;
+		}
+
+	} while (execute_result != EXECUTE_OUT_OF_CYCLES);
+}
+
+
+
+/***************************************************************************
+    CACHE MANAGEMENT
+***************************************************************************/
+
+/*-------------------------------------------------
+    code_flush_cache - flush the cache and
+    regenerate static code
+-------------------------------------------------*/
+
+void sh34_base_device::code_flush_cache()
+{
+	/* empty the transient cache contents */
+	m_drcuml->reset();
+
+	try
+	{
+		/* generate the entry point and out-of-cycles handlers */
+		static_generate_nocode_handler();
+		static_generate_out_of_cycles();
+		static_generate_entry_point();
+
+		/* add subroutines for memory accesses */
+		static_generate_memory_accessor(1, FALSE, "read8", &m_read8);
+		static_generate_memory_accessor(1, TRUE,  "write8", &m_write8);
+		static_generate_memory_accessor(2, FALSE, "read16", &m_read16);
+		static_generate_memory_accessor(2, TRUE,  "write16", &m_write16);
+		static_generate_memory_accessor(4, FALSE, "read32", &m_read32);
+		static_generate_memory_accessor(4, TRUE,  "write32", &m_write32);
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unable to generate SH4 static code\n");
+	}
+
+	m_cache_dirty = FALSE;
+}
+
+
+/*-------------------------------------------------
+    code_compile_block - compile a block of the
+    given mode at the specified pc
+-------------------------------------------------*/
+
+void sh34_base_device::code_compile_block(UINT8 mode, offs_t pc)
+{
+	compiler_state compiler = { 0 };
+	const opcode_desc *seqlast;
+	int override = FALSE;
+
+	g_profiler.start(PROFILER_DRC_COMPILE);
+
+	/* get a description of this sequence */
+	const opcode_desc *desclist = m_drcfe->describe_code(pc);
+
+	/* if we get an error back, flush the cache and try again */
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			/* start the block */
+			drcuml_block *block = m_drcuml->begin_block(4096);
+
+			/* every instruction that moves the PC leaves through the same path */
+			compiler.mode = mode;
+			compiler.labelnum = 1;
+			compiler.redispatch = compiler.labelnum++;
+
+			/* loop until we get through all instruction sequences */
+			for (const opcode_desc *seqhead = desclist; seqhead != NULL; seqhead = seqlast->next())
+			{
+				const opcode_desc *curdesc;
+				UINT32 nextpc;
+
+				/* add a code log entry */
+				if (m_drcuml->logging())
+					block->append_comment("-------------------------");                     // comment
+
+				/* determine the last instruction in this sequence */
+				for (seqlast = seqhead; seqlast != NULL; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != NULL);
+
+				/* if we don't have a hash for this mode/pc, or if we are overriding all, add one */
+				if (override || !m_drcuml->hash_exists(mode, seqhead->pc))
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+
+				/* if we already have a hash, and this is the first sequence, assume that we */
+				/* are recompiling due to being out of sync and allow future overrides */
+				else if (seqhead == desclist)
+				{
+					override = TRUE;
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+				}
+
+				/* otherwise, redispatch to that fixed PC and skip the rest of the processing */
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+					UML_HASHJMP(block, mode, seqhead->pc, *m_nocode);                       // hashjmp <mode>,seqhead->pc,nocode
+					continue;
+				}
+
+				/* validate this code block if we're not pointing into ROM */
+				compiler.cycles = 0;
+				if (m_program->get_write_ptr(seqhead->physpc) != NULL)
+					generate_checksum_block(block, &compiler, seqhead, seqlast);
+
+				/* label this instruction, if it may be jumped to locally */
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+
+				/* iterate over instructions in the sequence and compile them */
+				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+					generate_sequence_instruction(block, &compiler, curdesc);
+
+				/* unconditional branches and mode changes have already left */
+				if (seqlast->flags & (OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_CAN_CHANGE_MODES))
+					continue;
+
+				/* if we need to return to the start, do it */
+				if (seqlast->flags & OPFLAG_RETURN_TO_START)
+					nextpc = pc;
+
+				/* otherwise we just go to the next instruction */
+				else
+					nextpc = seqlast->pc + seqlast->length;
+
+				/* count off cycles and go there */
+				generate_update_cycles(block, &compiler);                                   // <subtract cycles>
+				UML_CMP(block, mem(&m_sh4_state->icount), 0);                               // cmp     icount,0
+				UML_EXHc(block, COND_LE, *m_out_of_cycles, nextpc);                         // exhle   out_of_cycles,nextpc
+				if (seqlast->next() == NULL || seqlast->next()->pc != nextpc)
+					UML_HASHJMP(block, mode, nextpc, *m_nocode);                            // hashjmp <mode>,nextpc,nocode
+			}
+
+			/* the PC was changed: take any pending interrupt, then step a delay slot */
+			/* or dispatch to the new PC in whatever FPU mode is now current */
+			UML_LABEL(block, compiler.redispatch);                                          // redispatch:
+			UML_CMP(block, mem(&m_sh4_state->test_irq), 0);                                 // cmp     [test_irq],0
+			UML_JMPc(block, COND_Z, compiler.labelnum);                                     // jz      skip
+			UML_CALLC(block, cfunc_check_irq, this);                                        // callc   cfunc_check_irq,this
+			UML_LABEL(block, compiler.labelnum++);                                          // skip:
+			UML_CMP(block, mem(&m_sh4_state->icount), 0);                                   // cmp     icount,0
+			UML_EXHc(block, COND_LE, *m_out_of_cycles, mem(&m_sh4_state->pc));              // exhle   out_of_cycles,[pc]
+			UML_CMP(block, mem(&m_sh4_state->delay), 0);                                    // cmp     [delay],0
+			UML_EXITc(block, COND_NE, EXECUTE_INTERPRET);                                   // exitne  EXECUTE_INTERPRET
+			UML_SHR(block, I0, mem(&m_sh4_state->fpscr), 19);                               // shr     i0,[fpscr],19
+			UML_AND(block, I0, I0, 3);                                                      // and     i0,i0,3
+			UML_HASHJMP(block, I0, mem(&m_sh4_state->pc), *m_nocode);                       // hashjmp i0,[pc],nocode
+
+			/* end the sequence */
+			block->end();
+			g_profiler.stop();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			code_flush_cache();
+		}
+	}
+}
+
+
+
+/***************************************************************************
+    C FUNCTION CALLBACKS
+***************************************************************************/
+
+/*-------------------------------------------------
+    func_check_irq - take a pending interrupt
+    raised by a natively generated access
+-------------------------------------------------*/
+
+void sh34_base_device::func_check_irq()
+{
+	if (m_sh4_state->test_irq && !m_sh4_state->delay)
+	{
+		sh4_check_pending_irq("mame_sh4_execute");
+	}
+}
+
+
+
+/***************************************************************************
+    STATIC CODEGEN
+***************************************************************************/
+
+/*-------------------------------------------------
+    static_generate_entry_point - generate a
+    static entry point
+-------------------------------------------------*/
+
+void sh34_base_device::static_generate_entry_point()
+{
+	drcuml_block *block;
+
+	block = m_drcuml->begin_block(20);
+
+	/* forward references */
+	alloc_handle(m_drcuml, &m_nocode, "nocode");
+
+	alloc_handle(m_drcuml, &m_entry, "entry");
+	UML_HANDLE(block, *m_entry);                                                    // handle  entry
+
+	/* generate a hash jump via the current mode and PC */
+	UML_SHR(block, I0, mem(&m_sh4_state->fpscr), 19);                               // shr     i0,[fpscr],19
+	UML_AND(block, I0, I0, 3);                                                      // and     i0,i0,3
+	UML_HASHJMP(block, I0, mem(&m_sh4_state->pc), *m_nocode);                       // hashjmp i0,[pc],nocode
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_nocode_handler - generate an
+    exception handler for "out of code"
+-------------------------------------------------*/
+
+void sh34_base_device::static_generate_nocode_handler()
+{
+	drcuml_block *block;
+
+	/* begin generating */
+	block = m_drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(m_drcuml, &m_nocode, "nocode");
+	UML_HANDLE(block, *m_nocode);                                                   // handle  nocode
+	UML_GETEXP(block, I0);                                                          // getexp  i0
+	UML_MOV(block, mem(&m_sh4_state->pc), I0);                                      // mov     [pc],i0
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                          // exit    EXECUTE_MISSING_CODE
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_out_of_cycles - generate an
+    out of cycles exception handler
+-------------------------------------------------*/
+
+void sh34_base_device::static_generate_out_of_cycles()
+{
+	drcuml_block *block;
+
+	/* begin generating */
+	block = m_drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(m_drcuml, &m_out_of_cycles, "out_of_cycles");
+	UML_HANDLE(block, *m_out_of_cycles);                                            // handle  out_of_cycles
+	UML_GETEXP(block, I0);                                                          // getexp  i0
+	UML_MOV(block, mem(&m_sh4_state->pc), I0);                                      // mov     [pc],i0
+	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                                         // exit    EXECUTE_OUT_OF_CYCLES
+
+	block->end();
+}
+
+
+/*------------------------------------------------------------------
+    static_generate_memory_accessor - generate a
+    read or write handler; the P4 area at
+    0xe0000000 and up is not mirrored, everything
+    below it is masked to 29 bits like RB/WB do
+------------------------------------------------------------------*/
+
+void sh34_base_device::static_generate_memory_accessor(int size, int iswrite, const char *name, code_handle **handleptr)
+{
+	/* on entry, address is in I0; data for writes is in I1 */
+	/* on exit, read result is in I0 */
+	drcuml_block *block;
+
+	/* begin generating */
+	block = m_drcuml->begin_block(64);
+
+	/* add a global entry for this */
+	alloc_handle(m_drcuml, handleptr, name);
+	UML_HANDLE(block, **handleptr);                                                 // handle  *handleptr
+
+	UML_CMP(block, I0, 0xe0000000);                                                 // cmp     i0,0xe0000000
+	UML_JMPc(block, COND_AE, 1);                                                    // jae     1
+	UML_AND(block, I0, I0, AM);                                                     // and     i0,i0,AM
+	UML_LABEL(block, 1);                                                            // 1:
+
+	if (iswrite)
+	{
+		if (size == 1)
+			UML_WRITE(block, I0, I1, SIZE_BYTE, SPACE_PROGRAM);                     // write   i0,i1,program_byte
+		else if (size == 2)
+			UML_WRITE(block, I0, I1, SIZE_WORD, SPACE_PROGRAM);                     // write   i0,i1,program_word
+		else
+			UML_WRITE(block, I0, I1, SIZE_DWORD, SPACE_PROGRAM);                    // write   i0,i1,program_dword
+	}
+	else
+	{
+		if (size == 1)
+			UML_READ(block, I0, I0, SIZE_BYTE, SPACE_PROGRAM);                      // read    i0,i0,program_byte
+		else if (size == 2)
+			UML_READ(block, I0, I0, SIZE_WORD, SPACE_PROGRAM);                      // read    i0,i0,program_word
+		else
+			UML_READ(block, I0, I0, SIZE_DWORD, SPACE_PROGRAM);                     // read    i0,i0,program_dword
+	}
+
+	UML_RET(block);                                                                 // ret
+
+	block->end();
+}
+
+
+
+/***************************************************************************
+    CODE GENERATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    log_add_disasm_comment - add a comment
+    including disassembly of an SH4 instruction
+-------------------------------------------------*/
+
+void sh34_base_device::log_add_disasm_comment(drcuml_block *block, UINT32 pc, UINT32 op)
+{
+	if (m_drcuml->logging())
+	{
+		char buffer[100];
+		DasmSH4(buffer, pc, op);
+		block->append_comment("%08X: %s", pc, buffer);                              // comment
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_update_cycles - subtract the cycles
+    accumulated so far from the icount
+-------------------------------------------------*/
+
+void sh34_base_device::generate_update_cycles(drcuml_block *block, compiler_state *compiler)
+{
+	if (compiler->cycles != 0)
+	{
+		UML_SUB(block, mem(&m_sh4_state->icount), mem(&m_sh4_state->icount), compiler->cycles); // sub     icount,icount,cycles
+		compiler->cycles = 0;
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_checksum_block - generate code to
+    validate a sequence of opcodes
+-------------------------------------------------*/
+
+void sh34_base_device::generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast)
+{
+	const opcode_desc *curdesc;
+	const opcode_desc *last;
+	UINT32 sum = 0;
+	int loaded = FALSE;
+
+	if (m_drcuml->logging())
+		block->append_comment("[Validation for %08X]", seqhead->pc);                // comment
+
+	/* loose verify covers the head; strict verify sums everything, including a trailing delay slot */
+	last = (m_drcoptions & SH4DRC_STRICT_VERIFY) ? seqlast : seqhead;
+	for (curdesc = seqhead; curdesc != last->next(); curdesc = curdesc->next())
+	{
+		for (int slot = 0; slot < 2; slot++)
+		{
+			const opcode_desc *desc = (slot == 0) ? curdesc : curdesc->delay.first();
+
+			if (slot == 1 && (desc == NULL || curdesc != seqlast || !(m_drcoptions & SH4DRC_STRICT_VERIFY)))
+				break;
+			if (desc->flags & OPFLAG_VIRTUAL_NOOP)
+				continue;
+
+			void *base = m_direct->read_decrypted_ptr(desc->physpc, m_fetch_xor);
+			if (base == NULL)
+				continue;
+			UML_LOAD(block, loaded ? I1 : I0, base, 0, SIZE_WORD, SCALE_x2);        // load    i1,base,word
+			if (loaded)
+				UML_ADD(block, I0, I0, I1);                                         // add     i0,i0,i1
+			sum += desc->opptr.w[0];
+			loaded = TRUE;
+		}
+	}
+
+	if (loaded)
+	{
+		UML_CMP(block, I0, sum);                                                    // cmp     i0,sum
+		UML_EXHc(block, COND_NE, *m_nocode, seqhead->pc);                           // exne    nocode,seqhead->pc
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_sequence_instruction - generate code
+    for a single instruction in a sequence
+-------------------------------------------------*/
+
+void sh34_base_device::generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	int in_delay_slot = ((desc->flags & OPFLAG_IN_DELAY_SLOT) != 0);
+
+	/* add an entry for the log */
+	if (m_drcuml->logging() && !(desc->flags & OPFLAG_VIRTUAL_NOOP))
+		log_add_disasm_comment(block, desc->pc, desc->opptr.w[0]);
+
+	/* if we are debugging, call the debugger; in a delay slot the PC already holds the target */
+	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+	{
+		if (!in_delay_slot)
+			UML_MOV(block, mem(&m_sh4_state->pc), desc->pc);                        // mov     [pc],desc->pc
+		generate_update_cycles(block, compiler);                                    // <subtract cycles>
+		UML_DEBUG(block, desc->pc);                                                 // debug   desc->pc
+	}
+
+	/* flush the PC the instruction sees, for speedup handlers and the like */
+	generate_flush_pc(block, desc);
+
+	/* accumulate total cycles */
+	compiler->cycles += desc->cycles;
+
+	/* if we hit an unmapped address, fatal error */
+	if (desc->flags & OPFLAG_COMPILER_UNMAPPED)
+	{
+		UML_MOV(block, mem(&m_sh4_state->pc), desc->pc);                            // mov     [pc],desc->pc
+		generate_update_cycles(block, compiler);                                    // <subtract cycles>
+		UML_EXIT(block, EXECUTE_UNMAPPED_CODE);                                     // exit    EXECUTE_UNMAPPED_CODE
+		return;
+	}
+
+	/* virtual no-ops generate nothing */
+	if (desc->flags & OPFLAG_VIRTUAL_NOOP)
+		return;
+
+	/* anything we can't do natively is handed to the interpreter */
+	if (!generate_opcode(block, compiler, desc))
+		generate_interpret(block, compiler, desc);
+}
+
+
+/*-------------------------------------------------
+    generate_flush_pc - store the PC the
+    interpreter would hold while executing this
+    instruction, if the options call for it
+-------------------------------------------------*/
+
+void sh34_base_device::generate_flush_pc(drcuml_block *block, const opcode_desc *desc)
+{
+	int flush = FALSE;
+
+	/* a delay slot runs with the PC already at the branch target */
+	if (desc->flags & OPFLAG_IN_DELAY_SLOT)
+		return;
+
+	if (m_drcoptions & SH4DRC_FLUSH_PC)
+		flush = ((desc->flags & (OPFLAG_READS_MEMORY | OPFLAG_WRITES_MEMORY)) != 0);
+
+	for (int pcflush = 0; pcflush < m_pcfsel && !flush; pcflush++)
+		if (desc->pc == m_pcflushes[pcflush])
+			flush = TRUE;
+
+	if (flush)
+		UML_MOV(block, mem(&m_sh4_state->pc), desc->pc + 2);                        // mov     [pc],desc->pc + 2
+}
+
+
+/*-------------------------------------------------
+    generate_delay_slot - generate the instruction
+    in the delay slot of a branch; the PC has
+    already been set to the branch target
+-------------------------------------------------*/
+
+void sh34_base_device::generate_delay_slot(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	assert(desc->delay.first() != NULL);
+	generate_sequence_instruction(block, compiler, desc->delay.first());            // <next instruction>
+}
+
+
+/*-------------------------------------------------
+    generate_interpret - generate a call to the
+    interpreter for a single instruction
+-------------------------------------------------*/
+
+void sh34_base_device::generate_interpret(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	int in_delay_slot = ((desc->flags & OPFLAG_IN_DELAY_SLOT) != 0);
+
+	/* execute_one() charges any cycles beyond the first itself */
+	compiler->cycles -= desc->cycles - 1;
+
+	if (!in_delay_slot)
+		UML_MOV(block, mem(&m_sh4_state->pc), desc->pc + 2);                        // mov     [pc],desc->pc + 2
+	UML_MOV(block, mem(&m_sh4_state->opcode), desc->opptr.w[0]);                    // mov     [opcode],op
+	generate_update_cycles(block, compiler);                                        // <subtract cycles>
+	UML_CALLC(block, cfunc_execute_one, this);                                      // callc   cfunc_execute_one,this
+
+	/* a delay slot is followed by its branch, which redispatches anyway */
+	if (in_delay_slot)
+		return;
+
+	/* branches and FPU mode changes always redispatch */
+	if (desc->flags & (OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_CAN_CHANGE_MODES))
+		UML_JMP(block, compiler->redispatch);                                       // jmp     redispatch
+
+	/* anything else leaves only if it moved the PC (an exception, SLEEP) */
+	else
+	{
+		UML_CMP(block, mem(&m_sh4_state->pc), desc->pc + 2);                        // cmp     [pc],desc->pc + 2
+		UML_JMPc(block, COND_NE, compiler->redispatch);                             // jmpne   redispatch
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_irq_check - after a native memory
+    access, leave if the access raised an
+    interrupt the interpreter would take before
+    the next instruction
+-------------------------------------------------*/
+
+void sh34_base_device::generate_irq_check(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	/* interrupts are checked after the delay slot by the branch itself */
+	if (desc->flags & OPFLAG_IN_DELAY_SLOT)
+		return;
+
+	compiler_state compiler_temp = *compiler;
+	code_label skip = compiler->labelnum++;
+
+	UML_CMP(block, mem(&m_sh4_state->test_irq), 0);                                 // cmp     [test_irq],0
+	UML_JMPc(block, COND_Z, skip);                                                  // jz      skip
+	UML_MOV(block, mem(&m_sh4_state->pc), desc->pc + 2);                            // mov     [pc],desc->pc + 2
+	generate_update_cycles(block, &compiler_temp);                                  // <subtract cycles>
+	UML_JMP(block, compiler->redispatch);                                           // jmp     redispatch
+	UML_LABEL(block, skip);                                                         // skip:
+}
+
+
+/*-------------------------------------------------
+    generate_branch - finish an unconditional
+    delayed branch whose target is in [pc]
+-------------------------------------------------*/
+
+void sh34_base_device::generate_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	generate_delay_slot(block, compiler, desc);
+	generate_update_cycles(block, compiler);                                        // <subtract cycles>
+	UML_JMP(block, compiler->redispatch);                                           // jmp     redispatch
+}
+
+
+/*-------------------------------------------------
+    generate_conditional_branch - generate BT, BF,
+    BT/S and BF/S; 'taken' is the T bit value
+    that takes the branch
+-------------------------------------------------*/
+
+void sh34_base_device::generate_conditional_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, int taken)
+{
+	compiler_state compiler_temp = *compiler;
+	code_label skip = compiler_temp.labelnum++;
+
+	UML_TEST(block, mem(&m_sh4_state->sr), T);                                      // test    [sr],T
+	UML_JMPc(block, taken ? COND_Z : COND_NZ, skip);                                // jz/jnz  skip
+
+	/* the taken path costs two extra cycles, or one with a delay slot */
+	UML_MOV(block, mem(&m_sh4_state->pc), desc->targetpc);                          // mov     [pc],targetpc
+	if (desc->delayslots != 0)
+	{
+		compiler_temp.cycles += 1;
+		generate_delay_slot(block, &compiler_temp, desc);
+	}
+	else
+		compiler_temp.cycles += 2;
+	generate_update_cycles(block, &compiler_temp);                                  // <subtract cycles>
+	UML_JMP(block, compiler->redispatch);                                           // jmp     redispatch
+
+	UML_LABEL(block, skip);                                                         // skip:
+	compiler->labelnum = compiler_temp.labelnum;
+}
+
+
+/*-------------------------------------------------
+    generate_opcode - generate code for a specific
+    opcode; returns FALSE for anything that must
+    be interpreted
+-------------------------------------------------*/
+
+int sh34_base_device::generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	UINT32 scratch;
+	UINT16 opcode = desc->opptr.w[0];
+	int in_delay_slot = ((desc->flags & OPFLAG_IN_DELAY_SLOT) != 0);
+
+	/* a branch in a delay slot is left to the interpreter, which sets up its own slot */
+	if (in_delay_slot && (desc->flags & OPFLAG_IS_BRANCH))
+		return FALSE;
+
+	switch (opcode >> 12)
+	{
+		case  0:
+			return generate_group_0(block, compiler, desc, opcode);
+
+		case  1:    // MOVLS4
+			UML_ADD(block, I0, R32(Rn), (opcode & 0x0f) * 4);                       // add     i0,Rn,disp*4
+			UML_MOV(block, I1, R32(Rm));                                            // mov     i1,Rm
+			UML_CALLH(block, *m_write32);                                           // callh   write32
+			generate_irq_check(block, compiler, desc);
+			return TRUE;
+
+		case  2:
+			return generate_group_2(block, compiler, desc, opcode);
+
+		case  3:
+			return generate_group_3(block, compiler, desc, opcode);
+
+		case  4:
+			return generate_group_4(block, compiler, desc, opcode);
+
+		case  5:    // MOVLL4
+			UML_ADD(block, I0, R32(Rm), (opcode & 0x0f) * 4);                       // add     i0,Rm,disp*4
+			UML_CALLH(block, *m_read32);                                            // callh   read32
+			UML_MOV(block, R32(Rn), I0);                                            // mov     Rn,i0
+			generate_irq_check(block, compiler, desc);
+			return TRUE;
+
+		case  6:
+			return generate_group_6(block, compiler, desc, opcode);
+
+		case  7:    // ADDI
+			UML_ADD(block, R32(Rn), R32(Rn), (UINT32)(INT32)(INT8)(opcode & 0xff)); // add     Rn,Rn,simm
+			return TRUE;
+
+		case  8:
+			return generate_group_8(block, compiler, desc, opcode);
+
+		case  9:    // MOVWI
+			/* the interpreter computes this from the branch target in a delay slot */
+			if (in_delay_slot)
+				return FALSE;
+			scratch = desc->pc + 4 + (opcode & 0xff) * 2;
+			if (m_drcoptions & SH4DRC_STRICT_PCREL)
+			{
+				UML_MOV(block, I0, scratch);                                        // mov     i0,scratch
+				UML_CALLH(block, *m_read16);                                        // callh   read16
+				UML_SEXT(block, R32(Rn), I0, SIZE_WORD);                            // sext    Rn,i0,word
+				generate_irq_check(block, compiler, desc);
+			}
+			else
+				UML_MOV(block, R32(Rn), (UINT32)(INT32)(INT16)RW(scratch));         // mov     Rn,<value>
+			return TRUE;
+
+		case 10:    // BRA
+			UML_MOV(block, mem(&m_sh4_state->pc), desc->targetpc);                  // mov     [pc],targetpc
+			generate_branch(block, compiler, desc);
+			return TRUE;
+
+		case 11:    // BSR
+			UML_MOV(block, mem(&m_sh4_state->pr), desc->pc + 4);                    // mov     [pr],desc->pc + 4
+			UML_MOV(block, mem(&m_sh4_state->pc), desc->targetpc);                  // mov     [pc],targetpc
+			generate_branch(block, compiler, desc);
+			return TRUE;
+
+		case 12:
+			return generate_group_12(block, compiler, desc, opcode);
+
+		case 13:    // MOVLI
+			if (in_delay_slot)
+				return FALSE;
+			scratch = ((desc->pc + 4) & ~3) + (opcode & 0xff) * 4;
+			if (m_drcoptions & SH4DRC_STRICT_PCREL)
+			{
+				UML_MOV(block, I0, scratch);                                        // mov     i0,scratch
+				UML_CALLH(block, *m_read32);                                        // callh   read32
+				UML_MOV(block, R32(Rn), I0);                                        // mov     Rn,i0
+				generate_irq_check(block, compiler, desc);
+			}
+			else
+				UML_MOV(block, R32(Rn), RL(scratch));                               // mov     Rn,<value>
+			return TRUE;
+
+		case 14:    // MOVI
+			UML_MOV(block, R32(Rn), (UINT32)(INT32)(INT8)(opcode & 0xff));          // mov     Rn,simm
+			return TRUE;
+
+		case 15:
+			return generate_group_15(block, compiler, desc, opcode);
+	}
+
+	return FALSE;
+}
+
+
+int sh34_base_device::generate_group_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode)
+{
+	switch (opcode & 0x0f)
+	{
+	case 0x00: // NOP();
+	case 0x01: // NOP();
+		return TRUE;
+
+	case 0x02:
+		switch ((opcode >> 4) & 0x0f)
+		{
+		case 0x01: // STCGBR(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->gbr));                        // mov     Rn,[gbr]
+			return TRUE;
+
+		case 0x02: // STCVBR(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->vbr));                        // mov     Rn,[vbr]
+			return TRUE;
+
+		case 0x05: // NOP();
+		case 0x06: // NOP();
+		case 0x07: // NOP();
+			return TRUE;
+		}
+		return FALSE;
+
+	case 0x03:
+		switch ((opcode >> 4) & 0x0f)
+		{
+		case 0x00: // BSRF(Rn);
+			UML_ADD(block, mem(&m_sh4_state->pc), R32(Rn), desc->pc + 4);           // add     [pc],Rn,desc->pc + 4
+			UML_MOV(block, mem(&m_sh4_state->pr), desc->pc + 4);                    // mov     [pr],desc->pc + 4
+			generate_branch(block, compiler, desc);
+			return TRUE;
+
+		case 0x02: // BRAF(Rn);
+			UML_ADD(block, mem(&m_sh4_state->pc), R32(Rn), desc->pc + 4);           // add     [pc],Rn,desc->pc + 4
+			generate_branch(block, compiler, desc);
+			return TRUE;
+
+		case 0x08: // PREFM(Rn);
+		case 0x09: // TODO
+		case 0x0a: // TODO
+		case 0x0b: // TODO
+		case 0x0c: // MOVCAL(Rn);
+			return FALSE;
+		}
+		return TRUE;
+
+	case 0x04: // MOVBS0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rn));                                        // add     i0,R0,Rn
+		UML_AND(block, I1, R32(Rm), 0x000000ff);                                    // and     i1,Rm,0xff
+		UML_CALLH(block, *m_write8);                                                // callh   write8
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case 0x05: // MOVWS0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rn));                                        // add     i0,R0,Rn
+		UML_AND(block, I1, R32(Rm), 0x0000ffff);                                    // and     i1,Rm,0xffff
+		UML_CALLH(block, *m_write16);                                               // callh   write16
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case 0x06: // MOVLS0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rn));                                        // add     i0,R0,Rn
+		UML_MOV(block, I1, R32(Rm));                                                // mov     i1,Rm
+		UML_CALLH(block, *m_write32);                                               // callh   write32
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case 0x07: // MULL(Rm, Rn);
+		UML_MULU(block, mem(&m_sh4_state->macl), mem(&m_sh4_state->ea), R32(Rn), R32(Rm)); // mulu    [macl],[ea],Rn,Rm
+		return TRUE;
+
+	case 0x08:
+		switch ((opcode >> 4) & 0x07)
+		{
+		case 0x00: // CLRT();
+			UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);       // and     [sr],[sr],~T
+			return TRUE;
+
+		case 0x01: // SETT();
+			UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), T);         // or      [sr],[sr],T
+			return TRUE;
+
+		case 0x02: // CLRMAC();
+			UML_MOV(block, mem(&m_sh4_state->macl), 0);                             // mov     [macl],0
+			UML_MOV(block, mem(&m_sh4_state->mach), 0);                             // mov     [mach],0
+			return TRUE;
+
+		case 0x04: // CLRS();
+			UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~S);       // and     [sr],[sr],~S
+			return TRUE;
+
+		case 0x05: // SETS();
+			UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), S);         // or      [sr],[sr],S
+			return TRUE;
+
+		case 0x03: // TODO
+			return FALSE;
+		}
+		return TRUE;
+
+	case 0x09:
+		switch ((opcode >> 4) & 0x03)
+		{
+		case 0x01: // DIV0U();
+			UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~(M|Q|T)); // and     [sr],[sr],~(M|Q|T)
+			return TRUE;
+
+		case 0x02: // MOVT(Rn);
+			UML_AND(block, R32(Rn), mem(&m_sh4_state->sr), T);                      // and     Rn,[sr],T
+			return TRUE;
+		}
+		return TRUE;
+
+	case 0x0a:
+		switch ((opcode >> 4) & 0x07)
+		{
+		case 0x00: // STSMACH(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->mach));                       // mov     Rn,[mach]
+			return TRUE;
+
+		case 0x01: // STSMACL(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->macl));                       // mov     Rn,[macl]
+			return TRUE;
+
+		case 0x02: // STSPR(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->pr));                         // mov     Rn,[pr]
+			return TRUE;
+
+		case 0x04: // NOP();
+			return TRUE;
+
+		case 0x05: // STSFPUL(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->fpul));                       // mov     Rn,[fpul]
+			return TRUE;
+
+		case 0x06: // STSFPSCR(Rn);
+			UML_AND(block, R32(Rn), mem(&m_sh4_state->fpscr), 0x003fffff);         // and     Rn,[fpscr],0x003fffff
+			return TRUE;
+		}
+		return FALSE;
+
+	case 0x0b:
+		switch ((opcode >> 4) & 0x03)
+		{
+		case 0x00: // RTS();
+			UML_MOV(block, mem(&m_sh4_state->pc), mem(&m_sh4_state->pr));           // mov     [pc],[pr]
+			generate_branch(block, compiler, desc);
+			return TRUE;
+
+		case 0x03: // NOP();
+			return TRUE;
+		}
+		return FALSE;
+
+	case 0x0c: // MOVBL0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rm));                                        // add     i0,R0,Rm
+		UML_CALLH(block, *m_read8);                                                 // callh   read8
+		UML_SEXT(block, R32(Rn), I0, SIZE_BYTE);                                    // sext    Rn,i0,byte
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case 0x0d: // MOVWL0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rm));                                        // add     i0,R0,Rm
+		UML_CALLH(block, *m_read16);                                                // callh   read16
+		UML_SEXT(block, R32(Rn), I0, SIZE_WORD);                                    // sext    Rn,i0,word
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case 0x0e: // MOVLL0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rm));                                        // add     i0,R0,Rm
+		UML_CALLH(block, *m_read32);                                                // callh   read32
+		UML_MOV(block, R32(Rn), I0);                                                // mov     Rn,i0
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case 0x0f: // MAC_L(Rm, Rn);
+		return FALSE;
+	}
+
+	return FALSE;
+}
+
+
+int sh34_base_device::generate_group_2(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode)
+{
+	switch (opcode & 15)
+	{
+	case  0: // MOVBS(Rm, Rn);
+		UML_MOV(block, I0, R32(Rn));                                                // mov     i0,Rn
+		UML_AND(block, I1, R32(Rm), 0xff);                                          // and     i1,Rm,0xff
+		UML_CALLH(block, *m_write8);                                                // callh   write8
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  1: // MOVWS(Rm, Rn);
+		UML_MOV(block, I0, R32(Rn));                                                // mov     i0,Rn
+		UML_AND(block, I1, R32(Rm), 0xffff);                                        // and     i1,Rm,0xffff
+		UML_CALLH(block, *m_write16);                                               // callh   write16
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  2: // MOVLS(Rm, Rn);
+		UML_MOV(block, I0, R32(Rn));                                                // mov     i0,Rn
+		UML_MOV(block, I1, R32(Rm));                                                // mov     i1,Rm
+		UML_CALLH(block, *m_write32);                                               // callh   write32
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  3: // NOP();
+		return TRUE;
+
+	case  4: // MOVBM(Rm, Rn);
+		UML_AND(block, I1, R32(Rm), 0xff);                                          // and     i1,Rm,0xff
+		UML_SUB(block, R32(Rn), R32(Rn), 1);                                        // sub     Rn,Rn,1
+		UML_MOV(block, I0, R32(Rn));                                                // mov     i0,Rn
+		UML_CALLH(block, *m_write8);                                                // callh   write8
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  5: // MOVWM(Rm, Rn);
+		UML_AND(block, I1, R32(Rm), 0xffff);                                        // and     i1,Rm,0xffff
+		UML_SUB(block, R32(Rn), R32(Rn), 2);                                        // sub     Rn,Rn,2
+		UML_MOV(block, I0, R32(Rn));                                                // mov     i0,Rn
+		UML_CALLH(block, *m_write16);                                               // callh   write16
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  6: // MOVLM(Rm, Rn);
+		UML_MOV(block, I1, R32(Rm));                                                // mov     i1,Rm
+		UML_SUB(block, R32(Rn), R32(Rn), 4);                                        // sub     Rn,Rn,4
+		UML_MOV(block, I0, R32(Rn));                                                // mov     i0,Rn
+		UML_CALLH(block, *m_write32);                                               // callh   write32
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  7: // DIV0S(Rm, Rn);
+		UML_AND(block, I0, mem(&m_sh4_state->sr), ~(Q|M|T));                        // and     i0,[sr],~(Q|M|T)
+		UML_SHR(block, I1, R32(Rn), 31);                                            // shr     i1,Rn,31
+		UML_ROLINS(block, I0, I1, 8, Q);                                            // rolins  i0,i1,8,Q
+		UML_SHR(block, I1, R32(Rm), 31);                                            // shr     i1,Rm,31
+		UML_ROLINS(block, I0, I1, 9, M);                                            // rolins  i0,i1,9,M
+		UML_XOR(block, I1, R32(Rn), R32(Rm));                                       // xor     i1,Rn,Rm
+		UML_SHR(block, I1, I1, 31);                                                 // shr     i1,i1,31
+		UML_OR(block, mem(&m_sh4_state->sr), I0, I1);                               // or      [sr],i0,i1
+		return TRUE;
+
+	case  8: // TST(Rm, Rn);
+		UML_TEST(block, R32(Rn), R32(Rm));                                          // test    Rn,Rm
+		UML_SETc(block, COND_Z, I0);                                                // setz    i0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                         // rolins  [sr],i0,0,T
+		return TRUE;
+
+	case  9: // AND(Rm, Rn);
+		UML_AND(block, R32(Rn), R32(Rn), R32(Rm));                                  // and     Rn,Rn,Rm
+		return TRUE;
+
+	case 10: // XOR(Rm, Rn);
+		UML_XOR(block, R32(Rn), R32(Rn), R32(Rm));                                  // xor     Rn,Rn,Rm
+		return TRUE;
+
+	case 11: // OR(Rm, Rn);
+		UML_OR(block, R32(Rn), R32(Rn), R32(Rm));                                   // or      Rn,Rn,Rm
+		return TRUE;
+
+	case 12: // CMPSTR(Rm, Rn);
+		{
+			code_label settrue = compiler->labelnum++;
+			code_label done = compiler->labelnum++;
+
+			UML_XOR(block, I0, R32(Rn), R32(Rm));                                   // xor     i0,Rn,Rm
+			UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);       // and     [sr],[sr],~T
+			UML_TEST(block, I0, 0xff000000);                                        // test    i0,0xff000000
+			UML_JMPc(block, COND_Z, settrue);                                       // jz      settrue
+			UML_TEST(block, I0, 0x00ff0000);                                        // test    i0,0x00ff0000
+			UML_JMPc(block, COND_Z, settrue);                                       // jz      settrue
+			UML_TEST(block, I0, 0x0000ff00);                                        // test    i0,0x0000ff00
+			UML_JMPc(block, COND_Z, settrue);                                       // jz      settrue
+			UML_TEST(block, I0, 0x000000ff);                                        // test    i0,0x000000ff
+			UML_JMPc(block, COND_NZ, done);                                         // jnz     done
+			UML_LABEL(block, settrue);                                              // settrue:
+			UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), T);         // or      [sr],[sr],T
+			UML_LABEL(block, done);                                                 // done:
+		}
+		return TRUE;
+
+	case 13: // XTRCT(Rm, Rn);
+		UML_SHL(block, I0, R32(Rm), 16);                                            // shl     i0,Rm,16
+		UML_SHR(block, I1, R32(Rn), 16);                                            // shr     i1,Rn,16
+		UML_OR(block, R32(Rn), I0, I1);                                             // or      Rn,i0,i1
+		return TRUE;
+
+	case 14: // MULU(Rm, Rn);
+		UML_AND(block, I0, R32(Rm), 0xffff);                                        // and     i0,Rm,0xffff
+		UML_AND(block, I1, R32(Rn), 0xffff);                                        // and     i1,Rn,0xffff
+		UML_MULU(block, mem(&m_sh4_state->macl), mem(&m_sh4_state->ea), I0, I1);    // mulu    [macl],[ea],i0,i1
+		return TRUE;
+
+	case 15: // MULS(Rm, Rn);
+		UML_SEXT(block, I0, R32(Rm), SIZE_WORD);                                    // sext    i0,Rm,word
+		UML_SEXT(block, I1, R32(Rn), SIZE_WORD);                                    // sext    i1,Rn,word
+		UML_MULS(block, mem(&m_sh4_state->macl), mem(&m_sh4_state->ea), I0, I1);    // muls    [macl],[ea],i0,i1
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+
+int sh34_base_device::generate_group_3(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode)
+{
+	switch (opcode & 15)
+	{
+	case  0: // CMPEQ(Rm, Rn);
+		UML_CMP(block, R32(Rn), R32(Rm));                                           // cmp     Rn,Rm
+		UML_SETc(block, COND_E, I0);                                                // sete    i0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                         // rolins  [sr],i0,0,T
+		return TRUE;
+
+	case  2: // CMPHS(Rm, Rn);
+		UML_CMP(block, R32(Rn), R32(Rm));                                           // cmp     Rn,Rm
+		UML_SETc(block, COND_AE, I0);                                               // setae   i0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                         // rolins  [sr],i0,0,T
+		return TRUE;
+
+	case  3: // CMPGE(Rm, Rn);
+		UML_CMP(block, R32(Rn), R32(Rm));                                           // cmp     Rn,Rm
+		UML_SETc(block, COND_GE, I0);                                               // setge   i0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                         // rolins  [sr],i0,0,T
+		return TRUE;
+
+	case  6: // CMPHI(Rm, Rn);
+		UML_CMP(block, R32(Rn), R32(Rm));                                           // cmp     Rn,Rm
+		UML_SETc(block, COND_A, I0);                                                // seta    i0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                         // rolins  [sr],i0,0,T
+		return TRUE;
+
+	case  7: // CMPGT(Rm, Rn);
+		UML_CMP(block, R32(Rn), R32(Rm));                                           // cmp     Rn,Rm
+		UML_SETc(block, COND_G, I0);                                                // setg    i0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                         // rolins  [sr],i0,0,T
+		return TRUE;
+
+	case  1: // NOP();
+	case  9: // NOP();
+		return TRUE;
+
+	case  4: // DIV1(Rm, Rn);
+	case 11: // SUBV(Rm, Rn);
+	case 15: // ADDV(Rm, Rn);
+		return FALSE;
+
+	case  5: // DMULU(Rm, Rn);
+		UML_MULU(block, mem(&m_sh4_state->macl), mem(&m_sh4_state->mach), R32(Rn), R32(Rm)); // mulu    [macl],[mach],Rn,Rm
+		return TRUE;
+
+	case 13: // DMULS(Rm, Rn);
+		UML_MULS(block, mem(&m_sh4_state->macl), mem(&m_sh4_state->mach), R32(Rn), R32(Rm)); // muls    [macl],[mach],Rn,Rm
+		return TRUE;
+
+	case  8: // SUB(Rm, Rn);
+		UML_SUB(block, R32(Rn), R32(Rn), R32(Rm));                                  // sub     Rn,Rn,Rm
+		return TRUE;
+
+	case 12: // ADD(Rm, Rn);
+		UML_ADD(block, R32(Rn), R32(Rn), R32(Rm));                                  // add     Rn,Rn,Rm
+		return TRUE;
+
+	case 10: // SUBC(Rm, Rn);
+		UML_CARRY(block, mem(&m_sh4_state->sr), 0);                                 // carry   [sr],0
+		UML_SUBB(block, R32(Rn), R32(Rn), R32(Rm));                                 // subb    Rn,Rn,Rm
+		UML_SETc(block, COND_C, I0);                                                // setc    i0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                         // rolins  [sr],i0,0,T
+		return TRUE;
+
+	case 14: // ADDC(Rm, Rn);
+		UML_CARRY(block, mem(&m_sh4_state->sr), 0);                                 // carry   [sr],0
+		UML_ADDC(block, R32(Rn), R32(Rn), R32(Rm));                                 // addc    Rn,Rn,Rm
+		UML_SETc(block, COND_C, I0);                                                // setc    i0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                         // rolins  [sr],i0,0,T
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+
+int sh34_base_device::generate_group_4(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode)
+{
+	switch (opcode & 0x0f)
+	{
+	case 0x00:
+		switch ((opcode >> 4) & 0x03)
+		{
+		case 0x00: // SHLL(Rn);
+			UML_SHL(block, R32(Rn), R32(Rn), 1);                                    // shl     Rn,Rn,1
+			UML_SETc(block, COND_C, I0);                                            // setc    i0
+			UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                     // rolins  [sr],i0,0,T
+			return TRUE;
+
+		case 0x01: // DT(Rn);
+			UML_SUB(block, R32(Rn), R32(Rn), 1);                                    // sub     Rn,Rn,1
+			UML_SETc(block, COND_Z, I0);                                            // setz    i0
+			UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                     // rolins  [sr],i0,0,T
+			return TRUE;
+
+		case 0x02: // SHAL(Rn);
+			UML_SHR(block, I0, R32(Rn), 31);                                        // shr     i0,Rn,31
+			UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                     // rolins  [sr],i0,0,T
+			UML_SHL(block, R32(Rn), R32(Rn), 1);                                    // shl     Rn,Rn,1
+			return TRUE;
+		}
+		return TRUE;
+
+	case 0x01:
+		switch ((opcode >> 4) & 0x03)
+		{
+		case 0x00: // SHLR(Rn);
+			UML_SHR(block, R32(Rn), R32(Rn), 1);                                    // shr     Rn,Rn,1
+			UML_SETc(block, COND_C, I0);                                            // setc    i0
+			UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                     // rolins  [sr],i0,0,T
+			return TRUE;
+
+		case 0x01: // CMPPZ(Rn);
+			UML_CMP(block, R32(Rn), 0);                                             // cmp     Rn,0
+			UML_SETc(block, COND_GE, I0);                                           // setge   i0
+			UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                     // rolins  [sr],i0,0,T
+			return TRUE;
+
+		case 0x02: // SHAR(Rn);
+			UML_ROLINS(block, mem(&m_sh4_state->sr), R32(Rn), 0, T);                // rolins  [sr],Rn,0,T
+			UML_SAR(block, R32(Rn), R32(Rn), 1);                                    // sar     Rn,Rn,1
+			return TRUE;
+		}
+		return TRUE;
+
+	case 0x02:
+		switch ((opcode >> 4) & 0x0f)
+		{
+		case 0x00: // STSMMACH(Rn);
+			UML_MOV(block, I1, mem(&m_sh4_state->mach));                            // mov     i1,[mach]
+			break;
+		case 0x01: // STSMMACL(Rn);
+			UML_MOV(block, I1, mem(&m_sh4_state->macl));                            // mov     i1,[macl]
+			break;
+		case 0x02: // STSMPR(Rn);
+			UML_MOV(block, I1, mem(&m_sh4_state->pr));                              // mov     i1,[pr]
+			break;
+		case 0x05: // STSMFPUL(Rn);
+			UML_MOV(block, I1, mem(&m_sh4_state->fpul));                            // mov     i1,[fpul]
+			break;
+		case 0x06: // STSMFPSCR(Rn);
+			UML_AND(block, I1, mem(&m_sh4_state->fpscr), 0x003fffff);               // and     i1,[fpscr],0x003fffff
+			break;
+		case 0x03: // STCMSGR(Rn);
+		case 0x0f: // STCMDBR(Rn);
+			return FALSE;
+		default:   // NOP();
+			return TRUE;
+		}
+		UML_SUB(block, R32(Rn), R32(Rn), 4);                                        // sub     Rn,Rn,4
+		UML_MOV(block, I0, R32(Rn));                                                // mov     i0,Rn
+		UML_CALLH(block, *m_write32);                                               // callh   write32
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case 0x03:
+		switch ((opcode >> 4) & 0x0f)
+		{
+		case 0x01: // STCMGBR(Rn);
+			UML_MOV(block, I1, mem(&m_sh4_state->gbr));                             // mov     i1,[gbr]
+			break;
+		case 0x02: // STCMVBR(Rn);
+			UML_MOV(block, I1, mem(&m_sh4_state->vbr));                             // mov     i1,[vbr]
+			break;
+		case 0x05: // NOP();
+		case 0x06: // NOP();
+		case 0x07: // NOP();
+			return TRUE;
+		default:   // STCMSR / STCMSSR / STCMSPC / STCMRBANK
+			return FALSE;
+		}
+		UML_SUB(block, R32(Rn), R32(Rn), 4);                                        // sub     Rn,Rn,4
+		UML_MOV(block, I0, R32(Rn));                                                // mov     i0,Rn
+		UML_CALLH(block, *m_write32);                                               // callh   write32
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case 0x04:
+		switch ((opcode >> 4) & 0x03)
+		{
+		case 0x00: // ROTL(Rn);
+			UML_ROL(block, R32(Rn), R32(Rn), 1);                                    // rol     Rn,Rn,1
+			UML_SETc(block, COND_C, I0);                                            // setc    i0
+			UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                     // rolins  [sr],i0,0,T
+			return TRUE;
+
+		case 0x02: // ROTCL(Rn);
+			UML_CARRY(block, mem(&m_sh4_state->sr), 0);                             // carry   [sr],0
+			UML_ROLC(block, R32(Rn), R32(Rn), 1);                                   // rolc    Rn,Rn,1
+			UML_SETc(block, COND_C, I0);                                            // setc    i0
+			UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                     // rolins  [sr],i0,0,T
+			return TRUE;
+		}
+		return TRUE;
+
+	case 0x05:
+		switch ((opcode >> 4) & 0x03)
+		{
+		case 0x00: // ROTR(Rn);
+			UML_ROR(block, R32(Rn), R32(Rn), 1);                                    // ror     Rn,Rn,1
+			UML_SETc(block, COND_C, I0);                                            // setc    i0
+			UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                     // rolins  [sr],i0,0,T
+			return TRUE;
+
+		case 0x01: // CMPPL(Rn);
+			UML_CMP(block, R32(Rn), 0);                                             // cmp     Rn,0
+			UML_SETc(block, COND_G, I0);                                            // setg    i0
+			UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                     // rolins  [sr],i0,0,T
+			return TRUE;
+
+		case 0x02: // ROTCR(Rn);
+			UML_CARRY(block, mem(&m_sh4_state->sr), 0);                             // carry   [sr],0
+			UML_RORC(block, R32(Rn), R32(Rn), 1);                                   // rorc    Rn,Rn,1
+			UML_SETc(block, COND_C, I0);                                            // setc    i0
+			UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                     // rolins  [sr],i0,0,T
+			return TRUE;
+		}
+		return TRUE;
+
+	case 0x06:
+		switch ((opcode >> 4) & 0x0f)
+		{
+		case 0x00: // LDSMMACH(Rn);
+		case 0x01: // LDSMMACL(Rn);
+		case 0x02: // LDSMPR(Rn);
+		case 0x05: // LDSMFPUL(Rn);
+			break;
+		case 0x03: // NOP();
+		case 0x04: // NOP();
+		case 0x07: // NOP();
+		case 0x08: // NOP();
+		case 0x09: // NOP();
+		case 0x0a: // NOP();
+		case 0x0b: // NOP();
+		case 0x0c: // NOP();
+		case 0x0d: // NOP();
+		case 0x0e: // NOP();
+			return TRUE;
+		default:   // LDSMFPSCR / LDCMDBR
+			return FALSE;
+		}
+		UML_MOV(block, I0, R32(Rn));                                                // mov     i0,Rn
+		UML_CALLH(block, *m_read32);                                                // callh   read32
+		UML_ADD(block, R32(Rn), R32(Rn), 4);                                        // add     Rn,Rn,4
+		switch ((opcode >> 4) & 0x0f)
+		{
+		case 0x00: UML_MOV(block, mem(&m_sh4_state->mach), I0); break;              // mov     [mach],i0
+		case 0x01: UML_MOV(block, mem(&m_sh4_state->macl), I0); break;              // mov     [macl],i0
+		case 0x02: UML_MOV(block, mem(&m_sh4_state->pr), I0); break;                // mov     [pr],i0
+		case 0x05: UML_MOV(block, mem(&m_sh4_state->fpul), I0); break;              // mov     [fpul],i0
+		}
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case 0x07:
+		switch ((opcode >> 4) & 0x0f)
+		{
+		case 0x01: // LDCMGBR(Rn);
+		case 0x02: // LDCMVBR(Rn);
+			break;
+		case 0x05: // NOP();
+		case 0x06: // NOP();
+		case 0x07: // NOP();
+			return TRUE;
+		default:   // LDCMSR / LDCMSSR / LDCMSPC / LDCMRBANK
+			return FALSE;
+		}
+		UML_MOV(block, I0, R32(Rn));                                                // mov     i0,Rn
+		UML_CALLH(block, *m_read32);                                                // callh   read32
+		UML_ADD(block, R32(Rn), R32(Rn), 4);                                        // add     Rn,Rn,4
+		if (((opcode >> 4) & 0x0f) == 0x01)
+			UML_MOV(block, mem(&m_sh4_state->gbr), I0);                             // mov     [gbr],i0
+		else
+			UML_MOV(block, mem(&m_sh4_state->vbr), I0);                             // mov     [vbr],i0
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case 0x08:
+		switch ((opcode >> 4) & 0x03)
+		{
+		case 0x00: // SHLL2(Rn);
+			UML_SHL(block, R32(Rn), R32(Rn), 2);                                    // shl     Rn,Rn,2
+			return TRUE;
+		case 0x01: // SHLL8(Rn);
+			UML_SHL(block, R32(Rn), R32(Rn), 8);                                    // shl     Rn,Rn,8
+			return TRUE;
+		case 0x02: // SHLL16(Rn);
+			UML_SHL(block, R32(Rn), R32(Rn), 16);                                   // shl     Rn,Rn,16
+			return TRUE;
+		}
+		return TRUE;
+
+	case 0x09:
+		switch ((opcode >> 4) & 0x03)
+		{
+		case 0x00: // SHLR2(Rn);
+			UML_SHR(block, R32(Rn), R32(Rn), 2);                                    // shr     Rn,Rn,2
+			return TRUE;
+		case 0x01: // SHLR8(Rn);
+			UML_SHR(block, R32(Rn), R32(Rn), 8);                                    // shr     Rn,Rn,8
+			return TRUE;
+		case 0x02: // SHLR16(Rn);
+			UML_SHR(block, R32(Rn), R32(Rn), 16);                                   // shr     Rn,Rn,16
+			return TRUE;
+		}
+		return TRUE;
+
+	case 0x0a:
+		switch ((opcode >> 4) & 0x0f)
+		{
+		case 0x00: // LDSMACH(Rn);
+			UML_MOV(block, mem(&m_sh4_state->mach), R32(Rn));                       // mov     [mach],Rn
+			return TRUE;
+		case 0x01: // LDSMACL(Rn);
+			UML_MOV(block, mem(&m_sh4_state->macl), R32(Rn));                       // mov     [macl],Rn
+			return TRUE;
+		case 0x02: // LDSPR(Rn);
+			UML_MOV(block, mem(&m_sh4_state->pr), R32(Rn));                         // mov     [pr],Rn
+			return TRUE;
+		case 0x05: // LDSFPUL(Rn);
+			UML_MOV(block, mem(&m_sh4_state->fpul), R32(Rn));                       // mov     [fpul],Rn
+			return TRUE;
+		case 0x06: // LDSFPSCR(Rn);
+		case 0x0f: // LDCDBR(Rn);
+			return FALSE;
+		}
+		return TRUE;
+
+	case 0x0b:
+		switch ((opcode >> 4) & 0x03)
+		{
+		case 0x00: // JSR(Rn);
+			UML_MOV(block, mem(&m_sh4_state->pc), R32(Rn));                         // mov     [pc],Rn
+			UML_MOV(block, mem(&m_sh4_state->pr), desc->pc + 4);                    // mov     [pr],desc->pc + 4
+			generate_branch(block, compiler, desc);
+			return TRUE;
+
+		case 0x01: // TAS(Rn);
+			UML_MOV(block, I0, R32(Rn));                                            // mov     i0,Rn
+			UML_CALLH(block, *m_read8);                                             // callh   read8
+			UML_TEST(block, I0, 0xff);                                              // test    i0,0xff
+			UML_SETc(block, COND_Z, I1);                                            // setz    i1
+			UML_ROLINS(block, mem(&m_sh4_state->sr), I1, 0, T);                     // rolins  [sr],i1,0,T
+			UML_OR(block, I1, I0, 0x80);                                            // or      i1,i0,0x80
+			UML_MOV(block, I0, R32(Rn));                                            // mov     i0,Rn
+			UML_CALLH(block, *m_write8);                                            // callh   write8
+			generate_irq_check(block, compiler, desc);
+			return TRUE;
+
+		case 0x02: // JMP(Rn);
+			UML_MOV(block, mem(&m_sh4_state->pc), R32(Rn));                         // mov     [pc],Rn
+			generate_branch(block, compiler, desc);
+			return TRUE;
+		}
+		return TRUE;
+
+	case 0x0c: // SHAD(Rm, Rn);
+	case 0x0d: // SHLD(Rm, Rn);
+		return FALSE;
+
+	case 0x0e:
+		switch ((opcode >> 4) & 0x0f)
+		{
+		case 0x01: // LDCGBR(Rn);
+			UML_MOV(block, mem(&m_sh4_state->gbr), R32(Rn));                        // mov     [gbr],Rn
+			return TRUE;
+		case 0x02: // LDCVBR(Rn);
+			UML_MOV(block, mem(&m_sh4_state->vbr), R32(Rn));                        // mov     [vbr],Rn
+			return TRUE;
+		case 0x05: // NOP();
+		case 0x06: // NOP();
+		case 0x07: // NOP();
+			return TRUE;
+		}
+		return FALSE;
+
+	case 0x0f: // MAC_W(Rm, Rn);
+		return FALSE;
+	}
+
+	return FALSE;
+}
+
+
+int sh34_base_device::generate_group_6(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode)
+{
+	switch (opcode & 15)
+	{
+	case  0: // MOVBL(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));                                                // mov     i0,Rm
+		UML_CALLH(block, *m_read8);                                                 // callh   read8
+		UML_SEXT(block, R32(Rn), I0, SIZE_BYTE);                                    // sext    Rn,i0,byte
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  1: // MOVWL(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));                                                // mov     i0,Rm
+		UML_CALLH(block, *m_read16);                                                // callh   read16
+		UML_SEXT(block, R32(Rn), I0, SIZE_WORD);                                    // sext    Rn,i0,word
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  2: // MOVLL(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));                                                // mov     i0,Rm
+		UML_CALLH(block, *m_read32);                                                // callh   read32
+		UML_MOV(block, R32(Rn), I0);                                                // mov     Rn,i0
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  3: // MOV(Rm, Rn);
+		UML_MOV(block, R32(Rn), R32(Rm));                                           // mov     Rn,Rm
+		return TRUE;
+
+	case  4: // MOVBP(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));                                                // mov     i0,Rm
+		UML_CALLH(block, *m_read8);                                                 // callh   read8
+		UML_SEXT(block, R32(Rn), I0, SIZE_BYTE);                                    // sext    Rn,i0,byte
+		if (Rm != Rn)
+			UML_ADD(block, R32(Rm), R32(Rm), 1);                                    // add     Rm,Rm,1
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  5: // MOVWP(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));                                                // mov     i0,Rm
+		UML_CALLH(block, *m_read16);                                                // callh   read16
+		UML_SEXT(block, R32(Rn), I0, SIZE_WORD);                                    // sext    Rn,i0,word
+		if (Rm != Rn)
+			UML_ADD(block, R32(Rm), R32(Rm), 2);                                    // add     Rm,Rm,2
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  6: // MOVLP(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));                                                // mov     i0,Rm
+		UML_CALLH(block, *m_read32);                                                // callh   read32
+		UML_MOV(block, R32(Rn), I0);                                                // mov     Rn,i0
+		if (Rm != Rn)
+			UML_ADD(block, R32(Rm), R32(Rm), 4);                                    // add     Rm,Rm,4
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  7: // NOT(Rm, Rn);
+		UML_XOR(block, R32(Rn), R32(Rm), 0xffffffff);                               // xor     Rn,Rm,~0
+		return TRUE;
+
+	case  8: // SWAPB(Rm, Rn);
+		UML_AND(block, I0, R32(Rm), 0xffff0000);                                    // and     i0,Rm,0xffff0000
+		UML_AND(block, I1, R32(Rm), 0x000000ff);                                    // and     i1,Rm,0x000000ff
+		UML_AND(block, I2, R32(Rm), 0x0000ff00);                                    // and     i2,Rm,0x0000ff00
+		UML_SHL(block, I1, I1, 8);                                                  // shl     i1,i1,8
+		UML_SHR(block, I2, I2, 8);                                                  // shr     i2,i2,8
+		UML_OR(block, I0, I0, I1);                                                  // or      i0,i0,i1
+		UML_OR(block, R32(Rn), I0, I2);                                             // or      Rn,i0,i2
+		return TRUE;
+
+	case  9: // SWAPW(Rm, Rn);
+		UML_ROL(block, R32(Rn), R32(Rm), 16);                                       // rol     Rn,Rm,16
+		return TRUE;
+
+	case 10: // NEGC(Rm, Rn);
+		UML_CARRY(block, mem(&m_sh4_state->sr), 0);                                 // carry   [sr],0
+		UML_SUBB(block, R32(Rn), 0, R32(Rm));                                       // subb    Rn,0,Rm
+		UML_SETc(block, COND_C, I0);                                                // setc    i0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                         // rolins  [sr],i0,0,T
+		return TRUE;
+
+	case 11: // NEG(Rm, Rn);
+		UML_SUB(block, R32(Rn), 0, R32(Rm));                                        // sub     Rn,0,Rm
+		return TRUE;
+
+	case 12: // EXTUB(Rm, Rn);
+		UML_AND(block, R32(Rn), R32(Rm), 0x000000ff);                               // and     Rn,Rm,0xff
+		return TRUE;
+
+	case 13: // EXTUW(Rm, Rn);
+		UML_AND(block, R32(Rn), R32(Rm), 0x0000ffff);                               // and     Rn,Rm,0xffff
+		return TRUE;
+
+	case 14: // EXTSB(Rm, Rn);
+		UML_SEXT(block, R32(Rn), R32(Rm), SIZE_BYTE);                               // sext    Rn,Rm,byte
+		return TRUE;
+
+	case 15: // EXTSW(Rm, Rn);
+		UML_SEXT(block, R32(Rn), R32(Rm), SIZE_WORD);                               // sext    Rn,Rm,word
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+
+int sh34_base_device::generate_group_8(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode)
+{
+	switch (opcode & (15<<8))
+	{
+	case  0<< 8: // MOVBS4(opcode & 0x0f, Rm);
+		UML_ADD(block, I0, R32(Rm), opcode & 0x0f);                                 // add     i0,Rm,disp
+		UML_AND(block, I1, R32(0), 0xff);                                           // and     i1,R0,0xff
+		UML_CALLH(block, *m_write8);                                                // callh   write8
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  1<< 8: // MOVWS4(opcode & 0x0f, Rm);
+		UML_ADD(block, I0, R32(Rm), (opcode & 0x0f) * 2);                           // add     i0,Rm,disp*2
+		UML_AND(block, I1, R32(0), 0xffff);                                         // and     i1,R0,0xffff
+		UML_CALLH(block, *m_write16);                                               // callh   write16
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  2<< 8: // NOP();
+	case  3<< 8: // NOP();
+	case  6<< 8: // NOP();
+	case  7<< 8: // NOP();
+	case 10<< 8: // NOP();
+	case 12<< 8: // NOP();
+	case 14<< 8: // NOP();
+		return TRUE;
+
+	case  4<< 8: // MOVBL4(Rm, opcode & 0x0f);
+		UML_ADD(block, I0, R32(Rm), opcode & 0x0f);                                 // add     i0,Rm,disp
+		UML_CALLH(block, *m_read8);                                                 // callh   read8
+		UML_SEXT(block, R32(0), I0, SIZE_BYTE);                                     // sext    R0,i0,byte
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  5<< 8: // MOVWL4(Rm, opcode & 0x0f);
+		UML_ADD(block, I0, R32(Rm), (opcode & 0x0f) * 2);                           // add     i0,Rm,disp*2
+		UML_CALLH(block, *m_read16);                                                // callh   read16
+		UML_SEXT(block, R32(0), I0, SIZE_WORD);                                     // sext    R0,i0,word
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  8<< 8: // CMPIM(opcode & 0xff);
+		UML_CMP(block, R32(0), (UINT32)(INT32)(INT8)(opcode & 0xff));               // cmp     R0,simm
+		UML_SETc(block, COND_E, I0);                                                // sete    i0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                         // rolins  [sr],i0,0,T
+		return TRUE;
+
+	case  9<< 8: // BT(opcode & 0xff);
+	case 13<< 8: // BTS(opcode & 0xff);
+		generate_conditional_branch(block, compiler, desc, 1);
+		return TRUE;
+
+	case 11<< 8: // BF(opcode & 0xff);
+	case 15<< 8: // BFS(opcode & 0xff);
+		generate_conditional_branch(block, compiler, desc, 0);
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+
+int sh34_base_device::generate_group_12(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode)
+{
+	UINT32 disp = opcode & 0xff;
+
+	switch (opcode & (15<<8))
+	{
+	case  0<<8: // MOVBSG(opcode & 0xff);
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), disp);                           // add     i0,[gbr],disp
+		UML_AND(block, I1, R32(0), 0xff);                                           // and     i1,R0,0xff
+		UML_CALLH(block, *m_write8);                                                // callh   write8
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  1<<8: // MOVWSG(opcode & 0xff);
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), disp * 2);                       // add     i0,[gbr],disp*2
+		UML_AND(block, I1, R32(0), 0xffff);                                         // and     i1,R0,0xffff
+		UML_CALLH(block, *m_write16);                                               // callh   write16
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  2<<8: // MOVLSG(opcode & 0xff);
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), disp * 4);                       // add     i0,[gbr],disp*4
+		UML_MOV(block, I1, R32(0));                                                 // mov     i1,R0
+		UML_CALLH(block, *m_write32);                                               // callh   write32
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  3<<8: // TRAPA(opcode & 0xff);
+		return FALSE;
+
+	case  4<<8: // MOVBLG(opcode & 0xff);
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), disp);                           // add     i0,[gbr],disp
+		UML_CALLH(block, *m_read8);                                                 // callh   read8
+		UML_SEXT(block, R32(0), I0, SIZE_BYTE);                                     // sext    R0,i0,byte
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  5<<8: // MOVWLG(opcode & 0xff);
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), disp * 2);                       // add     i0,[gbr],disp*2
+		UML_CALLH(block, *m_read16);                                                // callh   read16
+		UML_SEXT(block, R32(0), I0, SIZE_WORD);                                     // sext    R0,i0,word
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  6<<8: // MOVLLG(opcode & 0xff);
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), disp * 4);                       // add     i0,[gbr],disp*4
+		UML_CALLH(block, *m_read32);                                                // callh   read32
+		UML_MOV(block, R32(0), I0);                                                 // mov     R0,i0
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case  7<<8: // MOVA(opcode & 0xff);
+		/* the interpreter computes this from the branch target in a delay slot */
+		if (desc->flags & OPFLAG_IN_DELAY_SLOT)
+			return FALSE;
+		UML_MOV(block, R32(0), ((desc->pc + 4) & ~3) + disp * 4);                   // mov     R0,address
+		return TRUE;
+
+	case  8<<8: // TSTI(opcode & 0xff);
+		UML_TEST(block, R32(0), disp);                                              // test    R0,disp
+		UML_SETc(block, COND_Z, I0);                                                // setz    i0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                         // rolins  [sr],i0,0,T
+		return TRUE;
+
+	case  9<<8: // ANDI(opcode & 0xff);
+		UML_AND(block, R32(0), R32(0), disp);                                       // and     R0,R0,disp
+		return TRUE;
+
+	case 10<<8: // XORI(opcode & 0xff);
+		UML_XOR(block, R32(0), R32(0), disp);                                       // xor     R0,R0,disp
+		return TRUE;
+
+	case 11<<8: // ORI(opcode & 0xff);
+		UML_OR(block, R32(0), R32(0), disp);                                        // or      R0,R0,disp
+		return TRUE;
+
+	case 12<<8: // TSTM(opcode & 0xff);
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr));                         // add     i0,R0,[gbr]
+		UML_CALLH(block, *m_read8);                                                 // callh   read8
+		UML_TEST(block, I0, disp);                                                  // test    i0,disp
+		UML_SETc(block, COND_Z, I0);                                                // setz    i0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                         // rolins  [sr],i0,0,T
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case 13<<8: // ANDM(opcode & 0xff);
+	case 14<<8: // XORM(opcode & 0xff);
+	case 15<<8: // ORM(opcode & 0xff);
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr));                         // add     i0,R0,[gbr]
+		UML_CALLH(block, *m_read8);                                                 // callh   read8
+		if ((opcode & (15<<8)) == (13<<8))
+			UML_AND(block, I1, I0, disp);                                           // and     i1,i0,disp
+		else if ((opcode & (15<<8)) == (14<<8))
+			UML_XOR(block, I1, I0, disp);                                           // xor     i1,i0,disp
+		else
+			UML_OR(block, I1, I0, disp);                                            // or      i1,i0,disp
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr));                         // add     i0,R0,[gbr]
+		UML_CALLH(block, *m_write8);                                                // callh   write8
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+
+int sh34_base_device::generate_group_15(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode)
+{
+	code_label skip;
+
+	/* only single precision with 32-bit moves (PR = 0, SZ = 0) is generated natively */
+	if (compiler->mode != 0)
+		return FALSE;
+
+	switch (opcode & 0x0f)
+	{
+	case 0x00: // FADD(Rm, Rn);
+		UML_FSADD(block, FR32(Rn), FR32(Rn), FR32(Rm));                             // fsadd   FRn,FRn,FRm
+		return TRUE;
+
+	case 0x01: // FSUB(Rm, Rn);
+		UML_FSSUB(block, FR32(Rn), FR32(Rn), FR32(Rm));                             // fssub   FRn,FRn,FRm
+		return TRUE;
+
+	case 0x02: // FMUL(Rm, Rn);
+		UML_FSMUL(block, FR32(Rn), FR32(Rn), FR32(Rm));                             // fsmul   FRn,FRn,FRm
+		return TRUE;
+
+	case 0x03: // FDIV(Rm, Rn);
+		/* the interpreter leaves FRn alone when dividing by zero */
+		skip = compiler->labelnum++;
+		UML_FSCMP(block, FR32(Rm), mem(&m_sh4_state->fzero));                       // fscmp   FRm,[fzero]
+		UML_SETc(block, COND_E, I0);                                                // sete    i0
+		UML_SETc(block, COND_NU, I1);                                               // setnu   i1
+		UML_TEST(block, I0, I1);                                                    // test    i0,i1
+		UML_JMPc(block, COND_NZ, skip);                                             // jnz     skip
+		UML_FSDIV(block, FR32(Rn), FR32(Rn), FR32(Rm));                             // fsdiv   FRn,FRn,FRm
+		UML_LABEL(block, skip);                                                     // skip:
+		return TRUE;
+
+	case 0x04: // FCMP_EQ(Rm, Rn);
+		UML_FSCMP(block, FR32(Rn), FR32(Rm));                                       // fscmp   FRn,FRm
+		UML_SETc(block, COND_E, I0);                                                // sete    i0
+		UML_SETc(block, COND_NU, I1);                                               // setnu   i1
+		UML_AND(block, I0, I0, I1);                                                 // and     i0,i0,i1
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                         // rolins  [sr],i0,0,T
+		return TRUE;
+
+	case 0x05: // FCMP_GT(Rm, Rn);
+		UML_FSCMP(block, FR32(Rn), FR32(Rm));                                       // fscmp   FRn,FRm
+		UML_SETc(block, COND_A, I0);                                                // seta    i0
+		UML_SETc(block, COND_NU, I1);                                               // setnu   i1
+		UML_AND(block, I0, I0, I1);                                                 // and     i0,i0,i1
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);                         // rolins  [sr],i0,0,T
+		return TRUE;
+
+	case 0x06: // FMOVS0FR(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rm));                                        // add     i0,R0,Rm
+		UML_CALLH(block, *m_read32);                                                // callh   read32
+		UML_MOV(block, FR32(Rn), I0);                                               // mov     FRn,i0
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case 0x07: // FMOVFRS0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rn));                                        // add     i0,R0,Rn
+		UML_MOV(block, I1, FR32(Rm));                                               // mov     i1,FRm
+		UML_CALLH(block, *m_write32);                                               // callh   write32
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case 0x08: // FMOVMRFR(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));                                                // mov     i0,Rm
+		UML_CALLH(block, *m_read32);                                                // callh   read32
+		UML_MOV(block, FR32(Rn), I0);                                               // mov     FRn,i0
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case 0x09: // FMOVMRIFR(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));                                                // mov     i0,Rm
+		UML_CALLH(block, *m_read32);                                                // callh   read32
+		UML_MOV(block, FR32(Rn), I0);                                               // mov     FRn,i0
+		UML_ADD(block, R32(Rm), R32(Rm), 4);                                        // add     Rm,Rm,4
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case 0x0a: // FMOVFRMR(Rm, Rn);
+		UML_MOV(block, I0, R32(Rn));                                                // mov     i0,Rn
+		UML_MOV(block, I1, FR32(Rm));                                               // mov     i1,FRm
+		UML_CALLH(block, *m_write32);                                               // callh   write32
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case 0x0b: // FMOVFRMDR(Rm, Rn);
+		UML_SUB(block, R32(Rn), R32(Rn), 4);                                        // sub     Rn,Rn,4
+		UML_MOV(block, I0, R32(Rn));                                                // mov     i0,Rn
+		UML_MOV(block, I1, FR32(Rm));                                               // mov     i1,FRm
+		UML_CALLH(block, *m_write32);                                               // callh   write32
+		generate_irq_check(block, compiler, desc);
+		return TRUE;
+
+	case 0x0c: // FMOVFR(Rm, Rn);
+		UML_MOV(block, FR32(Rn), FR32(Rm));                                         // mov     FRn,FRm
+		return TRUE;
+
+	case 0x0d:
+		switch ((opcode >> 4) & 0x0f)
+		{
+		case 0x00: // FSTS(Rn);
+			UML_MOV(block, FR32(Rn), mem(&m_sh4_state->fpul));                      // mov     FRn,[fpul]
+			return TRUE;
+
+		case 0x01: // FLDS(Rn);
+			UML_MOV(block, mem(&m_sh4_state->fpul), FR32(Rn));                      // mov     [fpul],FRn
+			return TRUE;
+
+		case 0x02: // FLOAT(Rn);
+			UML_FSFRINT(block, FR32(Rn), mem(&m_sh4_state->fpul), SIZE_DWORD);      // fsfrint FRn,[fpul],dword
+			return TRUE;
+
+		case 0x03: // FTRC(Rn);
+			UML_FSTOINT(block, mem(&m_sh4_state->fpul), FR32(Rn), SIZE_DWORD, ROUND_TRUNC); // fstoint [fpul],FRn,dword,trunc
+			return TRUE;
+
+		case 0x04: // FNEG(Rn);
+			UML_XOR(block, FR32(Rn), FR32(Rn), 0x80000000);                         // xor     FRn,FRn,0x80000000
+			return TRUE;
+
+		case 0x05: // FABS(Rn);
+			UML_AND(block, FR32(Rn), FR32(Rn), 0x7fffffff);                         // and     FRn,FRn,0x7fffffff
+			return TRUE;
+
+		case 0x06: // FSQRT(Rn);
+			/* the interpreter leaves negative values alone */
+			skip = compiler->labelnum++;
+			UML_FSCMP(block, FR32(Rn), mem(&m_sh4_state->fzero));                   // fscmp   FRn,[fzero]
+			UML_SETc(block, COND_B, I0);                                            // setb    i0
+			UML_SETc(block, COND_NU, I1);                                           // setnu   i1
+			UML_TEST(block, I0, I1);                                                // test    i0,i1
+			UML_JMPc(block, COND_NZ, skip);                                         // jnz     skip
+			UML_FSSQRT(block, FR32(Rn), FR32(Rn));                                  // fssqrt  FRn,FRn
+			UML_LABEL(block, skip);                                                 // skip:
+			return TRUE;
+
+		case 0x08: // FLDI0(Rn);
+			UML_MOV(block, FR32(Rn), 0);                                            // mov     FRn,0
+			return TRUE;
+
+		case 0x09: // FLDI1(Rn);
+			UML_MOV(block, FR32(Rn), 0x3f800000);                                   // mov     FRn,1.0f
+			return TRUE;
+
+		case 0x0e: // FIPR(Rn);
+			{
+				UINT32 n = Rn & 12;
+				UINT32 m = (Rn & 3) << 2;
+
+				UML_FSMUL(block, F0, FR32(n + 0), FR32(m + 0));                     // fsmul   f0,FRn+0,FRm+0
+				UML_FSMUL(block, F1, FR32(n + 1), FR32(m + 1));                     // fsmul   f1,FRn+1,FRm+1
+				UML_FSMUL(block, F2, FR32(n + 2), FR32(m + 2));                     // fsmul   f2,FRn+2,FRm+2
+				UML_FSMUL(block, F3, FR32(n + 3), FR32(m + 3));                     // fsmul   f3,FRn+3,FRm+3
+				UML_FSADD(block, F0, F0, F1);                                       // fsadd   f0,f0,f1
+				UML_FSADD(block, F0, F0, F2);                                       // fsadd   f0,f0,f2
+				UML_FSADD(block, FR32(n + 3), F0, F3);                              // fsadd   FRn+3,f0,f3
+			}
+			return TRUE;
+
+		case 0x0f:
+			/* FTRV; FSCHG, FRCHG and FSSCA are interpreted */
+			if ((opcode & 0x300) == 0x100)
+			{
+				UINT32 n = Rn & 12;
+
+				for (int i = 0; i < 4; i++)
+				{
+					UML_FSMOV(block, F4, mem(&m_sh4_state->fzero));                 // fsmov   f4,[fzero]
+					for (int j = 0; j < 4; j++)
+					{
+						UML_FSMUL(block, F5, XF32((j << 2) + i), FR32(n + j));      // fsmul   f5,XF,FRn+j
+						UML_FSADD(block, F4, F4, F5);                               // fsadd   f4,f4,f5
+					}
+					UML_FSMOV(block, (i == 0) ? F0 : (i == 1) ? F1 : (i == 2) ? F2 : F3, F4); // fsmov   f<i>,f4
+				}
+				UML_FSMOV(block, FR32(n + 0), F0);                                  // fsmov   FRn+0,f0
+				UML_FSMOV(block, FR32(n + 1), F1);                                  // fsmov   FRn+1,f1
+				UML_FSMOV(block, FR32(n + 2), F2);                                  // fsmov   FRn+2,f2
+				UML_FSMOV(block, FR32(n + 3), F3);                                  // fsmov   FRn+3,f3
+				return TRUE;
+			}
+			return FALSE;
+		}
+		return FALSE;
+
+	case 0x0e: // FMAC(Rm, Rn);
+		UML_FSMUL(block, F0, FR32(0), FR32(Rm));                                    // fsmul   f0,FR0,FRm
+		UML_FSADD(block, FR32(Rn), F0, FR32(Rn));                                   // fsadd   FRn,f0,FRn
+		return TRUE;
+	}
+
+	return FALSE;
+}
@@ -0,0 +1,1037 @@
+// license:BSD-3-Clause
+// copyright-holders:R. Belmont
+/***************************************************************************
+
+    sh4fe.c
+
+    Front end for SH-4 recompiler
+
+    Derived from the SH-2 front end, extended with the SH-4 control
+    registers, banked registers and the FPU.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "sh4.h"
+#include "sh4comn.h"
+#include "cpu/drcfe.h"
+
+
+/***************************************************************************
+    INSTRUCTION PARSERS
+***************************************************************************/
+
+sh4_frontend::sh4_frontend(sh34_base_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence)
+	: drc_frontend(*device, window_start, window_end, max_sequence)
+	, m_sh4(device)
+{
+}
+
+/*-------------------------------------------------
+    describe_instruction - build a description
+    of a single instruction
+-------------------------------------------------*/
+
+bool sh4_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	UINT16 opcode;
+
+	/* fetch the opcode; addresses are masked to 29 bits like the interpreter's fetch */
+	desc.physpc = desc.pc & AM;
+	opcode = desc.opptr.w[0] = m_sh4->m_direct->read_decrypted_word(desc.physpc, m_sh4->m_fetch_xor);
+
+	/* all instructions are 2 bytes and most are a single cycle */
+	desc.length = 2;
+	desc.cycles = 1;
+
+	switch (opcode>>12)
+	{
+		case  0:
+			return describe_group_0(desc, prev, opcode);
+
+		case  1:    // MOVLS4
+			desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(Rm);
+			desc.flags |= OPFLAG_WRITES_MEMORY;
+			return true;
+
+		case  2:
+			return describe_group_2(desc, prev, opcode);
+
+		case  3:
+			return describe_group_3(desc, prev, opcode);
+
+		case  4:
+			return describe_group_4(desc, prev, opcode);
+
+		case  5:    // MOVLL4
+			desc.regin[0] |= REGFLAG_R(Rm);
+			desc.regout[0] |= REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_READS_MEMORY;
+			return true;
+
+		case  6:
+			return describe_group_6(desc, prev, opcode);
+
+		case  7:    // ADDI
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case  8:
+			return describe_group_8(desc, prev, opcode);
+
+		case  9:    // MOVWI
+			desc.regout[0] |= REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_READS_MEMORY;
+			return true;
+
+		case 11:    // BSR
+			desc.regout[1] |= REGFLAG_PR;
+			// (intentional fallthrough - BSR is BRA with the addition of PR = the return address)
+		case 10:    // BRA
+			{
+				INT32 disp = ((INT32)opcode << 20) >> 20;
+
+				desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+				desc.targetpc = (desc.pc + 2) + disp * 2 + 2;
+				desc.delayslots = 1;
+				desc.cycles = 2;
+				return true;
+			}
+
+		case 12:
+			return describe_group_12(desc, prev, opcode);
+
+		case 13:    // MOVLI
+			desc.regout[0] |= REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_READS_MEMORY;
+			return true;
+
+		case 14:    // MOVI
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case 15:
+			return describe_group_15(desc, prev, opcode);
+	}
+
+	return false;
+}
+
+bool sh4_frontend::describe_group_0(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & 0x0f)
+	{
+	case 0x00: // NOP();
+	case 0x01: // NOP();
+		return true;
+
+	case 0x02:
+		switch ((opcode >> 4) & 0x0f)
+		{
+		case 0x00: // STCSR(Rn);
+			desc.regin[1] |= REGFLAG_SR;
+			break;
+		case 0x01: // STCGBR(Rn);
+			desc.regin[1] |= REGFLAG_GBR;
+			break;
+		case 0x02: // STCVBR(Rn);
+			desc.regin[1] |= REGFLAG_VBR;
+			break;
+		case 0x03: // STCSSR(Rn);
+			desc.regin[1] |= REGFLAG_SSR;
+			break;
+		case 0x04: // STCSPC(Rn);
+			desc.regin[1] |= REGFLAG_SPC;
+			break;
+		case 0x05: // NOP();
+		case 0x06: // NOP();
+		case 0x07: // NOP();
+			return true;
+		default:   // STCRBANK(Rm, Rn);
+			desc.regin[1] |= REGFLAG_SR;
+			break;
+		}
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x03:
+		switch ((opcode >> 4) & 0x0f)
+		{
+		case 0x00: // BSRF(Rn);
+			desc.regout[1] |= REGFLAG_PR;
+			// (intentional fallthrough)
+		case 0x02: // BRAF(Rn);
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			desc.delayslots = 1;
+			desc.cycles = 2;
+			return true;
+
+		case 0x08: // PREFM(Rn);
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_READS_MEMORY | OPFLAG_WRITES_MEMORY;
+			return true;
+
+		case 0x0c: // MOVCAL(Rn);
+			desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(0);
+			desc.flags |= OPFLAG_WRITES_MEMORY;
+			return true;
+
+		default:   // NOP() / TODO()
+			return true;
+		}
+
+	case 0x04: // MOVBS0(Rm, Rn);
+	case 0x05: // MOVWS0(Rm, Rn);
+	case 0x06: // MOVLS0(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn) | REGFLAG_R(0);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 0x07: // MULL(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(Rm);
+		desc.regout[1] |= REGFLAG_MACL;
+		desc.cycles = 2;
+		return true;
+
+	case 0x08:
+		switch ((opcode >> 4) & 0x07)
+		{
+		case 0x00: // CLRT();
+		case 0x01: // SETT();
+		case 0x04: // CLRS();
+		case 0x05: // SETS();
+			desc.regin[1] |= REGFLAG_SR;
+			desc.regout[1] |= REGFLAG_SR;
+			return true;
+
+		case 0x02: // CLRMAC();
+			desc.regout[1] |= REGFLAG_MACL | REGFLAG_MACH;
+			return true;
+
+		default:   // NOP() / TODO()
+			return true;
+		}
+
+	case 0x09:
+		switch ((opcode >> 4) & 0x03)
+		{
+		case 0x01: // DIV0U();
+			desc.regin[1] |= REGFLAG_SR;
+			desc.regout[1] |= REGFLAG_SR;
+			return true;
+
+		case 0x02: // MOVT(Rn);
+			desc.regin[1] |= REGFLAG_SR;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		default:   // NOP();
+			return true;
+		}
+
+	case 0x0a:
+		switch ((opcode >> 4) & 0x07)
+		{
+		case 0x00: // STSMACH(Rn);
+			desc.regin[1] |= REGFLAG_MACH;
+			break;
+		case 0x01: // STSMACL(Rn);
+			desc.regin[1] |= REGFLAG_MACL;
+			break;
+		case 0x02: // STSPR(Rn);
+			desc.regin[1] |= REGFLAG_PR;
+			break;
+		case 0x03: // STCSGR(Rn);
+			desc.regin[1] |= REGFLAG_SGR;
+			break;
+		case 0x05: // STSFPUL(Rn);
+			desc.regin[1] |= REGFLAG_FPUL;
+			break;
+		case 0x06: // STSFPSCR(Rn);
+			desc.regin[1] |= REGFLAG_FPSCR;
+			break;
+		case 0x07: // STCDBR(Rn);
+			desc.regin[1] |= REGFLAG_DBR;
+			break;
+		default:   // NOP();
+			return true;
+		}
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x0b:
+		switch ((opcode >> 4) & 0x03)
+		{
+		case 0x00: // RTS();
+			desc.regin[1] |= REGFLAG_PR;
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			desc.delayslots = 1;
+			desc.cycles = 2;
+			return true;
+
+		case 0x01: // SLEEP();
+			desc.flags |= OPFLAG_END_SEQUENCE;
+			desc.cycles = 3;
+			return true;
+
+		case 0x02: // RTE();
+			desc.regin[1] |= REGFLAG_SSR | REGFLAG_SPC;
+			desc.regout[1] |= REGFLAG_SR;
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE | OPFLAG_CAN_EXPOSE_EXTERNAL_INT;
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			desc.delayslots = 1;
+			desc.cycles = 2;
+			return true;
+
+		default:   // NOP();
+			return true;
+		}
+
+	case 0x0c: // MOVBL0(Rm, Rn);
+	case 0x0d: // MOVWL0(Rm, Rn);
+	case 0x0e: // MOVLL0(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(0);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case 0x0f: // MAC_L(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regin[1] |= REGFLAG_SR | REGFLAG_MACL | REGFLAG_MACH;
+		desc.regout[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_MACL | REGFLAG_MACH;
+		desc.flags |= OPFLAG_READS_MEMORY;
+		desc.cycles = 3;
+		return true;
+	}
+
+	return false;
+}
+
+bool sh4_frontend::describe_group_2(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & 15)
+	{
+	case  0: // MOVBS(Rm, Rn);
+	case  1: // MOVWS(Rm, Rn);
+	case  2: // MOVLS(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case  3: // NOP();
+		return true;
+
+	case  4: // MOVBM(Rm, Rn);
+	case  5: // MOVWM(Rm, Rn);
+	case  6: // MOVLM(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 13: // XTRCT(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case  7: // DIV0S(Rm, Rn);
+	case  8: // TST(Rm, Rn);
+	case 12: // CMPSTR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case  9: // AND(Rm, Rn);
+	case 10: // XOR(Rm, Rn);
+	case 11: // OR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 14: // MULU(Rm, Rn);
+	case 15: // MULS(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_MACL;
+		return true;
+	}
+
+	return false;
+}
+
+bool sh4_frontend::describe_group_3(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & 15)
+	{
+	case  0: // CMPEQ(Rm, Rn);
+	case  2: // CMPHS(Rm, Rn);
+	case  3: // CMPGE(Rm, Rn);
+	case  6: // CMPHI(Rm, Rn);
+	case  7: // CMPGT(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case  1: // NOP();
+	case  9: // NOP();
+		return true;
+
+	case  4: // DIV1(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case  5: // DMULU(Rm, Rn);
+	case 13: // DMULS(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_MACL | REGFLAG_MACH;
+		desc.cycles = 2;
+		return true;
+
+	case  8: // SUB(Rm, Rn);
+	case 12: // ADD(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 10: // SUBC(Rm, Rn);
+	case 11: // SUBV(Rm, Rn);
+	case 14: // ADDC(Rm, Rn);
+	case 15: // ADDV(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+	}
+	return false;
+}
+
+bool sh4_frontend::describe_group_4(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & 0x0f)
+	{
+	case 0x00:
+	case 0x01:
+		switch ((opcode >> 4) & 0x03)
+		{
+		case 0x00: // SHLL(Rn); / SHLR(Rn);
+		case 0x01: // DT(Rn); / CMPPZ(Rn);
+		case 0x02: // SHAL(Rn); / SHAR(Rn);
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.regin[1] |= REGFLAG_SR;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			desc.regout[1] |= REGFLAG_SR;
+			return true;
+
+		default:   // NOP();
+			return true;
+		}
+
+	case 0x02:
+		switch ((opcode >> 4) & 0x0f)
+		{
+		case 0x00: // STSMMACH(Rn);
+			desc.regin[1] |= REGFLAG_MACH;
+			break;
+		case 0x01: // STSMMACL(Rn);
+			desc.regin[1] |= REGFLAG_MACL;
+			break;
+		case 0x02: // STSMPR(Rn);
+			desc.regin[1] |= REGFLAG_PR;
+			break;
+		case 0x03: // STCMSGR(Rn);
+			desc.regin[1] |= REGFLAG_SGR;
+			break;
+		case 0x05: // STSMFPUL(Rn);
+			desc.regin[1] |= REGFLAG_FPUL;
+			break;
+		case 0x06: // STSMFPSCR(Rn);
+			desc.regin[1] |= REGFLAG_FPSCR;
+			break;
+		case 0x0f: // STCMDBR(Rn);
+			desc.regin[1] |= REGFLAG_DBR;
+			break;
+		default:   // NOP();
+			return true;
+		}
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 0x03:
+		switch ((opcode >> 4) & 0x0f)
+		{
+		case 0x00: // STCMSR(Rn);
+			desc.regin[1] |= REGFLAG_SR;
+			desc.cycles = 2;
+			break;
+		case 0x01: // STCMGBR(Rn);
+			desc.regin[1] |= REGFLAG_GBR;
+			desc.cycles = 2;
+			break;
+		case 0x02: // STCMVBR(Rn);
+			desc.regin[1] |= REGFLAG_VBR;
+			desc.cycles = 2;
+			break;
+		case 0x03: // STCMSSR(Rn);
+			desc.regin[1] |= REGFLAG_SSR;
+			break;
+		case 0x04: // STCMSPC(Rn);
+			desc.regin[1] |= REGFLAG_SPC;
+			break;
+		case 0x05: // NOP();
+		case 0x06: // NOP();
+		case 0x07: // NOP();
+			return true;
+		default:   // STCMRBANK(Rm, Rn);
+			desc.regin[1] |= REGFLAG_SR;
+			desc.cycles = 2;
+			break;
+		}
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 0x04:
+	case 0x05:
+		switch ((opcode >> 4) & 0x03)
+		{
+		case 0x00: // ROTL(Rn); / ROTR(Rn);
+		case 0x02: // ROTCL(Rn); / ROTCR(Rn);
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.regin[1] |= REGFLAG_SR;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			desc.regout[1] |= REGFLAG_SR;
+			return true;
+
+		case 0x01: // NOP(); / CMPPL(Rn);
+			if (opcode & 1)
+			{
+				desc.regin[0] |= REGFLAG_R(Rn);
+				desc.regin[1] |= REGFLAG_SR;
+				desc.regout[1] |= REGFLAG_SR;
+			}
+			return true;
+
+		default:   // NOP();
+			return true;
+		}
+
+	case 0x06:
+		switch ((opcode >> 4) & 0x0f)
+		{
+		case 0x00: // LDSMMACH(Rn);
+			desc.regout[1] |= REGFLAG_MACH;
+			break;
+		case 0x01: // LDSMMACL(Rn);
+			desc.regout[1] |= REGFLAG_MACL;
+			break;
+		case 0x02: // LDSMPR(Rn);
+			desc.regout[1] |= REGFLAG_PR;
+			break;
+		case 0x05: // LDSMFPUL(Rn);
+			desc.regout[1] |= REGFLAG_FPUL;
+			break;
+		case 0x06: // LDSMFPSCR(Rn);
+			desc.regout[1] |= REGFLAG_FPSCR;
+			desc.flags |= OPFLAG_END_SEQUENCE | OPFLAG_CAN_CHANGE_MODES;
+			break;
+		case 0x0f: // LDCMDBR(Rn);
+			desc.regout[1] |= REGFLAG_DBR;
+			break;
+		default:   // NOP();
+			return true;
+		}
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case 0x07:
+		switch ((opcode >> 4) & 0x0f)
+		{
+		case 0x00: // LDCMSR(Rn);
+			desc.regout[1] |= REGFLAG_SR;
+			desc.flags |= OPFLAG_CAN_EXPOSE_EXTERNAL_INT | OPFLAG_END_SEQUENCE;
+			desc.cycles = 3;
+			break;
+		case 0x01: // LDCMGBR(Rn);
+			desc.regout[1] |= REGFLAG_GBR;
+			desc.cycles = 3;
+			break;
+		case 0x02: // LDCMVBR(Rn);
+			desc.regout[1] |= REGFLAG_VBR;
+			desc.cycles = 3;
+			break;
+		case 0x03: // LDCMSSR(Rn);
+			desc.regout[1] |= REGFLAG_SSR;
+			break;
+		case 0x04: // LDCMSPC(Rn);
+			desc.regout[1] |= REGFLAG_SPC;
+			break;
+		case 0x05: // NOP();
+		case 0x06: // NOP();
+		case 0x07: // NOP();
+			return true;
+		default:   // LDCMRBANK(Rm, Rn);
+			desc.regin[1] |= REGFLAG_SR;
+			break;
+		}
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case 0x08: // SHLL2(Rn); / SHLL8(Rn); / SHLL16(Rn);
+	case 0x09: // SHLR2(Rn); / SHLR8(Rn); / SHLR16(Rn);
+		if (((opcode >> 4) & 0x03) != 0x03)
+		{
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.regout[0] |= REGFLAG_R(Rn);
+		}
+		return true;
+
+	case 0x0a:
+		switch ((opcode >> 4) & 0x0f)
+		{
+		case 0x00: // LDSMACH(Rn);
+			desc.regout[1] |= REGFLAG_MACH;
+			break;
+		case 0x01: // LDSMACL(Rn);
+			desc.regout[1] |= REGFLAG_MACL;
+			break;
+		case 0x02: // LDSPR(Rn);
+			desc.regout[1] |= REGFLAG_PR;
+			break;
+		case 0x05: // LDSFPUL(Rn);
+			desc.regout[1] |= REGFLAG_FPUL;
+			break;
+		case 0x06: // LDSFPSCR(Rn);
+			desc.regout[1] |= REGFLAG_FPSCR;
+			desc.flags |= OPFLAG_END_SEQUENCE | OPFLAG_CAN_CHANGE_MODES;
+			break;
+		case 0x0f: // LDCDBR(Rn);
+			desc.regout[1] |= REGFLAG_DBR;
+			break;
+		default:   // NOP();
+			return true;
+		}
+		desc.regin[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x0b:
+		switch ((opcode >> 4) & 0x03)
+		{
+		case 0x00: // JSR(Rn);
+			desc.regout[1] |= REGFLAG_PR;
+			desc.cycles = 2;
+			// (intentional fallthrough)
+		case 0x02: // JMP(Rn);
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			desc.delayslots = 1;
+			return true;
+
+		case 0x01: // TAS(Rn);
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.regin[1] |= REGFLAG_SR;
+			desc.regout[1] |= REGFLAG_SR;
+			desc.flags |= OPFLAG_READS_MEMORY | OPFLAG_WRITES_MEMORY;
+			desc.cycles = 4;
+			return true;
+
+		default:   // NOP();
+			return true;
+		}
+
+	case 0x0c: // SHAD(Rm, Rn);
+	case 0x0d: // SHLD(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x0e:
+		switch ((opcode >> 4) & 0x0f)
+		{
+		case 0x00: // LDCSR(Rn);
+			desc.regout[1] |= REGFLAG_SR;
+			desc.flags |= OPFLAG_CAN_EXPOSE_EXTERNAL_INT | OPFLAG_END_SEQUENCE;
+			break;
+		case 0x01: // LDCGBR(Rn);
+			desc.regout[1] |= REGFLAG_GBR;
+			break;
+		case 0x02: // LDCVBR(Rn);
+			desc.regout[1] |= REGFLAG_VBR;
+			break;
+		case 0x03: // LDCSSR(Rn);
+			desc.regout[1] |= REGFLAG_SSR;
+			break;
+		case 0x04: // LDCSPC(Rn);
+			desc.regout[1] |= REGFLAG_SPC;
+			break;
+		case 0x05: // NOP();
+		case 0x06: // NOP();
+		case 0x07: // NOP();
+			return true;
+		default:   // LDCRBANK(Rm, Rn);
+			desc.regin[1] |= REGFLAG_SR;
+			break;
+		}
+		desc.regin[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x0f: // MAC_W(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regin[1] |= REGFLAG_SR | REGFLAG_MACL | REGFLAG_MACH;
+		desc.regout[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_MACL | REGFLAG_MACH;
+		desc.flags |= OPFLAG_READS_MEMORY;
+		desc.cycles = 3;
+		return true;
+	}
+
+	return false;
+}
+
+bool sh4_frontend::describe_group_6(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & 15)
+	{
+	case  0: // MOVBL(Rm, Rn);
+	case  1: // MOVWL(Rm, Rn);
+	case  2: // MOVLL(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case  3: // MOV(Rm, Rn);
+	case  7: // NOT(Rm, Rn);
+	case  8: // SWAPB(Rm, Rn);
+	case  9: // SWAPW(Rm, Rn);
+	case 11: // NEG(Rm, Rn);
+	case 12: // EXTUB(Rm, Rn);
+	case 13: // EXTUW(Rm, Rn);
+	case 14: // EXTSB(Rm, Rn);
+	case 15: // EXTSW(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case  4: // MOVBP(Rm, Rn);
+	case  5: // MOVWP(Rm, Rn);
+	case  6: // MOVLP(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm);
+		desc.regout[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case 10: // NEGC(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+	}
+	return false;
+}
+
+bool sh4_frontend::describe_group_8(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	INT32 disp;
+
+	switch ( opcode  & (15<<8) )
+	{
+	case  0 << 8: // MOVBS4(opcode & 0x0f, Rm);
+	case  1 << 8: // MOVWS4(opcode & 0x0f, Rm);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(0);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case  2<< 8: // NOP();
+	case  3<< 8: // NOP();
+	case  6<< 8: // NOP();
+	case  7<< 8: // NOP();
+	case 10<< 8: // NOP();
+	case 12<< 8: // NOP();
+	case 14<< 8: // NOP();
+		return true;
+
+	case  4<< 8: // MOVBL4(Rm, opcode & 0x0f);
+	case  5<< 8: // MOVWL4(Rm, opcode & 0x0f);
+		desc.regin[0] |= REGFLAG_R(Rm);
+		desc.regout[0] |= REGFLAG_R(0);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case  8<< 8: // CMPIM(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case  9<< 8: // BT(opcode & 0xff);
+	case 11<< 8: // BF(opcode & 0xff);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+		disp = ((INT32)opcode << 24) >> 24;
+		desc.targetpc = (desc.pc + 2) + disp * 2 + 2;
+		return true;
+
+	case 13<< 8: // BTS(opcode & 0xff);
+	case 15<< 8: // BFS(opcode & 0xff);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+		disp = ((INT32)opcode << 24) >> 24;
+		desc.targetpc = (desc.pc + 2) + disp * 2 + 2;
+		desc.delayslots = 1;
+		return true;
+	}
+
+	return false;
+}
+
+bool sh4_frontend::describe_group_12(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & (15<<8))
+	{
+	case  0<<8: // MOVBSG(opcode & 0xff);
+	case  1<<8: // MOVWSG(opcode & 0xff);
+	case  2<<8: // MOVLSG(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regin[1] |= REGFLAG_GBR;
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case  3<<8: // TRAPA(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(15);
+		desc.regin[1] |= REGFLAG_SR | REGFLAG_VBR;
+		desc.regout[1] |= REGFLAG_SR | REGFLAG_SSR | REGFLAG_SPC | REGFLAG_SGR;
+		desc.cycles = 8;
+		desc.targetpc = BRANCH_TARGET_DYNAMIC;
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+		return true;
+
+	case  4<<8: // MOVBLG(opcode & 0xff);
+	case  5<<8: // MOVWLG(opcode & 0xff);
+	case  6<<8: // MOVLLG(opcode & 0xff);
+		desc.regin[1] |= REGFLAG_GBR;
+		desc.regout[0] |= REGFLAG_R(0);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case  7<<8: // MOVA(opcode & 0xff);
+		desc.regout[0] |= REGFLAG_R(0);
+		return true;
+
+	case  8<<8: // TSTI(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regin[1] |= REGFLAG_SR;
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case  9<<8: // ANDI(opcode & 0xff);
+	case 10<<8: // XORI(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regout[0] |= REGFLAG_R(0);
+		return true;
+
+	case 11<<8: // ORI(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regout[0] |= REGFLAG_R(0);
+		desc.cycles = 3;
+		return true;
+
+	case 12<<8: // TSTM(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regin[1] |= REGFLAG_SR | REGFLAG_GBR;
+		desc.regout[1] |= REGFLAG_SR;
+		desc.flags |= OPFLAG_READS_MEMORY;
+		desc.cycles = 3;
+		return true;
+
+	case 13<<8: // ANDM(opcode & 0xff);
+	case 14<<8: // XORM(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regin[1] |= REGFLAG_GBR;
+		desc.flags |= OPFLAG_READS_MEMORY | OPFLAG_WRITES_MEMORY;
+		desc.cycles = 3;
+		return true;
+
+	case 15<<8: // ORM(opcode & 0xff);
+		desc.regin[0] |= REGFLAG_R(0);
+		desc.regin[1] |= REGFLAG_GBR;
+		desc.flags |= OPFLAG_READS_MEMORY | OPFLAG_WRITES_MEMORY;
+		return true;
+	}
+	return false;
+}
+
+bool sh4_frontend::describe_group_15(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & 0x0f)
+	{
+	case 0x00: // FADD(Rm, Rn);
+	case 0x01: // FSUB(Rm, Rn);
+	case 0x02: // FMUL(Rm, Rn);
+	case 0x03: // FDIV(Rm, Rn);
+		desc.regin[1] |= REGFLAG_FPSCR;
+		desc.regin[2] |= REGFLAG_FR(Rm) | REGFLAG_FR(Rn);
+		desc.regout[2] |= REGFLAG_FR(Rn);
+		return true;
+
+	case 0x04: // FCMP_EQ(Rm, Rn);
+	case 0x05: // FCMP_GT(Rm, Rn);
+		desc.regin[1] |= REGFLAG_FPSCR | REGFLAG_SR;
+		desc.regin[2] |= REGFLAG_FR(Rm) | REGFLAG_FR(Rn);
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case 0x06: // FMOVS0FR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(0);
+		desc.regin[1] |= REGFLAG_FPSCR;
+		desc.regout[2] |= REGFLAG_FR(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case 0x07: // FMOVFRS0(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(0);
+		desc.regin[1] |= REGFLAG_FPSCR;
+		desc.regin[2] |= REGFLAG_FR(Rm);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 0x08: // FMOVMRFR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm);
+		desc.regin[1] |= REGFLAG_FPSCR;
+		desc.regout[2] |= REGFLAG_FR(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case 0x09: // FMOVMRIFR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm);
+		desc.regin[1] |= REGFLAG_FPSCR;
+		desc.regout[0] |= REGFLAG_R(Rm);
+		desc.regout[2] |= REGFLAG_FR(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case 0x0a: // FMOVFRMR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regin[1] |= REGFLAG_FPSCR;
+		desc.regin[2] |= REGFLAG_FR(Rm);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 0x0b: // FMOVFRMDR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regin[1] |= REGFLAG_FPSCR;
+		desc.regin[2] |= REGFLAG_FR(Rm);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 0x0c: // FMOVFR(Rm, Rn);
+		desc.regin[1] |= REGFLAG_FPSCR;
+		desc.regin[2] |= REGFLAG_FR(Rm);
+		desc.regout[2] |= REGFLAG_FR(Rn);
+		return true;
+
+	case 0x0d:
+		switch ((opcode >> 4) & 0x0f)
+		{
+		case 0x00: // FSTS(Rn);
+			desc.regin[1] |= REGFLAG_FPUL;
+			desc.regout[2] |= REGFLAG_FR(Rn);
+			return true;
+
+		case 0x01: // FLDS(Rn);
+			desc.regin[2] |= REGFLAG_FR(Rn);
+			desc.regout[1] |= REGFLAG_FPUL;
+			return true;
+
+		case 0x02: // FLOAT(Rn);
+			desc.regin[1] |= REGFLAG_FPSCR | REGFLAG_FPUL;
+			desc.regout[2] |= REGFLAG_FR(Rn) | REGFLAG_FR(Rn | 1);
+			return true;
+
+		case 0x03: // FTRC(Rn);
+			desc.regin[1] |= REGFLAG_FPSCR;
+			desc.regin[2] |= REGFLAG_FR(Rn) | REGFLAG_FR(Rn | 1);
+			desc.regout[1] |= REGFLAG_FPUL;
+			return true;
+
+		case 0x0a: // FCNVSD(Rn);
+			desc.regin[1] |= REGFLAG_FPSCR | REGFLAG_FPUL;
+			desc.regout[2] |= REGFLAG_FR(Rn) | REGFLAG_FR(Rn | 1);
+			return true;
+
+		case 0x0b: // FCNVDS(Rn);
+			desc.regin[1] |= REGFLAG_FPSCR;
+			desc.regin[2] |= REGFLAG_FR(Rn) | REGFLAG_FR(Rn | 1);
+			desc.regout[1] |= REGFLAG_FPUL;
+			return true;
+
+		case 0x0e: // FIPR(Rn);
+			desc.regin[2] |= 0xffff;
+			desc.regout[2] |= REGFLAG_FR((Rn & 12) + 3);
+			return true;
+
+		case 0x0f:
+			if ((opcode & 0x300) == 0x300)
+			{
+				// FSCHG(); / FRCHG();
+				desc.regin[1] |= REGFLAG_FPSCR;
+				desc.regout[1] |= REGFLAG_FPSCR;
+				desc.regout[2] |= 0xffff;
+				desc.flags |= OPFLAG_END_SEQUENCE | OPFLAG_CAN_CHANGE_MODES;
+			}
+			else if (opcode & 0x100)
+			{
+				// FTRV(Rn);
+				desc.regin[2] |= 0xffff;
+				desc.regout[2] |= 0xf << (Rn & 12);
+			}
+			else
+			{
+				// FSSCA(Rn);
+				desc.regin[1] |= REGFLAG_FPUL;
+				desc.regout[2] |= REGFLAG_FR(Rn) | REGFLAG_FR(Rn + 1);
+			}
+			return true;
+
+		case 0x0c: // dbreak();
+		case 0x0d: // dbreak();
+			return true;
+
+		default:   // FNEG / FABS / FSQRT / FSRRA / FLDI0 / FLDI1
+			desc.regin[1] |= REGFLAG_FPSCR;
+			desc.regin[2] |= REGFLAG_FR(Rn);
+			desc.regout[2] |= REGFLAG_FR(Rn) | REGFLAG_FR(Rn | 1);
+			return true;
+		}
+
+	case 0x0e: // FMAC(Rm, Rn);
+		desc.regin[1] |= REGFLAG_FPSCR;
+		desc.regin[2] |= REGFLAG_FR(0) | REGFLAG_FR(Rm) | REGFLAG_FR(Rn);
+		desc.regout[2] |= REGFLAG_FR(Rn);
+		return true;
+
+	case 0x0f: // dbreak();
+		return true;
+	}
+
+	return false;
+}
@@ -150,6 +150,7 @@ static void execute_snap(running_machine &machine, int ref, int params, const ch
 static void execute_source(running_machine &machine, int ref, int params, const char **param);
 static void execute_map(running_machine &machine, int ref, int params, const char **param);
 static void execute_memdump(running_machine &machine, int ref, int params, const char **param);
+static void execute_tlbstats(running_machine &machine, int ref, int params, const char **param);
 static void execute_symlist(running_machine &machine, int ref, int params, const char **param);
 static void execute_softreset(running_machine &machine, int ref, int params, const char **param);
 static void execute_hardreset(running_machine &machine, int ref, int params, const char **param);
@@ -390,6 +391,7 @@ void debug_command_init(running_machine &machine)
 	debug_console_register_command(machine, "mapd",      CMDFLAG_NONE, AS_DATA, 1, 1, execute_map);
 	debug_console_register_command(machine, "mapi",      CMDFLAG_NONE, AS_IO, 1, 1, execute_map);
 	debug_console_register_command(machine, "memdump",   CMDFLAG_NONE, 0, 0, 1, execute_memdump);
+	debug_console_register_command(machine, "tlbstats",  CMDFLAG_NONE, 0, 0, 1, execute_tlbstats);
 
 	debug_console_register_command(machine, "symlist",   CMDFLAG_NONE, 0, 0, 1, execute_symlist);
 
@@ -2916,6 +2918,37 @@ static void execute_memdump(running_machine &machine, int ref, int params, const
 }
 
 
+/*-------------------------------------------------
+    execute_tlbstats - execute the tlbstats
+    command
+-------------------------------------------------*/
+
+static void execute_tlbstats(running_machine &machine, int ref, int params, const char **param)
+{
+	device_t *cpu = NULL;
+
+	/* validate parameters */
+	if (!debug_command_parameter_cpu(machine, (params > 0) ? param[0] : NULL, &cpu))
+		return;
+
+	/* report the read and write statistics for each space */
+	for (int spacenum = 0; spacenum < ADDRESS_SPACES; spacenum++)
+		if (cpu->memory().has_space(spacenum))
+		{
+			address_space &space = cpu->memory().space(spacenum);
+			for (int readorwrite = ROW_READ; readorwrite <= ROW_WRITE; readorwrite++)
+			{
+				UINT64 hits, misses;
+				space.tlb_stats(read_or_write(readorwrite), hits, misses);
+				UINT64 total = hits + misses;
+				debug_console_printf(machine, "%-8s %-5s: %10" I64FMT "u hits, %10" I64FMT "u misses (%.1f%% hit rate)\n",
+						space.name(), (readorwrite == ROW_READ) ? "read" : "write", hits, misses,
+						(total != 0) ? 100.0 * (double)hits / (double)total : 0.0);
+			}
+		}
+}
+
+
 /*-------------------------------------------------
     execute_symlist - execute the symlist command
 -------------------------------------------------*/
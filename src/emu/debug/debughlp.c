@@ -123,6 +123,7 @@ static const help_item static_help_list[] =
 		"  mapd <address> -- map logical data address to physical address and bank\n"
 		"  mapi <address> -- map logical I/O address to physical address and bank\n"
 		"  memdump [<filename>] -- dump the current memory map to <filename>\n"
+		"  tlbstats [<cpu>] -- show memory dispatch TLB hit rates for <cpu>\n"
 	},
 	{
 		"execution",
@@ -1223,6 +1224,23 @@ static const help_item static_help_list[] =
 		"memdump\n"
 		"  Dumps memory to memdump.log.\n"
 	},
+	{
+		"tlbstats",
+		"\n"
+		"  tlbstats [<cpu>]\n"
+		"\n"
+		"Shows how often reads and writes in each address space of <cpu> were resolved by the memory "
+		"system's software TLB instead of the full address table. Pages that map entirely to RAM are "
+		"accessed directly on a hit. If <cpu> is omitted, the currently visible CPU is used.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"tlbstats\n"
+		"  Shows TLB statistics for the currently visible CPU.\n"
+		"\n"
+		"tlbstats 1\n"
+		"  Shows TLB statistics for CPU #1.\n"
+	},
 	{
 		"comadd",
 		"\n"
@@ -44,6 +44,7 @@ const int TRIGGER_SUSPENDTIME   = -4000;
 device_execute_interface::device_execute_interface(const machine_config &mconfig, device_t &device)
 	: device_interface(device, "execute"),
 		m_disabled(false),
+		m_parallel(false),
 		m_vblank_interrupt_screen(NULL),
 		m_timed_interrupt_period(attotime::zero),
 		m_is_octal(false),
@@ -53,6 +54,7 @@ device_execute_interface::device_execute_interface(const machine_config &mconfig
 		m_icountptr(NULL),
 		m_cycles_running(0),
 		m_cycles_stolen(0),
+		m_parallel_executing(false),
 		m_suspend(0),
 		m_nextsuspend(0),
 		m_eatcycles(0),
@@ -95,6 +97,21 @@ void device_execute_interface::static_set_disable(device_t &device)
 }
 
 
+//-------------------------------------------------
+//  static_set_parallel - configuration helper to
+//  allow a device to execute concurrently with
+//  other parallel devices
+//-------------------------------------------------
+
+void device_execute_interface::static_set_parallel(device_t &device)
+{
+	device_execute_interface *exec;
+	if (!device.interface(exec))
+		throw emu_fatalerror("MCFG_DEVICE_PARALLEL_EXECUTE called on device '%s' with no execute interface", device.tag());
+	exec->m_parallel = true;
+}
+
+
 //-------------------------------------------------
 //  static_set_vblank_int - configuration helper
 //  to set up VBLANK interrupts on the device
@@ -239,6 +256,8 @@ void device_execute_interface::suspend_resume_changed()
 void device_execute_interface::suspend(UINT32 reason, bool eatcycles)
 {
 if (TEMPLOG) printf("suspend %s (%X)\n", device().tag(), reason);
+	m_scheduler->validate_parallel_access(*this, "suspended");
+
 	// set the suspend reason and eat cycles flag
 	m_nextsuspend |= reason;
 	m_nexteatcycles = eatcycles;
@@ -254,6 +273,8 @@ if (TEMPLOG) printf("suspend %s (%X)\n", device().tag(), reason);
 void device_execute_interface::resume(UINT32 reason)
 {
 if (TEMPLOG) printf("resume %s (%X)\n", device().tag(), reason);
+	m_scheduler->validate_parallel_access(*this, "resumed");
+
 	// clear the suspend reason and eat cycles flag
 	m_nextsuspend &= ~reason;
 	suspend_resume_changed();
@@ -777,6 +798,8 @@ if (TEMPLOG) printf("setline(%s,%d,%d,%d)\n", m_execute->device().tag(), m_linen
 		return;
 	}
 
+	m_execute->device().machine().scheduler().validate_parallel_access(*m_execute, "set an input line on");
+
 	// if we're full of events, flush the queue and log a message
 	int event_index = m_qindex++;
 	if (event_index >= ARRAY_LENGTH(m_queue))
@@ -87,6 +87,11 @@ enum
 
 #define MCFG_DEVICE_DISABLE() \
 	device_execute_interface::static_set_disable(*device);
+// the device only talks to others via latches/shared RAM sampled at quantum
+// boundaries; its timer changes are applied once the group finishes, in
+// execute list order; see -parallel_execute
+#define MCFG_DEVICE_PARALLEL_EXECUTE() \
+	device_execute_interface::static_set_parallel(*device);
 #define MCFG_DEVICE_VBLANK_INT_DRIVER(_tag, _class, _func) \
 	device_execute_interface::static_set_vblank_int(*device, device_interrupt_delegate(&_class::_func, #_class "::" #_func, DEVICE_SELF, (_class *)0), _tag);
 #define MCFG_DEVICE_VBLANK_INT_DEVICE(_tag, _devtag, _class, _func) \
@@ -138,6 +143,7 @@ public:
 
 	// configuration access
 	bool disabled() const { return m_disabled; }
+	bool parallel() const { return m_parallel; }
 	UINT64 clocks_to_cycles(UINT64 clocks) const { return execute_clocks_to_cycles(clocks); }
 	UINT64 cycles_to_clocks(UINT64 cycles) const { return execute_cycles_to_clocks(cycles); }
 	UINT32 min_cycles() const { return execute_min_cycles(); }
@@ -150,6 +156,7 @@ public:
 
 	// static inline configuration helpers
 	static void static_set_disable(device_t &device);
+	static void static_set_parallel(device_t &device);
 	static void static_set_vblank_int(device_t &device, device_interrupt_delegate function, const char *tag, int rate = 0);
 	static void static_set_periodic_int(device_t &device, device_interrupt_delegate function, const attotime &rate);
 	static void static_set_irq_acknowledge_callback(device_t &device, device_irq_acknowledge_delegate callback);
@@ -259,6 +266,7 @@ protected:
 
 	// configuration
 	bool                    m_disabled;                 // disabled from executing?
+	bool                    m_parallel;                 // may execute concurrently with other parallel devices?
 	device_interrupt_delegate m_vblank_interrupt;       // for interrupts tied to VBLANK
 	const char *            m_vblank_interrupt_screen;  // the screen that causes the VBLANK interrupt
 	device_interrupt_delegate m_timed_interrupt;        // for interrupts not tied to VBLANK
@@ -278,6 +286,8 @@ protected:
 	int *                   m_icountptr;                // pointer to the icount
 	int                     m_cycles_running;           // number of cycles we are executing
 	int                     m_cycles_stolen;            // number of cycles we artificially stole
+	bool                    m_parallel_executing;       // currently executing as part of a parallel group?
+	dynamic_array<emu_timer *> m_parallel_timers;       // timer changes deferred until the group is done
 
 	// suspend states
 	UINT32                  m_suspend;                  // suspend reason mask (0 = not suspended)
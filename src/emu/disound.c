@@ -9,6 +9,7 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include "soundsimd.h"
 
 
 
@@ -460,12 +461,8 @@ void device_mixer_interface::sound_stream_update(sound_stream &stream, stream_sa
 	for (int output = 0; output < m_outputs; output++)
 		memset(outputs[output], 0, samples * sizeof(outputs[0][0]));
 
-	// loop over samples
+	// add each input to the appropriate output a whole buffer at a time
 	const UINT8 *outmap = &m_outputmap[0];
-	for (int pos = 0; pos < samples; pos++)
-	{
-		// for each input, add it to the appropriate output
-		for (int inp = 0; inp < m_auto_allocated_inputs; inp++)
-			outputs[outmap[inp]][pos] += inputs[inp][pos];
-	}
+	for (int inp = 0; inp < m_auto_allocated_inputs; inp++)
+		sound_mix_add(outputs[outmap[inp]], inputs[inp], samples);
 }
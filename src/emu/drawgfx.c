@@ -390,7 +390,7 @@ void gfx_element::opaque(bitmap_ind16 &dest, const rectangle &cliprect,
 	color = colorbase() + granularity() * (color % colors());
 	code %= elements();
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_OPAQUE, NO_PRIORITY);
+	DRAWGFX_CORE_ROWOP(UINT16, PIXEL_OP_REBASE_OPAQUE, ROW_OP_REBASE_OPAQUE, NO_PRIORITY);
 }
 
 void gfx_element::opaque(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -399,7 +399,7 @@ void gfx_element::opaque(bitmap_rgb32 &dest, const rectangle &cliprect,
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
 	code %= elements();
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_OPAQUE, NO_PRIORITY);
+	DRAWGFX_CORE_ROWOP(UINT32, PIXEL_OP_REMAP_OPAQUE, ROW_OP_REMAP_OPAQUE, NO_PRIORITY);
 }
 
 
@@ -433,7 +433,7 @@ void gfx_element::transpen(bitmap_ind16 &dest, const rectangle &cliprect,
 	// render
 	color = colorbase() + granularity() * (color % colors());
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY);
+	DRAWGFX_CORE_ROWOP(UINT16, PIXEL_OP_REBASE_TRANSPEN, ROW_OP_REBASE_TRANSPEN, NO_PRIORITY);
 }
 
 void gfx_element::transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -461,7 +461,7 @@ void gfx_element::transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN, NO_PRIORITY);
+	DRAWGFX_CORE_ROWOP(UINT32, PIXEL_OP_REMAP_TRANSPEN, ROW_OP_REMAP_TRANSPEN, NO_PRIORITY);
 }
 
 
@@ -53,6 +53,7 @@
 #define __DRAWGFXM_H__
 
 #include "profiler.h"
+#include "drawsimd.h"
 
 
 /* special priority type meaning "none" */
@@ -368,6 +369,33 @@ do
 while (0)
 
 
+/***************************************************************************
+    ROW OPERATIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    ROW_OP_* - render a complete non-flipped row
+    of COUNT pixels with one of the scanline
+    kernels from drawsimd.h; each evaluates to
+    true if the row was handled
+-------------------------------------------------*/
+
+#define ROW_OP_NONE(DEST, PRIORITY, SOURCE, COUNT)                                      \
+	false
+
+#define ROW_OP_REBASE_OPAQUE(DEST, PRIORITY, SOURCE, COUNT)                             \
+	(draw_scanline_rebase8(DEST, SOURCE, COUNT, color), true)
+
+#define ROW_OP_REMAP_OPAQUE(DEST, PRIORITY, SOURCE, COUNT)                              \
+	(draw_scanline_remap32(DEST, SOURCE, COUNT, paldata), true)
+
+#define ROW_OP_REBASE_TRANSPEN(DEST, PRIORITY, SOURCE, COUNT)                           \
+	(draw_scanline_rebase_transpen8(DEST, SOURCE, COUNT, color, trans_pen), true)
+
+#define ROW_OP_REMAP_TRANSPEN(DEST, PRIORITY, SOURCE, COUNT)                            \
+	(draw_scanline_remap_transpen8(DEST, SOURCE, COUNT, paldata, trans_pen), true)
+
+
 /***************************************************************************
     BASIC DRAWGFX CORE
 ***************************************************************************/
@@ -385,10 +413,17 @@ while (0)
         INT32 destx - the top-left X coordinate to render to
         INT32 desty - the top-left Y coordinate to render to
         bitmap_t &priority - the priority bitmap (even if PRIORITY_TYPE is NO_PRIORITY, at least needs a dummy)
+
+    DRAWGFX_CORE_ROWOP additionally takes one of the ROW_OP* macros, which
+    is offered each complete non-flipped row before falling back to
+    PIXEL_OP; DRAWGFX_CORE is the same with ROW_OP_NONE.
 */
 
 
 #define DRAWGFX_CORE(PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE)                               \
+	DRAWGFX_CORE_ROWOP(PIXEL_TYPE, PIXEL_OP, ROW_OP_NONE, PRIORITY_TYPE)
+
+#define DRAWGFX_CORE_ROWOP(PIXEL_TYPE, PIXEL_OP, ROW_OP, PRIORITY_TYPE)                 \
 do {                                                                                    \
 	g_profiler.start(PROFILER_DRAWGFX);                                                 \
 	do {                                                                                \
@@ -474,6 +509,10 @@ do {
 				const UINT8 *srcptr = srcdata;                                      \
 				srcdata += dy;                                                      \
 																					\
+				/* let the row operation render the whole row if it can */          \
+				if (ROW_OP(destptr, priptr, srcptr, numblocks * 4 + leftovers))     \
+					continue;                                                       \
+																					\
 				/* iterate over unrolled blocks of 4 */                             \
 				for (curx = 0; curx < numblocks; curx++)                            \
 				{                                                                   \
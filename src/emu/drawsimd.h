@@ -0,0 +1,288 @@
+/***************************************************************************
+
+    drawsimd.h
+
+    Scanline kernels shared by the tilemap and drawgfx renderers.
+    Each kernel handles a single run of pixels and is optimized with
+    SIMD where it can be assumed to be available.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __DRAWSIMD_H__
+#define __DRAWSIMD_H__
+
+/* use SSE2 on 64-bit implementations, where it can be assumed */
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#define DRAWSIMD_SSE2   1
+#include <emmintrin.h>
+#else
+#define DRAWSIMD_SSE2   0
+#endif
+
+
+/***************************************************************************
+    PRIORITY KERNELS
+***************************************************************************/
+
+/*-------------------------------------------------
+    draw_scanline_priority - update a run of
+    priority pixels to (pri & andmask) | ormask
+-------------------------------------------------*/
+
+inline void draw_scanline_priority(UINT8 *pri, int count, UINT8 andmask, UINT8 ormask)
+{
+	int i = 0;
+#if DRAWSIMD_SSE2
+	__m128i vand = _mm_set1_epi8(andmask);
+	__m128i vor = _mm_set1_epi8(ormask);
+	for ( ; i + 16 <= count; i += 16)
+	{
+		__m128i p = _mm_loadu_si128((const __m128i *)&pri[i]);
+		_mm_storeu_si128((__m128i *)&pri[i], _mm_or_si128(_mm_and_si128(p, vand), vor));
+	}
+#endif
+	for ( ; i < count; i++)
+		pri[i] = (pri[i] & andmask) | ormask;
+}
+
+
+/*-------------------------------------------------
+    draw_scanline_masked_priority - update the
+    priority pixels whose mask byte matches
+-------------------------------------------------*/
+
+inline void draw_scanline_masked_priority(UINT8 *pri, const UINT8 *maskptr, UINT8 mask, UINT8 value, int count, UINT8 andmask, UINT8 ormask)
+{
+	int i = 0;
+#if DRAWSIMD_SSE2
+	__m128i vmask = _mm_set1_epi8(mask);
+	__m128i vvalue = _mm_set1_epi8(value);
+	__m128i vand = _mm_set1_epi8(andmask);
+	__m128i vor = _mm_set1_epi8(ormask);
+	for ( ; i + 16 <= count; i += 16)
+	{
+		__m128i m = _mm_cmpeq_epi8(_mm_and_si128(_mm_loadu_si128((const __m128i *)&maskptr[i]), vmask), vvalue);
+		__m128i p = _mm_loadu_si128((const __m128i *)&pri[i]);
+		__m128i newp = _mm_or_si128(_mm_and_si128(p, vand), vor);
+		_mm_storeu_si128((__m128i *)&pri[i], _mm_or_si128(_mm_and_si128(m, newp), _mm_andnot_si128(m, p)));
+	}
+#endif
+	for ( ; i < count; i++)
+		if ((maskptr[i] & mask) == value)
+			pri[i] = (pri[i] & andmask) | ormask;
+}
+
+
+
+/***************************************************************************
+    INDEXED KERNELS
+***************************************************************************/
+
+/*-------------------------------------------------
+    draw_scanline_rebase16 - copy a run of 16-bit
+    pens, adding a palette base to each
+-------------------------------------------------*/
+
+inline void draw_scanline_rebase16(UINT16 *dest, const UINT16 *source, int count, UINT16 base)
+{
+	int i = 0;
+#if DRAWSIMD_SSE2
+	__m128i vbase = _mm_set1_epi16(base);
+	for ( ; i + 8 <= count; i += 8)
+		_mm_storeu_si128((__m128i *)&dest[i], _mm_add_epi16(_mm_loadu_si128((const __m128i *)&source[i]), vbase));
+#endif
+	for ( ; i < count; i++)
+		dest[i] = source[i] + base;
+}
+
+
+/*-------------------------------------------------
+    draw_scanline_masked_rebase16 - copy the
+    16-bit pens whose mask byte matches, adding a
+    palette base to each
+-------------------------------------------------*/
+
+inline void draw_scanline_masked_rebase16(UINT16 *dest, const UINT16 *source, const UINT8 *maskptr, UINT8 mask, UINT8 value, int count, UINT16 base)
+{
+	int i = 0;
+#if DRAWSIMD_SSE2
+	__m128i vbase = _mm_set1_epi16(base);
+	__m128i vmask = _mm_set1_epi8(mask);
+	__m128i vvalue = _mm_set1_epi8(value);
+	for ( ; i + 8 <= count; i += 8)
+	{
+		__m128i m = _mm_cmpeq_epi8(_mm_and_si128(_mm_loadl_epi64((const __m128i *)&maskptr[i]), vmask), vvalue);
+		m = _mm_unpacklo_epi8(m, m);
+		__m128i pix = _mm_add_epi16(_mm_loadu_si128((const __m128i *)&source[i]), vbase);
+		__m128i old = _mm_loadu_si128((const __m128i *)&dest[i]);
+		_mm_storeu_si128((__m128i *)&dest[i], _mm_or_si128(_mm_and_si128(m, pix), _mm_andnot_si128(m, old)));
+	}
+#endif
+	for ( ; i < count; i++)
+		if ((maskptr[i] & mask) == value)
+			dest[i] = source[i] + base;
+}
+
+
+/*-------------------------------------------------
+    draw_scanline_rebase8 - expand a run of 8-bit
+    pens to 16 bits, adding a palette base
+-------------------------------------------------*/
+
+inline void draw_scanline_rebase8(UINT16 *dest, const UINT8 *source, int count, UINT16 base)
+{
+	int i = 0;
+#if DRAWSIMD_SSE2
+	__m128i vbase = _mm_set1_epi16(base);
+	__m128i zero = _mm_setzero_si128();
+	for ( ; i + 16 <= count; i += 16)
+	{
+		__m128i src = _mm_loadu_si128((const __m128i *)&source[i]);
+		_mm_storeu_si128((__m128i *)&dest[i + 0], _mm_add_epi16(_mm_unpacklo_epi8(src, zero), vbase));
+		_mm_storeu_si128((__m128i *)&dest[i + 8], _mm_add_epi16(_mm_unpackhi_epi8(src, zero), vbase));
+	}
+#endif
+	for ( ; i < count; i++)
+		dest[i] = base + source[i];
+}
+
+
+/*-------------------------------------------------
+    draw_scanline_rebase_transpen8 - expand the
+    8-bit pens that do not match the transparent
+    pen to 16 bits, adding a palette base
+-------------------------------------------------*/
+
+inline void draw_scanline_rebase_transpen8(UINT16 *dest, const UINT8 *source, int count, UINT16 base, UINT8 trans_pen)
+{
+	int i = 0;
+#if DRAWSIMD_SSE2
+	__m128i vbase = _mm_set1_epi16(base);
+	__m128i vtrans = _mm_set1_epi8(trans_pen);
+	__m128i zero = _mm_setzero_si128();
+	for ( ; i + 16 <= count; i += 16)
+	{
+		__m128i src = _mm_loadu_si128((const __m128i *)&source[i]);
+		__m128i t = _mm_cmpeq_epi8(src, vtrans);
+		int transmask = _mm_movemask_epi8(t);
+
+		/* fully transparent runs are common at the edges of sprites */
+		if (transmask == 0xffff)
+			continue;
+
+		__m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(src, zero), vbase);
+		__m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(src, zero), vbase);
+		if (transmask != 0)
+		{
+			__m128i tlo = _mm_unpacklo_epi8(t, t);
+			__m128i thi = _mm_unpackhi_epi8(t, t);
+			lo = _mm_or_si128(_mm_andnot_si128(tlo, lo), _mm_and_si128(tlo, _mm_loadu_si128((const __m128i *)&dest[i + 0])));
+			hi = _mm_or_si128(_mm_andnot_si128(thi, hi), _mm_and_si128(thi, _mm_loadu_si128((const __m128i *)&dest[i + 8])));
+		}
+		_mm_storeu_si128((__m128i *)&dest[i + 0], lo);
+		_mm_storeu_si128((__m128i *)&dest[i + 8], hi);
+	}
+#endif
+	for ( ; i < count; i++)
+		if (source[i] != trans_pen)
+			dest[i] = base + source[i];
+}
+
+
+
+/***************************************************************************
+    RGB KERNELS
+***************************************************************************/
+
+/*
+    SSE2 has no gather, so palette lookups stay scalar; the SIMD work
+    below is limited to classifying runs of pixels so that transparent
+    spans can be skipped and opaque spans copied without per-pixel tests.
+*/
+
+/*-------------------------------------------------
+    draw_scanline_remap32 - look up a run of pens
+    in a palette
+-------------------------------------------------*/
+
+template<class _SourceType, class _PenType>
+inline void draw_scanline_remap32(UINT32 *dest, const _SourceType *source, int count, const _PenType *pens)
+{
+	int i = 0;
+	for ( ; i + 4 <= count; i += 4)
+	{
+		dest[i + 0] = pens[source[i + 0]];
+		dest[i + 1] = pens[source[i + 1]];
+		dest[i + 2] = pens[source[i + 2]];
+		dest[i + 3] = pens[source[i + 3]];
+	}
+	for ( ; i < count; i++)
+		dest[i] = pens[source[i]];
+}
+
+
+/*-------------------------------------------------
+    draw_scanline_masked_remap32 - look up the
+    16-bit pens whose mask byte matches in a
+    palette
+-------------------------------------------------*/
+
+template<class _PenType>
+inline void draw_scanline_masked_remap32(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, UINT8 mask, UINT8 value, int count, const _PenType *pens)
+{
+	int i = 0;
+#if DRAWSIMD_SSE2
+	__m128i vmask = _mm_set1_epi8(mask);
+	__m128i vvalue = _mm_set1_epi8(value);
+	for ( ; i + 16 <= count; i += 16)
+	{
+		int drawmask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(_mm_loadu_si128((const __m128i *)&maskptr[i]), vmask), vvalue));
+		if (drawmask == 0xffff)
+			draw_scanline_remap32(&dest[i], &source[i], 16, pens);
+		else
+			for (int bit = 0; drawmask != 0; bit++, drawmask >>= 1)
+				if (drawmask & 1)
+					dest[i + bit] = pens[source[i + bit]];
+	}
+#endif
+	for ( ; i < count; i++)
+		if ((maskptr[i] & mask) == value)
+			dest[i] = pens[source[i]];
+}
+
+
+/*-------------------------------------------------
+    draw_scanline_remap_transpen8 - look up the
+    8-bit pens that do not match the transparent
+    pen in a palette
+-------------------------------------------------*/
+
+template<class _PenType>
+inline void draw_scanline_remap_transpen8(UINT32 *dest, const UINT8 *source, int count, const _PenType *pens, UINT8 trans_pen)
+{
+	int i = 0;
+#if DRAWSIMD_SSE2
+	__m128i vtrans = _mm_set1_epi8(trans_pen);
+	for ( ; i + 16 <= count; i += 16)
+	{
+		int drawmask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)&source[i]), vtrans)) & 0xffff;
+		if (drawmask == 0xffff)
+			draw_scanline_remap32(&dest[i], &source[i], 16, pens);
+		else
+			for (int bit = 0; drawmask != 0; bit++, drawmask >>= 1)
+				if (drawmask & 1)
+					dest[i + bit] = pens[source[i + bit]];
+	}
+#endif
+	for ( ; i < count; i++)
+		if (source[i] != trans_pen)
+			dest[i] = pens[source[i]];
+}
+
+
+#endif  /* __DRAWSIMD_H__ */
@@ -64,6 +64,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SNAPSHOT_DIRECTORY,                         "snap",      OPTION_STRING,     "directory to save screenshots" },
 	{ OPTION_DIFF_DIRECTORY,                             "diff",      OPTION_STRING,     "directory to save hard drive image difference files" },
 	{ OPTION_COMMENT_DIRECTORY,                          "comments",  OPTION_STRING,     "directory to save debugger comments" },
+	{ OPTION_DRCCACHE_DIRECTORY,                         "drccache",  OPTION_STRING,     "directory to save DRC block records" },
 #ifdef USE_HISCORE
 	{ "hiscore_directory",                               "hi",        OPTION_STRING,     "directory to save hiscores" },
 #endif /* USE_HISCORE */
@@ -89,6 +90,8 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SNAPBILINEAR,                               "1",         OPTION_BOOLEAN,    "specify if the snapshot/movie should have bilinear filtering applied" },
 	{ OPTION_STATENAME,                                  "%g",        OPTION_STRING,     "override of the default state subfolder naming; %g == gamename" },
 	{ OPTION_BURNIN,                                     "0",         OPTION_BOOLEAN,    "create burn-in snapshots for each screen" },
+	{ OPTION_REWIND,                                     "0",         OPTION_BOOLEAN,    "keep a history of per-frame state deltas that can be stepped back through while paused" },
+	{ OPTION_REWIND_CAPACITY "(1-2047)",                 "32",        OPTION_INTEGER,    "memory, in megabytes, to use for the rewind history" },
 
 	// performance options
 	{ NULL,                                              NULL,        OPTION_HEADER,     "CORE PERFORMANCE OPTIONS" },
@@ -99,6 +102,11 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SLEEP,                                      "1",         OPTION_BOOLEAN,    "enable sleeping, which gives time back to other applications when idle" },
 	{ OPTION_SPEED "(0.01-100)",                         "1.0",       OPTION_FLOAT,      "controls the speed of gameplay, relative to realtime; smaller numbers are slower" },
 	{ OPTION_REFRESHSPEED ";rs",                         "0",         OPTION_BOOLEAN,    "automatically adjusts the speed of gameplay to keep the refresh rate lower than the screen" },
+	{ OPTION_PARALLEL_EXECUTE ";pe",                     "0",         OPTION_BOOLEAN,    "execute devices marked as loosely coupled concurrently on worker threads" },
+	{ OPTION_PARALLEL_VALIDATE ";pv",                    "0",         OPTION_BOOLEAN,    "with -parallel_execute, run loosely coupled devices serially and log early stops and cross-device control that threaded execution would get wrong" },
+	{ OPTION_PARALLEL_TILEMAPS ";ptm",                   "1",         OPTION_BOOLEAN,    "split large tilemap draws into horizontal bands rendered on worker threads" },
+	{ OPTION_PARALLEL_SOUND ";psnd",                     "0",         OPTION_BOOLEAN,    "generate sound streams that don't depend on each other concurrently on worker threads" },
+	{ OPTION_BENCHSUITE_OUTPUT,                          NULL,        OPTION_STRING,     "file to write -benchsuite results to (JSON if it ends in .json, CSV otherwise); default is standard output" },
 
 	// rotation options
 	{ NULL,                                              NULL,        OPTION_HEADER,     "CORE ROTATION OPTIONS" },
@@ -141,6 +149,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SAMPLERATE ";sr(1000-1000000)",             "48000",     OPTION_INTEGER,    "set sound output sample rate" },
 	{ OPTION_SAMPLES,                                    "1",         OPTION_BOOLEAN,    "enable the use of external samples if available" },
 	{ OPTION_VOLUME ";vol",                              "0",         OPTION_INTEGER,    "sound volume in decibels (-32 min, 0 max)" },
+	{ OPTION_RESAMPLE_QUALITY "(0-2)",                   "0",         OPTION_INTEGER,    "default sample rate conversion between sound streams (0=linear, 1=low, 2=high quality filter)" },
 
 	// input options
 	{ NULL,                                              NULL,        OPTION_HEADER,     "CORE INPUT OPTIONS" },
@@ -176,6 +185,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ NULL,                                              NULL,        OPTION_HEADER,     "CORE DEBUGGING OPTIONS" },
 	{ OPTION_UPDATEINPAUSE,                              "0",         OPTION_BOOLEAN,    "keep calling video updates while in pause" },
 	{ OPTION_DEBUGSCRIPT,                                NULL,        OPTION_STRING,     "script for debugger" },
+	{ OPTION_PROFILE_OUTPUT,                             NULL,        OPTION_STRING,     "write a folded-stack profile of host time per device, timer and memory handler to this file at exit (profiling builds only)" },
 
 	// misc options
 	{ NULL,                                              NULL,        OPTION_HEADER,     "CORE MISC OPTIONS" },
@@ -183,6 +193,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_DRC_USE_C,                                  "0",         OPTION_BOOLEAN,    "force DRC use C backend" },
 	{ OPTION_DRC_LOG_UML,                                "0",         OPTION_BOOLEAN,    "write DRC UML disassembly log" },
 	{ OPTION_DRC_LOG_NATIVE,                             "0",         OPTION_BOOLEAN,    "write DRC native disassembly log" },
+	{ OPTION_DRC_PERSIST,                                "0",         OPTION_BOOLEAN,    "recompile blocks recorded on previous runs when their code is first reached" },
 	{ OPTION_BIOS,                                       NULL,        OPTION_STRING,     "select the system BIOS to use" },
 	{ OPTION_CHEAT ";c",                                 "0",         OPTION_BOOLEAN,    "enable cheat subsystem" },
 	{ OPTION_SKIP_GAMEINFO,                              "0",         OPTION_BOOLEAN,    "skip displaying the information screen at startup" },
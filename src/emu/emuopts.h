@@ -74,6 +74,7 @@ enum
 #define OPTION_SNAPSHOT_DIRECTORY   "snapshot_directory"
 #define OPTION_DIFF_DIRECTORY       "diff_directory"
 #define OPTION_COMMENT_DIRECTORY    "comment_directory"
+#define OPTION_DRCCACHE_DIRECTORY   "drccache_directory"
 #ifdef USE_HISCORE
 #define OPTION_HISCORE_DIRECTORY    "hiscore_directory"
 #endif /* USE_HISCORE */
@@ -100,6 +101,8 @@ enum
 #define OPTION_SNAPBILINEAR         "snapbilinear"
 #define OPTION_STATENAME            "statename"
 #define OPTION_BURNIN               "burnin"
+#define OPTION_REWIND               "rewind"
+#define OPTION_REWIND_CAPACITY      "rewind_capacity"
 
 // core performance options
 #define OPTION_AUTOFRAMESKIP        "autoframeskip"
@@ -109,6 +112,11 @@ enum
 #define OPTION_SLEEP                "sleep"
 #define OPTION_SPEED                "speed"
 #define OPTION_REFRESHSPEED         "refreshspeed"
+#define OPTION_PARALLEL_EXECUTE     "parallel_execute"
+#define OPTION_PARALLEL_VALIDATE    "parallel_validate"
+#define OPTION_PARALLEL_TILEMAPS    "parallel_tilemaps"
+#define OPTION_PARALLEL_SOUND       "parallel_sound"
+#define OPTION_BENCHSUITE_OUTPUT    "benchsuite_output"
 
 // core rotation options
 #define OPTION_ROTATE               "rotate"
@@ -146,6 +154,7 @@ enum
 #define OPTION_SAMPLERATE           "samplerate"
 #define OPTION_SAMPLES              "samples"
 #define OPTION_VOLUME               "volume"
+#define OPTION_RESAMPLE_QUALITY     "resample_quality"
 
 // core input options
 #define OPTION_COIN_LOCKOUT         "coin_lockout"
@@ -178,12 +187,14 @@ enum
 // core debugging options
 #define OPTION_UPDATEINPAUSE        "update_in_pause"
 #define OPTION_DEBUGSCRIPT          "debugscript"
+#define OPTION_PROFILE_OUTPUT       "profile_output"
 
 // core misc options
 #define OPTION_DRC                  "drc"
 #define OPTION_DRC_USE_C            "drc_use_c"
 #define OPTION_DRC_LOG_UML          "drc_log_uml"
 #define OPTION_DRC_LOG_NATIVE       "drc_log_native"
+#define OPTION_DRC_PERSIST          "drc_persist"
 #define OPTION_BIOS                 "bios"
 #define OPTION_CHEAT                "cheat"
 #define OPTION_SKIP_GAMEINFO        "skip_gameinfo"
@@ -286,6 +297,7 @@ public:
 	const char *snapshot_directory() const { return value(OPTION_SNAPSHOT_DIRECTORY); }
 	const char *diff_directory() const { return value(OPTION_DIFF_DIRECTORY); }
 	const char *comment_directory() const { return value(OPTION_COMMENT_DIRECTORY); }
+	const char *drccache_directory() const { return value(OPTION_DRCCACHE_DIRECTORY); }
 
 	// core state/playback options
 	const char *state() const { return value(OPTION_STATE); }
@@ -301,6 +313,8 @@ public:
 	bool snap_bilinear() const { return bool_value(OPTION_SNAPBILINEAR); }
 	const char *state_name() const { return value(OPTION_STATENAME); }
 	bool burnin() const { return bool_value(OPTION_BURNIN); }
+	bool rewind() const { return bool_value(OPTION_REWIND); }
+	int rewind_capacity() const { return int_value(OPTION_REWIND_CAPACITY); }
 
 	// core performance options
 	bool auto_frameskip() const { return bool_value(OPTION_AUTOFRAMESKIP); }
@@ -310,6 +324,11 @@ public:
 	bool sleep() const { return bool_value(OPTION_SLEEP); }
 	float speed() const { return float_value(OPTION_SPEED); }
 	bool refresh_speed() const { return bool_value(OPTION_REFRESHSPEED); }
+	bool parallel_execute() const { return bool_value(OPTION_PARALLEL_EXECUTE); }
+	bool parallel_validate() const { return bool_value(OPTION_PARALLEL_VALIDATE); }
+	bool parallel_tilemaps() const { return bool_value(OPTION_PARALLEL_TILEMAPS); }
+	bool parallel_sound() const { return bool_value(OPTION_PARALLEL_SOUND); }
+	const char *benchsuite_output() const { return value(OPTION_BENCHSUITE_OUTPUT); }
 
 	// core rotation options
 	bool rotate() const { return bool_value(OPTION_ROTATE); }
@@ -344,6 +363,7 @@ public:
 	int sample_rate() const { return int_value(OPTION_SAMPLERATE); }
 	bool samples() const { return bool_value(OPTION_SAMPLES); }
 	int volume() const { return int_value(OPTION_VOLUME); }
+	int resample_quality() const { return int_value(OPTION_RESAMPLE_QUALITY); }
 
 	// core input options
 	bool coin_lockout() const { return bool_value(OPTION_COIN_LOCKOUT); }
@@ -374,12 +394,14 @@ public:
 	// core debugging options
 	const char *debug_script() const { return value(OPTION_DEBUGSCRIPT); }
 	bool update_in_pause() const { return bool_value(OPTION_UPDATEINPAUSE); }
+	const char *profile_output() const { return value(OPTION_PROFILE_OUTPUT); }
 
 	// core misc options
 	bool drc() const { return bool_value(OPTION_DRC); }
 	bool drc_use_c() const { return bool_value(OPTION_DRC_USE_C); }
 	bool drc_log_uml() const { return bool_value(OPTION_DRC_LOG_UML); }
 	bool drc_log_native() const { return bool_value(OPTION_DRC_LOG_NATIVE); }
+	bool drc_persist() const { return bool_value(OPTION_DRC_PERSIST); }
 	const char *bios() const { return value(OPTION_BIOS); }
 	bool cheat() const { return bool_value(OPTION_CHEAT); }
 	bool skip_gameinfo() const { return bool_value(OPTION_SKIP_GAMEINFO); }
@@ -360,6 +360,10 @@ int running_machine::run(bool firstrun)
 		// then finish setting up our local machine
 		start();
 
+		// start recording a profile if requested
+		if (options().profile_output()[0] != 0)
+			g_profiler.start_trace();
+
 		// load the configuration settings and NVRAM
 		bool settingsloaded = config_load_settings(*this);
 
@@ -410,6 +414,10 @@ int running_machine::run(bool firstrun)
 			else
 				m_video->frame_update();
 
+			// capture or restore the rewind history
+			if (m_save.rewind() != NULL)
+				m_save.rewind()->update();
+
 			// handle save/load
 			if (m_saveload_schedule != SLS_NONE)
 				handle_saveload();
@@ -420,6 +428,10 @@ int running_machine::run(bool firstrun)
 		// and out via the exit phase
 		m_current_phase = MACHINE_PHASE_EXIT;
 
+		// write out the profile if we were recording one
+		if (options().profile_output()[0] != 0)
+			g_profiler.write_trace(*this, options().profile_output());
+
 #ifdef MAME_DEBUG
 		if (g_tagmap_counter_enabled)
 		{
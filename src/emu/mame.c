@@ -92,6 +92,11 @@
 
 machine_manager* machine_manager::m_manager = NULL;
 
+// these live here rather than in drccache.c so that builds without a
+// recompiler still link
+UINT32 g_drc_cache_flushes = 0;
+size_t g_drc_cache_peak_bytes = 0;
+
 machine_manager* machine_manager::instance(emu_options &options,osd_interface &osd)
 {
 	if(!m_manager)
@@ -117,6 +122,11 @@ machine_manager::machine_manager(emu_options &options,osd_interface &osd)
 		m_new_driver_pending(NULL),
 		m_machine(NULL)
 {
+	m_last_run_stats.result = MAMERR_NONE;
+	m_last_run_stats.emulated_time = attotime::zero;
+	m_last_run_stats.real_seconds = 0;
+	m_last_run_stats.speed_percent = 0;
+	m_last_run_stats.frames = 0;
 }
 
 
@@ -213,8 +223,10 @@ int machine_manager::execute()
 		set_machine(&machine);
 
 		// run the machine
+		osd_ticks_t start = osd_ticks();
 		error = machine.run(firstrun);
 		firstrun = false;
+		update_run_stats(machine, error, start);
 
 		// check the state of the machine
 		if (m_new_driver_pending)
@@ -251,6 +263,30 @@ int machine_manager::execute()
 }
 
 
+/*-------------------------------------------------
+    update_run_stats - capture statistics from a
+    machine that has just finished running
+-------------------------------------------------*/
+
+void machine_manager::update_run_stats(running_machine &machine, int result, osd_ticks_t start)
+{
+	m_last_run_stats.result = result;
+	m_last_run_stats.real_seconds = (double)(osd_ticks() - start) / (double)osd_ticks_per_second();
+	m_last_run_stats.emulated_time = attotime::zero;
+	m_last_run_stats.speed_percent = 0;
+	m_last_run_stats.frames = 0;
+
+	// a machine that failed to start may not have a video manager
+	if (result != MAMERR_NONE)
+		return;
+
+	m_last_run_stats.emulated_time = machine.time();
+	m_last_run_stats.speed_percent = machine.video().overall_speed_percent();
+	if (machine.first_screen() != NULL)
+		m_last_run_stats.frames = machine.first_screen()->frame_number();
+}
+
+
 /***************************************************************************
     MISCELLANEOUS
 ***************************************************************************/
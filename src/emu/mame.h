@@ -75,6 +75,19 @@ public:
 };
 
 
+// ======================> machine_run_stats
+
+// summary of the most recently completed machine run
+struct machine_run_stats
+{
+	int                 result;                 // MAMERR_* code returned by the run
+	attotime            emulated_time;          // emulated time at exit
+	double              real_seconds;           // host time spent inside running_machine::run
+	double              speed_percent;          // average speed over the unthrottled portion
+	UINT64              frames;                 // frames drawn by the first screen
+};
+
+
 // ======================> machine_manager
 
 class machine_manager
@@ -102,7 +115,12 @@ public:
 	/* execute as configured by the OPTION_SYSTEMNAME option on the specified options */
 	int execute();
 	void schedule_new_driver(const game_driver &driver);
+
+	// statistics for the last machine that ran
+	const machine_run_stats &last_run_stats() const { return m_last_run_stats; }
 private:
+	void update_run_stats(running_machine &machine, int result, osd_ticks_t start);
+
 	osd_interface &         m_osd;                  // reference to OSD system
 	emu_options &           m_options;              // reference to options
 
@@ -112,6 +130,7 @@ private:
 	const game_driver *     m_new_driver_pending;   // pointer to the next pending driver
 
 	running_machine *m_machine;
+	machine_run_stats       m_last_run_stats;       // statistics for the last run
 	static machine_manager* m_manager;
 };
 
@@ -122,6 +141,10 @@ private:
 extern const char build_version[];
 extern const char bare_build_version[];
 
+// recompiler cache counters, maintained by drccache.c when a DRC is linked in
+extern UINT32 g_drc_cache_flushes;
+extern size_t g_drc_cache_peak_bytes;
+
 
 /***************************************************************************
     FUNCTION PROTOTYPES
@@ -554,7 +554,41 @@ public:
 	}
 
 	// enable watchpoints by swapping in the watchpoint table
-	void enable_watchpoints(bool enable = true) { m_live_lookup = enable ? s_watchpoint_table : &m_table[0]; }
+	void enable_watchpoints(bool enable = true) { m_live_lookup = enable ? s_watchpoint_table : &m_table[0]; tlb_invalidate(); }
+
+	// software TLB definitions
+	static const int TLB_PAGE_BITS  = 10;                       // number of address bits covered by a TLB page
+	static const offs_t TLB_PAGE_MASK = (1 << TLB_PAGE_BITS) - 1;   // mask of the offset within a TLB page
+	static const int TLB_ENTRIES    = 64;                       // number of entries in the direct-mapped TLB
+
+	// a TLB entry caches the resolution of a page that maps to a single handler
+	struct tlb_entry
+	{
+		offs_t              m_page;                     // page number, or ~0 if unused
+		UINT16              m_entry;                    // handler covering the whole page, or STATIC_INVALID if mixed
+		UINT8 *             m_base;                     // RAM backing the start of the page, or NULL
+	};
+
+	// look up the TLB entry for an address, refilling it on a miss
+	const tlb_entry &tlb_lookup(offs_t byteaddress)
+	{
+		offs_t page = byteaddress >> TLB_PAGE_BITS;
+		tlb_entry &tlb = m_tlb[page & (TLB_ENTRIES - 1)];
+		if (tlb.m_page == page && tlb.m_entry != STATIC_INVALID)
+		{
+			m_tlb_hits++;
+			return tlb;
+		}
+		m_tlb_misses++;
+		if (tlb.m_page != page)
+			tlb_fill(tlb, byteaddress);
+		return tlb;
+	}
+
+	// TLB management
+	void tlb_invalidate();
+	UINT64 tlb_hits() const { return m_tlb_hits; }
+	UINT64 tlb_misses() const { return m_tlb_misses; }
 
 	// table mapping helpers
 	void map_range(offs_t bytestart, offs_t byteend, offs_t bytemask, offs_t bytemirror, UINT16 staticentry);
@@ -618,6 +652,12 @@ private:
 	void verify_reference_counts();
 	void setup_range_solid(offs_t addrstart, offs_t addrend, offs_t addrmask, offs_t addrmirror, std::list<UINT32> &entries);
 	void setup_range_masked(offs_t addrstart, offs_t addrend, offs_t addrmask, offs_t addrmirror, UINT64 mask, std::list<UINT32> &entries);
+	void tlb_fill(tlb_entry &tlb, offs_t byteaddress);
+
+	// software TLB state
+	tlb_entry m_tlb[TLB_ENTRIES];
+	UINT64 m_tlb_hits;
+	UINT64 m_tlb_misses;
 
 	void handler_ref(UINT16 entry, int count)
 	{
@@ -699,12 +739,14 @@ private:
 
 		UINT16 *oldtable = m_live_lookup;
 		m_live_lookup = m_table;
+		tlb_invalidate();
 		_UintType result;
 		if (sizeof(_UintType) == 1) result = m_space.read_byte(offset);
 		if (sizeof(_UintType) == 2) result = m_space.read_word(offset << 1, mask);
 		if (sizeof(_UintType) == 4) result = m_space.read_dword(offset << 2, mask);
 		if (sizeof(_UintType) == 8) result = m_space.read_qword(offset << 3, mask);
 		m_live_lookup = oldtable;
+		tlb_invalidate();
 		return result;
 	}
 
@@ -769,11 +811,13 @@ private:
 
 		UINT16 *oldtable = m_live_lookup;
 		m_live_lookup = m_table;
+		tlb_invalidate();
 		if (sizeof(_UintType) == 1) m_space.write_byte(offset, data);
 		if (sizeof(_UintType) == 2) m_space.write_word(offset << 1, data, mask);
 		if (sizeof(_UintType) == 4) m_space.write_dword(offset << 2, data, mask);
 		if (sizeof(_UintType) == 8) m_space.write_qword(offset << 3, data, mask);
 		m_live_lookup = oldtable;
+		tlb_invalidate();
 	}
 
 	// internal state
@@ -1057,14 +1101,25 @@ public:
 
 		if (TEST_HANDLER) printf("[r%X,%s]", offset, core_i64_hex_format(mask, sizeof(_NativeType) * 2));
 
-		// look up the handler
+		// RAM pages cached in the TLB can be read directly
 		offs_t byteaddress = offset & m_bytemask;
-		UINT32 entry = read_lookup(byteaddress);
+		const address_table::tlb_entry &tlb = m_read.tlb_lookup(byteaddress);
+		_NativeType result;
+		if (tlb.m_base != NULL)
+		{
+			result = *reinterpret_cast<_NativeType *>(tlb.m_base + (byteaddress & address_table::TLB_PAGE_MASK));
+			g_profiler.stop();
+			return result;
+		}
+
+		// otherwise look up the handler, unless the TLB already knows it
+		UINT32 entry = (tlb.m_entry != STATIC_INVALID) ? tlb.m_entry : read_lookup(byteaddress);
 		const handler_entry_read &handler = m_read.handler_read(entry);
+		if (g_profiler.tracing() && entry > STATIC_BANKMAX)
+			g_profiler.set_name(handler.name());
 
 		// either read directly from RAM, or call the delegate
 		offset = handler.byteoffset(byteaddress);
-		_NativeType result;
 		if (entry <= STATIC_BANKMAX) result = *reinterpret_cast<_NativeType *>(handler.ramptr(offset));
 		else if (sizeof(_NativeType) == 1) result = handler.read8(*this, offset, mask);
 		else if (sizeof(_NativeType) == 2) result = handler.read16(*this, offset >> 1, mask);
@@ -1082,14 +1137,25 @@ public:
 
 		if (TEST_HANDLER) printf("[r%X]", offset);
 
-		// look up the handler
+		// RAM pages cached in the TLB can be read directly
 		offs_t byteaddress = offset & m_bytemask;
-		UINT32 entry = read_lookup(byteaddress);
+		const address_table::tlb_entry &tlb = m_read.tlb_lookup(byteaddress);
+		_NativeType result;
+		if (tlb.m_base != NULL)
+		{
+			result = *reinterpret_cast<_NativeType *>(tlb.m_base + (byteaddress & address_table::TLB_PAGE_MASK));
+			g_profiler.stop();
+			return result;
+		}
+
+		// otherwise look up the handler, unless the TLB already knows it
+		UINT32 entry = (tlb.m_entry != STATIC_INVALID) ? tlb.m_entry : read_lookup(byteaddress);
 		const handler_entry_read &handler = m_read.handler_read(entry);
+		if (g_profiler.tracing() && entry > STATIC_BANKMAX)
+			g_profiler.set_name(handler.name());
 
 		// either read directly from RAM, or call the delegate
 		offset = handler.byteoffset(byteaddress);
-		_NativeType result;
 		if (entry <= STATIC_BANKMAX) result = *reinterpret_cast<_NativeType *>(handler.ramptr(offset));
 		else if (sizeof(_NativeType) == 1) result = handler.read8(*this, offset, 0xff);
 		else if (sizeof(_NativeType) == 2) result = handler.read16(*this, offset >> 1, 0xffff);
@@ -1105,10 +1171,22 @@ public:
 	{
 		g_profiler.start(PROFILER_MEMWRITE);
 
-		// look up the handler
+		// RAM pages cached in the TLB can be written directly
 		offs_t byteaddress = offset & m_bytemask;
-		UINT32 entry = write_lookup(byteaddress);
+		const address_table::tlb_entry &tlb = m_write.tlb_lookup(byteaddress);
+		if (tlb.m_base != NULL)
+		{
+			_NativeType *dest = reinterpret_cast<_NativeType *>(tlb.m_base + (byteaddress & address_table::TLB_PAGE_MASK));
+			*dest = (*dest & ~mask) | (data & mask);
+			g_profiler.stop();
+			return;
+		}
+
+		// otherwise look up the handler, unless the TLB already knows it
+		UINT32 entry = (tlb.m_entry != STATIC_INVALID) ? tlb.m_entry : write_lookup(byteaddress);
 		const handler_entry_write &handler = m_write.handler_write(entry);
+		if (g_profiler.tracing() && entry > STATIC_BANKMAX)
+			g_profiler.set_name(handler.name());
 
 		// either write directly to RAM, or call the delegate
 		offset = handler.byteoffset(byteaddress);
@@ -1130,10 +1208,21 @@ public:
 	{
 		g_profiler.start(PROFILER_MEMWRITE);
 
-		// look up the handler
+		// RAM pages cached in the TLB can be written directly
 		offs_t byteaddress = offset & m_bytemask;
-		UINT32 entry = write_lookup(byteaddress);
+		const address_table::tlb_entry &tlb = m_write.tlb_lookup(byteaddress);
+		if (tlb.m_base != NULL)
+		{
+			*reinterpret_cast<_NativeType *>(tlb.m_base + (byteaddress & address_table::TLB_PAGE_MASK)) = data;
+			g_profiler.stop();
+			return;
+		}
+
+		// otherwise look up the handler, unless the TLB already knows it
+		UINT32 entry = (tlb.m_entry != STATIC_INVALID) ? tlb.m_entry : write_lookup(byteaddress);
 		const handler_entry_write &handler = m_write.handler_write(entry);
+		if (g_profiler.tracing() && entry > STATIC_BANKMAX)
+			g_profiler.set_name(handler.name());
 
 		// either write directly to RAM, or call the delegate
 		offset = handler.byteoffset(byteaddress);
@@ -2208,6 +2297,31 @@ const char *address_space::get_handler_string(read_or_write readorwrite, offs_t
 }
 
 
+//-------------------------------------------------
+//  invalidate_tlb - empty the software TLBs for
+//  reads and writes
+//-------------------------------------------------
+
+void address_space::invalidate_tlb()
+{
+	read().tlb_invalidate();
+	write().tlb_invalidate();
+}
+
+
+//-------------------------------------------------
+//  tlb_stats - return the software TLB hit and
+//  miss counts for reads or writes
+//-------------------------------------------------
+
+void address_space::tlb_stats(read_or_write readorwrite, UINT64 &hits, UINT64 &misses)
+{
+	const address_table &table = (readorwrite == ROW_READ) ? static_cast<address_table &>(read()) : static_cast<address_table &>(write());
+	hits = table.tlb_hits();
+	misses = table.tlb_misses();
+}
+
+
 //-------------------------------------------------
 //  dump_map - dump the contents of a single
 //  address space
@@ -2725,6 +2839,10 @@ address_table::address_table(address_space &space, bool large)
 
 	// initialize the handlers refcounts
 	memset(handler_refcount, 0, sizeof(handler_refcount));
+
+	// start with an empty TLB
+	tlb_invalidate();
+	m_tlb_hits = m_tlb_misses = 0;
 }
 
 
@@ -2995,6 +3113,9 @@ void address_table::verify_reference_counts()
 
 void address_table::populate_range(offs_t bytestart, offs_t byteend, UINT16 handlerindex)
 {
+	// any change to the table may invalidate cached pages
+	tlb_invalidate();
+
 	offs_t l2mask = (1 << level2_bits()) - 1;
 	offs_t l1start = bytestart >> level2_bits();
 	offs_t l2start = bytestart & l2mask;
@@ -3269,6 +3390,70 @@ void address_table::mask_all_handlers(offs_t mask)
 	// we don't loop over map entries because the mask applies to static handlers as well
 	for (int entrynum = 0; entrynum < ENTRY_COUNT; entrynum++)
 		handler(entrynum).apply_mask(mask);
+
+	// cached RAM pointers were computed with the old masks
+	tlb_invalidate();
+}
+
+
+//-------------------------------------------------
+//  tlb_invalidate - empty the software TLB
+//-------------------------------------------------
+
+void address_table::tlb_invalidate()
+{
+	for (int index = 0; index < TLB_ENTRIES; index++)
+	{
+		m_tlb[index].m_page = ~0;
+		m_tlb[index].m_entry = STATIC_INVALID;
+		m_tlb[index].m_base = NULL;
+	}
+}
+
+
+//-------------------------------------------------
+//  tlb_fill - fill a TLB entry for the page
+//  containing the given address; pages that map
+//  to more than one handler are marked as mixed
+//  and always go through the table
+//-------------------------------------------------
+
+void address_table::tlb_fill(tlb_entry &tlb, offs_t byteaddress)
+{
+	offs_t pagestart = byteaddress & ~TLB_PAGE_MASK;
+	offs_t pageend = pagestart | (TLB_PAGE_MASK & m_space.bytemask());
+
+	// a large table entry that is not a subtable covers the whole page; otherwise
+	// every entry in the page must agree
+	UINT16 entry = m_live_lookup[level1_index(pagestart)];
+	if (!m_large || entry >= SUBTABLE_BASE)
+	{
+		const UINT16 *table = m_large ? &m_live_lookup[level2_index_large(entry, pagestart)] : &m_live_lookup[pagestart];
+		entry = table[0];
+		for (offs_t index = 1; index <= pageend - pagestart; index++)
+			if (table[index] != entry)
+			{
+				entry = STATIC_INVALID;
+				break;
+			}
+	}
+
+	tlb.m_page = pagestart >> TLB_PAGE_BITS;
+	tlb.m_entry = entry;
+	tlb.m_base = NULL;
+
+	// RAM pages can be accessed directly as long as they are linear across the page
+	if (entry != STATIC_INVALID && entry <= STATIC_BANKMAX)
+	{
+		const handler_entry &handler = this->handler(entry);
+		if (handler.ramptr() != NULL)
+		{
+			UINT8 *first = handler.ramptr(handler.byteoffset(pagestart));
+			UINT8 *last = handler.ramptr(handler.byteoffset(pageend));
+			if (last - first == pageend - pagestart)
+				tlb.m_base = first;
+		}
+	}
 }
 
 
@@ -3970,9 +4155,12 @@ void memory_bank::add_reference(address_space &space, read_or_write readorwrite)
 
 void memory_bank::invalidate_references()
 {
-	// invalidate all the direct references to any referenced address spaces
+	// invalidate all the direct references and TLBs of any referenced address spaces
 	for (bank_reference *ref = m_reflist.first(); ref != NULL; ref = ref->next())
+	{
 		ref->space().direct().force_update();
+		ref->space().invalidate_tlb();
+	}
 }
 
 
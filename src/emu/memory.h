@@ -306,6 +306,10 @@ public:
 	bool log_unmap() const { return m_log_unmap; }
 	void set_log_unmap(bool log) { m_log_unmap = log; }
 	void dump_map(FILE *file, read_or_write readorwrite);
+	void tlb_stats(read_or_write readorwrite, UINT64 &hits, UINT64 &misses);
+
+	// software TLB management
+	void invalidate_tlb();
 
 	// watchpoint enablers
 	virtual void enable_read_watchpoints(bool enable = true) = 0;
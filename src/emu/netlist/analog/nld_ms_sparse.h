@@ -0,0 +1,173 @@
+/*
+ * nld_ms_sparse.h
+ *
+ * Gaussian elimination specialised to the structure of one matrix group.
+ *
+ * The non-zero pattern of the matrix is fixed once the netlist has been set
+ * up, since it only depends on which nets are connected by terminals. The
+ * pattern, including fill-in, is computed in vsetup. This yields for every
+ * pivot the rows below it that need eliminating and the columns right of the
+ * diagonal that take part. Solving then only touches those elements.
+ *
+ */
+
+#ifndef NLD_MS_SPARSE_H_
+#define NLD_MS_SPARSE_H_
+
+#include "nld_solver.h"
+#include "nld_ms_direct.h"
+
+template <int m_N, int _storage_N>
+class ATTR_ALIGNED(64) netlist_matrix_solver_sparse_t: public netlist_matrix_solver_direct_t<m_N, _storage_N>
+{
+public:
+
+	netlist_matrix_solver_sparse_t(const netlist_solver_parameters_t &params, int size)
+		: netlist_matrix_solver_direct_t<m_N, _storage_N>(params, size)
+		, m_ops(0)
+		{}
+
+	virtual ~netlist_matrix_solver_sparse_t() {}
+
+	ATTR_COLD virtual void vsetup(netlist_analog_net_t::list_t &nets);
+
+	ATTR_HOT inline int vsolve_non_dynamic();
+protected:
+	ATTR_HOT virtual double vsolve();
+
+	ATTR_HOT void sparse_LE(double (* RESTRICT x));
+
+private:
+	/* columns right of the diagonal which are non-zero in each row after elimination */
+	int m_ucol_start[_storage_N + 1];
+	int m_ucol[_storage_N * _storage_N];
+
+	/* rows below each pivot with a non-zero element in the pivot column */
+	int m_lrow_start[_storage_N + 1];
+	int m_lrow[_storage_N * _storage_N];
+
+	int m_ops;
+};
+
+// ----------------------------------------------------------------------------------------
+// netlist_matrix_solver - sparse Gaussian elimination
+// ----------------------------------------------------------------------------------------
+
+template <int m_N, int _storage_N>
+ATTR_COLD void netlist_matrix_solver_sparse_t<m_N, _storage_N>::vsetup(netlist_analog_net_t::list_t &nets)
+{
+	netlist_matrix_solver_direct_t<m_N, _storage_N>::vsetup(nets);
+
+	const int kN = this->N();
+	bool touched[_storage_N][_storage_N];
+
+	for (int k = 0; k < kN; k++)
+	{
+		for (int i = 0; i < kN; i++)
+			touched[k][i] = (i == k);
+
+		const int *net_other = this->m_terms[k]->net_other();
+		for (int i = 0; i < this->m_terms[k]->m_railstart; i++)
+			touched[k][net_other[i]] = true;
+	}
+
+	/* symbolic elimination: record the fill-in */
+	for (int i = 0; i < kN; i++)
+		for (int j = i + 1; j < kN; j++)
+			if (touched[j][i])
+				for (int k = i + 1; k < kN; k++)
+					if (touched[i][k])
+						touched[j][k] = true;
+
+	int ucount = 0;
+	int lcount = 0;
+	m_ops = 0;
+	for (int i = 0; i < kN; i++)
+	{
+		m_ucol_start[i] = ucount;
+		for (int k = i + 1; k < kN; k++)
+			if (touched[i][k])
+				m_ucol[ucount++] = k;
+
+		m_lrow_start[i] = lcount;
+		for (int j = i + 1; j < kN; j++)
+			if (touched[j][i])
+				m_lrow[lcount++] = j;
+
+		m_ops += (lcount - m_lrow_start[i]) * (ucount - m_ucol_start[i] + 1);
+	}
+	m_ucol_start[kN] = ucount;
+	m_lrow_start[kN] = lcount;
+
+	this->netlist().log("       sparse LU: %d elimination operations, %d dense", m_ops, (kN - 1) * kN * (kN + 1) / 3);
+}
+
+template <int m_N, int _storage_N>
+ATTR_HOT void netlist_matrix_solver_sparse_t<m_N, _storage_N>::sparse_LE(
+		double (* RESTRICT x))
+{
+	const int kN = this->N();
+
+	for (int i = 0; i < kN; i++)
+	{
+		const double f = 1.0 / this->m_A[i][i];
+		const int * RESTRICT ucol = &m_ucol[m_ucol_start[i]];
+		const int ucount = m_ucol_start[i + 1] - m_ucol_start[i];
+
+		/* Eliminate column i from the rows which have it */
+
+		for (int jx = m_lrow_start[i]; jx < m_lrow_start[i + 1]; jx++)
+		{
+			const int j = m_lrow[jx];
+			const double f1 = - this->m_A[j][i] * f;
+
+			for (int kx = 0; kx < ucount; kx++)
+				this->m_A[j][ucol[kx]] += this->m_A[i][ucol[kx]] * f1;
+			this->m_RHS[j] += this->m_RHS[i] * f1;
+		}
+	}
+	/* back substitution */
+	for (int j = kN - 1; j >= 0; j--)
+	{
+		double tmp = 0;
+
+		for (int kx = m_ucol_start[j]; kx < m_ucol_start[j + 1]; kx++)
+			tmp += this->m_A[j][m_ucol[kx]] * x[m_ucol[kx]];
+
+		x[j] = (this->m_RHS[j] - tmp) / this->m_A[j][j];
+	}
+}
+
+template <int m_N, int _storage_N>
+ATTR_HOT double netlist_matrix_solver_sparse_t<m_N, _storage_N>::vsolve()
+{
+	this->solve_base(this);
+	return this->compute_next_timestep();
+}
+
+template <int m_N, int _storage_N>
+ATTR_HOT inline int netlist_matrix_solver_sparse_t<m_N, _storage_N>::vsolve_non_dynamic()
+{
+	double new_v[_storage_N] = { 0.0 };
+
+	this->build_LE();
+	this->sparse_LE(new_v);
+
+	if (this->is_dynamic())
+	{
+		double err = this->delta(new_v);
+
+		this->store(new_v, true);
+
+		if (err > this->m_params.m_accuracy)
+		{
+			return 2;
+		}
+		return 1;
+	}
+	this->store(new_v, false);  // ==> No need to store RHS
+	return 1;
+}
+
+
+#endif /* NLD_MS_SPARSE_H_ */
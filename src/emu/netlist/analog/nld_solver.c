@@ -32,6 +32,7 @@
 #include "nld_ms_direct1.h"
 #include "nld_ms_direct2.h"
 #include "nld_ms_gauss_seidel.h"
+#include "nld_ms_sparse.h"
 #include "nld_twoterm.h"
 #include "../nl_lists.h"
 
@@ -346,6 +347,7 @@ NETLIB_START(solver)
 	register_param("GS_THRESHOLD", m_gs_threshold, 5);      // below this value, gaussian elimination is used
 	register_param("NR_LOOPS", m_nr_loops, 25);             // Newton-Raphson loops
 	register_param("PARALLEL", m_parallel, 0);
+	register_param("SPARSE", m_sparse, 0);                  // use LU solvers specialised to each group's structure
 	register_param("SOR_FACTOR", m_sor, 1.059);
 	register_param("GMIN", m_gmin, NETLIST_GMIN_DEFAULT);
 	register_param("DYNAMIC_TS", m_dynamic, 0);
@@ -432,12 +434,14 @@ NETLIB_UPDATE(solver)
 }
 
 template <int m_N, int _storage_N>
-netlist_matrix_solver_t * NETLIB_NAME(solver)::create_solver(int size, const int gs_threshold, const bool use_specific)
+netlist_matrix_solver_t * NETLIB_NAME(solver)::create_solver(int size, const int gs_threshold, const bool use_specific, const bool use_sparse)
 {
 	if (use_specific && m_N == 1)
 		return new netlist_matrix_solver_direct1_t(m_params);
 	else if (use_specific && m_N == 2)
 		return new netlist_matrix_solver_direct2_t(m_params);
+	else if (use_sparse)
+		return new netlist_matrix_solver_sparse_t<m_N, _storage_N>(m_params, size);
 	else
 	{
 		if (size >= gs_threshold)
@@ -453,6 +457,7 @@ ATTR_COLD void NETLIB_NAME(solver)::post_start()
 	int cur_group = -1;
 	const int gs_threshold = m_gs_threshold.Value();
 	const bool use_specific = true;
+	const bool use_sparse = (m_sparse.Value() == 1);
 
 	m_params.m_accuracy = m_accuracy.Value();
 	m_params.m_gs_loops = m_gs_loops.Value();
@@ -501,44 +506,44 @@ ATTR_COLD void NETLIB_NAME(solver)::post_start()
 		switch (net_count)
 		{
 			case 1:
-				ms = create_solver<1,1>(1, gs_threshold, use_specific);
+				ms = create_solver<1,1>(1, gs_threshold, use_specific, use_sparse);
 				break;
 			case 2:
-				ms = create_solver<2,2>(2, gs_threshold, use_specific);
+				ms = create_solver<2,2>(2, gs_threshold, use_specific, use_sparse);
 				break;
 			case 3:
-				ms = create_solver<3,3>(3, gs_threshold, use_specific);
+				ms = create_solver<3,3>(3, gs_threshold, use_specific, use_sparse);
 				break;
 			case 4:
-				ms = create_solver<4,4>(4, gs_threshold, use_specific);
+				ms = create_solver<4,4>(4, gs_threshold, use_specific, use_sparse);
 				break;
 			case 5:
-				ms = create_solver<5,5>(5, gs_threshold, use_specific);
+				ms = create_solver<5,5>(5, gs_threshold, use_specific, use_sparse);
 				break;
 			case 6:
-				ms = create_solver<6,6>(6, gs_threshold, use_specific);
+				ms = create_solver<6,6>(6, gs_threshold, use_specific, use_sparse);
 				break;
 			case 7:
-				ms = create_solver<7,7>(7, gs_threshold, use_specific);
+				ms = create_solver<7,7>(7, gs_threshold, use_specific, use_sparse);
 				break;
 			case 8:
-				ms = create_solver<8,8>(8, gs_threshold, use_specific);
+				ms = create_solver<8,8>(8, gs_threshold, use_specific, use_sparse);
 				break;
 			case 12:
-				ms = create_solver<12,12>(12, gs_threshold, use_specific);
+				ms = create_solver<12,12>(12, gs_threshold, use_specific, use_sparse);
 				break;
 			default:
 				if (net_count <= 16)
 				{
-					ms = create_solver<0,16>(net_count, gs_threshold, use_specific);
+					ms = create_solver<0,16>(net_count, gs_threshold, use_specific, use_sparse);
 				}
 				else if (net_count <= 32)
 				{
-					ms = create_solver<0,32>(net_count, gs_threshold, use_specific);
+					ms = create_solver<0,32>(net_count, gs_threshold, use_specific, use_sparse);
 				}
 				else if (net_count <= 64)
 				{
-					ms = create_solver<0,64>(net_count, gs_threshold, use_specific);
+					ms = create_solver<0,64>(net_count, gs_threshold, use_specific, use_sparse);
 				}
 				else
 				{
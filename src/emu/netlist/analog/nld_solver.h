@@ -230,6 +230,9 @@ public:
 	ATTR_COLD int get_net_idx(netlist_net_t *net);
 	ATTR_COLD virtual void log_stats() {};
 
+	ATTR_COLD inline int net_count() const { return m_nets.count(); }
+	ATTR_COLD inline int solve_count() const { return m_stat_vsolver_calls; }
+
 	inline const eSolverType type() const { return m_type; }
 
 protected:
@@ -283,6 +286,8 @@ public:
 
 	ATTR_HOT inline double gmin() { return m_gmin.Value(); }
 
+	ATTR_COLD inline const netlist_matrix_solver_t::list_t &solvers() const { return m_mat_solvers; }
+
 protected:
 	ATTR_HOT void update();
 	ATTR_HOT void start();
@@ -305,6 +310,7 @@ protected:
 	netlist_param_int_t m_gs_loops;
 	netlist_param_int_t m_gs_threshold;
 	netlist_param_int_t m_parallel;
+	netlist_param_logic_t  m_sparse;
 
 	netlist_matrix_solver_t::list_t m_mat_solvers;
 private:
@@ -312,7 +318,7 @@ private:
 	netlist_solver_parameters_t m_params;
 
 	template <int m_N, int _storage_N>
-	netlist_matrix_solver_t *create_solver(int size, int gs_threshold, bool use_specific);
+	netlist_matrix_solver_t *create_solver(int size, int gs_threshold, bool use_specific, bool use_sparse);
 };
 
 
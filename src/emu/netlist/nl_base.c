@@ -142,6 +142,10 @@ netlist_base_t::netlist_base_t()
 		m_gnd(NULL),
 		m_setup(NULL)
 {
+#if (NL_KEEP_STATISTICS)
+	m_stat_events = 0;
+	m_stat_batches = 0;
+#endif
 }
 
 netlist_base_t::~netlist_base_t()
@@ -255,11 +259,17 @@ ATTR_HOT ATTR_ALIGN void netlist_base_t::process_queue(const netlist_time delta)
 	{
 		while ( (m_time < m_stop) && (m_queue.is_not_empty()))
 		{
-			const netlist_queue_t::entry_t *e = m_queue.pop();
-			m_time = e->exec_time();
-			e->object()->update_devs();
+			/* all events due at the same time are processed in one go, unless a device aborts the slice */
+			m_time = m_queue.peek()->exec_time();
+			inc_stat(m_stat_batches);
+			do
+			{
+				const netlist_queue_t::entry_t *e = m_queue.pop();
+				e->object()->update_devs();
 
-			add_to_stat(m_perf_out_processed, 1);
+				inc_stat(m_stat_events);
+				add_to_stat(m_perf_out_processed, 1);
+			} while (m_time < m_stop && m_queue.is_not_empty() && m_queue.peek()->exec_time() == m_time);
 		}
 		if (m_queue.is_empty())
 			m_time = m_stop;
@@ -280,9 +290,14 @@ ATTR_HOT ATTR_ALIGN void netlist_base_t::process_queue(const netlist_time delta)
 					NETLIB_NAME(mainclock)::mc_update(mc_net);
 				}
 
-				const netlist_queue_t::entry_t *e = m_queue.pop();
-				m_time = e->exec_time();
-				e->object()->update_devs();
+				m_time = m_queue.peek()->exec_time();
+				inc_stat(m_stat_batches);
+				do
+				{
+					const netlist_queue_t::entry_t *e = m_queue.pop();
+					e->object()->update_devs();
+					inc_stat(m_stat_events);
+				} while (m_time < m_stop && m_queue.is_not_empty() && m_queue.peek()->exec_time() == m_time);
 
 			} else {
 				m_time = mc_time;
@@ -1135,6 +1135,12 @@ public:
 	ATTR_HOT void process_queue(const netlist_time delta);
 	ATTR_HOT inline void abort_current_queue_slice() { m_stop = netlist_time::zero; }
 
+#if (NL_KEEP_STATISTICS)
+	// event statistics; a batch is a run of events for the same time
+	ATTR_COLD UINT64 stat_events() const { return m_stat_events; }
+	ATTR_COLD UINT64 stat_batches() const { return m_stat_batches; }
+#endif
+
 	ATTR_COLD void rebuild_lists(); /* must be called after post_load ! */
 
 	ATTR_COLD void set_setup(netlist_setup_t *asetup) { m_setup = asetup;  }
@@ -1215,6 +1221,10 @@ protected:
 	int m_perf_out_processed;
 	int m_perf_inp_processed;
 	int m_perf_inp_active;
+
+	// events processed, and batches of events for the same time
+	UINT64 m_stat_events;
+	UINT64 m_stat_batches;
 #endif
 
 private:
@@ -41,6 +41,9 @@ public:
 	{
 		//m_list = global_alloc_array(entry_t, SIZE);
 		clear();
+#if (NL_KEEP_STATISTICS)
+		clear_stats();
+#endif
 	}
 
 	ATTR_HOT inline int capacity() const { return _Size; }
@@ -60,6 +63,13 @@ public:
 		*i = e;
 		inc_stat(m_prof_sort);
 		assert(m_end - m_list < _Size);
+
+#if (NL_KEEP_STATISTICS)
+		m_stat_pushes++;
+		m_stat_depth += count() - 1;
+		if (count() > m_stat_max_depth)
+			m_stat_max_depth = count();
+#endif
 	}
 
 	ATTR_HOT inline const entry_t *pop()
@@ -103,6 +113,17 @@ public:
 	ATTR_HOT inline const entry_t & operator[](const int & index) const { return m_list[index]; }
 
 #if (NL_KEEP_STATISTICS)
+	// event statistics
+	ATTR_COLD void clear_stats()
+	{
+		m_stat_pushes = 0;
+		m_stat_depth = 0;
+		m_stat_max_depth = 0;
+	}
+	ATTR_COLD UINT64 stat_pushes() const { return m_stat_pushes; }
+	ATTR_COLD int stat_max_depth() const { return m_stat_max_depth; }
+	ATTR_COLD double stat_avg_depth() const { return (m_stat_pushes > 0) ? (double) m_stat_depth / (double) m_stat_pushes : 0.0; }
+
 	// profiling
 	INT32   m_prof_start;
 	INT32   m_prof_end;
@@ -115,6 +136,12 @@ private:
 	entry_t * m_end;
 	entry_t m_list[_Size];
 
+#if (NL_KEEP_STATISTICS)
+	UINT64 m_stat_pushes;
+	UINT64 m_stat_depth;
+	int m_stat_max_depth;
+#endif
+
 };
 
 #endif /* NLLISTS_H_ */
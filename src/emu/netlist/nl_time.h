@@ -41,6 +41,7 @@ public:
 	ATTR_HOT friend inline bool operator>=(const netlist_time &left, const netlist_time &right);
 	ATTR_HOT friend inline bool operator<=(const netlist_time &left, const netlist_time &right);
 	ATTR_HOT friend inline bool operator!=(const netlist_time &left, const netlist_time &right);
+	ATTR_HOT friend inline bool operator==(const netlist_time &left, const netlist_time &right);
 
 	ATTR_HOT inline const netlist_time &operator=(const netlist_time &right) { m_time = right.m_time; return *this; }
 	ATTR_HOT inline const netlist_time &operator=(const double &right) { m_time = (INTERNALTYPE) ( right * (double) RESOLUTION); return *this; }
@@ -117,4 +118,9 @@ ATTR_HOT inline bool operator!=(const netlist_time &left, const netlist_time &ri
 	return (left.m_time != right.m_time);
 }
 
+ATTR_HOT inline bool operator==(const netlist_time &left, const netlist_time &right)
+{
+	return (left.m_time == right.m_time);
+}
+
 #endif /* NLTIME_H_ */
@@ -19,6 +19,12 @@
 
     the profiler handles a FILO list so calls may be nested.
 
+    In addition to the on-screen totals, the profiler can build a call
+    tree of scopes for the whole session (-profile_output). Scopes can
+    be given a finer-grained name with set_name(), e.g. the timer
+    callback or memory handler being run, and the tree is written out
+    in folded-stack format at exit.
+
 ***************************************************************************/
 
 #include "emu.h"
@@ -52,6 +58,41 @@ profiler_state g_profiler;
 
 #define TEXT_UPDATE_TIME        0.5
 
+static const profile_string names[] =
+{
+	{ PROFILER_DRC_COMPILE,      "DRC Compilation" },
+	{ PROFILER_MEM_REMAP,        "Memory Remapping" },
+	{ PROFILER_MEMREAD,          "Memory Read" },
+	{ PROFILER_MEMWRITE,         "Memory Write" },
+	{ PROFILER_VIDEO,            "Video Update" },
+	{ PROFILER_DRAWGFX,          "drawgfx" },
+	{ PROFILER_COPYBITMAP,       "copybitmap" },
+	{ PROFILER_TILEMAP_DRAW,     "Tilemap Draw" },
+	{ PROFILER_TILEMAP_DRAW_ROZ, "Tilemap ROZ Draw" },
+	{ PROFILER_TILEMAP_UPDATE,   "Tilemap Update" },
+	{ PROFILER_BLIT,             "OSD Blitting" },
+	{ PROFILER_SOUND,            "Sound Generation" },
+	{ PROFILER_TIMER_CALLBACK,   "Timer Callbacks" },
+#ifdef USE_HISCORE
+	//MKCHAMP - INCLUDING THE HISCORE ENGINE TO THE PROFILER
+	{ PROFILER_HISCORE,          "Hiscore" },
+#endif /* USE_HISCORE */
+	{ PROFILER_INPUT,            "Input Processing" },
+	{ PROFILER_MOVIE_REC,        "Movie Recording" },
+	{ PROFILER_LOGERROR,         "Error Logging" },
+	{ PROFILER_EXTRA,            "Unaccounted/Overhead" },
+	{ PROFILER_USER1,            "User 1" },
+	{ PROFILER_USER2,            "User 2" },
+	{ PROFILER_USER3,            "User 3" },
+	{ PROFILER_USER4,            "User 4" },
+	{ PROFILER_USER5,            "User 5" },
+	{ PROFILER_USER6,            "User 6" },
+	{ PROFILER_USER7,            "User 7" },
+	{ PROFILER_USER8,            "User 8" },
+	{ PROFILER_PROFILER,         "Profiler" },
+	{ PROFILER_IDLE,             "Idle" }
+};
+
 
 
 //**************************************************************************
@@ -67,6 +108,17 @@ dummy_profiler_state::dummy_profiler_state()
 }
 
 
+//-------------------------------------------------
+//  start_trace - let the user know tracing
+//  needs a profiling build
+//-------------------------------------------------
+
+void dummy_profiler_state::start_trace()
+{
+	osd_printf_warning("Profile output requested, but the profiler is not included in this build (build with PROFILER=1)\n");
+}
+
+
 
 //**************************************************************************
 //  REAL PROFILER STATE
@@ -77,6 +129,7 @@ dummy_profiler_state::dummy_profiler_state()
 //-------------------------------------------------
 
 real_profiler_state::real_profiler_state()
+	: m_trace_root(NULL)
 {
 	memset(m_filo, 0, sizeof(m_filo));
 	memset(m_data, 0, sizeof(m_data));
@@ -101,6 +154,7 @@ void real_profiler_state::reset(bool enabled)
 		// set up dummy entry
 		m_filoptr->start = 0;
 		m_filoptr->type = PROFILER_TOTAL;
+		m_filoptr->node = m_trace_root;
 	}
 	else
 	{
@@ -141,41 +195,6 @@ const char *real_profiler_state::text(running_machine &machine)
 
 void real_profiler_state::update_text(running_machine &machine)
 {
-	static const profile_string names[] =
-	{
-		{ PROFILER_DRC_COMPILE,      "DRC Compilation" },
-		{ PROFILER_MEM_REMAP,        "Memory Remapping" },
-		{ PROFILER_MEMREAD,          "Memory Read" },
-		{ PROFILER_MEMWRITE,         "Memory Write" },
-		{ PROFILER_VIDEO,            "Video Update" },
-		{ PROFILER_DRAWGFX,          "drawgfx" },
-		{ PROFILER_COPYBITMAP,       "copybitmap" },
-		{ PROFILER_TILEMAP_DRAW,     "Tilemap Draw" },
-		{ PROFILER_TILEMAP_DRAW_ROZ, "Tilemap ROZ Draw" },
-		{ PROFILER_TILEMAP_UPDATE,   "Tilemap Update" },
-		{ PROFILER_BLIT,             "OSD Blitting" },
-		{ PROFILER_SOUND,            "Sound Generation" },
-		{ PROFILER_TIMER_CALLBACK,   "Timer Callbacks" },
-#ifdef USE_HISCORE
-		//MKCHAMP - INCLUDING THE HISCORE ENGINE TO THE PROFILER
-		{ PROFILER_HISCORE,          "Hiscore" },
-#endif /* USE_HISCORE */
-		{ PROFILER_INPUT,            "Input Processing" },
-		{ PROFILER_MOVIE_REC,        "Movie Recording" },
-		{ PROFILER_LOGERROR,         "Error Logging" },
-		{ PROFILER_EXTRA,            "Unaccounted/Overhead" },
-		{ PROFILER_USER1,            "User 1" },
-		{ PROFILER_USER2,            "User 2" },
-		{ PROFILER_USER3,            "User 3" },
-		{ PROFILER_USER4,            "User 4" },
-		{ PROFILER_USER5,            "User 5" },
-		{ PROFILER_USER6,            "User 6" },
-		{ PROFILER_USER7,            "User 7" },
-		{ PROFILER_USER8,            "User 8" },
-		{ PROFILER_PROFILER,         "Profiler" },
-		{ PROFILER_IDLE,             "Idle" }
-	};
-
 	// compute the total time for all bits, not including profiler or idle
 	UINT64 computed = 0;
 	profile_type curtype;
@@ -231,3 +250,147 @@ void real_profiler_state::update_text(running_machine &machine)
 	// reset data set to 0
 	memset(m_data, 0, sizeof(m_data));
 }
+
+
+
+//-------------------------------------------------
+//  start_trace - begin building a call tree of
+//  profiler scopes
+//-------------------------------------------------
+
+void real_profiler_state::start_trace()
+{
+	if (tracing())
+		return;
+
+	// allocate the root, which collects time spent outside of any scope
+	m_trace_root = global_alloc_clear(trace_node);
+	m_trace_root->type = PROFILER_TOTAL;
+
+	// restart with the root at the bottom of the FILO
+	reset(true);
+}
+
+
+//-------------------------------------------------
+//  trace_child - find or create the child of the
+//  given node for a type and name
+//-------------------------------------------------
+
+real_profiler_state::trace_node *real_profiler_state::trace_child(trace_node *parent, int type, const char *name)
+{
+	// names are compared by pointer; they come from tags and delegates that live for the session
+	for (trace_node *node = parent->child; node != NULL; node = node->sibling)
+		if (node->type == type && node->name == name)
+			return node;
+
+	trace_node *node = global_alloc_clear(trace_node);
+	node->parent = parent;
+	node->sibling = parent->child;
+	node->type = type;
+	node->name = name;
+	parent->child = node;
+	return node;
+}
+
+
+//-------------------------------------------------
+//  trace_label - build the frame label for a node
+//-------------------------------------------------
+
+void real_profiler_state::trace_label(running_machine &machine, astring &string, const trace_node &node)
+{
+	string.reset();
+	if (node.type >= PROFILER_DEVICE_FIRST && node.type < PROFILER_DEVICE_MAX)
+	{
+		device_iterator iter(machine.root_device());
+		device_t *device = iter.byindex(node.type - PROFILER_DEVICE_FIRST);
+		string.cpy((device != NULL) ? device->tag() : "?");
+	}
+	else
+		for (int nameindex = 0; nameindex < ARRAY_LENGTH(names); nameindex++)
+			if (names[nameindex].type == node.type)
+			{
+				string.cpy(names[nameindex].string);
+				break;
+			}
+
+	if (node.name != NULL)
+		string.cat(": ").cat(node.name);
+
+	// semicolons separate frames in the output format
+	string.replacechr(';', ',');
+}
+
+
+//-------------------------------------------------
+//  trace_write_node - write a node and all its
+//  children as folded stacks
+//-------------------------------------------------
+
+void real_profiler_state::trace_write_node(running_machine &machine, emu_file &file, astring &path, const trace_node &node)
+{
+	int pathlength = path.len();
+
+	// append our own frame
+	astring label;
+	trace_label(machine, label, node);
+	if (pathlength != 0)
+		path.cat(";");
+	path.cat(label);
+
+	// one line per stack, weighted by the ticks spent in that exact scope
+	if (node.ticks != 0)
+		file.printf("%s %" I64FMT "d\n", path.cstr(), (INT64)node.ticks);
+
+	for (const trace_node *child = node.child; child != NULL; child = child->sibling)
+		trace_write_node(machine, file, path, *child);
+
+	path.substr(0, pathlength);
+}
+
+
+//-------------------------------------------------
+//  trace_free - free a node and its children
+//-------------------------------------------------
+
+void real_profiler_state::trace_free(trace_node *node)
+{
+	trace_node *next;
+	for (trace_node *child = node->child; child != NULL; child = next)
+	{
+		next = child->sibling;
+		trace_free(child);
+	}
+	global_free(node);
+}
+
+
+//-------------------------------------------------
+//  write_trace - write out the call tree in
+//  folded-stack format and stop tracing
+//-------------------------------------------------
+
+void real_profiler_state::write_trace(running_machine &machine, const char *filename)
+{
+	if (!tracing())
+		return;
+
+	// unwind anything still open so its time is counted
+	while (m_filoptr > m_filo)
+		real_stop();
+
+	emu_file file(OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(filename) == FILERR_NONE)
+	{
+		astring path;
+		trace_write_node(machine, file, path, *m_trace_root);
+	}
+	else
+		osd_printf_error("Unable to open profile output file %s\n", filename);
+
+	// tear down the tree and go back to normal profiling
+	trace_free(m_trace_root);
+	m_trace_root = NULL;
+	reset(false);
+}
@@ -19,6 +19,12 @@
 
     the profiler handles a FILO list so calls may be nested.
 
+    In addition to the on-screen totals, the profiler can build a call
+    tree of scopes for the whole session (-profile_output). Scopes can
+    be given a finer-grained name with set_name(), e.g. the timer
+    callback or memory handler being run, and the tree is written out
+    in folded-stack format at exit.
+
 ***************************************************************************/
 
 #pragma once
@@ -28,6 +34,8 @@
 
 #include "attotime.h"
 
+class emu_file;
+
 
 
 //**************************************************************************
@@ -106,7 +114,8 @@ public:
 	// enable/disable
 	void enable(bool state = true)
 	{
-		if (state != enabled())
+		// tracing keeps us enabled until it is written out
+		if (state != enabled() && !tracing())
 		{
 			reset(state);
 		}
@@ -116,9 +125,30 @@ public:
 	void start(profile_type type) { if (enabled()) real_start(type); }
 	void stop() { if (enabled()) real_stop(); }
 
+	// call tree tracing
+	bool tracing() const { return m_trace_root != NULL; }
+	void set_name(const char *name) { if (tracing() && m_filoptr->node != NULL) m_filoptr->node = trace_child(m_filoptr->node->parent, m_filoptr->type, name); }
+	void start_trace();
+	void write_trace(running_machine &machine, const char *filename);
+
 private:
+	// a node in the call tree
+	struct trace_node
+	{
+		trace_node *    parent;                     // parent scope
+		trace_node *    child;                      // first child scope
+		trace_node *    sibling;                    // next sibling scope
+		int             type;                       // type of entry
+		const char *    name;                       // optional name from set_name()
+		osd_ticks_t     ticks;                      // time spent in this scope itself
+	};
+
 	void reset(bool enabled);
 	void update_text(running_machine &machine);
+	trace_node *trace_child(trace_node *parent, int type, const char *name);
+	void trace_label(running_machine &machine, astring &string, const trace_node &node);
+	void trace_write_node(running_machine &machine, emu_file &file, astring &path, const trace_node &node);
+	void trace_free(trace_node *node);
 
 	//-------------------------------------------------
 	//  real_start - mark the beginning of a
@@ -135,6 +165,8 @@ private:
 
 		// update previous entry
 		m_data[m_filoptr->type] += curticks - m_filoptr->start;
+		if (m_filoptr->node != NULL)
+			m_filoptr->node->ticks += curticks - m_filoptr->start;
 
 		// move to next entry
 		m_filoptr++;
@@ -142,6 +174,7 @@ private:
 		// fill in this entry
 		m_filoptr->type = type;
 		m_filoptr->start = curticks;
+		m_filoptr->node = (m_filoptr[-1].node != NULL) ? trace_child(m_filoptr[-1].node, type, NULL) : NULL;
 	}
 
 	//-------------------------------------------------
@@ -158,6 +191,8 @@ private:
 
 		// account for the time taken
 		m_data[m_filoptr->type] += curticks - m_filoptr->start;
+		if (m_filoptr->node != NULL)
+			m_filoptr->node->ticks += curticks - m_filoptr->start;
 
 		// move back an entry
 		m_filoptr--;
@@ -171,10 +206,12 @@ private:
 	{
 		int             type;                       // type of entry
 		osd_ticks_t     start;                      // start time
+		trace_node *    node;                       // call tree node, if tracing
 	};
 
 	// internal state
 	filo_entry *        m_filoptr;                  // current FILO index
+	trace_node *        m_trace_root;               // root of the call tree, or NULL if not tracing
 	astring             m_text;                     // profiler text
 	attotime            m_text_time;                // profiler text last update
 	filo_entry          m_filo[32];                 // array of FILO entries
@@ -200,6 +237,12 @@ public:
 	// start/stop
 	void start(profile_type type) { }
 	void stop() { }
+
+	// call tree tracing
+	bool tracing() const { return false; }
+	void set_name(const char *name) { }
+	void start_trace();
+	void write_trace(running_machine &machine, const char *filename) { }
 };
 
 
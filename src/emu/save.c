@@ -20,6 +20,22 @@
     Data is always written as native-endian.
     Data is converted from the endiannness it was written upon load.
 
+****************************************************************************
+
+    Rewind deltas:
+
+    Each delta is the XOR of two consecutive in-memory states, stored as
+    a sequence of blocks:
+
+    varint  Number of unchanged (zero) bytes to skip
+    varint  Number of changed bytes that follow
+    ...     The changed bytes, XORed against the newer state
+
+    Varints are 7 bits per byte, least significant first, with the top
+    bit set on all but the last byte. A changed run only ends at a run of
+    at least REWIND_MIN_SKIP unchanged bytes, which bounds the block
+    overhead for the worst case.
+
 ***************************************************************************/
 
 #include "emu.h"
@@ -44,6 +60,9 @@
 const int SAVE_VERSION      = 2;
 const int HEADER_SIZE       = 32;
 
+// shortest run of unchanged bytes that ends a block in a rewind delta
+const UINT32 REWIND_MIN_SKIP = 8;
+
 // Available flags
 enum
 {
@@ -62,7 +81,8 @@ enum
 save_manager::save_manager(running_machine &machine)
 	: m_machine(machine),
 		m_reg_allowed(true),
-		m_illegal_regs(0)
+		m_illegal_regs(0),
+		m_state_size(0)
 {
 }
 
@@ -77,7 +97,26 @@ void save_manager::allow_registration(bool allowed)
 	// allow/deny registration
 	m_reg_allowed = allowed;
 	if (!allowed)
+	{
 		dump_registry();
+
+		// the layout is now final, so compute where each entry lives in an in-memory state
+		m_state_size = 0;
+		for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+		{
+			entry->m_offset = m_state_size;
+			m_state_size += entry->m_typesize * entry->m_typecount;
+		}
+
+		// set up rewinding if requested and possible
+		if (machine().options().rewind() && m_rewind == NULL)
+		{
+			if (m_illegal_regs > 0)
+				osd_printf_warning(_("Rewind disabled due to illegal save state registrations\n"));
+			else
+				m_rewind.reset(global_alloc(rewind_manager(*this, machine().options().rewind_capacity() * 1024 * 1024)));
+		}
+	}
 }
 
 
@@ -301,6 +340,53 @@ save_error save_manager::write_file(emu_file &file)
 }
 
 
+//-------------------------------------------------
+//  write_buffer - write the current state into
+//  a block of state_size() bytes of memory
+//-------------------------------------------------
+
+save_error save_manager::write_buffer(UINT8 *data)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+	assert(!m_reg_allowed);
+
+	// call the pre-save functions
+	for (state_callback *func = m_presave_list.first(); func != NULL; func = func->next())
+		func->m_func();
+
+	// then copy all the data
+	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+		memcpy(data + entry->m_offset, entry->m_data, entry->m_typesize * entry->m_typecount);
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  read_buffer - restore the state from a block
+//  of memory filled by write_buffer
+//-------------------------------------------------
+
+save_error save_manager::read_buffer(const UINT8 *data)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+	assert(!m_reg_allowed);
+
+	// copy all the data; it was written by us, so no flipping is needed
+	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+		memcpy(entry->m_data, data + entry->m_offset, entry->m_typesize * entry->m_typecount);
+
+	// call the post-load functions
+	for (state_callback *func = m_postload_list.first(); func != NULL; func = func->next())
+		func->m_func();
+
+	return STATERR_NONE;
+}
+
+
 //-------------------------------------------------
 //  signature - compute the signature, which
 //  is a CRC over the structure of the data
@@ -443,3 +529,325 @@ void save_manager::state_entry::flip_data()
 			break;
 	}
 }
+
+
+
+//**************************************************************************
+//  REWIND MANAGER
+//**************************************************************************
+
+//-------------------------------------------------
+//  write_varint - write a variable-length
+//  integer, returning the new end pointer
+//-------------------------------------------------
+
+static inline UINT8 *write_varint(UINT8 *dest, UINT32 value)
+{
+	for ( ; value >= 0x80; value >>= 7)
+		*dest++ = (value & 0x7f) | 0x80;
+	*dest++ = value;
+	return dest;
+}
+
+
+//-------------------------------------------------
+//  read_varint - read a variable-length integer,
+//  returning the pointer past it
+//-------------------------------------------------
+
+static inline const UINT8 *read_varint(const UINT8 *src, UINT32 &value)
+{
+	value = 0;
+	for (int shift = 0; ; shift += 7)
+	{
+		value |= (*src & 0x7f) << shift;
+		if ((*src++ & 0x80) == 0)
+			return src;
+	}
+}
+
+
+//-------------------------------------------------
+//  rewind_manager - constructor
+//-------------------------------------------------
+
+rewind_manager::rewind_manager(save_manager &save, UINT32 capacity)
+	: m_save(save),
+		m_current(0),
+		m_valid(false),
+		m_capture_pending(false),
+		m_restore_pending(false),
+		m_last_time(attotime::zero)
+{
+	UINT32 size = save.state_size();
+	m_state[0].resize(size);
+	m_state[1].resize(size);
+
+	// worst case: every other REWIND_MIN_SKIP bytes changed, with two 5-byte varints per block
+	m_encoded.resize(size + (size / REWIND_MIN_SKIP + 1) * 10);
+	m_ring.resize(capacity);
+
+	// note the end of every frame; the capture itself waits for the end of the timeslice
+	machine().add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(FUNC(rewind_manager::frame_update), this));
+}
+
+
+//-------------------------------------------------
+//  ~rewind_manager - destructor
+//-------------------------------------------------
+
+rewind_manager::~rewind_manager()
+{
+	while (m_step_list.first() != NULL)
+		discard_oldest();
+}
+
+
+//-------------------------------------------------
+//  frame_update - note that a frame has completed
+//-------------------------------------------------
+
+void rewind_manager::frame_update()
+{
+	m_capture_pending = true;
+}
+
+
+//-------------------------------------------------
+//  update - perform any pending restore or
+//  capture; called between timeslices, where
+//  no timer callback is half way through
+//-------------------------------------------------
+
+void rewind_manager::update()
+{
+	if (m_restore_pending)
+		restore();
+	else if (m_capture_pending)
+		capture();
+	m_restore_pending = m_capture_pending = false;
+}
+
+
+//-------------------------------------------------
+//  capture - capture the current state and push
+//  a delta leading back to the previous one
+//-------------------------------------------------
+
+void rewind_manager::capture()
+{
+	// only capture once emulation has actually moved on (not while paused)
+	attotime now = machine().time();
+	if (m_valid && now == m_last_time)
+		return;
+
+	// anonymous timers can't be captured; the next frame's delta will cover this one too
+	if (!machine().scheduler().can_save())
+		return;
+
+	// write the new state into the scratch copy
+	UINT8 *older = m_state[m_current];
+	UINT8 *newer = m_state[m_current ^ 1];
+	if (m_save.write_buffer(newer) != STATERR_NONE)
+		return;
+
+	// record how to get from the new state back to the old one
+	if (m_valid)
+		store_delta(m_encoded, encode_delta(newer, older, m_save.state_size(), m_encoded));
+
+	// the new state becomes the current one
+	m_current ^= 1;
+	m_valid = true;
+	m_last_time = now;
+}
+
+
+//-------------------------------------------------
+//  step_back - request a restore of the state
+//  from two captures ago at the next update;
+//  returns false if there isn't enough history
+//-------------------------------------------------
+
+bool rewind_manager::step_back()
+{
+	if (m_step_list.count() < 2 || !machine().scheduler().can_save())
+		return false;
+
+	m_restore_pending = true;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  restore - restore the state from two captures
+//  ago, so that single-stepping one frame
+//  forward redraws the previous frame
+//-------------------------------------------------
+
+void rewind_manager::restore()
+{
+	if (m_step_list.count() < 2 || !machine().scheduler().can_save())
+		return;
+
+	// unwind the two newest deltas into the current state
+	for (int stepnum = 0; stepnum < 2; stepnum++)
+	{
+		rewind_step *step = m_step_list.last();
+		if (step->m_length != 0)
+			apply_delta(m_state[m_current], &m_ring[step->m_offset], step->m_length);
+		m_step_allocator.reclaim(m_step_list.detach(*step));
+	}
+
+	// and load it
+	m_save.read_buffer(m_state[m_current]);
+	m_last_time = machine().time();
+}
+
+
+//-------------------------------------------------
+//  store_delta - copy an encoded delta into the
+//  ring, discarding the oldest ones to make room
+//-------------------------------------------------
+
+void rewind_manager::store_delta(const UINT8 *data, UINT32 length)
+{
+	UINT32 capacity = m_ring.count();
+
+	// if it can never fit, all we can do is start over from here
+	if (length > capacity)
+	{
+		while (m_step_list.first() != NULL)
+			discard_oldest();
+		return;
+	}
+
+	// find a free span, throwing away the oldest deltas until there is one
+	UINT32 offset = 0;
+	while (m_step_list.first() != NULL)
+	{
+		UINT32 head = m_step_list.last()->m_offset + m_step_list.last()->m_length;
+		UINT32 tail = m_step_list.first()->m_offset;
+
+		// if the newest delta runs right up to the end, the free space starts over at 0
+		if (head == capacity)
+			head = 0;
+
+		// if the oldest delta lies beyond the newest, the free span is the gap between them
+		if (tail >= head)
+		{
+			if (tail - head >= length)
+			{
+				offset = head;
+				break;
+			}
+		}
+
+		// otherwise it's the space after the newest plus the space before the oldest
+		else
+		{
+			if (capacity - head >= length)
+			{
+				offset = head;
+				break;
+			}
+			if (tail >= length)
+			{
+				offset = 0;
+				break;
+			}
+		}
+		discard_oldest();
+	}
+
+	// copy in the data and append it; an empty delta takes no space and may sit at the end
+	if (length != 0)
+		memcpy(&m_ring[offset], data, length);
+	rewind_step *step = m_step_allocator.alloc();
+	step->m_offset = offset;
+	step->m_length = length;
+	m_step_list.append(*step);
+}
+
+
+//-------------------------------------------------
+//  discard_oldest - throw away the oldest delta
+//-------------------------------------------------
+
+void rewind_manager::discard_oldest()
+{
+	m_step_allocator.reclaim(m_step_list.detach_head());
+}
+
+
+//-------------------------------------------------
+//  encode_delta - encode the difference between
+//  two states, returning the encoded length
+//-------------------------------------------------
+
+UINT32 rewind_manager::encode_delta(const UINT8 *newer, const UINT8 *older, UINT32 length, UINT8 *dest)
+{
+	UINT8 *start = dest;
+	UINT32 pos = 0;
+	while (pos < length)
+	{
+		// count unchanged bytes, 8 at a time where possible
+		UINT32 skipstart = pos;
+		while (pos + 8 <= length && memcmp(&newer[pos], &older[pos], 8) == 0)
+			pos += 8;
+		while (pos < length && newer[pos] == older[pos])
+			pos++;
+		UINT32 skip = pos - skipstart;
+
+		// count changed bytes, absorbing short unchanged gaps
+		UINT32 changestart = pos;
+		while (pos < length)
+		{
+			if (newer[pos] != older[pos])
+			{
+				pos++;
+				continue;
+			}
+			UINT32 run = 1;
+			while (run < REWIND_MIN_SKIP && pos + run < length && newer[pos + run] == older[pos + run])
+				run++;
+			if (run >= REWIND_MIN_SKIP || pos + run == length)
+				break;
+			pos += run;
+		}
+		UINT32 change = pos - changestart;
+
+		// nothing changed at the end is implied
+		if (change == 0)
+			break;
+
+		// write the block header and the XORed bytes
+		dest = write_varint(dest, skip);
+		dest = write_varint(dest, change);
+		for (UINT32 index = changestart; index < pos; index++)
+			*dest++ = newer[index] ^ older[index];
+	}
+	return dest - start;
+}
+
+
+//-------------------------------------------------
+//  apply_delta - XOR an encoded delta into a
+//  state
+//-------------------------------------------------
+
+void rewind_manager::apply_delta(UINT8 *state, const UINT8 *delta, UINT32 length)
+{
+	const UINT8 *end = delta + length;
+	while (delta < end)
+	{
+		// decode the block header
+		UINT32 skip, change;
+		delta = read_varint(delta, skip);
+		delta = read_varint(delta, change);
+
+		// XOR the changed bytes into place
+		state += skip;
+		while (change-- != 0)
+			*state++ ^= *delta++;
+	}
+}
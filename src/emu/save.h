@@ -76,6 +76,11 @@ typedef delegate<void ()> save_prepost_delegate;
 //  TYPE DEFINITIONS
 //**************************************************************************
 
+class rewind_manager;
+
+
+// ======================> save_manager
+
 class save_manager
 {
 	// type_checker is a set of templates to identify valid save types
@@ -90,6 +95,8 @@ public:
 	running_machine &machine() const { return m_machine; }
 	int registration_count() const { return m_entry_list.count(); }
 	bool registration_allowed() const { return m_reg_allowed; }
+	UINT32 state_size() const { return m_state_size; }
+	rewind_manager *rewind() const { return m_rewind; }
 
 	// registration control
 	void allow_registration(bool allowed = true);
@@ -146,6 +153,10 @@ public:
 	save_error write_file(emu_file &file);
 	save_error read_file(emu_file &file);
 
+	// in-memory processing; buffers must be state_size() bytes
+	save_error write_buffer(UINT8 *data);
+	save_error read_buffer(const UINT8 *data);
+
 private:
 	// internal helpers
 	UINT32 signature() const;
@@ -192,6 +203,8 @@ private:
 	running_machine &       m_machine;              // reference to our machine
 	bool                    m_reg_allowed;          // are registrations allowed?
 	int                     m_illegal_regs;         // number of illegal registrations
+	UINT32                  m_state_size;           // total size of all entries, once registration closes
+	auto_pointer<rewind_manager> m_rewind;          // rewind buffer, if enabled
 
 	simple_list<state_entry> m_entry_list;          // list of reigstered entries
 	simple_list<state_callback> m_presave_list;     // list of pre-save functions
@@ -199,6 +212,63 @@ private:
 };
 
 
+// ======================> rewind_manager
+
+// rewind_manager keeps the most recent state in memory along with a ring of
+// compressed deltas leading back from it, one per emulated frame
+class rewind_manager
+{
+public:
+	// construction/destruction
+	rewind_manager(save_manager &save, UINT32 capacity);
+	~rewind_manager();
+
+	// getters
+	running_machine &machine() const { return m_save.machine(); }
+	int steps() const { return m_step_list.count(); }
+
+	// operations
+	bool step_back();
+	void update();
+
+private:
+	// internal helpers
+	void frame_update();
+	void capture();
+	void restore();
+	void store_delta(const UINT8 *data, UINT32 length);
+	void discard_oldest();
+	static UINT32 encode_delta(const UINT8 *newer, const UINT8 *older, UINT32 length, UINT8 *dest);
+	static void apply_delta(UINT8 *state, const UINT8 *delta, UINT32 length);
+
+	// a single compressed delta in the ring
+	class rewind_step
+	{
+	public:
+		// getters
+		rewind_step *next() const { return m_next; }
+
+		// state
+		rewind_step *       m_next;                 // next (newer) step
+		UINT32              m_offset;               // offset of the delta within the ring
+		UINT32              m_length;               // length of the delta
+	};
+
+	// internal state
+	save_manager &          m_save;                 // reference to the save manager
+	dynamic_buffer          m_state[2];             // current and scratch copies of the full state
+	int                     m_current;              // which of m_state holds the current state
+	bool                    m_valid;                // true once m_state[m_current] holds a capture
+	bool                    m_capture_pending;      // true if a frame has completed since the last update
+	bool                    m_restore_pending;      // true if step_back has been requested
+	attotime                m_last_time;            // machine time of the current state
+	dynamic_buffer          m_encoded;              // scratch space for encoding a delta
+	dynamic_buffer          m_ring;                 // ring buffer holding the deltas
+	simple_list<rewind_step> m_step_list;           // deltas in the ring, oldest first
+	fixed_allocator<rewind_step> m_step_allocator;  // allocator for rewind_step objects
+};
+
+
 // template specializations to enumerate the fundamental atomic types you are allowed to save
 ALLOW_SAVE_TYPE_AND_ARRAY(char);
 ALLOW_SAVE_TYPE_AND_ARRAY(bool);
@@ -35,6 +35,9 @@ enum
 	TRIGGER_SUSPENDTIME = -4000
 };
 
+// fan-out of the timer heap; 4 keeps each set of children in a single cache line
+const int TIMER_HEAP_ARITY = 4;
+
 
 
 //**************************************************************************
@@ -49,6 +52,9 @@ emu_timer::emu_timer()
 	: m_machine(NULL),
 		m_next(NULL),
 		m_prev(NULL),
+		m_heap_index(-1),
+		m_sequence(0),
+		m_heap_key(attotime::never),
 		m_param(0),
 		m_ptr(NULL),
 		m_enabled(false),
@@ -82,6 +88,7 @@ emu_timer &emu_timer::init(running_machine &machine, timer_expired_delegate call
 	m_machine = &machine;
 	m_next = NULL;
 	m_prev = NULL;
+	m_heap_index = -1;
 	m_callback = callback;
 	m_param = 0;
 	m_ptr = ptr;
@@ -114,6 +121,7 @@ emu_timer &emu_timer::init(device_t &device, device_timer_id id, void *ptr, bool
 	m_machine = &device.machine();
 	m_next = NULL;
 	m_prev = NULL;
+	m_heap_index = -1;
 	m_callback = timer_expired_delegate();
 	m_param = 0;
 	m_ptr = ptr;
@@ -161,9 +169,8 @@ bool emu_timer::enable(bool enable)
 		// set the enable flag
 		m_enabled = enable;
 
-		// remove the timer and insert back into the list
-		machine().scheduler().timer_list_remove(*this);
-		machine().scheduler().timer_list_insert(*this);
+		// move the timer to its new position in the heap
+		machine().scheduler().timer_heap_update(*this);
 	}
 	return old;
 }
@@ -195,12 +202,12 @@ void emu_timer::adjust(attotime start_delay, INT32 param, const attotime &period
 	m_expire = m_start + start_delay;
 	m_period = period;
 
-	// remove and re-insert the timer in its new order
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	// move the timer to its new position in the heap
+	scheduler.timer_heap_update(*this);
 
-	// if this was inserted as the head, abort the current timeslice and resync
-	if (this == scheduler.first_timer())
+	// if this is now the next timer to fire, abort the current timeslice and resync;
+	// parallel devices defer their heap updates, so compare against the current top instead
+	if (this == &scheduler.timer_heap_top() || (scheduler.m_parallel_active && m_expire < scheduler.timer_heap_top().m_heap_key))
 		scheduler.abort_timeslice();
 }
 
@@ -279,10 +286,8 @@ inline void emu_timer::schedule_next_period()
 	m_start = m_expire;
 	m_expire += m_period;
 
-	// remove and re-insert us
-	device_scheduler &scheduler = machine().scheduler();
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	// move us to our new position in the heap
+	machine().scheduler().timer_heap_update(*this);
 }
 
 
@@ -306,6 +311,10 @@ void emu_timer::dump() const
 //  DEVICE SCHEDULER
 //**************************************************************************
 
+// parallel device running on the current thread, if any
+ATTR_THREAD_LOCAL device_execute_interface *device_scheduler::s_parallel_device = NULL;
+
+
 //-------------------------------------------------
 //  device_scheduler - constructor
 //-------------------------------------------------
@@ -316,15 +325,19 @@ device_scheduler::device_scheduler(running_machine &machine) :
 	m_execute_list(NULL),
 	m_basetime(attotime::zero),
 	m_timer_list(NULL),
+	m_timer_sequence(0),
 	m_callback_timer(NULL),
 	m_callback_timer_modified(false),
 	m_callback_timer_expire_time(attotime::zero),
 	m_suspend_changes_pending(true),
+	m_parallel_queue(NULL),
+	m_parallel_lock(NULL),
+	m_parallel_active(false),
+	m_parallel_validate(false),
 	m_quantum_minimum(ATTOSECONDS_IN_NSEC(1) / 1000)
 {
-	// append a single never-expiring timer so there is always one in the list
-	m_timer_list = &m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), NULL, true);
-	m_timer_list->adjust(attotime::never);
+	// append a single never-expiring timer so there is always one in the heap
+	m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), NULL, true).adjust(attotime::never);
 
 	// register global states
 	machine.save().save_item(NAME(m_basetime));
@@ -342,6 +355,12 @@ device_scheduler::~device_scheduler()
 	// remove all timers
 	while (m_timer_list != NULL)
 		m_timer_allocator.reclaim(m_timer_list->release());
+
+	// free the parallel execution queue
+	if (m_parallel_queue != NULL)
+		osd_work_queue_free(m_parallel_queue);
+	if (m_parallel_lock != NULL)
+		osd_lock_free(m_parallel_lock);
 }
 
 
@@ -357,7 +376,8 @@ attotime device_scheduler::time() const
 
 	// if we're executing as a particular CPU, use its local time as a base
 	// otherwise, return the global base time
-	return (m_executing_device != NULL) ? m_executing_device->local_time() : m_basetime;
+	device_execute_interface *executing = currently_executing();
+	return (executing != NULL) ? executing->local_time() : m_basetime;
 }
 
 
@@ -424,14 +444,14 @@ void device_scheduler::timeslice()
 		m_quantum_allocator.reclaim(m_quantum_list.detach_head());
 
 	// loop until we hit the next timer
-	while (m_basetime < m_timer_list->m_expire)
+	while (m_basetime < timer_heap_top().m_heap_key)
 	{
 		// by default, assume our target is the end of the next quantum
 		attotime target = m_basetime + attotime(0, m_quantum_list.first()->m_actual);
 
 		// however, if the next timer is going to fire before then, override
-		if (m_timer_list->m_expire < target)
-			target = m_timer_list->m_expire;
+		if (timer_heap_top().m_heap_key < target)
+			target = timer_heap_top().m_heap_key;
 
 		LOG(("------------------\n"));
 		LOG(("cpu_timeslice: target = %s\n", target.as_string(PRECISION)));
@@ -443,6 +463,14 @@ void device_scheduler::timeslice()
 		// loop over all CPUs
 		for (device_execute_interface *exec = m_execute_list; exec != NULL; exec = exec->m_nextexec)
 		{
+			// runs of parallel devices are dispatched together to the work queue
+			if (m_parallel_queue != NULL && exec->m_parallel && !call_debugger)
+			{
+				exec = execute_parallel(exec, target);
+				if (exec == NULL)
+					break;
+			}
+
 			// only process if this CPU is executing or truly halted (not yielding)
 			// and if our target is later than the CPU's current time (coarse check)
 			if (EXPECTED((exec->m_suspend == 0 || exec->m_eatcycles) && target.seconds >= exec->m_localtime.seconds))
@@ -501,6 +529,10 @@ void device_scheduler::timeslice()
 					// if the new local CPU time is less than our target, move the target up, but not before the base
 					if (exec->m_localtime < target)
 					{
+						// threaded execution would still run the rest of the group to the old target
+						if (m_parallel_validate && exec->m_parallel && exec->m_nextexec != NULL && exec->m_nextexec->m_parallel)
+							logerror("Parallel device '%s' stopped %s early; threaded results for '%s' will differ\n",
+									exec->device().tag(), (target - exec->m_localtime).as_string(PRECISION), exec->m_nextexec->device().tag());
 						target = max(exec->m_localtime, m_basetime);
 						LOG(("         (new target)\n"));
 					}
@@ -525,8 +557,9 @@ void device_scheduler::timeslice()
 
 void device_scheduler::abort_timeslice()
 {
-	if (m_executing_device != NULL)
-		m_executing_device->abort_timeslice();
+	device_execute_interface *executing = currently_executing();
+	if (executing != NULL)
+		executing->abort_timeslice();
 }
 
 
@@ -572,7 +605,7 @@ void device_scheduler::boost_interleave(const attotime &timeslice_time, const at
 
 emu_timer *device_scheduler::timer_alloc(timer_expired_delegate callback, void *ptr)
 {
-	return &m_timer_allocator.alloc()->init(machine(), callback, ptr, false);
+	return &timer_alloc_item()->init(machine(), callback, ptr, false);
 }
 
 
@@ -584,7 +617,7 @@ emu_timer *device_scheduler::timer_alloc(timer_expired_delegate callback, void *
 
 void device_scheduler::timer_set(const attotime &duration, timer_expired_delegate callback, int param, void *ptr)
 {
-	m_timer_allocator.alloc()->init(machine(), callback, ptr, true).adjust(duration, param);
+	timer_alloc_item()->init(machine(), callback, ptr, true).adjust(duration, param);
 }
 
 
@@ -596,7 +629,7 @@ void device_scheduler::timer_set(const attotime &duration, timer_expired_delegat
 
 void device_scheduler::timer_pulse(const attotime &period, timer_expired_delegate callback, int param, void *ptr)
 {
-	m_timer_allocator.alloc()->init(machine(), callback, ptr, false).adjust(period, param, period);
+	timer_alloc_item()->init(machine(), callback, ptr, false).adjust(period, param, period);
 }
 
 
@@ -607,7 +640,7 @@ void device_scheduler::timer_pulse(const attotime &period, timer_expired_delegat
 
 emu_timer *device_scheduler::timer_alloc(device_t &device, device_timer_id id, void *ptr)
 {
-	return &m_timer_allocator.alloc()->init(device, id, ptr, false);
+	return &timer_alloc_item()->init(device, id, ptr, false);
 }
 
 
@@ -619,7 +652,7 @@ emu_timer *device_scheduler::timer_alloc(device_t &device, device_timer_id id, v
 
 void device_scheduler::timer_set(const attotime &duration, device_t &device, device_timer_id id, int param, void *ptr)
 {
-	m_timer_allocator.alloc()->init(device, id, ptr, true).adjust(duration, param);
+	timer_alloc_item()->init(device, id, ptr, true).adjust(duration, param);
 }
 
 
@@ -664,25 +697,17 @@ void device_scheduler::presave()
 
 void device_scheduler::postload()
 {
-	// remove all timers and make a private list of permanent ones
-	simple_list<emu_timer> private_list;
-	while (m_timer_list != NULL)
+	// temporary timers go away entirely (except our special never-expiring one)
+	emu_timer *nexttimer;
+	for (emu_timer *timer = m_timer_list; timer != NULL; timer = nexttimer)
 	{
-		emu_timer &timer = *m_timer_list;
-
-		// temporary timers go away entirely (except our special never-expiring one)
-		if (timer.m_temporary && !timer.expire().is_never())
-			m_timer_allocator.reclaim(timer.release());
-
-		// permanent ones get added to our private list
-		else
-			private_list.append(timer_list_remove(timer));
+		nexttimer = timer->next();
+		if (timer->m_temporary && !timer->expire().is_never())
+			m_timer_allocator.reclaim(timer->release());
 	}
 
-	// now re-insert them; this effectively re-sorts them by time
-	emu_timer *timer;
-	while ((timer = private_list.detach_head()) != NULL)
-		timer_list_insert(*timer);
+	// the loaded state changed expiration times behind the heap's back; rebuild it
+	timer_heap_rebuild();
 
 	m_suspend_changes_pending = true;
 	rebuild_execute_list();
@@ -803,59 +828,238 @@ void device_scheduler::rebuild_execute_list()
 
 	// append the suspend list to the end of the active list
 	*active_tailptr = suspend_list;
+
+	// allocate a work queue if parallel execution is requested and anyone can use it;
+	// in validation mode parallel devices stay on the serial path instead
+	if (m_parallel_queue == NULL && !m_parallel_validate && machine().options().parallel_execute())
+		for (device_execute_interface *exec = m_execute_list; exec != NULL; exec = exec->m_nextexec)
+			if (exec->m_parallel)
+			{
+				if (machine().options().parallel_validate())
+					m_parallel_validate = true;
+				else
+				{
+					m_parallel_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+					m_parallel_lock = osd_lock_alloc();
+				}
+				break;
+			}
 }
 
 
 //-------------------------------------------------
-//  timer_list_insert - insert a new timer into
-//  the list at the appropriate location
+//  execute_parallel - run a consecutive group of
+//  parallel devices from the execute list
+//  concurrently up to the given target; returns
+//  the first device after the group
 //-------------------------------------------------
 
-emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
+device_execute_interface *device_scheduler::execute_parallel(device_execute_interface *first, attotime &target)
 {
-	// disabled timers sort to the end
-	const attotime &expire = timer.m_enabled ? timer.m_expire : attotime::never;
+	// gather the group and work out how far each member needs to go
+	m_parallel_group.resize(0);
+	m_parallel_batch.resize(0);
+	device_execute_interface *exec;
+	for (exec = first; exec != NULL && exec->m_parallel; exec = exec->m_nextexec)
+		if ((exec->m_suspend == 0 || exec->m_eatcycles) && target.seconds >= exec->m_localtime.seconds)
+		{
+			attoseconds_t delta = (target - exec->m_localtime).as_attoseconds();
+			if (delta >= exec->m_attoseconds_per_cycle)
+			{
+				exec->m_cycles_running = divu_64x32((UINT64)delta >> exec->m_divshift, exec->m_divisor);
+				m_parallel_group.append(exec);
 
-	// loop over the timer list
-	emu_timer *prevtimer = NULL;
-	for (emu_timer *curtimer = m_timer_list; curtimer != NULL; prevtimer = curtimer, curtimer = curtimer->next())
+				// only devices that aren't suspended actually execute
+				if (exec->m_suspend == 0)
+				{
+					exec->m_cycles_stolen = 0;
+					*exec->m_icountptr = exec->m_cycles_running;
+					exec->m_parallel_executing = true;
+					m_parallel_batch.append(exec);
+				}
+			}
+		}
+	device_execute_interface *end = exec;
+
+	// every member runs to the same target, so the result doesn't depend on thread timing;
+	// the profiler isn't thread safe, so fall back to running them in order while it's on
+	m_parallel_active = true;
+	if (m_parallel_batch.count() == 1 || g_profiler.enabled())
 	{
-		// if the current list entry expires after us, we should be inserted before it
-		if (curtimer->m_expire > expire)
+		for (int index = 0; index < m_parallel_batch.count(); index++)
 		{
-			// link the new guy in before the current list entry
-			timer.m_prev = curtimer->m_prev;
-			timer.m_next = curtimer;
-
-			if (curtimer->m_prev != NULL)
-				curtimer->m_prev->m_next = &timer;
-			else
-				m_timer_list = &timer;
+			exec = m_parallel_batch[index];
+			g_profiler.start(exec->m_profiler);
+			s_parallel_device = exec;
+			exec->run();
+			s_parallel_device = NULL;
+			g_profiler.stop();
+		}
+	}
+	else if (m_parallel_batch.count() > 1)
+	{
+		osd_work_item_queue_multiple(m_parallel_queue, parallel_execute_callback, m_parallel_batch.count(), &m_parallel_batch[0], sizeof(m_parallel_batch[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		osd_work_queue_wait(m_parallel_queue, osd_ticks_per_second() * 100);
+	}
+	m_parallel_active = false;
 
-			curtimer->m_prev = &timer;
-			return timer;
+	// now account for the cycles in execute list order, same as the serial path
+	attotime earliest = target;
+	for (int index = 0; index < m_parallel_group.count(); index++)
+	{
+		exec = m_parallel_group[index];
+		int ran = exec->m_cycles_running;
+		if (exec->m_parallel_executing)
+		{
+			exec->m_parallel_executing = false;
+			assert(ran >= *exec->m_icountptr);
+			ran -= *exec->m_icountptr;
+			assert(ran >= exec->m_cycles_stolen);
+			ran -= exec->m_cycles_stolen;
 		}
+		exec->m_totalcycles += ran;
+		exec->m_localtime += attotime(0, exec->m_attoseconds_per_cycle * ran);
+		LOG(("  cpu '%s': %d ran in parallel, %d total, time = %s\n", exec->device().tag(), ran, (INT32)exec->m_totalcycles, exec->m_localtime.as_string(PRECISION)));
+		if (exec->m_localtime < earliest)
+			earliest = exec->m_localtime;
+
+		// replay any timer changes in the order the serial path would have made them
+		apply_deferred_timers(*exec);
 	}
 
-	// need to insert after the last one
-	if (prevtimer != NULL)
-		prevtimer->m_next = &timer;
-	else
-		m_timer_list = &timer;
+	// if anyone stopped early, pull the target back for the devices that follow
+	if (earliest < target)
+		target = max(earliest, m_basetime);
+
+	return end;
+}
+
+
+//-------------------------------------------------
+//  validate_parallel_access - with
+//  -parallel_validate, log a parallel device
+//  controlling another member of its group,
+//  which threaded execution would be running at
+//  the same time
+//-------------------------------------------------
 
-	timer.m_prev = prevtimer;
-	timer.m_next = NULL;
+void device_scheduler::validate_parallel_access(device_execute_interface &target, const char *what)
+{
+	device_execute_interface *executing = m_executing_device;
+	if (!m_parallel_validate || executing == NULL || executing == &target || !executing->m_parallel || !target.m_parallel)
+		return;
+
+	// both must be in the same run of consecutive parallel devices
+	int found = 0;
+	for (device_execute_interface *exec = m_execute_list; exec != NULL && found < 2; exec = exec->m_nextexec)
+	{
+		if (!exec->m_parallel)
+			found = 0;
+		else if (exec == executing || exec == &target)
+			found++;
+	}
+	if (found == 2)
+		logerror("Parallel device '%s' %s '%s' in the same group; threaded results will differ\n", executing->device().tag(), what, target.device().tag());
+}
+
+
+//-------------------------------------------------
+//  parallel_execute_callback - work queue callback
+//  to run a single parallel device
+//-------------------------------------------------
+
+void *device_scheduler::parallel_execute_callback(void *param, int threadid)
+{
+	device_execute_interface *exec = *(device_execute_interface **)param;
+	s_parallel_device = exec;
+	exec->run();
+	s_parallel_device = NULL;
+	return NULL;
+}
+
+
+//-------------------------------------------------
+//  apply_deferred_timers - insert or reposition
+//  the timers a parallel device changed while it
+//  was running
+//-------------------------------------------------
+
+void device_scheduler::apply_deferred_timers(device_execute_interface &exec)
+{
+	for (int index = 0; index < exec.m_parallel_timers.count(); index++)
+	{
+		emu_timer &timer = *exec.m_parallel_timers[index];
+		if (timer.m_heap_index < 0)
+			timer_list_insert(timer);
+		else
+			timer_heap_update(timer);
+	}
+	exec.m_parallel_timers.resize(0);
+}
+
+
+//-------------------------------------------------
+//  timer_alloc_item - get a fresh timer from the
+//  allocator
+//-------------------------------------------------
+
+emu_timer *device_scheduler::timer_alloc_item()
+{
+	if (!m_parallel_active)
+		return m_timer_allocator.alloc();
+
+	// the free list is shared, so parallel devices take turns
+	osd_lock_acquire(m_parallel_lock);
+	emu_timer *timer = m_timer_allocator.alloc();
+	osd_lock_release(m_parallel_lock);
+	return timer;
+}
+
+
+//-------------------------------------------------
+//  timer_list_insert - insert a new timer into
+//  the list of all timers and into the heap
+//-------------------------------------------------
+
+emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
+{
+	// parallel devices queue their timer changes until the group is done
+	if (m_parallel_active)
+	{
+		assert(s_parallel_device != NULL);
+		s_parallel_device->m_parallel_timers.append(&timer);
+		return timer;
+	}
+
+	// link at the head of the list of all timers
+	timer.m_prev = NULL;
+	timer.m_next = m_timer_list;
+	if (m_timer_list != NULL)
+		m_timer_list->m_prev = &timer;
+	m_timer_list = &timer;
+
+	// disabled timers sort to the end; equal expirations stay in insertion order
+	timer.m_heap_key = timer.m_enabled ? timer.m_expire : attotime::never;
+	timer.m_sequence = m_timer_sequence++;
+
+	// append to the heap and let it bubble up to its proper place
+	timer.m_heap_index = m_timer_heap.count();
+	m_timer_heap.append(&timer);
+	timer_heap_sift_up(timer.m_heap_index);
 	return timer;
 }
 
 
 //-------------------------------------------------
 //  timer_list_remove - remove a timer from the
-//  linked list
+//  list of all timers and from the heap
 //-------------------------------------------------
 
 emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 {
+	// timers are only released outside of parallel execution
+	assert(!m_parallel_active);
+
 	// remove it from the list
 	if (timer.m_prev != NULL)
 		timer.m_prev->m_next = timer.m_next;
@@ -865,23 +1069,146 @@ emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 	if (timer.m_next != NULL)
 		timer.m_next->m_prev = timer.m_prev;
 
+	// move the last heap entry into the hole and restore the heap order
+	int index = timer.m_heap_index;
+	int last = m_timer_heap.count() - 1;
+	assert(index >= 0 && index <= last && m_timer_heap[index] == &timer);
+	emu_timer *lasttimer = m_timer_heap[last];
+	m_timer_heap.resize_keep(last);
+	if (index != last)
+	{
+		m_timer_heap[index] = lasttimer;
+		lasttimer->m_heap_index = index;
+		timer_heap_sift_up(index);
+		timer_heap_sift_down(lasttimer->m_heap_index);
+	}
+	timer.m_heap_index = -1;
 	return timer;
 }
 
 
+//-------------------------------------------------
+//  timer_heap_update - reposition a timer in the
+//  heap after its expiration or enable state
+//  changed
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_update(emu_timer &timer)
+{
+	// parallel devices queue their timer changes until the group is done
+	if (m_parallel_active)
+	{
+		assert(s_parallel_device != NULL);
+		s_parallel_device->m_parallel_timers.append(&timer);
+		return;
+	}
+
+	// a re-armed timer sorts after everyone else with the same expiration
+	timer.m_heap_key = timer.m_enabled ? timer.m_expire : attotime::never;
+	timer.m_sequence = m_timer_sequence++;
+
+	// only one of these will actually move it
+	timer_heap_sift_up(timer.m_heap_index);
+	timer_heap_sift_down(timer.m_heap_index);
+}
+
+
+//-------------------------------------------------
+//  timer_heap_sift_up - move the entry at the
+//  given index toward the root until it is no
+//  earlier than its parent
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_sift_up(int index)
+{
+	emu_timer *timer = m_timer_heap[index];
+	while (index > 0)
+	{
+		int parent = (index - 1) / TIMER_HEAP_ARITY;
+		emu_timer *parenttimer = m_timer_heap[parent];
+		if (!timer->heap_before(*parenttimer))
+			break;
+		m_timer_heap[index] = parenttimer;
+		parenttimer->m_heap_index = index;
+		index = parent;
+	}
+	m_timer_heap[index] = timer;
+	timer->m_heap_index = index;
+}
+
+
+//-------------------------------------------------
+//  timer_heap_sift_down - move the entry at the
+//  given index toward the leaves until it is no
+//  later than any of its children
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_sift_down(int index)
+{
+	int count = m_timer_heap.count();
+	emu_timer *timer = m_timer_heap[index];
+	for (;;)
+	{
+		// find the earliest child
+		int first = index * TIMER_HEAP_ARITY + 1;
+		if (first >= count)
+			break;
+		int last = MIN(first + TIMER_HEAP_ARITY, count);
+		int best = first;
+		for (int child = first + 1; child < last; child++)
+			if (m_timer_heap[child]->heap_before(*m_timer_heap[best]))
+				best = child;
+
+		// stop if we're already no later than it
+		emu_timer *besttimer = m_timer_heap[best];
+		if (!besttimer->heap_before(*timer))
+			break;
+		m_timer_heap[index] = besttimer;
+		besttimer->m_heap_index = index;
+		index = best;
+	}
+	m_timer_heap[index] = timer;
+	timer->m_heap_index = index;
+}
+
+
+//-------------------------------------------------
+//  timer_heap_rebuild - recompute all heap keys
+//  and rebuild the heap from scratch
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_rebuild()
+{
+	// renumber in list order so ties resolve the same way on every load
+	m_timer_heap.resize(0);
+	m_timer_sequence = 0;
+	for (emu_timer *timer = m_timer_list; timer != NULL; timer = timer->next())
+	{
+		timer->m_heap_key = timer->m_enabled ? timer->m_expire : attotime::never;
+		timer->m_sequence = m_timer_sequence++;
+		timer->m_heap_index = m_timer_heap.count();
+		m_timer_heap.append(timer);
+	}
+
+	// heapify from the last parent back to the root
+	for (int index = (m_timer_heap.count() - 2) / TIMER_HEAP_ARITY; index >= 0; index--)
+		timer_heap_sift_down(index);
+}
+
+
 //-------------------------------------------------
 //  execute_timers - execute timers that are due
 //-------------------------------------------------
 
 inline void device_scheduler::execute_timers()
 {
-	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), m_timer_list->m_expire.as_string(PRECISION)));
+	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), timer_heap_top().m_expire.as_string(PRECISION)));
 
 	// now process any timers that are overdue
-	while (m_timer_list->m_expire <= m_basetime)
+	while (timer_heap_top().m_heap_key <= m_basetime)
 	{
 		// if this is a one-shot timer, disable it now
-		emu_timer &timer = *m_timer_list;
+		emu_timer &timer = timer_heap_top();
 		bool was_enabled = timer.m_enabled;
 		if (timer.m_period.is_zero() || timer.m_period.is_never())
 			timer.m_enabled = false;
@@ -895,6 +1222,7 @@ inline void device_scheduler::execute_timers()
 		if (was_enabled)
 		{
 			g_profiler.start(PROFILER_TIMER_CALLBACK);
+			g_profiler.set_name((timer.m_device != NULL) ? timer.m_device->tag() : timer.m_callback.name());
 
 			if (timer.m_device != NULL)
 			{
@@ -972,15 +1300,33 @@ void device_scheduler::add_scheduling_quantum(const attotime &quantum, const att
 }
 
 
+//-------------------------------------------------
+//  compare_timers - qsort callback for ordering
+//  timers by when they will fire
+//-------------------------------------------------
+
+int CLIB_DECL device_scheduler::compare_timers(const void *item1, const void *item2)
+{
+	const emu_timer *timer1 = *(const emu_timer * const *)item1;
+	const emu_timer *timer2 = *(const emu_timer * const *)item2;
+	return timer1->heap_before(*timer2) ? -1 : timer2->heap_before(*timer1) ? 1 : 0;
+}
+
+
 //-------------------------------------------------
 //  dump_timers - dump the current timer state
 //-------------------------------------------------
 
 void device_scheduler::dump_timers() const
 {
+	// sort a copy of the heap so the dump lists timers in firing order
+	dynamic_array<emu_timer *> sorted;
+	sorted.copyfrom(m_timer_heap);
+	qsort(&sorted[0], sorted.count(), sizeof(sorted[0]), compare_timers);
+
 	logerror("=============================================\n");
 	logerror("Timer Dump: Time = %15s\n", time().as_string(PRECISION));
-	for (emu_timer *timer = first_timer(); timer != NULL; timer = timer->next())
-		timer->dump();
+	for (int index = 0; index < sorted.count(); index++)
+		sorted[index]->dump();
 	logerror("=============================================\n");
 }
@@ -93,11 +93,15 @@ private:
 	void register_save();
 	void schedule_next_period();
 	void dump() const;
+	bool heap_before(const emu_timer &other) const { return (m_heap_key < other.m_heap_key) || (m_heap_key == other.m_heap_key && m_sequence < other.m_sequence); }
 
 	// internal state
 	running_machine *   m_machine;      // reference to the owning machine
-	emu_timer *         m_next;         // next timer in order in the list
-	emu_timer *         m_prev;         // previous timer in order in the list
+	emu_timer *         m_next;         // next timer in the list of all timers
+	emu_timer *         m_prev;         // previous timer in the list of all timers
+	int                 m_heap_index;   // index within the scheduler's timer heap
+	UINT64              m_sequence;     // insertion sequence number, for ordering equal expirations
+	attotime            m_heap_key;     // expiration time used for ordering within the heap
 	timer_expired_delegate m_callback;  // callback function
 	INT32               m_param;        // integer parameter
 	void *              m_ptr;          // pointer parameter
@@ -127,7 +131,7 @@ public:
 	running_machine &machine() const { return m_machine; }
 	attotime time() const;
 	emu_timer *first_timer() const { return m_timer_list; }
-	device_execute_interface *currently_executing() const { return m_executing_device; }
+	device_execute_interface *currently_executing() const { return m_parallel_active ? s_parallel_device : m_executing_device; }
 	bool can_save() const;
 
 	// execution
@@ -136,6 +140,7 @@ public:
 	void trigger(int trigid, const attotime &after = attotime::zero);
 	void boost_interleave(const attotime &timeslice_time, const attotime &boost_duration);
 	void suspend_resume_changed() { m_suspend_changes_pending = true; }
+	void validate_parallel_access(device_execute_interface &target, const char *what);
 
 	// timers, specified by callback/name
 	emu_timer *timer_alloc(timer_expired_delegate callback, void *ptr = NULL);
@@ -170,10 +175,20 @@ private:
 	void rebuild_execute_list();
 	void apply_suspend_changes();
 	void add_scheduling_quantum(const attotime &quantum, const attotime &duration);
+	device_execute_interface *execute_parallel(device_execute_interface *first, attotime &target);
+	static void *parallel_execute_callback(void *param, int threadid);
+	void apply_deferred_timers(device_execute_interface &exec);
 
 	// timer helpers
+	emu_timer *timer_alloc_item();
 	emu_timer &timer_list_insert(emu_timer &timer);
 	emu_timer &timer_list_remove(emu_timer &timer);
+	emu_timer &timer_heap_top() const { return *m_timer_heap[0]; }
+	void timer_heap_update(emu_timer &timer);
+	void timer_heap_sift_up(int index);
+	void timer_heap_sift_down(int index);
+	void timer_heap_rebuild();
+	static int CLIB_DECL compare_timers(const void *item1, const void *item2);
 	void execute_timers();
 
 	// internal state
@@ -183,7 +198,9 @@ private:
 	attotime                    m_basetime;                 // global basetime; everything moves forward from here
 
 	// list of active timers
-	emu_timer *                 m_timer_list;               // head of the active list
+	emu_timer *                 m_timer_list;               // head of the list of all timers
+	dynamic_array<emu_timer *>  m_timer_heap;               // d-ary min-heap of timers, ordered by expiration
+	UINT64                      m_timer_sequence;           // next timer insertion sequence number
 	fixed_allocator<emu_timer>  m_timer_allocator;          // allocator for timers
 
 	// other internal states
@@ -192,6 +209,15 @@ private:
 	attotime                    m_callback_timer_expire_time; // the original expiration time
 	bool                        m_suspend_changes_pending;  // suspend/resume changes are pending
 
+	// parallel execution
+	osd_work_queue *            m_parallel_queue;           // work queue for parallel devices, or NULL if disabled
+	osd_lock *                  m_parallel_lock;            // guards the timer allocator while parallel devices run
+	bool                        m_parallel_active;          // true while parallel devices are running
+	bool                        m_parallel_validate;        // run parallel devices serially and report conflicts
+	dynamic_array<device_execute_interface *> m_parallel_group; // devices in the current parallel group
+	dynamic_array<device_execute_interface *> m_parallel_batch; // subset of the group that actually runs
+	static ATTR_THREAD_LOCAL device_execute_interface *s_parallel_device; // parallel device running on this thread
+
 	// scheduling quanta
 	class quantum_slot
 	{
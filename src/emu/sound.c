@@ -13,6 +13,7 @@
 #include "osdepend.h"
 #include "config.h"
 #include "sound/wavwrite.h"
+#include "soundsimd.h"
 
 
 
@@ -102,6 +103,10 @@ sound_stream::sound_stream(device_t &device, int inputs, int outputs, int sample
 	else
 		m_sync_timer = NULL;
 
+	// start with the globally configured resampling quality
+	int quality = m_device.machine().options().resample_quality();
+	m_resample_quality = stream_resample_quality(MAX(int(RESAMPLE_LINEAR), MIN(quality, int(RESAMPLE_HIGH))));
+
 	// force an update to the sample rates; this will cause everything to be recomputed
 	// and will generate the initial resample buffers for our inputs
 	recompute_sample_rate_data();
@@ -249,6 +254,9 @@ void sound_stream::set_input(int index, sound_stream *input_stream, int output_i
 	if (input.m_source != NULL)
 		input.m_source->m_dependents++;
 
+	// the dependency graph has changed
+	m_device.machine().sound().m_parallel_dirty = true;
+
 	// update sample rates now that we know the input
 	recompute_sample_rate_data();
 }
@@ -370,6 +378,19 @@ void sound_stream::set_output_gain(int outputnum, float gain)
 }
 
 
+//-------------------------------------------------
+//  set_resample_quality - choose how samples
+//  from our inputs are converted to our rate
+//-------------------------------------------------
+
+void sound_stream::set_resample_quality(stream_resample_quality quality)
+{
+	update();
+	m_resample_quality = quality;
+	recompute_sample_rate_data();
+}
+
+
 //-------------------------------------------------
 //  update_with_accounting - do a regular update,
 //  but also do periodic accounting
@@ -502,6 +523,18 @@ void sound_stream::recompute_sample_rate_data()
 			else if (input.m_source->m_stream->m_sample_rate == m_sample_rate)
 				latency = 0;
 
+			// a band-limited filter also needs half its taps' worth of samples ahead of
+			// the base sample; limit it to a quarter of what the source keeps per update
+			if (m_resample_quality != RESAMPLE_LINEAR && input.m_source->m_stream->m_sample_rate != m_sample_rate)
+			{
+				int taps = resample_filter::desired_taps(input.m_source->m_stream->m_sample_rate, m_sample_rate, m_resample_quality);
+				taps = MIN(taps, 2 * (input.m_source->m_stream->m_max_samples_per_update / 4)) & ~3;
+				latency += (taps / 2) * new_attosecs_per_sample;
+			}
+
+			// the filter is looked up again the next time we generate data
+			input.m_filter = NULL;
+
 			// we generally don't want to tweak the latency, so we just keep the greatest
 			// one we've computed thus far
 			input.m_latency_attoseconds = MAX(input.m_latency_attoseconds, latency);
@@ -667,8 +700,45 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, UINT
 	// compute the stepping fraction
 	UINT32 step = (UINT64(input_stream.m_sample_rate) << FRAC_BITS) / m_sample_rate;
 
+	// find the band-limited filter to use, if one was requested
+	const resample_filter *filter = NULL;
+	if (m_resample_quality != RESAMPLE_LINEAR && step != FRAC_ONE)
+	{
+		// the source rate may have changed since we last looked
+		if (input.m_filter == NULL || !input.m_filter->matches(input_stream.m_sample_rate, m_sample_rate, m_resample_quality))
+		{
+			// our latency bounds how far past the base sample the filter can reach
+			attoseconds_t spare = input.m_latency_attoseconds - MAX(input_stream.m_attoseconds_per_sample, m_attoseconds_per_sample);
+			int maxtaps = (spare > 0) ? 2 * (spare / input_stream.m_attoseconds_per_sample) : 0;
+			input.m_filter = m_device.machine().sound().find_resample_filter(input_stream.m_sample_rate, m_sample_rate, m_resample_quality, maxtaps);
+		}
+
+		// fall back to the linear paths if the history doesn't reach back far enough
+		filter = input.m_filter;
+		if (filter != NULL && basesample - (filter->taps() / 2 - 1) < input_stream.m_output_base_sampindex)
+			filter = NULL;
+	}
+
+	// band-limited: convolve with the filter for each fractional position
+	if (filter != NULL)
+	{
+		int taps = filter->taps();
+		source -= taps / 2 - 1;
+		while (numsamples--)
+		{
+			// compute the sample
+			INT64 sample = sound_convolve(source, filter->phase(basefrac >> (FRAC_BITS - resample_filter::PHASE_BITS)), taps);
+			*dest++ = (sample * gain) >> 8;
+
+			// advance
+			basefrac += step;
+			source += basefrac >> FRAC_BITS;
+			basefrac &= FRAC_MASK;
+		}
+	}
+
 	// if we have equal sample rates, we just need to copy
-	if (step == FRAC_ONE)
+	else if (step == FRAC_ONE)
 	{
 		while (numsamples--)
 		{
@@ -756,6 +826,7 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, UINT
 sound_stream::stream_input::stream_input()
 	: m_source(NULL),
 		m_latency_attoseconds(0),
+		m_filter(NULL),
 		m_gain(0x100),
 		m_user_gain(0x100)
 {
@@ -763,6 +834,75 @@ sound_stream::stream_input::stream_input()
 
 
 
+//**************************************************************************
+//  RESAMPLE FILTER
+//**************************************************************************
+
+//-------------------------------------------------
+//  resample_filter - constructor; builds one
+//  Blackman-windowed sinc for each phase
+//-------------------------------------------------
+
+resample_filter::resample_filter(UINT32 input_rate, UINT32 output_rate, stream_resample_quality quality, int taps)
+	: m_next(NULL),
+		m_input_rate(input_rate),
+		m_output_rate(output_rate),
+		m_quality(quality),
+		m_taps(taps),
+		m_coeffs(taps << PHASE_BITS)
+{
+	// cut off a little below the lower of the two Nyquist frequencies, relative to the input rate
+	double cutoff = 0.90 * MIN(1.0, double(output_rate) / double(input_rate));
+	int half = taps / 2;
+
+	for (int phasenum = 0; phasenum < (1 << PHASE_BITS); phasenum++)
+	{
+		double frac = double(phasenum) / double(1 << PHASE_BITS);
+		float *coeffs = &m_coeffs[phasenum * taps];
+		double sum = 0;
+
+		for (int tapnum = 0; tapnum < taps; tapnum++)
+		{
+			// distance in input samples from the point being sampled
+			double t = double(tapnum - (half - 1)) - frac;
+			double x = M_PI * cutoff * t;
+			double sinc = (x == 0) ? cutoff : cutoff * sin(x) / x;
+
+			// window spans the full width of the filter
+			double pos = (t + half) / double(taps);
+			double window = 0.42 - 0.5 * cos(2 * M_PI * pos) + 0.08 * cos(4 * M_PI * pos);
+
+			coeffs[tapnum] = sinc * window;
+			sum += sinc * window;
+		}
+
+		// normalize so that DC passes at unity gain
+		for (int tapnum = 0; tapnum < taps; tapnum++)
+			coeffs[tapnum] /= sum;
+	}
+}
+
+
+//-------------------------------------------------
+//  desired_taps - return the number of taps we'd
+//  like for a given conversion and quality
+//-------------------------------------------------
+
+int resample_filter::desired_taps(UINT32 input_rate, UINT32 output_rate, stream_resample_quality quality)
+{
+	// zero crossings on each side of the centre, at the output rate
+	UINT64 half = (quality == RESAMPLE_HIGH) ? 16 : 4;
+
+	// when decimating, the filter has to widen to cover the same span of input
+	if (input_rate > output_rate)
+		half = (half * input_rate + output_rate - 1) / output_rate;
+
+	// keep it a multiple of 4 for the convolution kernel
+	return MIN((2 * half + 3) & ~3, UINT64(MAX_TAPS));
+}
+
+
+
 //**************************************************************************
 //  STREAM OUTPUT
 //**************************************************************************
@@ -798,8 +938,11 @@ sound_manager::sound_manager(running_machine &machine)
 		m_attenuation(0),
 		m_nosound_mode(machine.osd().no_sound()),
 		m_wavfile(NULL),
+		m_filter_lock(osd_lock_alloc()),
 		m_update_attoseconds(STREAMS_UPDATE_ATTOTIME.attoseconds),
-		m_last_update(attotime::zero)
+		m_last_update(attotime::zero),
+		m_parallel_queue(NULL),
+		m_parallel_dirty(true)
 {
 	// get filename for WAV file or AVI file if specified
 	const char *wavfile = machine.options().wav_write();
@@ -831,6 +974,10 @@ sound_manager::sound_manager(running_machine &machine)
 	// set the starting attenuation
 	set_attenuation(machine.options().volume());
 
+	// allocate a work queue if independent streams may be generated concurrently
+	if (machine.options().parallel_sound())
+		m_parallel_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
 	// start the periodic update flushing timer
 	m_update_timer = machine.scheduler().timer_alloc(timer_expired_delegate(FUNC(sound_manager::update), this));
 	m_update_timer->adjust(STREAMS_UPDATE_ATTOTIME, 0, STREAMS_UPDATE_ATTOTIME);
@@ -847,6 +994,45 @@ sound_manager::~sound_manager()
 	if (m_wavfile != NULL)
 		wav_close(m_wavfile);
 	m_wavfile = NULL;
+
+	// free the parallel generation queue
+	if (m_parallel_queue != NULL)
+		osd_work_queue_free(m_parallel_queue);
+	m_parallel_queue = NULL;
+
+	// free the filter lock
+	if (m_filter_lock != NULL)
+		osd_lock_free(m_filter_lock);
+	m_filter_lock = NULL;
+}
+
+
+//-------------------------------------------------
+//  find_resample_filter - return a filter for the
+//  given conversion, building it the first time
+//  any stream asks for it
+//-------------------------------------------------
+
+const resample_filter *sound_manager::find_resample_filter(UINT32 input_rate, UINT32 output_rate, stream_resample_quality quality, int maxtaps)
+{
+	// too little latency to fit even the shortest filter
+	int taps = MIN(resample_filter::desired_taps(input_rate, output_rate, quality), maxtaps) & ~3;
+	if (taps < 4)
+		return NULL;
+
+	// streams generated on workers can get here concurrently
+	osd_lock_acquire(m_filter_lock);
+	resample_filter *filter;
+	for (filter = m_filter_list.first(); filter != NULL; filter = filter->next())
+		if (filter->matches(input_rate, output_rate, quality) && filter->taps() == taps)
+			break;
+	if (filter == NULL)
+	{
+		VPRINTF(("resample filter %d -> %d, quality %d, %d taps\n", input_rate, output_rate, quality, taps));
+		filter = &m_filter_list.append(*global_alloc(resample_filter(input_rate, output_rate, quality, taps)));
+	}
+	osd_lock_release(m_filter_lock);
+	return filter;
 }
 
 
@@ -856,6 +1042,7 @@ sound_manager::~sound_manager()
 
 sound_stream *sound_manager::stream_alloc(device_t &device, int inputs, int outputs, int sample_rate, stream_update_delegate callback)
 {
+	m_parallel_dirty = true;
 	return &m_stream_list.append(*global_alloc(sound_stream(device, inputs, outputs, sample_rate, callback)));
 }
 
@@ -1018,6 +1205,12 @@ void sound_manager::update(void *ptr, int param)
 
 	g_profiler.start(PROFILER_SOUND);
 
+	// generate independent streams ahead of time on worker threads; anything left over
+	// is pulled in by the speakers below as before. The profiler isn't thread safe, so
+	// everything is left to the speakers while it's on
+	if (m_parallel_queue != NULL && !g_profiler.enabled())
+		update_streams_parallel();
+
 	// force all the speaker streams to generate the proper number of samples
 	int samples_this_update = 0;
 	speaker_device_iterator iter(machine().root_device());
@@ -1028,28 +1221,40 @@ void sound_manager::update(void *ptr, int param)
 	UINT32 finalmix_step = machine().video().speed_factor();
 	UINT32 finalmix_offset = 0;
 	INT16 *finalmix = m_finalmix;
-	int sample;
-	for (sample = m_finalmix_leftover; sample < samples_this_update * 1000; sample += finalmix_step)
+
+	// at normal speed every sample is used once, so clamp and interleave in bulk
+	if (finalmix_step == 1000 && m_finalmix_leftover < 1000)
+	{
+		sound_mix_clamp_interleave(finalmix, m_leftmix, m_rightmix, samples_this_update);
+		finalmix_offset = samples_this_update * 2;
+	}
+
+	// otherwise, step through at the adjusted rate
+	else
 	{
-		int sampindex = sample / 1000;
-
-		// clamp the left side
-		INT32 samp = m_leftmix[sampindex];
-		if (samp < -32768)
-			samp = -32768;
-		else if (samp > 32767)
-			samp = 32767;
-		finalmix[finalmix_offset++] = samp;
-
-		// clamp the right side
-		samp = m_rightmix[sampindex];
-		if (samp < -32768)
-			samp = -32768;
-		else if (samp > 32767)
-			samp = 32767;
-		finalmix[finalmix_offset++] = samp;
+		int sample;
+		for (sample = m_finalmix_leftover; sample < samples_this_update * 1000; sample += finalmix_step)
+		{
+			int sampindex = sample / 1000;
+
+			// clamp the left side
+			INT32 samp = m_leftmix[sampindex];
+			if (samp < -32768)
+				samp = -32768;
+			else if (samp > 32767)
+				samp = 32767;
+			finalmix[finalmix_offset++] = samp;
+
+			// clamp the right side
+			samp = m_rightmix[sampindex];
+			if (samp < -32768)
+				samp = -32768;
+			else if (samp > 32767)
+				samp = 32767;
+			finalmix[finalmix_offset++] = samp;
+		}
+		m_finalmix_leftover = sample - samples_this_update * 1000;
 	}
-	m_finalmix_leftover = sample - samples_this_update * 1000;
 
 	// play the result
 	if (finalmix_offset > 0)
@@ -1083,3 +1288,148 @@ void sound_manager::update(void *ptr, int param)
 
 	g_profiler.stop();
 }
+
+
+//-------------------------------------------------
+//  update_streams_parallel - bring all streams
+//  that don't depend on each other up to date
+//  concurrently, one dependency level at a time
+//-------------------------------------------------
+
+void sound_manager::update_streams_parallel()
+{
+	// rebuild the plan if the graph has changed
+	if (m_parallel_dirty)
+		build_parallel_plan();
+
+	// each level only reads from streams in earlier levels, which are already up to date
+	for (int levelnum = 0; levelnum + 1 < m_parallel_levels.count(); levelnum++)
+	{
+		int first = m_parallel_levels[levelnum];
+		int count = m_parallel_levels[levelnum + 1] - first;
+		if (count == 1)
+			parallel_update_callback(&m_parallel_tasks[first], 0);
+		else if (count > 1)
+		{
+			osd_work_item_queue_multiple(m_parallel_queue, parallel_update_callback, count, &m_parallel_tasks[first], sizeof(m_parallel_tasks[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+			osd_work_queue_wait(m_parallel_queue, osd_ticks_per_second() * 100);
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  build_parallel_plan - group streams by device
+//  and sort the groups into levels, so that every
+//  group only depends on groups in earlier levels
+//-------------------------------------------------
+
+void sound_manager::build_parallel_plan()
+{
+	m_parallel_dirty = false;
+	m_parallel_streams.resize(0);
+	m_parallel_tasks.resize(0);
+	m_parallel_levels.resize(0);
+
+	// streams of the same device may share state, so each device becomes one group;
+	// synchronous streams are updated from their own timers and always stay serial
+	dynamic_array<device_t *> devices;
+	dynamic_array<int> groups;
+	dynamic_array<int> levels;
+	dynamic_array<UINT8> serial;
+	for (sound_stream *stream = m_stream_list.first(); stream != NULL; stream = stream->next())
+	{
+		int group;
+		for (group = 0; group < devices.count(); group++)
+			if (devices[group] == &stream->device())
+				break;
+		if (group == devices.count())
+		{
+			devices.append(&stream->device());
+			levels.append(0);
+			serial.append(0);
+		}
+		groups.append(group);
+		if (stream->m_synchronous)
+			serial[group] = 1;
+	}
+
+	// relax the levels until they settle; anything depending on a serial group is serial too
+	bool changed = true;
+	for (int pass = 0; changed && pass <= devices.count(); pass++)
+	{
+		changed = false;
+		int streamnum = 0;
+		for (sound_stream *stream = m_stream_list.first(); stream != NULL; stream = stream->next(), streamnum++)
+			for (int inputnum = 0; inputnum < stream->m_input.count(); inputnum++)
+			{
+				sound_stream::stream_output *source = stream->m_input[inputnum].m_source;
+				if (source == NULL)
+					continue;
+
+				// find the group of the source stream
+				int group = groups[streamnum];
+				int srcgroup = 0;
+				for (sound_stream *srcstream = m_stream_list.first(); srcstream != source->m_stream; srcstream = srcstream->next())
+					srcgroup++;
+				srcgroup = groups[srcgroup];
+				if (srcgroup == group)
+					continue;
+
+				if (serial[srcgroup] && !serial[group])
+				{
+					serial[group] = 1;
+					changed = true;
+				}
+				if (levels[group] <= levels[srcgroup])
+				{
+					levels[group] = levels[srcgroup] + 1;
+					changed = true;
+				}
+			}
+	}
+
+	// devices feeding each other in a loop can't be ordered; leave it all to the speakers
+	if (changed)
+	{
+		logerror("Sound streams form a loop between devices; generating them serially\n");
+		return;
+	}
+
+	// emit the parallel groups level by level
+	int maxlevel = 0;
+	for (int group = 0; group < devices.count(); group++)
+		if (!serial[group])
+			maxlevel = MAX(maxlevel, levels[group]);
+	for (int levelnum = 0; levelnum <= maxlevel; levelnum++)
+	{
+		m_parallel_levels.append(m_parallel_tasks.count());
+		for (int group = 0; group < devices.count(); group++)
+			if (!serial[group] && levels[group] == levelnum)
+			{
+				parallel_task &task = m_parallel_tasks.append();
+				task.m_manager = this;
+				task.m_first = m_parallel_streams.count();
+				int streamnum = 0;
+				for (sound_stream *stream = m_stream_list.first(); stream != NULL; stream = stream->next(), streamnum++)
+					if (groups[streamnum] == group)
+						m_parallel_streams.append(stream);
+				task.m_count = m_parallel_streams.count() - task.m_first;
+			}
+	}
+	m_parallel_levels.append(m_parallel_tasks.count());
+}
+
+
+//-------------------------------------------------
+//  parallel_update_callback - work queue callback
+//  that updates all the streams of one device
+//-------------------------------------------------
+
+void *sound_manager::parallel_update_callback(void *param, int threadid)
+{
+	parallel_task &task = *reinterpret_cast<parallel_task *>(param);
+	for (int index = 0; index < task.m_count; index++)
+		task.m_manager->m_parallel_streams[task.m_first + index]->update();
+	return NULL;
+}
@@ -25,6 +25,14 @@
 const int STREAM_SYNC       = -1;       // special rate value indicating a one-sample-at-a-time stream
                                         // with actual rate defined by its input
 
+// quality of conversion between the sample rates of a stream and its inputs
+enum stream_resample_quality
+{
+	RESAMPLE_LINEAR = 0,                // point sampling, linear blending or averaging; cheapest
+	RESAMPLE_LOW,                       // short band-limited polyphase filter
+	RESAMPLE_HIGH                       // long band-limited polyphase filter
+};
+
 //**************************************************************************
 //  MACROS
 //**************************************************************************
@@ -48,6 +56,44 @@ struct mixer_input
 };
 
 
+// ======================> resample_filter
+
+// bank of band-limited FIR filters for one pair of sample rates, one filter per fractional phase
+class resample_filter
+{
+	friend class simple_list<resample_filter>;
+
+public:
+	// construction/destruction
+	resample_filter(UINT32 input_rate, UINT32 output_rate, stream_resample_quality quality, int taps);
+
+	// getters
+	resample_filter *next() const { return m_next; }
+	int taps() const { return m_taps; }
+	bool matches(UINT32 input_rate, UINT32 output_rate, stream_resample_quality quality) const
+		{ return (m_input_rate == input_rate && m_output_rate == output_rate && m_quality == quality); }
+
+	// coefficients for the given phase; tap 0 applies to the sample (taps / 2 - 1) before the base sample
+	const float *phase(UINT32 phasenum) const { return &m_coeffs[phasenum * m_taps]; }
+
+	// helpers
+	static int desired_taps(UINT32 input_rate, UINT32 output_rate, stream_resample_quality quality);
+
+	// constants
+	static const int PHASE_BITS = 8;
+	static const int MAX_TAPS = 512;
+
+private:
+	// internal state
+	resample_filter *   m_next;                 // next filter in the list
+	UINT32              m_input_rate;           // sample rate of the input
+	UINT32              m_output_rate;          // sample rate of the output
+	stream_resample_quality m_quality;          // quality level
+	int                 m_taps;                 // taps per phase, always a multiple of 4
+	dynamic_array<float> m_coeffs;              // coefficients for each phase, normalized to unity gain
+};
+
+
 // ======================> sound_stream
 
 class sound_stream
@@ -84,6 +130,7 @@ class sound_stream
 		stream_output *     m_source;               // pointer to the sound_output for this source
 		dynamic_array<stream_sample_t> m_resample;  // buffer for resampling to the stream's sample rate
 		attoseconds_t       m_latency_attoseconds;  // latency between this stream and the input stream
+		const resample_filter *m_filter;            // band-limited filter, or NULL if not chosen yet
 		INT16               m_gain;                 // gain to apply to this input
 		INT16               m_user_gain;            // user-controlled gain to apply to this input
 	};
@@ -112,6 +159,7 @@ public:
 	float user_gain(int inputnum) const;
 	float input_gain(int inputnum) const;
 	float output_gain(int outputnum) const;
+	stream_resample_quality resample_quality() const { return m_resample_quality; }
 
 	// operations
 	void set_input(int inputnum, sound_stream *input_stream, int outputnum = 0, float gain = 1.0f);
@@ -123,6 +171,7 @@ public:
 	void set_user_gain(int inputnum, float gain);
 	void set_input_gain(int inputnum, float gain);
 	void set_output_gain(int outputnum, float gain);
+	void set_resample_quality(stream_resample_quality quality);
 
 private:
 	// helpers called by our friends only
@@ -146,6 +195,7 @@ private:
 	UINT32              m_sample_rate;                // sample rate of this stream
 	UINT32              m_new_sample_rate;            // newly-set sample rate for the stream
 	bool                m_synchronous;                // synchronous stream that runs at the rate of its input
+	stream_resample_quality m_resample_quality;       // how to convert the rates of our inputs
 
 	// timing information
 	attoseconds_t       m_attoseconds_per_sample;     // number of attoseconds per sample
@@ -226,6 +276,18 @@ private:
 	void config_save(int config_type, xml_data_node *parentnode);
 
 	void update(void *ptr = NULL, INT32 param = 0);
+	void update_streams_parallel();
+	void build_parallel_plan();
+	static void *parallel_update_callback(void *param, int threadid);
+	const resample_filter *find_resample_filter(UINT32 input_rate, UINT32 output_rate, stream_resample_quality quality, int maxtaps);
+
+	// all the streams of one device, updated in order on a single worker
+	struct parallel_task
+	{
+		sound_manager *     m_manager;              // owning manager
+		int                 m_first;                // index of the first stream in m_parallel_streams
+		int                 m_count;                // number of streams
+	};
 
 	// internal state
 	running_machine &   m_machine;              // reference to our machine
@@ -244,8 +306,17 @@ private:
 
 	// streams data
 	simple_list<sound_stream> m_stream_list;    // list of streams
+	simple_list<resample_filter> m_filter_list; // filters shared by all streams with the same rates
+	osd_lock *          m_filter_lock;          // lock for the filter list, which workers may extend
 	attoseconds_t       m_update_attoseconds;   // attoseconds between global updates
 	attotime            m_last_update;          // last update time
+
+	// parallel stream generation
+	osd_work_queue *    m_parallel_queue;       // work queue for independent streams, or NULL if disabled
+	bool                m_parallel_dirty;       // true if streams were added or rewired since the plan was built
+	dynamic_array<sound_stream *> m_parallel_streams; // streams that can run on workers, grouped by device
+	dynamic_array<parallel_task> m_parallel_tasks; // one task per device, ordered by dependency level
+	dynamic_array<int>  m_parallel_levels;      // index of the first task of each level, plus one past the end
 };
 
 
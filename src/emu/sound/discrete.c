@@ -105,13 +105,6 @@ public:
 	virtual ~discrete_task(void) { }
 
 	inline void step_nodes(void);
-	inline bool lock_threadid(INT32 threadid)
-	{
-		INT32 prev_id;
-		prev_id = compare_exchange32(&m_threadid, -1, threadid);
-		return (prev_id == -1 && m_threadid == threadid);
-	}
-	inline void unlock(void) { m_threadid = -1; }
 
 	//const linked_list_entry *list;
 	node_step_list_t        step_list;
@@ -124,28 +117,103 @@ public:
 
 protected:
 	discrete_task(discrete_device &pdev)
-	: task_group(0), m_device(pdev), m_threadid(-1)
+	: task_group(0), m_device(pdev), m_producers(0), m_slice(0), m_samples(0)
 	{
 		source_list.clear();
 		step_list.clear();
 		m_buffers.clear();
+		m_consumers.clear();
+		m_pending.clear();
 	}
 
-	static void *task_callback(void *param, int threadid);
-	inline bool process(void);
+	inline void process(void);
 
 	void check(discrete_task *dest_task);
-	void prepare_for_queue(int samples);
+	void prepare_for_queue(int samples, int slices);
 
 	dynamic_array_t<output_buffer>      m_buffers;
 	discrete_device &                   m_device;
 
+	/* tasks reading our buffers and the number of tasks we read from */
+	dynamic_array_t<discrete_task *>    m_consumers;
+	int                                 m_producers;
+
+	/* unmet dependencies of each slice: producers still working on it,
+	 * plus our own previous slice */
+	dynamic_array_t<INT32>              m_pending;
+
 private:
-	volatile INT32          m_threadid;
-	volatile int            m_samples;
+	int                     m_slice;
+	int                     m_samples;
 
 };
 
+/*
+ * Ready task slices are kept in one deque per worker. A worker runs its own
+ * work newest first and steals the oldest work of other workers when it
+ * runs dry. The critical sections are a handful of instructions, so a
+ * simple compare_exchange32 lock does.
+ */
+
+class discrete_task_deque
+{
+public:
+	void init(discrete_device &device, int size)
+	{
+		m_device = &device;
+		m_tasks = auto_alloc_array_clear(device.machine(), discrete_task *, size);
+		m_size = size;
+		reset();
+	}
+
+	void reset(void) { m_lock = 0; m_active = 0; m_head = m_tail = 0; }
+
+	/* owner side */
+	inline int push(discrete_task *task)
+	{
+		acquire();
+		m_tasks[m_tail++ % m_size] = task;
+		int count = m_tail - m_head;
+		release();
+		return count;
+	}
+	inline discrete_task *pop(void)
+	{
+		discrete_task *task = NULL;
+		acquire();
+		if (m_tail != m_head)
+			task = m_tasks[--m_tail % m_size];
+		release();
+		return task;
+	}
+
+	/* thief side */
+	inline discrete_task *steal(void)
+	{
+		discrete_task *task = NULL;
+		if (m_tail == m_head)
+			return NULL;
+		acquire();
+		if (m_tail != m_head)
+			task = m_tasks[m_head++ % m_size];
+		release();
+		return task;
+	}
+
+	discrete_device *       m_device;
+	volatile INT32          m_active;       /* a work item is running on this deque */
+
+private:
+	inline void acquire(void) { while (compare_exchange32(&m_lock, 0, 1) != 0) { } }
+	inline void release(void) { atomic_exchange32(&m_lock, 0); }
+
+	volatile INT32          m_lock;
+	discrete_task **        m_tasks;
+	int                     m_size;
+	volatile int            m_head;
+	volatile int            m_tail;
+};
+
 
 /*************************************
  *
@@ -209,60 +277,36 @@ inline void discrete_task::step_nodes(void)
 		*(outbuf->ptr++) = *outbuf->source;
 }
 
-void *discrete_task::task_callback(void *param, int threadid)
-{
-	task_list_t *list = (task_list_t *) param;
-	do
-	{
-		for_each(discrete_task **, task, list)
-		{
-			/* try to lock */
-			if ((*task)->lock_threadid(threadid))
-			{
-				if (!(*task)->process())
-					return NULL;
-				(*task)->unlock();
-			}
-		}
-	} while (1);
-
-	return NULL;
-}
-
-bool discrete_task::process(void)
+inline void discrete_task::process(void)
 {
 	int samples = MIN(m_samples, MAX_SAMPLES_PER_TASK_SLICE);
 
-	/* check dependencies */
+	/* our producers have finished this slice */
 	for_each(input_buffer *, sn, &source_list)
 	{
 		int avail;
 
 		avail = sn->linked_outbuf->ptr - sn->ptr;
-		assert_always(avail >= 0, "task_callback: available samples are negative");
-		if (avail < samples)
-			samples = avail;
+		assert_always(avail >= samples, "discrete_task: source slice is not complete");
 	}
 
 	m_samples -= samples;
-	assert_always(m_samples >=0, "task_callback: task_samples got negative");
 	while (samples > 0)
 	{
 		/* step */
 		step_nodes();
 		samples--;
 	}
-	if (m_samples == 0)
-	{
-		/* return and keep the task locked so it is not picked up by other worker threads */
-		return false;
-	}
-	return true;
 }
 
-void discrete_task::prepare_for_queue(int samples)
+void discrete_task::prepare_for_queue(int samples, int slices)
 {
 	m_samples = samples;
+	m_slice = 0;
+	m_pending.clear();
+	for (int slice = 0; slice < slices; slice++)
+		m_pending.add(m_producers + (slice > 0 ? 1 : 0));
+
 	/* set up task buffers */
 	for_each(output_buffer *, ob, &m_buffers)
 		ob->ptr = ob->node_buf;
@@ -335,6 +379,17 @@ void discrete_task::check(discrete_task *dest_task)
 						source.ptr = NULL;
 						dest_task->source_list.add(source);
 
+						/* record the dependency once per pair of tasks */
+						bool known = false;
+						for_each(discrete_task **, consumer, &m_consumers)
+							if (*consumer == dest_task)
+								known = true;
+						if (!known)
+						{
+							m_consumers.add(dest_task);
+							dest_task->m_producers++;
+						}
+
 						/* point the input to a buffered location */
 						dest_node->m_input[inputnum] = &dest_task->source_list[dest_task->source_list.count()-1].buffer; // was copied!   &source.buffer;
 
@@ -834,6 +889,9 @@ discrete_device::discrete_device(const machine_config &mconfig, device_type type
 		m_indexed_node(NULL),
 		m_disclogfile(NULL),
 		m_queue(NULL),
+		m_task_deques(NULL),
+		m_task_workers(0),
+		m_task_slices(0),
 		m_profiling(0),
 		m_total_samples(0),
 		m_total_stream_updates(0)
@@ -923,6 +981,12 @@ void discrete_device::device_start()
 				(*dest_task)->check((*task));
 		}
 	}
+
+	/* one worker per task, each with room for every task */
+	m_task_workers = task_list.count();
+	m_task_deques = auto_alloc_array_clear(machine(), discrete_task_deque, m_task_workers);
+	for (int i = 0; i < m_task_workers; i++)
+		m_task_deques[i].init(*this, task_list.count());
 }
 
 void discrete_device::device_stop()
@@ -1034,19 +1098,23 @@ void discrete_device::process(int samples)
 		return;
 
 	/* Setup tasks */
+	m_task_slices = (samples + MAX_SAMPLES_PER_TASK_SLICE - 1) / MAX_SAMPLES_PER_TASK_SLICE;
 	for_each(discrete_task **, task, &task_list)
-	{
-		/* unlock the thread */
-		(*task)->unlock();
-
-		(*task)->prepare_for_queue(samples);
-	}
+		(*task)->prepare_for_queue(samples, m_task_slices);
 
+	/* deal the tasks without producers out to the workers */
+	for (int i = 0; i < m_task_workers; i++)
+		m_task_deques[i].reset();
+	int workers = 0;
 	for_each(discrete_task **, task, &task_list)
-	{
-		/* Fire a work item for each task */
-		osd_work_item_queue(m_queue, discrete_task::task_callback, (void *) &task_list, WORK_ITEM_FLAG_AUTO_RELEASE);
-	}
+		if ((*task)->m_producers == 0)
+		{
+			m_task_deques[workers].m_active = 1;
+			m_task_deques[workers++].push(*task);
+		}
+
+	/* the others start parked and are queued by task_ready when there is work to spare */
+	osd_work_item_queue_multiple(m_queue, discrete_device::task_worker, workers, m_task_deques, sizeof(m_task_deques[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
 	osd_work_queue_wait(m_queue, osd_ticks_per_second()*10);
 
 	if (m_profiling)
@@ -1056,6 +1124,72 @@ void discrete_device::process(int samples)
 	}
 }
 
+//-------------------------------------------------
+//  task_worker - run ready task slices until
+//  none are left to run or steal
+//-------------------------------------------------
+
+void *discrete_device::task_worker(void *param, int threadid)
+{
+	discrete_task_deque &deque = *(discrete_task_deque *) param;
+	discrete_device &device = *deque.m_device;
+	int self = &deque - device.m_task_deques;
+
+	while (1)
+	{
+		discrete_task *task = deque.pop();
+
+		/* steal, starting with our neighbour */
+		for (int i = 1; task == NULL && i < device.m_task_workers; i++)
+			task = device.m_task_deques[(self + i) % device.m_task_workers].steal();
+
+		/* nothing runnable: whatever is left depends on work in progress
+		 * elsewhere, and whoever finishes it will run it or queue us again */
+		if (task == NULL)
+			break;
+
+		task->process();
+		device.task_done(task, deque);
+	}
+	atomic_exchange32(&deque.m_active, 0);
+	return NULL;
+}
+
+//-------------------------------------------------
+//  task_done - release the slices waiting on
+//  the slice a task just finished
+//-------------------------------------------------
+
+void discrete_device::task_done(discrete_task *task, discrete_task_deque &deque)
+{
+	int slice = task->m_slice++;
+
+	for_each(discrete_task **, dest, &task->m_consumers)
+		if (atomic_decrement32(&(*dest)->m_pending[slice]) == 0)
+			task_ready(*dest, deque);
+
+	if (task->m_slice < m_task_slices && atomic_decrement32(&task->m_pending[task->m_slice]) == 0)
+		task_ready(task, deque);
+}
+
+//-------------------------------------------------
+//  task_ready - queue a runnable task slice and
+//  wake a parked worker if there is work to spare
+//-------------------------------------------------
+
+void discrete_device::task_ready(discrete_task *task, discrete_task_deque &deque)
+{
+	if (deque.push(task) < 2)
+		return;
+
+	for (int i = 0; i < m_task_workers; i++)
+		if (m_task_deques[i].m_active == 0 && compare_exchange32(&m_task_deques[i].m_active, 0, 1) == 0)
+		{
+			osd_work_item_queue(m_queue, discrete_device::task_worker, &m_task_deques[i], WORK_ITEM_FLAG_AUTO_RELEASE);
+			break;
+		}
+}
+
 //-------------------------------------------------
 //  sound_stream_update - handle update requests for
 //  our sound stream
@@ -4181,6 +4181,7 @@ enum discrete_node_type
 struct discrete_block;
 class discrete_node_base_factory;
 class discrete_task;
+class discrete_task_deque;
 class discrete_base_node;
 class discrete_dss_input_stream_node;
 class discrete_device;
@@ -4345,6 +4346,11 @@ private:
 	void display_profiling(void);
 	void init_nodes(const sound_block_list_t &block_list);
 
+	/* task scheduling */
+	static void *task_worker(void *param, int threadid);
+	void task_ready(discrete_task *task, discrete_task_deque &deque);
+	void task_done(discrete_task *task, discrete_task_deque &deque);
+
 	/* internal node tracking */
 	discrete_base_node **   m_indexed_node;
 
@@ -4356,6 +4362,9 @@ private:
 
 	/* parallel tasks */
 	osd_work_queue *        m_queue;
+	discrete_task_deque *   m_task_deques;  /* one per worker */
+	int                     m_task_workers;
+	int                     m_task_slices;  /* slices per task in the current update */
 
 	/* profiling */
 	int                     m_profiling;
@@ -0,0 +1,147 @@
+/***************************************************************************
+
+    soundsimd.h
+
+    Mixing kernels shared by the sound manager, speakers and mixer
+    devices. Each kernel handles a single run of samples and is
+    optimized with SIMD where it can be assumed to be available.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __SOUNDSIMD_H__
+#define __SOUNDSIMD_H__
+
+#include <math.h>
+
+/* use SSE2 on 64-bit implementations, where it can be assumed */
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#define SOUNDSIMD_SSE2  1
+#include <emmintrin.h>
+#else
+#define SOUNDSIMD_SSE2  0
+#endif
+
+
+/***************************************************************************
+    ACCUMULATION KERNELS
+***************************************************************************/
+
+/*-------------------------------------------------
+    sound_mix_add - accumulate a run of samples
+    into a mix buffer
+-------------------------------------------------*/
+
+inline void sound_mix_add(INT32 *dest, const INT32 *source, int count)
+{
+	int i = 0;
+#if SOUNDSIMD_SSE2
+	for ( ; i + 8 <= count; i += 8)
+	{
+		__m128i d0 = _mm_loadu_si128((const __m128i *)&dest[i]);
+		__m128i d1 = _mm_loadu_si128((const __m128i *)&dest[i + 4]);
+		__m128i s0 = _mm_loadu_si128((const __m128i *)&source[i]);
+		__m128i s1 = _mm_loadu_si128((const __m128i *)&source[i + 4]);
+		_mm_storeu_si128((__m128i *)&dest[i], _mm_add_epi32(d0, s0));
+		_mm_storeu_si128((__m128i *)&dest[i + 4], _mm_add_epi32(d1, s1));
+	}
+#endif
+	for ( ; i < count; i++)
+		dest[i] += source[i];
+}
+
+
+/*-------------------------------------------------
+    sound_mix_add_stereo - accumulate a run of
+    samples into both halves of a stereo mix
+-------------------------------------------------*/
+
+inline void sound_mix_add_stereo(INT32 *left, INT32 *right, const INT32 *source, int count)
+{
+	int i = 0;
+#if SOUNDSIMD_SSE2
+	for ( ; i + 4 <= count; i += 4)
+	{
+		__m128i s = _mm_loadu_si128((const __m128i *)&source[i]);
+		_mm_storeu_si128((__m128i *)&left[i], _mm_add_epi32(_mm_loadu_si128((const __m128i *)&left[i]), s));
+		_mm_storeu_si128((__m128i *)&right[i], _mm_add_epi32(_mm_loadu_si128((const __m128i *)&right[i]), s));
+	}
+#endif
+	for ( ; i < count; i++)
+	{
+		left[i] += source[i];
+		right[i] += source[i];
+	}
+}
+
+
+
+/***************************************************************************
+    OUTPUT KERNELS
+***************************************************************************/
+
+/*-------------------------------------------------
+    sound_mix_clamp_interleave - clamp a run of
+    left and right samples to 16 bits and
+    interleave them into a stereo buffer
+-------------------------------------------------*/
+
+inline void sound_mix_clamp_interleave(INT16 *dest, const INT32 *left, const INT32 *right, int count)
+{
+	int i = 0;
+#if SOUNDSIMD_SSE2
+	for ( ; i + 8 <= count; i += 8)
+	{
+		// saturating packs do the clamping
+		__m128i l = _mm_packs_epi32(_mm_loadu_si128((const __m128i *)&left[i]), _mm_loadu_si128((const __m128i *)&left[i + 4]));
+		__m128i r = _mm_packs_epi32(_mm_loadu_si128((const __m128i *)&right[i]), _mm_loadu_si128((const __m128i *)&right[i + 4]));
+		_mm_storeu_si128((__m128i *)&dest[i * 2], _mm_unpacklo_epi16(l, r));
+		_mm_storeu_si128((__m128i *)&dest[i * 2 + 8], _mm_unpackhi_epi16(l, r));
+	}
+#endif
+	for ( ; i < count; i++)
+	{
+		INT32 samp = left[i];
+		dest[i * 2 + 0] = (samp < -32768) ? -32768 : (samp > 32767) ? 32767 : samp;
+		samp = right[i];
+		dest[i * 2 + 1] = (samp < -32768) ? -32768 : (samp > 32767) ? 32767 : samp;
+	}
+}
+
+
+
+/***************************************************************************
+    FILTER KERNELS
+***************************************************************************/
+
+/*-------------------------------------------------
+    sound_convolve - apply a set of filter taps
+    to a run of samples, returning the rounded
+    result
+-------------------------------------------------*/
+
+inline INT32 sound_convolve(const INT32 *source, const float *coeffs, int taps)
+{
+	float sum = 0.0f;
+	int i = 0;
+#if SOUNDSIMD_SSE2
+	__m128 acc = _mm_setzero_ps();
+	for ( ; i + 4 <= taps; i += 4)
+		acc = _mm_add_ps(acc, _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)&source[i])), _mm_loadu_ps(&coeffs[i])));
+
+	// fold the four partial sums together
+	acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+	acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+	sum = _mm_cvtss_f32(acc);
+#endif
+	for ( ; i < taps; i++)
+		sum += (float)source[i] * coeffs[i];
+	return (INT32)floor(sum + 0.5f);
+}
+
+
+#endif  /* __SOUNDSIMD_H__ */
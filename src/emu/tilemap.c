@@ -9,6 +9,7 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include "drawsimd.h"
 
 
 //**************************************************************************
@@ -111,8 +112,7 @@ inline void tilemap_t::scanline_draw_opaque_null(int count, UINT8 *pri, UINT32 p
 		return;
 
 	// update priority across the scanline
-	for (int i = 0; i < count; i++)
-		pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+	draw_scanline_priority(pri, count, pcode >> 8, pcode);
 }
 
 
@@ -128,9 +128,7 @@ inline void tilemap_t::scanline_draw_masked_null(const UINT8 *maskptr, int mask,
 		return;
 
 	// update priority across the scanline, checking the mask
-	for (int i = 0; i < count; i++)
-		if ((maskptr[i] & mask) == value)
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+	draw_scanline_masked_priority(pri, maskptr, mask, value, count, pcode >> 8, pcode);
 }
 
 
@@ -154,26 +152,19 @@ inline void tilemap_t::scanline_draw_opaque_ind16(UINT16 *dest, const UINT16 *so
 			return;
 
 		// update priority across the scanline
-		for (int i = 0; i < count; i++)
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
+		draw_scanline_priority(pri, count, pcode >> 8, pcode);
 	}
 
 	// priority case
 	else if ((pcode & 0xffff) != 0xff00)
 	{
-		for (int i = 0; i < count; i++)
-		{
-			dest[i] = source[i] + pal;
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
+		draw_scanline_rebase16(dest, source, count, pal);
+		draw_scanline_priority(pri, count, pcode >> 8, pcode);
 	}
 
 	// no priority case
 	else
-	{
-		for (int i = 0; i < count; i++)
-			dest[i] = source[i] + pal;
-	}
+		draw_scanline_rebase16(dest, source, count, pal);
 }
 
 
@@ -189,21 +180,13 @@ inline void tilemap_t::scanline_draw_masked_ind16(UINT16 *dest, const UINT16 *so
 	// priority case
 	if ((pcode & 0xffff) != 0xff00)
 	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-			{
-				dest[i] = source[i] + pal;
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-			}
+		draw_scanline_masked_rebase16(dest, source, maskptr, mask, value, count, pal);
+		draw_scanline_masked_priority(pri, maskptr, mask, value, count, pcode >> 8, pcode);
 	}
 
 	// no priority case
 	else
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = source[i] + pal;
-	}
+		draw_scanline_masked_rebase16(dest, source, maskptr, mask, value, count, pal);
 }
 
 
@@ -220,19 +203,13 @@ inline void tilemap_t::scanline_draw_opaque_rgb32(UINT32 *dest, const UINT16 *so
 	// priority case
 	if ((pcode & 0xffff) != 0xff00)
 	{
-		for (int i = 0; i < count; i++)
-		{
-			dest[i] = clut[source[i]];
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
+		draw_scanline_remap32(dest, source, count, clut);
+		draw_scanline_priority(pri, count, pcode >> 8, pcode);
 	}
 
 	// no priority case
 	else
-	{
-		for (int i = 0; i < count; i++)
-			dest[i] = clut[source[i]];
-	}
+		draw_scanline_remap32(dest, source, count, clut);
 }
 
 
@@ -248,21 +225,13 @@ inline void tilemap_t::scanline_draw_masked_rgb32(UINT32 *dest, const UINT16 *so
 	// priority case
 	if ((pcode & 0xffff) != 0xff00)
 	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-			{
-				dest[i] = clut[source[i]];
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-			}
+		draw_scanline_masked_remap32(dest, source, maskptr, mask, value, count, clut);
+		draw_scanline_masked_priority(pri, maskptr, mask, value, count, pcode >> 8, pcode);
 	}
 
 	// no priority case
 	else
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = clut[source[i]];
-	}
+		draw_scanline_masked_remap32(dest, source, maskptr, mask, value, count, clut);
 }
 
 
@@ -951,6 +920,53 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 	UINT32 width = visarea.min_x + visarea.max_x + 1;
 	UINT32 height = visarea.min_y + visarea.max_y + 1;
 
+	// large draws are split into horizontal bands and rendered in parallel; tile_update calls
+	// back into the driver, so every tile has to be brought up to date before the bands start
+	osd_work_queue *queue = m_manager->work_queue();
+	int bands = MIN(blit.cliprect.height() / MIN_BAND_HEIGHT, MAX_DRAW_BANDS);
+	if (queue != NULL && bands > 1)
+	{
+		pixmap_update();
+
+		draw_band<_BitmapClass> band[MAX_DRAW_BANDS];
+		int top = blit.cliprect.min_y;
+		for (int bandnum = 0; bandnum < bands; bandnum++)
+		{
+			band[bandnum].tilemap = this;
+			band[bandnum].screen = &screen;
+			band[bandnum].dest = &dest;
+			band[bandnum].blit = blit;
+			band[bandnum].blit.cliprect.min_y = top;
+			top = blit.cliprect.min_y + blit.cliprect.height() * (bandnum + 1) / bands;
+			band[bandnum].blit.cliprect.max_y = top - 1;
+			band[bandnum].width = width;
+			band[bandnum].height = height;
+		}
+		osd_work_item_queue_multiple(queue, draw_band_callback<_BitmapClass>, bands, band, sizeof(band[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		osd_work_queue_wait(queue, osd_ticks_per_second() * 100);
+	}
+	else
+		draw_scrolled(screen, dest, blit, width, height);
+g_profiler.stop();
+}
+
+void tilemap_t::draw(screen_device &screen, bitmap_ind16 &dest, const rectangle &cliprect, UINT32 flags, UINT8 priority, UINT8 priority_mask)
+{ draw_common(screen, dest, cliprect, flags, priority, priority_mask); }
+
+void tilemap_t::draw(screen_device &screen, bitmap_rgb32 &dest, const rectangle &cliprect, UINT32 flags, UINT8 priority, UINT8 priority_mask)
+{ draw_common(screen, dest, cliprect, flags, priority, priority_mask); }
+
+
+//-------------------------------------------------
+//  draw_scrolled - draw the tilemap into the
+//  blit cliprect, handling scrolling and
+//  wraparound; width and height are those of the
+//  flipped visible area
+//-------------------------------------------------
+
+template<class _BitmapClass>
+void tilemap_t::draw_scrolled(screen_device &screen, _BitmapClass &dest, blit_parameters &blit, UINT32 width, UINT32 height)
+{
 	// XY scrolling playfield
 	if (m_scrollrows == 1 && m_scrollcols == 1)
 	{
@@ -1036,14 +1052,21 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 			}
 		}
 	}
-g_profiler.stop();
 }
 
-void tilemap_t::draw(screen_device &screen, bitmap_ind16 &dest, const rectangle &cliprect, UINT32 flags, UINT8 priority, UINT8 priority_mask)
-{ draw_common(screen, dest, cliprect, flags, priority, priority_mask); }
 
-void tilemap_t::draw(screen_device &screen, bitmap_rgb32 &dest, const rectangle &cliprect, UINT32 flags, UINT8 priority, UINT8 priority_mask)
-{ draw_common(screen, dest, cliprect, flags, priority, priority_mask); }
+//-------------------------------------------------
+//  draw_band_callback - work queue callback to
+//  draw a single band of a parallel draw
+//-------------------------------------------------
+
+template<class _BitmapClass>
+void *tilemap_t::draw_band_callback(void *param, int threadid)
+{
+	draw_band<_BitmapClass> &band = *reinterpret_cast<draw_band<_BitmapClass> *>(param);
+	band.tilemap->draw_scrolled(*band.screen, *band.dest, band.blit, band.width, band.height);
+	return NULL;
+}
 
 
 //-------------------------------------------------
@@ -1484,8 +1507,11 @@ void tilemap_t::draw_debug(screen_device &screen, bitmap_rgb32 &dest, UINT32 scr
 
 tilemap_manager::tilemap_manager(running_machine &machine)
 	: m_machine(machine),
-		m_instance(0)
+		m_instance(0),
+		m_work_queue(NULL)
 {
+	if (machine.options().parallel_tilemaps())
+		m_work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
 }
 
 
@@ -1509,6 +1535,10 @@ tilemap_manager::~tilemap_manager()
 				break;
 			}
 	}
+
+	// free the work queue
+	if (m_work_queue != NULL)
+		osd_work_queue_free(m_work_queue);
 }
 
 
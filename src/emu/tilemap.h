@@ -486,6 +486,10 @@ class tilemap_t
 	// maximum index in each array
 	static const int MAX_PEN_TO_FLAGS = 256;
 
+	// limits for splitting a draw into bands rendered in parallel
+	static const int MAX_DRAW_BANDS = 8;
+	static const int MIN_BAND_HEIGHT = 32;
+
 protected:
 	// tilemap_manager controlls our allocations
 	tilemap_t();
@@ -587,6 +591,18 @@ private:
 		UINT8               alpha;
 	};
 
+	// parameters for drawing one band of a parallel draw
+	template<class _BitmapClass>
+	struct draw_band
+	{
+		tilemap_t *         tilemap;
+		screen_device *     screen;
+		_BitmapClass *      dest;
+		blit_parameters     blit;
+		UINT32              width;
+		UINT32              height;
+	};
+
 	// inline helpers
 	INT32 effective_rowscroll(int index, UINT32 screen_width);
 	INT32 effective_colscroll(int index, UINT32 screen_height);
@@ -615,6 +631,8 @@ private:
 	UINT8 tile_apply_bitmask(const UINT8 *maskdata, UINT32 x0, UINT32 y0, UINT8 category, UINT8 flags);
 	void configure_blit_parameters(blit_parameters &blit, bitmap_ind8 &priority_bitmap, const rectangle &cliprect, UINT32 flags, UINT8 priority, UINT8 priority_mask);
 	template<class _BitmapClass> void draw_common(screen_device &screen, _BitmapClass &dest, const rectangle &cliprect, UINT32 flags, UINT8 priority, UINT8 priority_mask);
+	template<class _BitmapClass> void draw_scrolled(screen_device &screen, _BitmapClass &dest, blit_parameters &blit, UINT32 width, UINT32 height);
+	template<class _BitmapClass> static void *draw_band_callback(void *param, int threadid);
 	template<class _BitmapClass> void draw_roz_common(screen_device &screen, _BitmapClass &dest, const rectangle &cliprect, UINT32 startx, UINT32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound, UINT32 flags, UINT8 priority, UINT8 priority_mask);
 	template<class _BitmapClass> void draw_instance(screen_device &screen, _BitmapClass &dest, const blit_parameters &blit, int xpos, int ypos);
 	template<class _BitmapClass> void draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, const blit_parameters &blit, UINT32 startx, UINT32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound);
@@ -690,6 +708,7 @@ public:
 
 	// getters
 	running_machine &machine() const { return m_machine; }
+	osd_work_queue *work_queue() const { return m_work_queue; }
 
 	// tilemap creation
 	tilemap_t &create(device_gfx_interface &decoder, tilemap_get_info_delegate tile_get_info, tilemap_mapper_delegate mapper, int tilewidth, int tileheight, int cols, int rows, tilemap_t *allocated = NULL);
@@ -711,6 +730,7 @@ private:
 	running_machine &       m_machine;
 	simple_list<tilemap_t>  m_tilemap_list;
 	int                     m_instance;
+	osd_work_queue *        m_work_queue;           // queue for parallel band drawing, or NULL
 };
 
 
@@ -2219,6 +2219,26 @@ UINT32 ui_manager::handler_ingame(running_machine &machine, render_container *co
 		return machine.ui().set_handler(handler_load_save, LOADSAVE_LOAD);
 	}
 
+	// handle a rewind request; the first press just pauses, after which each press steps
+	// back a frame, and holding the key down keeps stepping back one frame per update
+	bool rewind_pressed = ui_input_pressed(machine, IPT_UI_REWIND_SINGLE);
+	if (machine.save().rewind() != NULL)
+	{
+		if (rewind_pressed && !machine.paused())
+			machine.pause();
+		else if (machine.paused() && (rewind_pressed || machine.ioport().type_pressed(IPT_UI_REWIND_SINGLE)))
+		{
+			if (machine.save().rewind()->step_back())
+			{
+				// single-step forward into the frame we want so that it gets redrawn
+				machine.ui().set_single_step(true);
+				machine.resume();
+			}
+			else if (rewind_pressed)
+				popmessage(_("Rewind history exhausted"));
+		}
+	}
+
 	// handle a save snapshot request
 	if (ui_input_pressed(machine, IPT_UI_SNAPSHOT))
 		machine.video().save_active_screen_snapshots();
@@ -106,7 +106,11 @@ video_manager::video_manager(running_machine &machine)
 		m_avi_file(NULL),
 		m_avi_frame_period(attotime::zero),
 		m_avi_next_frame_time(attotime::zero),
-		m_avi_frame(0)
+		m_avi_frame(0),
+		m_encode_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_IO)),
+		m_encode_next(0),
+		m_avi_error(0),
+		m_mng_error(0)
 {
 	// request a callback upon exiting
 	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(video_manager::exit), this));
@@ -340,20 +344,24 @@ void video_manager::save_active_screen_snapshots()
 		for (screen_device *screen = iter.first(); screen != NULL; screen = iter.next())
 			if (machine().render().is_live(*screen))
 			{
-				emu_file file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
-				file_error filerr = open_next(file, "png");
+				emu_file *file = global_alloc(emu_file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS));
+				file_error filerr = open_next(*file, "png");
 				if (filerr == FILERR_NONE)
-					save_snapshot(screen, file);
+					queue_snapshot(screen, file);
+				else
+					global_free(file);
 			}
 	}
 
 	// otherwise, just write a single snapshot
 	else
 	{
-		emu_file file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
-		file_error filerr = open_next(file, "png");
+		emu_file *file = global_alloc(emu_file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS));
+		file_error filerr = open_next(*file, "png");
 		if (filerr == FILERR_NONE)
-			save_snapshot(NULL, file);
+			queue_snapshot(NULL, file);
+		else
+			global_free(file);
 	}
 }
 
@@ -472,6 +480,9 @@ void video_manager::begin_recording(const char *name, movie_format format)
 
 void video_manager::end_recording(movie_format format)
 {
+	// let the encoder catch up before closing anything
+	encode_flush();
+
 	if (format == MF_AVI)
 	{
 		// close the file if it exists
@@ -483,6 +494,7 @@ void video_manager::end_recording(movie_format format)
 			// reset the state
 			m_avi_frame = 0;
 		}
+		m_avi_error = 0;
 	}
 	else if (format == MF_MNG)
 	{
@@ -495,6 +507,7 @@ void video_manager::end_recording(movie_format format)
 			// reset the state
 			m_mng_frame = 0;
 		}
+		m_mng_error = 0;
 	}
 }
 
@@ -511,13 +524,20 @@ void video_manager::add_sound_to_recording(const INT16 *sound, int numsamples)
 	{
 		g_profiler.start(PROFILER_MOVIE_REC);
 
-		// write the next frame
-		avi_error avierr = avi_append_sound_samples(m_avi_file, 0, sound + 0, numsamples, 1);
-		if (avierr == AVIERR_NONE)
-			avierr = avi_append_sound_samples(m_avi_file, 1, sound + 1, numsamples, 1);
-		if (avierr != AVIERR_NONE)
+		// stop if the encoder failed on anything earlier
+		if (m_avi_error != 0)
 			end_recording(MF_AVI);
 
+		// otherwise, hand a copy of the samples to the encoder
+		else
+		{
+			encode_job &job = encode_alloc(JOB_SOUND);
+			job.m_sound.resize(numsamples * 2);
+			memcpy(&job.m_sound[0], sound, numsamples * 2 * sizeof(INT16));
+			job.m_samples = numsamples;
+			encode_queue(job);
+		}
+
 		g_profiler.stop();
 	}
 }
@@ -534,18 +554,36 @@ void video_manager::exit()
 	end_recording(MF_AVI);
 	end_recording(MF_MNG);
 
+	// finish any outstanding snapshots and stop the encoder
+	encode_flush();
+	if (m_encode_queue != NULL)
+		osd_work_queue_free(m_encode_queue);
+	m_encode_queue = NULL;
+
 	// free the snapshot target
 	machine().render().target_free(m_snap_target);
 	m_snap_bitmap.reset();
 
 	// print a final result if we have at least 2 seconds' worth of data
 	if (m_overall_emutime.seconds >= 1)
-	{
-		osd_ticks_t tps = osd_ticks_per_second();
-		double final_real_time = (double)m_overall_real_seconds + (double)m_overall_real_ticks / (double)tps;
-		double final_emu_time = m_overall_emutime.as_double();
-		osd_printf_info(_("Average speed: %.2f%% (%d seconds)\n"), 100 * final_emu_time / final_real_time, (m_overall_emutime + attotime(0, ATTOSECONDS_PER_SECOND / 2)).seconds);
-	}
+		osd_printf_info(_("Average speed: %.2f%% (%d seconds)\n"), overall_speed_percent(), (m_overall_emutime + attotime(0, ATTOSECONDS_PER_SECOND / 2)).seconds);
+}
+
+
+//-------------------------------------------------
+//  overall_speed_percent - return the average
+//  speed over all periods that counted towards
+//  the overall total, or 0 if there were none
+//-------------------------------------------------
+
+double video_manager::overall_speed_percent() const
+{
+	osd_ticks_t tps = osd_ticks_per_second();
+	double final_real_time = (double)m_overall_real_seconds + (double)m_overall_real_ticks / (double)tps;
+	double final_emu_time = m_overall_emutime.as_double();
+	if (final_real_time == 0)
+		return 0;
+	return 100 * final_emu_time / final_real_time;
 }
 
 
@@ -1047,10 +1085,12 @@ void video_manager::recompute_speed(const attotime &emutime)
 		if (machine().first_screen() != NULL)
 		{
 			// create a final screenshot
-			emu_file file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
-			file_error filerr = file.open(machine().basename(), PATH_SEPARATOR "final.png");
+			emu_file *file = global_alloc(emu_file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS));
+			file_error filerr = file->open(machine().basename(), PATH_SEPARATOR "final.png");
 			if (filerr == FILERR_NONE)
-				save_snapshot(machine().first_screen(), file);
+				queue_snapshot(machine().first_screen(), file);
+			else
+				global_free(file);
 		}
 
 		// schedule our demise
@@ -1243,65 +1283,216 @@ void video_manager::record_frame()
 	g_profiler.start(PROFILER_MOVIE_REC);
 	attotime curtime = machine().time();
 
-	// create the bitmap
-	create_snapshot_bitmap(NULL);
+	// stop any recording the encoder failed to write
+	if (m_avi_error != 0)
+		end_recording(MF_AVI);
+	if (m_mng_error != 0)
+		end_recording(MF_MNG);
 
-	// handle an AVI recording
+	// count how many AVI frames are due
+	UINT32 avi_frames = 0;
 	if (m_avi_file != NULL)
-	{
-		// loop until we hit the right time
 		while (m_avi_next_frame_time <= curtime)
 		{
-			// write the next frame
-			avi_error avierr = avi_append_video_frame(m_avi_file, m_snap_bitmap);
-			if (avierr != AVIERR_NONE)
-			{
-				g_profiler.stop();
-				end_recording(MF_AVI);
-				break;
-			}
-
-			// advance time
 			m_avi_next_frame_time += m_avi_frame_period;
 			m_avi_frame++;
+			avi_frames++;
 		}
-	}
 
-	// handle a MNG recording
+	// and how many MNG frames
+	UINT32 mng_frames = 0;
+	bool mng_first = (m_mng_frame == 0);
 	if (m_mng_file != NULL)
-	{
-		// loop until we hit the right time
 		while (m_mng_next_frame_time <= curtime)
 		{
-			// set up the text fields in the movie info
-			png_info pnginfo = { 0 };
-			if (m_mng_frame == 0)
+			m_mng_next_frame_time += m_mng_frame_period;
+			m_mng_frame++;
+			mng_frames++;
+		}
+
+	// create the bitmap and hand a copy to the encoder; this waits if it has fallen behind
+	if (avi_frames != 0 || mng_frames != 0)
+	{
+		create_snapshot_bitmap(NULL);
+		encode_job &job = encode_alloc(JOB_FRAME);
+		if (!job.m_bitmap.valid() || job.m_bitmap.width() != m_snap_bitmap.width() || job.m_bitmap.height() != m_snap_bitmap.height())
+			job.m_bitmap.allocate(m_snap_bitmap.width(), m_snap_bitmap.height());
+		copybitmap(job.m_bitmap, m_snap_bitmap, 0, 0, 0, 0, m_snap_bitmap.cliprect());
+		job.m_avi_frames = avi_frames;
+		job.m_mng_frames = mng_frames;
+		job.m_mng_first = mng_first;
+		encode_queue(job);
+	}
+
+	g_profiler.stop();
+}
+
+
+//-------------------------------------------------
+//  queue_snapshot - snapshot the given screen
+//  and hand it to the encoder, which writes it
+//  to the file and then frees it
+//-------------------------------------------------
+
+void video_manager::queue_snapshot(screen_device *screen, emu_file *file)
+{
+	// validate
+	assert(!m_snap_native || screen != NULL);
+
+	// create the bitmap and take a copy
+	create_snapshot_bitmap(screen);
+	encode_job &job = encode_alloc(JOB_SNAPSHOT);
+	if (!job.m_bitmap.valid() || job.m_bitmap.width() != m_snap_bitmap.width() || job.m_bitmap.height() != m_snap_bitmap.height())
+		job.m_bitmap.allocate(m_snap_bitmap.width(), m_snap_bitmap.height());
+	copybitmap(job.m_bitmap, m_snap_bitmap, 0, 0, 0, 0, m_snap_bitmap.cliprect());
+	job.m_snapfile.reset(file);
+	encode_queue(job);
+}
+
+
+//-------------------------------------------------
+//  encode_alloc - claim the oldest job in the
+//  ring, waiting for the encoder to finish it
+//  if necessary
+//-------------------------------------------------
+
+video_manager::encode_job &video_manager::encode_alloc(encode_job_type type)
+{
+	encode_job &job = m_encode_job[m_encode_next];
+	m_encode_next = (m_encode_next + 1) % ENCODE_QUEUE_DEPTH;
+	encode_retire(job);
+
+	job.m_manager = this;
+	job.m_type = type;
+	job.m_avi_frames = 0;
+	job.m_mng_frames = 0;
+	job.m_mng_first = false;
+	job.m_samples = 0;
+	job.m_pngerr = PNGERR_NONE;
+	return job;
+}
+
+
+//-------------------------------------------------
+//  encode_queue - hand a filled-in job to the
+//  encoder thread
+//-------------------------------------------------
+
+void video_manager::encode_queue(encode_job &job)
+{
+	// the queue runs items in order on a single thread, which keeps the streams intact
+	if (m_encode_queue != NULL)
+		job.m_osd = osd_work_item_queue(m_encode_queue, encode_job_static, &job, 0);
+
+	// if we couldn't queue it, just do the work now
+	if (job.m_osd == NULL)
+		encode_execute(job);
+}
+
+
+//-------------------------------------------------
+//  encode_retire - wait for a job to complete
+//  and report the outcome of a snapshot
+//-------------------------------------------------
+
+void video_manager::encode_retire(encode_job &job)
+{
+	if (job.m_osd != NULL)
+	{
+		while (!osd_work_item_wait(job.m_osd, osd_ticks_per_second())) ;
+		osd_work_item_release(job.m_osd);
+		job.m_osd = NULL;
+	}
+
+	if (job.m_type == JOB_SNAPSHOT && job.m_pngerr != PNGERR_NONE)
+		osd_printf_error(_("Error generating PNG for snapshot: png_error = %d\n"), job.m_pngerr);
+	job.m_pngerr = PNGERR_NONE;
+	job.m_snapfile.reset();
+}
+
+
+//-------------------------------------------------
+//  encode_flush - wait for everything queued to
+//  be written
+//-------------------------------------------------
+
+void video_manager::encode_flush()
+{
+	for (int jobnum = 0; jobnum < ENCODE_QUEUE_DEPTH; jobnum++)
+		encode_retire(m_encode_job[(m_encode_next + jobnum) % ENCODE_QUEUE_DEPTH]);
+}
+
+
+//-------------------------------------------------
+//  encode_execute - encode and write a job; runs
+//  on the encoder thread, so touches nothing but
+//  the job and the open movie files
+//-------------------------------------------------
+
+void *video_manager::encode_job_static(void *param, int threadid)
+{
+	encode_job *job = reinterpret_cast<encode_job *>(param);
+	job->m_manager->encode_execute(*job);
+	return NULL;
+}
+
+void video_manager::encode_execute(encode_job &job)
+{
+	switch (job.m_type)
+	{
+		case JOB_FRAME:
+			// append to the AVI until we're caught up or something fails
+			for (UINT32 framenum = 0; framenum < job.m_avi_frames && m_avi_error == 0; framenum++)
+				if (avi_append_video_frame(m_avi_file, job.m_bitmap) != AVIERR_NONE)
+					atomic_exchange32(&m_avi_error, 1);
+
+			// same for the MNG; the bitmap is RGB so no palette is needed
+			for (UINT32 framenum = 0; framenum < job.m_mng_frames && m_mng_error == 0; framenum++)
 			{
-				astring text1(emulator_info::get_appname(), " ", build_version);
-				astring text2(machine().system().manufacturer, " ", machine().system().description);
-				png_add_text(&pnginfo, "Software", text1);
-				png_add_text(&pnginfo, "System", text2);
+				// set up the text fields in the movie info
+				png_info pnginfo = { 0 };
+				if (job.m_mng_first && framenum == 0)
+				{
+					astring text1(emulator_info::get_appname(), " ", build_version);
+					astring text2(machine().system().manufacturer, " ", machine().system().description);
+					png_add_text(&pnginfo, "Software", text1);
+					png_add_text(&pnginfo, "System", text2);
+				}
+
+				// write the next frame
+				png_error error = mng_capture_frame(*m_mng_file, &pnginfo, job.m_bitmap, 0, NULL);
+				png_free(&pnginfo);
+				if (error != PNGERR_NONE)
+					atomic_exchange32(&m_mng_error, 1);
 			}
+			break;
 
-			// write the next frame
-			const rgb_t *palette = (machine().first_screen() !=NULL && machine().first_screen()->palette() != NULL) ? machine().first_screen()->palette()->palette()->entry_list_adjusted() : NULL;
-			int entries = (machine().first_screen() !=NULL && machine().first_screen()->palette() != NULL) ? machine().first_screen()->palette()->entries() : 0;
-			png_error error = mng_capture_frame(*m_mng_file, &pnginfo, m_snap_bitmap, entries, palette);
-			png_free(&pnginfo);
-			if (error != PNGERR_NONE)
+		case JOB_SOUND:
+			if (m_avi_error == 0)
 			{
-				g_profiler.stop();
-				end_recording(MF_MNG);
-				break;
+				avi_error avierr = avi_append_sound_samples(m_avi_file, 0, &job.m_sound[0], job.m_samples, 1);
+				if (avierr == AVIERR_NONE)
+					avierr = avi_append_sound_samples(m_avi_file, 1, &job.m_sound[1], job.m_samples, 1);
+				if (avierr != AVIERR_NONE)
+					atomic_exchange32(&m_avi_error, 1);
 			}
+			break;
 
-			// advance time
-			m_mng_next_frame_time += m_mng_frame_period;
-			m_mng_frame++;
+		case JOB_SNAPSHOT:
+		{
+			// add two text entries describing the image
+			astring text1(emulator_info::get_appname(), " ", build_version);
+			astring text2(machine().system().manufacturer, " ", machine().system().description);
+			png_info pnginfo = { 0 };
+			png_add_text(&pnginfo, "Software", text1);
+			png_add_text(&pnginfo, "System", text2);
+
+			// now do the actual work; errors are reported when the job is retired
+			job.m_pngerr = png_write_bitmap(*job.m_snapfile, &pnginfo, job.m_bitmap, 0, NULL);
+			png_free(&pnginfo);
+			break;
 		}
 	}
-
-	g_profiler.stop();
 }
 
 //-------------------------------------------------
@@ -83,6 +83,7 @@ public:
 	// current speed helpers
 	astring &speed_text(astring &string);
 	double speed_percent() const { return m_speed_percent; }
+	double overall_speed_percent() const;
 
 	// snapshots
 	void save_snapshot(screen_device *screen, emu_file &file);
@@ -94,6 +95,43 @@ public:
 	void add_sound_to_recording(const INT16 *sound, int numsamples);
 
 private:
+	// kinds of work handed to the encoder thread
+	enum encode_job_type
+	{
+		JOB_FRAME,
+		JOB_SOUND,
+		JOB_SNAPSHOT
+	};
+
+	// a frame, block of sound or snapshot waiting to be encoded and written
+	struct encode_job
+	{
+		encode_job()
+			: m_manager(NULL),
+				m_osd(NULL),
+				m_type(JOB_FRAME),
+				m_avi_frames(0),
+				m_mng_frames(0),
+				m_mng_first(false),
+				m_samples(0),
+				m_pngerr(0) { }
+
+		video_manager *     m_manager;                  // pointer back to the manager
+		osd_work_item *     m_osd;                      // work item, or NULL if idle
+		encode_job_type     m_type;                     // what kind of job this is
+		bitmap_rgb32        m_bitmap;                   // copy of the snapshot bitmap
+		UINT32              m_avi_frames;               // number of times to append to the AVI
+		UINT32              m_mng_frames;               // number of times to append to the MNG
+		bool                m_mng_first;                // first frame of the MNG?
+		dynamic_array<INT16> m_sound;                   // interleaved stereo samples for the AVI
+		int                 m_samples;                  // number of stereo samples
+		auto_pointer<emu_file> m_snapfile;              // open file for a snapshot
+		int                 m_pngerr;                   // png_error from writing a snapshot
+	};
+
+	// maximum number of jobs in flight before the emulation waits for the encoder
+	static const int ENCODE_QUEUE_DEPTH = 8;
+
 	// internal helpers
 	void exit();
 	void screenless_update_callback(void *ptr, int param);
@@ -117,6 +155,15 @@ private:
 	void create_snapshot_bitmap(screen_device *screen);
 	file_error open_next(emu_file &file, const char *extension);
 	void record_frame();
+	void queue_snapshot(screen_device *screen, emu_file *file);
+
+	// asynchronous encoding helpers
+	encode_job &encode_alloc(encode_job_type type);
+	void encode_queue(encode_job &job);
+	void encode_retire(encode_job &job);
+	void encode_flush();
+	static void *encode_job_static(void *param, int threadid);
+	void encode_execute(encode_job &job);
 
 	// internal state
 	running_machine &   m_machine;                  // reference to our machine
@@ -177,6 +224,13 @@ private:
 	attotime            m_avi_next_frame_time;      // time of next frame
 	UINT32              m_avi_frame;                // current movie frame number
 
+	// asynchronous encoding
+	osd_work_queue *    m_encode_queue;             // I/O queue that encodes and writes, in order
+	encode_job          m_encode_job[ENCODE_QUEUE_DEPTH]; // ring of jobs
+	int                 m_encode_next;              // next job in the ring to reuse
+	volatile INT32      m_avi_error;                // set by the encoder if an AVI write failed
+	volatile INT32      m_mng_error;                // set by the encoder if a MNG write failed
+
 	static const UINT8      s_skiptable[FRAMESKIP_LEVELS][FRAMESKIP_LEVELS];
 
 	static const attoseconds_t ATTOSECONDS_PER_SPEED_UPDATE = ATTOSECONDS_PER_SECOND / 4;
@@ -59,6 +59,7 @@
 #define POLYFLAG_INCLUDE_BOTTOM_EDGE        0x01
 #define POLYFLAG_INCLUDE_RIGHT_EDGE         0x02
 #define POLYFLAG_NO_WORK_QUEUE              0x04
+#define POLYFLAG_TILE_BINNING               0x08        // defer work to wait(), one item per bucket
 
 #define SCANLINES_PER_BUCKET                8
 #define CACHE_LINE_SIZE                     64          // this is a general guess
@@ -248,7 +249,33 @@ private:
 		return polygon;
 	}
 
+	// add a unit to the end of its bucket; in binning mode the forward link
+	// goes into the upper half of the previous tail's count_next
+	void unit_link(work_unit &unit, UINT32 unit_index, UINT32 bucketnum)
+	{
+		UINT16 tail = m_unit_bucket[bucketnum];
+		unit.previtem = tail;
+		m_unit_bucket[bucketnum] = unit_index;
+
+		if (m_flags & POLYFLAG_TILE_BINNING)
+		{
+			if (tail == 0xffff)
+				m_bin_head[bucketnum] = unit_index;
+			else
+				m_unit[tail].count_next |= unit_index << 16;
+		}
+	}
+
+	// enqueue the units of a new polygon; binned units wait for the next flush
+	void unit_queue(UINT32 startunit)
+	{
+		if (m_queue != NULL && !(m_flags & POLYFLAG_TILE_BINNING))
+			osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	}
+
 	static void *work_item_callback(void *param, int threadid);
+	static void *bin_callback(void *param, int threadid);
+	void bin_flush();
 	void presave() { wait("pre-save"); }
 
 	// queue management
@@ -266,11 +293,14 @@ private:
 
 	// buckets
 	UINT16              m_unit_bucket[TOTAL_BUCKETS]; // buckets for tracking unit usage
+	UINT16              m_bin_head[TOTAL_BUCKETS];  // first unit in each bucket, for binning
+	work_unit *         m_bin_list[TOTAL_BUCKETS];  // heads of the non-empty buckets, as queued
 
 	// statistics
 	UINT32              m_tiles;                    // number of tiles queued
 	UINT32              m_triangles;                // number of triangles queued
 	UINT32              m_quads;                    // number of quads queued
+	UINT32              m_bins;                     // number of bins queued
 	UINT64              m_pixels;                   // number of pixels rendered
 #if KEEP_POLY_STATISTICS
 	UINT32              m_conflicts[WORK_MAX_THREADS]; // number of conflicts found, per thread
@@ -294,8 +324,10 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(runnin
 		m_flags(flags),
 		m_triangles(0),
 		m_quads(0),
+		m_bins(0),
 		m_pixels(0)
 {
+	memset(m_unit_bucket, 0xff, sizeof(m_unit_bucket));
 #if KEEP_POLY_STATISTICS
 	memset(m_conflicts, 0, sizeof(m_conflicts));
 	memset(m_resolved, 0, sizeof(m_resolved));
@@ -321,8 +353,10 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(screen
 		m_flags(flags),
 		m_triangles(0),
 		m_quads(0),
+		m_bins(0),
 		m_pixels(0)
 {
+	memset(m_unit_bucket, 0xff, sizeof(m_unit_bucket));
 #if KEEP_POLY_STATISTICS
 	memset(m_conflicts, 0, sizeof(m_conflicts));
 	memset(m_resolved, 0, sizeof(m_resolved));
@@ -357,6 +391,7 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::~poly_manager()
 	// output global stats
 	printf("Total triangles = %d\n", m_triangles);
 	printf("Total quads = %d\n", m_quads);
+	printf("Total bins = %d\n", m_bins);
 	if (m_pixels > 1000000000)
 		printf("Total pixels   = %d%09d\n", (UINT32)(m_pixels / 1000000000), (UINT32)(m_pixels % 1000000000));
 	else
@@ -437,6 +472,61 @@ void *poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::work_item_cal
 }
 
 
+//-------------------------------------------------
+//  bin_callback - process every unit in one
+//  bucket, in the order they were submitted
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void *poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::bin_callback(void *param, int threadid)
+{
+	work_unit *unit = *(work_unit **)param;
+	while (1)
+	{
+		polygon_info &polygon = *unit->polygon;
+		UINT32 count_next = unit->count_next;
+
+		// iterate over extents
+		int count = count_next & 0xffff;
+		for (int curscan = 0; curscan < count; curscan++)
+			polygon.m_callback(unit->scanline + curscan, unit->extent[curscan], *polygon.m_object, threadid);
+
+		// follow the link to the next unit in this bucket
+		count_next >>= 16;
+		if (count_next == 0)
+			break;
+		unit = &polygon.m_owner->m_unit[count_next];
+	}
+	return NULL;
+}
+
+
+//-------------------------------------------------
+//  bin_flush - hand each non-empty bucket to the
+//  work queue as a single item, so one thread
+//  owns those scanlines until the flush is done
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::bin_flush()
+{
+	int numbins = 0;
+	for (int bucketnum = 0; bucketnum < TOTAL_BUCKETS; bucketnum++)
+		if (m_unit_bucket[bucketnum] != 0xffff)
+			m_bin_list[numbins++] = &m_unit[m_bin_head[bucketnum]];
+	m_bins += numbins;
+
+	if (m_queue != NULL)
+	{
+		if (numbins > 0)
+			osd_work_item_queue_multiple(m_queue, bin_callback, numbins, m_bin_list, sizeof(m_bin_list[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	}
+	else
+		for (int binnum = 0; binnum < numbins; binnum++)
+			bin_callback(&m_bin_list[binnum], 0);
+}
+
+
 //-------------------------------------------------
 //  wait - stall until all work is complete
 //-------------------------------------------------
@@ -450,12 +540,16 @@ void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::wait(const cha
 	if (LOG_WAITS)
 		time = get_profile_ticks();
 
+	// in binning mode, nothing has been queued yet
+	if (m_flags & POLYFLAG_TILE_BINNING)
+		bin_flush();
+
 	// wait for all pending work items to complete
 	if (m_queue != NULL)
 		osd_work_queue_wait(m_queue, osd_ticks_per_second() * 100);
 
 	// if we don't have a queue, just run the whole list now
-	else
+	else if (!(m_flags & POLYFLAG_TILE_BINNING))
 		for (int unitnum = 0; unitnum < m_unit.count(); unitnum++)
 			work_item_callback(&m_unit[unitnum], 0);
 
@@ -591,8 +685,7 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tile(
 		unit.polygon = &polygon;
 		unit.count_next = MIN(v2yclip - curscan, scaninc);
 		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
+		unit_link(unit, unit_index, bucketnum);
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -618,8 +711,7 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tile(
 	}
 
 	// enqueue the work items
-	if (m_queue != NULL)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	unit_queue(startunit);
 
 	// return the total number of pixels in the triangle
 	m_tiles++;
@@ -749,8 +841,7 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_trian
 		unit.polygon = &polygon;
 		unit.count_next = MIN(v3yclip - curscan, scaninc);
 		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
+		unit_link(unit, unit_index, bucketnum);
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -806,8 +897,7 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_trian
 	}
 
 	// enqueue the work items
-	if (m_queue != NULL)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	unit_queue(startunit);
 
 	// return the total number of pixels in the triangle
 	m_triangles++;
@@ -882,8 +972,7 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_trian
 		unit.polygon = &polygon;
 		unit.count_next = MIN(v3yclip - curscan, scaninc);
 		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
+		unit_link(unit, unit_index, bucketnum);
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -922,8 +1011,7 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_trian
 	}
 
 	// enqueue the work items
-	if (m_queue != NULL)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	unit_queue(startunit);
 
 	// return the total number of pixels in the object
 	m_triangles++;
@@ -1057,8 +1145,7 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_polyg
 		unit.polygon = &polygon;
 		unit.count_next = MIN(maxyclip - curscan, scaninc);
 		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
+		unit_link(unit, unit_index, bucketnum);
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -1121,8 +1208,7 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_polyg
 	}
 
 	// enqueue the work items
-	if (m_queue != NULL)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	unit_queue(startunit);
 
 	// return the total number of pixels in the triangle
 	m_quads++;
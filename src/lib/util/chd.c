@@ -173,9 +173,11 @@ inline void chd_file::file_read(UINT64 offset, void *dest, UINT32 length)
 	if (m_file == NULL)
 		throw CHDERR_NOT_OPEN;
 
-	// seek and read
+	// seek and read; the lock keeps read-ahead from moving the file pointer
+	osd_lock_acquire(m_lock);
 	core_fseek(m_file, offset, SEEK_SET);
 	UINT32 count = core_fread(m_file, dest, length);
+	osd_lock_release(m_lock);
 	if (count != length)
 		throw CHDERR_READ_ERROR;
 }
@@ -193,8 +195,10 @@ inline void chd_file::file_write(UINT64 offset, const void *source, UINT32 lengt
 		throw CHDERR_NOT_OPEN;
 
 	// seek and write
+	osd_lock_acquire(m_lock);
 	core_fseek(m_file, offset, SEEK_SET);
 	UINT32 count = core_fwrite(m_file, source, length);
+	osd_lock_release(m_lock);
 	if (count != length)
 		throw CHDERR_WRITE_ERROR;
 }
@@ -213,6 +217,8 @@ inline UINT64 chd_file::file_append(const void *source, UINT32 length, UINT32 al
 		throw CHDERR_NOT_OPEN;
 
 	// seek to the end and align if necessary
+	chd_error err = CHDERR_NONE;
+	osd_lock_acquire(m_lock);
 	core_fseek(m_file, 0, SEEK_END);
 	if (alignment != 0)
 	{
@@ -224,12 +230,12 @@ inline UINT64 chd_file::file_append(const void *source, UINT32 length, UINT32 al
 			UINT8 buffer[1024];
 			memset(buffer, 0, sizeof(buffer));
 			delta = alignment - delta;
-			while (delta != 0)
+			while (delta != 0 && err == CHDERR_NONE)
 			{
 				UINT32 bytes_to_write = MIN(sizeof(buffer), delta);
 				UINT32 count = core_fwrite(m_file, buffer, bytes_to_write);
 				if (count != bytes_to_write)
-					throw CHDERR_WRITE_ERROR;
+					err = CHDERR_WRITE_ERROR;
 				delta -= bytes_to_write;
 			}
 		}
@@ -237,9 +243,11 @@ inline UINT64 chd_file::file_append(const void *source, UINT32 length, UINT32 al
 
 	// write the real data
 	UINT64 offset = core_ftell(m_file);
-	UINT32 count = core_fwrite(m_file, source, length);
-	if (count != length)
-		throw CHDERR_READ_ERROR;
+	if (err == CHDERR_NONE && core_fwrite(m_file, source, length) != length)
+		err = CHDERR_READ_ERROR;
+	osd_lock_release(m_lock);
+	if (err != CHDERR_NONE)
+		throw err;
 	return offset;
 }
 
@@ -269,7 +277,10 @@ inline UINT8 chd_file::bits_for_value(UINT64 value)
 
 chd_file::chd_file()
 	: m_file(NULL),
-		m_owns_file(false)
+		m_owns_file(false),
+		m_lock(osd_lock_alloc()),
+		m_cachehunks(DEFAULT_CACHE_HUNKS),
+		m_readahead_queue(NULL)
 {
 	// reset state
 	memset(m_decompressor, 0, sizeof(m_decompressor));
@@ -285,6 +296,7 @@ chd_file::~chd_file()
 {
 	// close any open files
 	close();
+	osd_lock_free(m_lock);
 }
 
 
@@ -503,6 +515,21 @@ void chd_file::set_parent_sha1(sha1_t parent)
 }
 
 
+//-------------------------------------------------
+//  set_cache_hunks - set the number of hunks
+//  kept decompressed for partial reads; takes
+//  effect immediately if the file is open
+//-------------------------------------------------
+
+void chd_file::set_cache_hunks(UINT32 hunks)
+{
+	cache_flush();
+	m_cachehunks = MAX(hunks, 1);
+	if (m_file != NULL)
+		cache_allocate();
+}
+
+
 //-------------------------------------------------
 //  create - create a new file with no parent
 //  using an existing opened file handle
@@ -672,6 +699,12 @@ chd_error chd_file::open(core_file &file, bool writeable, chd_file *parent)
 
 void chd_file::close()
 {
+	// finish any read-ahead before tearing down the file and codecs
+	cache_flush();
+	if (m_readahead_queue != NULL)
+		osd_work_queue_free(m_readahead_queue);
+	m_readahead_queue = NULL;
+
 	// reset file characteristics
 	if (m_owns_file && m_file != NULL)
 		core_fclose(m_file);
@@ -714,7 +747,12 @@ void chd_file::close()
 
 	// reset caching
 	m_cache.reset();
-	m_cachehunk = ~0;
+	m_cacheclock = 0;
+	m_lasthunk = ~0;
+	m_sequential = 0;
+	m_cachehits = 0;
+	m_cachemisses = 0;
+	m_cacheprefetches = 0;
 }
 
 
@@ -723,6 +761,21 @@ void chd_file::close()
 //-------------------------------------------------
 
 chd_error chd_file::read_hunk(UINT32 hunknum, void *buffer)
+{
+	// the codecs and compressed buffer are shared with the read-ahead thread
+	osd_lock_acquire(m_lock);
+	chd_error err = hunk_read(hunknum, buffer);
+	osd_lock_release(m_lock);
+	return err;
+}
+
+
+//-------------------------------------------------
+//  hunk_read - read a single hunk from the CHD
+//  file; the caller must hold the lock
+//-------------------------------------------------
+
+chd_error chd_file::hunk_read(UINT32 hunknum, void *buffer)
 {
 	// wrap this for clean reporting
 	try
@@ -854,6 +907,26 @@ chd_error chd_file::read_hunk(UINT32 hunknum, void *buffer)
 //-------------------------------------------------
 
 chd_error chd_file::write_hunk(UINT32 hunknum, const void *buffer)
+{
+	// drop any cached copy, unless that's what we are writing from
+	cache_entry *entry = cache_find(hunknum);
+	if (entry != NULL && buffer != entry->m_data)
+		entry->m_hunknum = ~0;
+
+	// the map is shared with the read-ahead thread
+	osd_lock_acquire(m_lock);
+	chd_error err = hunk_write(hunknum, buffer);
+	osd_lock_release(m_lock);
+	return err;
+}
+
+
+//-------------------------------------------------
+//  hunk_write - write a single hunk to the CHD
+//  file; the caller must hold the lock
+//-------------------------------------------------
+
+chd_error chd_file::hunk_write(UINT32 hunknum, const void *buffer)
 {
 	// wrap this for clean reporting
 	try
@@ -901,10 +974,6 @@ chd_error chd_file::write_hunk(UINT32 hunknum, const void *buffer)
 			// write the map entry back
 			be_write(rawmap, rawentry, 4);
 			file_write(m_mapoffset + hunknum * 4, rawmap, 4);
-
-			// update the cached hunk if we just wrote it
-			if (hunknum == m_cachehunk && buffer != m_cache)
-				memcpy(m_cache, buffer, m_hunkbytes);
 		}
 
 		// otherwise, just overwrite
@@ -960,27 +1029,39 @@ chd_error chd_file::read_bytes(UINT64 offset, void *buffer, UINT32 bytes)
 		UINT32 startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
 		UINT32 endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
 
-		// if it's a full block, just read directly from disk unless it's the cached hunk
+		// anything in the cache, including completed read-ahead, is a hit
 		chd_error err = CHDERR_NONE;
-		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && curhunk != m_cachehunk)
+		cache_entry *entry = cache_find(curhunk);
+		if (entry != NULL)
+		{
+			m_cachehits++;
+			entry->m_lastuse = ++m_cacheclock;
+			memcpy(dest, &entry->m_data[startoffs], endoffs + 1 - startoffs);
+		}
+
+		// if it's a full block, just read directly from disk
+		else if (startoffs == 0 && endoffs == m_hunkbytes - 1)
+		{
+			m_cachemisses++;
 			err = read_hunk(curhunk, dest);
+		}
 
-		// otherwise, read from the cache
+		// otherwise, read into the least recently used cache entry
 		else
 		{
-			if (curhunk != m_cachehunk)
-			{
-				err = read_hunk(curhunk, m_cache);
-				if (err != CHDERR_NONE)
-					return err;
-				m_cachehunk = curhunk;
-			}
-			memcpy(dest, &m_cache[startoffs], endoffs + 1 - startoffs);
+			m_cachemisses++;
+			entry = &cache_alloc(curhunk);
+			err = read_hunk(curhunk, entry->m_data);
+			if (err != CHDERR_NONE)
+				entry->m_hunknum = ~0;
+			else
+				memcpy(dest, &entry->m_data[startoffs], endoffs + 1 - startoffs);
 		}
 
 		// handle errors and advance
 		if (err != CHDERR_NONE)
 			return err;
+		cache_note_access(curhunk);
 		dest += endoffs + 1 - startoffs;
 	}
 	return CHDERR_NONE;
@@ -1004,23 +1085,28 @@ chd_error chd_file::write_bytes(UINT64 offset, const void *buffer, UINT32 bytes)
 		UINT32 startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
 		UINT32 endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
 
-		// if it's a full block, just write directly to disk unless it's the cached hunk
+		// if it's a full block, just write directly to disk unless it's cached
 		chd_error err = CHDERR_NONE;
-		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && curhunk != m_cachehunk)
+		cache_entry *entry = cache_find(curhunk);
+		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && entry == NULL)
 			err = write_hunk(curhunk, source);
 
 		// otherwise, write from the cache
 		else
 		{
-			if (curhunk != m_cachehunk)
+			if (entry == NULL)
 			{
-				err = read_hunk(curhunk, m_cache);
+				entry = &cache_alloc(curhunk);
+				err = read_hunk(curhunk, entry->m_data);
 				if (err != CHDERR_NONE)
+				{
+					entry->m_hunknum = ~0;
 					return err;
-				m_cachehunk = curhunk;
+				}
 			}
-			memcpy(&m_cache[startoffs], source, endoffs + 1 - startoffs);
-			err = write_hunk(curhunk, m_cache);
+			entry->m_lastuse = ++m_cacheclock;
+			memcpy(&entry->m_data[startoffs], source, endoffs + 1 - startoffs);
+			err = write_hunk(curhunk, entry->m_data);
 		}
 
 		// handle errors and advance
@@ -2084,9 +2170,9 @@ void chd_file::create_open_common()
 	else
 		file_read(m_mapoffset, m_rawmap, m_rawmap.count());
 
-	// allocate the temporary compressed buffer and a buffer for caching
+	// allocate the temporary compressed buffer and the hunk cache
 	m_compressed.resize(m_hunkbytes);
-	m_cache.resize(m_hunkbytes);
+	cache_allocate();
 }
 
 
@@ -2300,6 +2386,184 @@ int CLIB_DECL chd_file::metadata_hash_compare(const void *elem1, const void *ele
 }
 
 
+//-------------------------------------------------
+//  cache_allocate - (re)allocate the hunk cache
+//  for the current hunk size
+//-------------------------------------------------
+
+void chd_file::cache_allocate()
+{
+	m_cache.resize(m_cachehunks);
+	for (int entrynum = 0; entrynum < m_cache.count(); entrynum++)
+	{
+		cache_entry &entry = m_cache[entrynum];
+		entry.m_data.resize(m_hunkbytes);
+		entry.m_hunknum = ~0;
+		entry.m_lastuse = 0;
+		entry.m_osd = NULL;
+		entry.m_chd = this;
+	}
+}
+
+
+//-------------------------------------------------
+//  cache_flush - wait for any outstanding
+//  read-ahead to complete
+//-------------------------------------------------
+
+void chd_file::cache_flush()
+{
+	for (int entrynum = 0; entrynum < m_cache.count(); entrynum++)
+		cache_wait(m_cache[entrynum]);
+}
+
+
+//-------------------------------------------------
+//  cache_index - return the index of the cache
+//  entry holding the given hunk, or -1
+//-------------------------------------------------
+
+int chd_file::cache_index(UINT32 hunknum) const
+{
+	for (int entrynum = 0; entrynum < m_cache.count(); entrynum++)
+		if (m_cache[entrynum].m_hunknum == hunknum)
+			return entrynum;
+	return -1;
+}
+
+
+//-------------------------------------------------
+//  cache_find - return the cache entry holding
+//  the given hunk, waiting for any read-ahead in
+//  progress; returns NULL if not cached
+//-------------------------------------------------
+
+chd_file::cache_entry *chd_file::cache_find(UINT32 hunknum)
+{
+	int entrynum = cache_index(hunknum);
+	if (entrynum == -1)
+		return NULL;
+
+	// a failed read-ahead is simply forgotten; the caller will retry and report it
+	cache_entry &entry = m_cache[entrynum];
+	cache_wait(entry);
+	if (entry.m_hunknum != hunknum)
+		return NULL;
+	return &entry;
+}
+
+
+//-------------------------------------------------
+//  cache_alloc - claim the least recently used
+//  cache entry for the given hunk
+//-------------------------------------------------
+
+chd_file::cache_entry &chd_file::cache_alloc(UINT32 hunknum)
+{
+	// prefer entries that aren't waiting on read-ahead
+	int victim = -1;
+	for (int entrynum = 0; entrynum < m_cache.count(); entrynum++)
+		if (m_cache[entrynum].m_osd == NULL && (victim == -1 || m_cache[entrynum].m_lastuse < m_cache[victim].m_lastuse))
+			victim = entrynum;
+
+	// if everything is in flight, wait for the first one
+	if (victim == -1)
+	{
+		victim = 0;
+		cache_wait(m_cache[victim]);
+	}
+
+	cache_entry &entry = m_cache[victim];
+	entry.m_hunknum = hunknum;
+	entry.m_lastuse = ++m_cacheclock;
+	return entry;
+}
+
+
+//-------------------------------------------------
+//  cache_wait - wait for read-ahead into an entry
+//  to complete; must not be called with the lock
+//  held
+//-------------------------------------------------
+
+void chd_file::cache_wait(cache_entry &entry)
+{
+	if (entry.m_osd == NULL)
+		return;
+
+	while (!osd_work_item_wait(entry.m_osd, osd_ticks_per_second())) ;
+	osd_work_item_release(entry.m_osd);
+	entry.m_osd = NULL;
+	if (entry.m_err != CHDERR_NONE)
+		entry.m_hunknum = ~0;
+}
+
+
+//-------------------------------------------------
+//  cache_note_access - track sequential access
+//  through read_bytes and kick off read-ahead
+//  once a run is detected
+//-------------------------------------------------
+
+void chd_file::cache_note_access(UINT32 hunknum)
+{
+	// repeated partial reads of one hunk don't count
+	if (hunknum == m_lasthunk)
+		return;
+	m_sequential = (hunknum == m_lasthunk + 1) ? m_sequential + 1 : 0;
+	m_lasthunk = hunknum;
+
+	// leave room in the cache for more than just the read-ahead
+	if (m_sequential >= READAHEAD_THRESHOLD && m_cache.count() > READAHEAD_HUNKS)
+		cache_readahead(hunknum);
+}
+
+
+//-------------------------------------------------
+//  cache_readahead - queue decompression of the
+//  hunks following the given one
+//-------------------------------------------------
+
+void chd_file::cache_readahead(UINT32 hunknum)
+{
+	// allocate the queue the first time we need it
+	if (m_readahead_queue == NULL)
+		m_readahead_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+	if (m_readahead_queue == NULL)
+		return;
+
+	for (UINT32 ahead = hunknum + 1; ahead <= hunknum + READAHEAD_HUNKS && ahead < m_hunkcount; ahead++)
+	{
+		// skip anything already cached or in flight
+		if (cache_index(ahead) != -1)
+			continue;
+
+		cache_entry &entry = cache_alloc(ahead);
+		entry.m_err = CHDERR_NONE;
+		entry.m_osd = osd_work_item_queue(m_readahead_queue, async_readahead_static, &entry, 0);
+		if (entry.m_osd == NULL)
+		{
+			entry.m_hunknum = ~0;
+			break;
+		}
+		m_cacheprefetches++;
+	}
+}
+
+
+//-------------------------------------------------
+//  async_readahead_static - decompress a hunk
+//  into a cache entry on the read-ahead queue
+//-------------------------------------------------
+
+void *chd_file::async_readahead_static(void *param, int threadid)
+{
+	cache_entry *entry = reinterpret_cast<cache_entry *>(param);
+	entry->m_err = entry->m_chd->read_hunk(entry->m_hunknum, entry->m_data);
+	return NULL;
+}
+
+
 
 //**************************************************************************
 //  CHD COMPRESSOR
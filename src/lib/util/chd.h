@@ -297,6 +297,11 @@ class chd_file
 	static const UINT32 V5_HEADER_SIZE = 124;
 	static const UINT32 MAX_HEADER_SIZE = V5_HEADER_SIZE;
 
+	// hunk cache parameters
+	static const UINT32 DEFAULT_CACHE_HUNKS = 16;   // hunks kept decompressed by default
+	static const UINT32 READAHEAD_HUNKS = 4;        // hunks to prefetch past a sequential read
+	static const UINT32 READAHEAD_THRESHOLD = 2;    // sequential hunks needed to start prefetching
+
 public:
 	// construction/destruction
 	chd_file();
@@ -320,10 +325,15 @@ public:
 	sha1_t raw_sha1();
 	sha1_t parent_sha1();
 	chd_error hunk_info(UINT32 hunknum, chd_codec_type &compressor, UINT32 &compbytes);
+	UINT32 cache_hunks() const { return m_cachehunks; }
+	UINT64 cache_hits() const { return m_cachehits; }
+	UINT64 cache_misses() const { return m_cachemisses; }
+	UINT64 cache_prefetches() const { return m_cacheprefetches; }
 
 	// setters
 	void set_raw_sha1(sha1_t rawdata);
 	void set_parent_sha1(sha1_t parent);
+	void set_cache_hunks(UINT32 hunks);
 
 	// file create
 	chd_error create(const char *filename, UINT64 logicalbytes, UINT32 hunkbytes, UINT32 unitbytes, chd_codec_type compression[4]);
@@ -370,6 +380,24 @@ private:
 	struct metadata_entry;
 	struct metadata_hash;
 
+	// a single decompressed hunk in the cache
+	struct cache_entry
+	{
+		cache_entry()
+			: m_hunknum(~0),
+				m_lastuse(0),
+				m_osd(NULL),
+				m_chd(NULL),
+				m_err(CHDERR_NONE) { }
+
+		dynamic_buffer      m_data;             // decompressed hunk data
+		UINT32              m_hunknum;          // which hunk is here, or ~0 if none
+		UINT32              m_lastuse;          // cache clock at last use, for LRU replacement
+		osd_work_item *     m_osd;              // pending read-ahead, or NULL if none
+		chd_file *          m_chd;              // pointer back to the owning file
+		chd_error           m_err;              // result of the read-ahead
+	};
+
 	// inline helpers
 	UINT64 be_read(const UINT8 *base, int numbytes);
 	void be_write(UINT8 *base, UINT64 value, int numbytes);
@@ -394,10 +422,21 @@ private:
 	void hunk_write_compressed(UINT32 hunknum, INT8 compression, const UINT8 *compressed, UINT32 complength, crc16_t crc16);
 	void hunk_copy_from_self(UINT32 hunknum, UINT32 otherhunk);
 	void hunk_copy_from_parent(UINT32 hunknum, UINT64 parentunit);
+	chd_error hunk_read(UINT32 hunknum, void *buffer);
+	chd_error hunk_write(UINT32 hunknum, const void *buffer);
 	bool metadata_find(chd_metadata_tag metatag, INT32 metaindex, metadata_entry &metaentry, bool resume = false);
 	void metadata_set_previous_next(UINT64 prevoffset, UINT64 nextoffset);
 	void metadata_update_hash();
 	static int CLIB_DECL metadata_hash_compare(const void *elem1, const void *elem2);
+	void cache_allocate();
+	void cache_flush();
+	int cache_index(UINT32 hunknum) const;
+	cache_entry *cache_find(UINT32 hunknum);
+	cache_entry &cache_alloc(UINT32 hunknum);
+	void cache_wait(cache_entry &entry);
+	void cache_note_access(UINT32 hunknum);
+	void cache_readahead(UINT32 hunknum);
+	static void *async_readahead_static(void *param, int threadid);
 
 	// file characteristics
 	core_file *             m_file;             // handle to the open core file
@@ -434,8 +473,16 @@ private:
 	dynamic_buffer          m_compressed;       // temporary buffer for compressed data
 
 	// caching
-	dynamic_buffer          m_cache;            // single-hunk cache for partial reads/writes
-	UINT32                  m_cachehunk;        // which hunk is in the cache?
+	osd_lock *              m_lock;             // serializes file and codec access with read-ahead
+	dynamic_array<cache_entry> m_cache;         // LRU cache of decompressed hunks
+	UINT32                  m_cachehunks;       // number of hunks to keep in the cache
+	UINT32                  m_cacheclock;       // clock used to stamp cache entries
+	UINT32                  m_lasthunk;         // last hunk accessed through read_bytes
+	UINT32                  m_sequential;       // number of sequential hunks accessed in a row
+	osd_work_queue *        m_readahead_queue;  // I/O queue for read-ahead, allocated on demand
+	UINT64                  m_cachehits;        // requests satisfied from the cache
+	UINT64                  m_cachemisses;      // requests that had to read the file
+	UINT64                  m_cacheprefetches;  // hunks queued for read-ahead
 };
 
 
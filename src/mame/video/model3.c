@@ -27,7 +27,7 @@ class model3_renderer : public poly_manager<float, model3_polydata, 6, 50000>
 {
 public:
 	model3_renderer(model3_state &state, int width, int height)
-		: poly_manager<float, model3_polydata, 6, 50000>(state.machine())
+		: poly_manager<float, model3_polydata, 6, 50000>(state.machine(), POLYFLAG_TILE_BINNING)
 	{
 		m_fb = auto_bitmap_rgb32_alloc(state.machine(), width, height);
 		m_zb = auto_bitmap_ind32_alloc(state.machine(), width, height);
@@ -0,0 +1,1060 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+//============================================================
+//
+//  work_steal.c - work stealing OSD core work item functions
+//
+//  Copyright (c) 1996-2010, Nicola Salmoria and the MAME Team.
+//  Visit http://mamedev.org for licensing and usage restrictions.
+//
+//  Drop-in replacement for work_osd.c. Items queued from any
+//  thread land in a shared injection list; each worker pulls
+//  a batch of them into its own Chase-Lev deque, pops from
+//  the bottom of it without taking any lock, and steals from
+//  the top of its siblings' deques once it runs dry. Idle
+//  workers spin for an adaptive interval before parking on
+//  their wake event.
+//
+//============================================================
+
+#if defined(OSD_WINDOWS)
+// standard windows headers
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <process.h>
+#include <tchar.h>
+#include <stdlib.h>
+
+#ifdef __GNUC__
+#include <stdint.h>
+#endif
+#endif
+
+// MAME headers
+#include "osdcore.h"
+
+#include "modules/sync/osdsync.h"
+#include "modules/lib/osdlib.h"
+
+#include "eminline.h"
+
+#if defined(OSD_SDL)
+#include "osinline.h"
+#endif
+
+#if defined(SDLMAME_MACOSX)
+#include "osxutils.h"
+#endif
+
+#if defined(OSD_SDL)
+typedef void *PVOID;
+#endif
+
+//============================================================
+//  DEBUGGING
+//============================================================
+
+#define KEEP_STATISTICS         (0)
+
+//============================================================
+//  PARAMETERS
+//============================================================
+
+#define ENV_PROCESSORS               "OSDPROCESSORS"
+#define ENV_WORKQUEUEMAXTHREADS      "OSDWORKQUEUEMAXTHREADS"
+
+#define SPIN_LOOP_TIME          (osd_ticks_per_second() / 10000)
+
+// deque size must be a power of 2; a worker only refills an empty
+// deque, and never with more than half of it (see deque_push)
+#define DEQUE_SIZE              (256)
+#define DEQUE_MASK              (DEQUE_SIZE - 1)
+#define DEQUE_BATCH             (DEQUE_SIZE / 2)
+
+//============================================================
+//  MACROS
+//============================================================
+
+#if KEEP_STATISTICS
+#define add_to_stat(v,x)        do { atomic_add32((v), (x)); } while (0)
+#define begin_timing(v)         do { (v) -= get_profile_ticks(); } while (0)
+#define end_timing(v)           do { (v) += get_profile_ticks(); } while (0)
+#else
+#define add_to_stat(v,x)        do { } while (0)
+#define begin_timing(v)         do { } while (0)
+#define end_timing(v)           do { } while (0)
+#endif
+
+#if defined(OSD_WINDOWS)
+#define spin_pause()            YieldProcessor()
+#elif defined(OSD_SDL) && (defined(__i386__) || defined(__x86_64__) || defined(__ppc__) || defined (__PPC__) || defined(__ppc64__) || defined(__PPC64__))
+#define spin_pause()            osd_yield_processor()
+#else
+#define spin_pause()            do { } while (0)
+#endif
+
+
+//============================================================
+//  TYPE DEFINITIONS
+//============================================================
+
+// top and bottom are free-running; only their difference is
+// meaningful, so all arithmetic on them is done unsigned
+struct work_deque
+{
+	volatile INT32      top;            // next slot thieves take from
+	volatile INT32      bottom;         // next slot the owner pushes to
+	osd_work_item * volatile slot[DEQUE_SIZE];
+};
+
+
+struct work_thread_info
+{
+	osd_work_queue *    queue;          // pointer back to the queue
+	osd_thread *        handle;         // handle to the thread
+	osd_event *         wakeevent;      // wake event for the thread
+	volatile INT32      parked;         // are we blocked on the wake event?
+	osd_ticks_t         spinlimit;      // how long to spin before parking
+	INT32               completed;      // items done but not yet taken off queue->items
+	work_deque          deque;          // our own work
+
+#if KEEP_STATISTICS
+	INT32               itemsdone;
+	INT32               steals;
+	INT32               refills;
+	INT32               parks;
+	osd_ticks_t         actruntime;
+	osd_ticks_t         runtime;
+	osd_ticks_t         spintime;
+	osd_ticks_t         waittime;
+#endif
+};
+
+
+struct osd_work_queue
+{
+	osd_scalable_lock * lock;           // lock for the injection list and item events
+	osd_work_item * volatile list;      // injection list of items not yet taken by a worker
+	osd_work_item ** volatile tailptr;  // pointer to the tail pointer of the injection list
+	INT32               listcount;      // number of items in the injection list
+	osd_work_item * volatile free;      // free list of work items
+	volatile INT32      items;          // items in the queue
+	volatile INT32      parked;         // number of parked threads
+	volatile INT32      waiting;        // is someone waiting on the queue to complete?
+	volatile INT32      exiting;        // should the threads exit on their next opportunity?
+	UINT32              threads;        // number of threads in this queue
+	UINT32              flags;          // creation flags
+	osd_ticks_t         minspin;        // bounds for the adaptive spin time
+	osd_ticks_t         maxspin;
+	work_thread_info *  thread;         // array of thread information
+	osd_event   *       doneevent;      // event signalled when work is complete
+
+#if KEEP_STATISTICS
+	volatile INT32      itemsqueued;    // total items queued
+	volatile INT32      setevents;      // number of times we called SetEvent
+	volatile INT32      wakeups;        // number of parked threads woken
+#endif
+};
+
+
+struct osd_work_item
+{
+	osd_work_item *     next;           // pointer to next item
+	osd_work_queue *    queue;          // pointer back to the owning queue
+	osd_work_callback   callback;       // callback function
+	void *              param;          // callback parameter
+	void *              result;         // callback result
+	osd_event *         event;          // event signalled when complete
+	UINT32              flags;          // creation flags
+	volatile INT32      done;           // is the item done?
+};
+
+//============================================================
+//  GLOBAL VARIABLES
+//============================================================
+
+int osd_num_processors = 0;
+
+//============================================================
+//  FUNCTION PROTOTYPES
+//============================================================
+
+static int effective_num_processors(void);
+static void * worker_thread_entry(void *param);
+static void worker_thread_process(osd_work_queue *queue, work_thread_info *thread);
+static void helper_thread_process(osd_work_queue *queue, int threadid);
+static void wake_threads(osd_work_queue *queue, int count);
+
+
+//============================================================
+//  memory_barrier - full fence built from the
+//  atomics in eminline.h, which don't provide a
+//  bare one
+//============================================================
+
+INLINE void memory_barrier(void)
+{
+	INT32 volatile fence = 0;
+	atomic_exchange32(&fence, 0);
+}
+
+
+//============================================================
+//  deque_push - owner adds a batch of items to the
+//  bottom of its (empty) deque and publishes them
+//  with a single store
+//============================================================
+
+static void deque_push(work_deque *deque, osd_work_item **items, int count)
+{
+	UINT32 bottom = deque->bottom;
+
+	// the deque is empty when we get here and count <= DEQUE_BATCH, so a
+	// thief still holding a stale top can never see one of its slots reused
+	for (int itemnum = 0; itemnum < count; itemnum++)
+		deque->slot[(bottom + itemnum) & DEQUE_MASK] = items[itemnum];
+	atomic_exchange32(&deque->bottom, bottom + count);
+}
+
+
+//============================================================
+//  deque_pop - owner takes the most recently
+//  pushed item; only the last item is contended
+//============================================================
+
+static osd_work_item *deque_pop(work_deque *deque)
+{
+	UINT32 bottom = (UINT32)deque->bottom - 1;
+	atomic_exchange32(&deque->bottom, bottom);
+	UINT32 top = deque->top;
+	INT32 size = (INT32)(bottom - top);
+
+	// empty: put bottom back
+	if (size < 0)
+	{
+		deque->bottom = top;
+		return NULL;
+	}
+
+	osd_work_item *item = deque->slot[bottom & DEQUE_MASK];
+	if (size > 0)
+		return item;
+
+	// last item: race the thieves for it
+	if (compare_exchange32(&deque->top, top, top + 1) != (INT32)top)
+		item = NULL;
+	deque->bottom = top + 1;
+	return item;
+}
+
+
+//============================================================
+//  deque_steal - take the oldest item from another
+//  thread's deque
+//============================================================
+
+static osd_work_item *deque_steal(work_deque *deque)
+{
+	UINT32 top = deque->top;
+	memory_barrier();
+	UINT32 bottom = deque->bottom;
+	if ((INT32)(bottom - top) <= 0)
+		return NULL;
+
+	memory_barrier();
+	osd_work_item *item = deque->slot[top & DEQUE_MASK];
+	if (compare_exchange32(&deque->top, top, top + 1) != (INT32)top)
+		return NULL;
+	return item;
+}
+
+
+//============================================================
+//  deque_empty
+//============================================================
+
+INLINE bool deque_empty(const work_deque *deque)
+{
+	return (INT32)((UINT32)deque->bottom - (UINT32)deque->top) <= 0;
+}
+
+
+//============================================================
+//  osd_work_queue_alloc
+//============================================================
+
+osd_work_queue *osd_work_queue_alloc(int flags)
+{
+	int threadnum;
+	int numprocs = effective_num_processors();
+	osd_work_queue *queue;
+	int osdthreadnum = 0;
+	int allocthreadnum;
+	char *osdworkqueuemaxthreads = osd_getenv(ENV_WORKQUEUEMAXTHREADS);
+
+	// allocate a new queue
+	queue = (osd_work_queue *)osd_malloc(sizeof(*queue));
+	if (queue == NULL)
+		goto error;
+	memset(queue, 0, sizeof(*queue));
+
+	// initialize basic queue members
+	queue->tailptr = (osd_work_item **)&queue->list;
+	queue->flags = flags;
+
+	// high frequency queues may spin for longer before parking
+	queue->minspin = (flags & WORK_QUEUE_FLAG_HIGH_FREQ) ? SPIN_LOOP_TIME / 8 : 0;
+	queue->maxspin = (flags & WORK_QUEUE_FLAG_HIGH_FREQ) ? SPIN_LOOP_TIME * 8 : SPIN_LOOP_TIME;
+
+	// allocate events for the queue
+	queue->doneevent = osd_event_alloc(TRUE, TRUE);     // manual reset, signalled
+	if (queue->doneevent == NULL)
+		goto error;
+
+	// initialize the critical section
+	queue->lock = osd_scalable_lock_alloc();
+	if (queue->lock == NULL)
+		goto error;
+
+	// determine how many threads to create...
+	// on a single-CPU system, create 1 thread for I/O queues, and 0 threads for everything else
+	if (numprocs == 1)
+		threadnum = (flags & WORK_QUEUE_FLAG_IO) ? 1 : 0;
+	// on an n-CPU system, create n-1 threads for multi queues, and 1 thread for everything else
+	else
+		threadnum = (flags & WORK_QUEUE_FLAG_MULTI) ? (numprocs - 1) : 1;
+
+	if (osdworkqueuemaxthreads != NULL && sscanf(osdworkqueuemaxthreads, "%d", &osdthreadnum) == 1 && threadnum > osdthreadnum)
+		threadnum = osdthreadnum;
+
+	// clamp to the maximum; the thread that waits on a multi queue helps
+	// out as thread number 'threads', and callbacks index per-thread
+	// arrays of WORK_MAX_THREADS entries by that number
+	queue->threads = MIN(threadnum, (flags & WORK_QUEUE_FLAG_MULTI) ? WORK_MAX_THREADS - 1 : WORK_MAX_THREADS);
+
+	// allocate memory for thread array (+1 for the calling thread)
+	allocthreadnum = queue->threads + 1;
+
+#if KEEP_STATISTICS
+	printf("osdprocs: %d effecprocs: %d threads: %d allocthreads: %d osdthreads: %d maxthreads: %d queuethreads: %d\n", osd_num_processors, numprocs, threadnum, allocthreadnum, osdthreadnum, WORK_MAX_THREADS, queue->threads);
+#endif
+
+	queue->thread = (work_thread_info *)osd_malloc_array(allocthreadnum * sizeof(queue->thread[0]));
+	if (queue->thread == NULL)
+		goto error;
+	memset(queue->thread, 0, allocthreadnum * sizeof(queue->thread[0]));
+
+	// iterate over threads
+	for (threadnum = 0; threadnum < queue->threads; threadnum++)
+	{
+		work_thread_info *thread = &queue->thread[threadnum];
+
+		// set a pointer back to the queue
+		thread->queue = queue;
+		thread->spinlimit = queue->maxspin;
+
+		// create the per-thread wake event
+		thread->wakeevent = osd_event_alloc(FALSE, FALSE);  // auto-reset, not signalled
+		if (thread->wakeevent == NULL)
+			goto error;
+
+		// create the thread
+		thread->handle = osd_thread_create(worker_thread_entry, thread);
+		if (thread->handle == NULL)
+			goto error;
+
+		// set its priority: I/O threads get high priority because they are assumed to be
+		// blocked most of the time; other threads just match the creator's priority
+		if (flags & WORK_QUEUE_FLAG_IO)
+			osd_thread_adjust_priority(thread->handle, 1);
+		else
+			osd_thread_adjust_priority(thread->handle, 0);
+	}
+
+	// start a timer going for "waittime" on the main thread
+	begin_timing(queue->thread[queue->threads].waittime);
+	return queue;
+
+error:
+	osd_work_queue_free(queue);
+	return NULL;
+}
+
+
+//============================================================
+//  osd_work_queue_items
+//============================================================
+
+int osd_work_queue_items(osd_work_queue *queue)
+{
+	// return the number of items currently in the queue
+	return queue->items;
+}
+
+
+//============================================================
+//  osd_work_queue_wait
+//============================================================
+
+int osd_work_queue_wait(osd_work_queue *queue, osd_ticks_t timeout)
+{
+	// if no threads, no waiting
+	if (queue->threads == 0)
+		return TRUE;
+
+	// if no items, we're done
+	if (queue->items == 0)
+		return TRUE;
+
+	// if this is a multi queue, help out rather than doing nothing
+	if (queue->flags & WORK_QUEUE_FLAG_MULTI)
+	{
+		end_timing(queue->thread[queue->threads].waittime);
+
+		// process what we can as a thief; we have no deque of our own
+		helper_thread_process(queue, queue->threads);
+
+		// if we're a high frequency queue, spin until done
+		if (queue->flags & WORK_QUEUE_FLAG_HIGH_FREQ && queue->items != 0)
+		{
+			osd_ticks_t stopspin = osd_ticks() + timeout;
+
+			// spin until we're done
+			begin_timing(thread->spintime);
+			while (queue->items != 0 && osd_ticks() < stopspin)
+				for (int spin = 0; spin < 1000 && queue->items != 0; spin++)
+					spin_pause();
+			end_timing(thread->spintime);
+
+			begin_timing(thread->waittime);
+			return (queue->items == 0);
+		}
+		begin_timing(thread->waittime);
+	}
+
+	// reset our done event and double-check the items before waiting
+	osd_event_reset(queue->doneevent);
+	atomic_exchange32(&queue->waiting, TRUE);
+	if (queue->items != 0)
+		osd_event_wait(queue->doneevent, timeout);
+	atomic_exchange32(&queue->waiting, FALSE);
+
+	// return TRUE if we actually hit 0
+	return (queue->items == 0);
+}
+
+
+//============================================================
+//  osd_work_queue_free
+//============================================================
+
+void osd_work_queue_free(osd_work_queue *queue)
+{
+	// if we have threads, clean them up
+	if (queue->thread != NULL)
+	{
+		int threadnum;
+
+		// stop the timer for "waittime" on the main thread
+		end_timing(queue->thread[queue->threads].waittime);
+
+		// signal all the threads to exit
+		atomic_exchange32(&queue->exiting, TRUE);
+		for (threadnum = 0; threadnum < queue->threads; threadnum++)
+		{
+			work_thread_info *thread = &queue->thread[threadnum];
+			if (thread->wakeevent != NULL)
+				osd_event_set(thread->wakeevent);
+		}
+
+		// wait for all the threads to go away
+		for (threadnum = 0; threadnum < queue->threads; threadnum++)
+		{
+			work_thread_info *thread = &queue->thread[threadnum];
+
+			// block on the thread going away, then close the handle
+			if (thread->handle != NULL)
+			{
+				osd_thread_wait_free(thread->handle);
+			}
+
+			// clean up the wake event
+			if (thread->wakeevent != NULL)
+				osd_event_free(thread->wakeevent);
+
+			// free anything still sitting in the deque
+			osd_work_item *item;
+			while ((item = deque_pop(&thread->deque)) != NULL)
+			{
+				if (item->event != NULL)
+					osd_event_free(item->event);
+				osd_free(item);
+			}
+		}
+
+#if KEEP_STATISTICS
+		// output per-thread statistics
+		for (threadnum = 0; threadnum <= queue->threads; threadnum++)
+		{
+			work_thread_info *thread = &queue->thread[threadnum];
+			osd_ticks_t total = thread->runtime + thread->waittime + thread->spintime;
+			printf("Thread %d:  items=%9d steals=%9d refills=%9d parks=%9d run=%5.2f%% (%5.2f%%)  spin=%5.2f%%  wait/other=%5.2f%% total=%9d\n",
+					threadnum, thread->itemsdone, thread->steals, thread->refills, thread->parks,
+					(double)thread->runtime * 100.0 / (double)total,
+					(double)thread->actruntime * 100.0 / (double)total,
+					(double)thread->spintime * 100.0 / (double)total,
+					(double)thread->waittime * 100.0 / (double)total,
+					(UINT32) total);
+		}
+#endif
+	}
+
+	// free the list
+	if (queue->thread != NULL)
+		osd_free(queue->thread);
+
+	// free all the events
+	if (queue->doneevent != NULL)
+		osd_event_free(queue->doneevent);
+
+	// free all items in the free list
+	while (queue->free != NULL)
+	{
+		osd_work_item *item = (osd_work_item *)queue->free;
+		queue->free = item->next;
+		if (item->event != NULL)
+			osd_event_free(item->event);
+		osd_free(item);
+	}
+
+	// free all items in the injection list
+	while (queue->list != NULL)
+	{
+		osd_work_item *item = (osd_work_item *)queue->list;
+		queue->list = item->next;
+		if (item->event != NULL)
+			osd_event_free(item->event);
+		osd_free(item);
+	}
+
+#if KEEP_STATISTICS
+	printf("Items queued   = %9d\n", queue->itemsqueued);
+	printf("SetEvent calls = %9d\n", queue->setevents);
+	printf("Wakeups        = %9d\n", queue->wakeups);
+#endif
+
+	if (queue->lock != NULL)
+		osd_scalable_lock_free(queue->lock);
+	// free the queue itself
+	osd_free(queue);
+}
+
+
+//============================================================
+//  osd_work_item_queue_multiple
+//============================================================
+
+osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_callback callback, INT32 numitems, void *parambase, INT32 paramstep, UINT32 flags)
+{
+	osd_work_item *itemlist = NULL, *lastitem = NULL;
+	osd_work_item **item_tailptr = &itemlist;
+	osd_work_item *freelist;
+	INT32 lockslot;
+	int itemnum;
+
+	// grab the whole free list at once; taking everything sidesteps the
+	// ABA problem of popping single items, and we hand back the rest below
+	do
+	{
+		freelist = (osd_work_item *)queue->free;
+	} while (freelist != NULL && compare_exchange_ptr((PVOID volatile *)&queue->free, freelist, NULL) != freelist);
+
+	// loop over items, building up a local list of work
+	for (itemnum = 0; itemnum < numitems; itemnum++)
+	{
+		osd_work_item *item = freelist;
+
+		// first allocate a new work item; try the free list first
+		if (item != NULL)
+		{
+			freelist = item->next;
+			atomic_exchange32(&item->done, FALSE); // needs to be set this way to prevent data race/usage of uninitialized memory on Linux
+		}
+
+		// if nothing, allocate something new
+		else
+		{
+			// allocate the item
+			item = (osd_work_item *)osd_malloc(sizeof(*item));
+			if (item == NULL)
+				return NULL;
+			item->event = NULL;
+			item->queue = queue;
+			item->done = FALSE;
+		}
+
+		// fill in the basics
+		item->next = NULL;
+		item->callback = callback;
+		item->param = parambase;
+		item->result = NULL;
+		item->flags = flags;
+
+		// advance to the next
+		lastitem = item;
+		*item_tailptr = item;
+		item_tailptr = &item->next;
+		parambase = (UINT8 *)parambase + paramstep;
+	}
+
+	// return any leftovers to the free list in one go
+	if (freelist != NULL)
+	{
+		osd_work_item *freetail = freelist, *next;
+		while (freetail->next != NULL)
+			freetail = freetail->next;
+		do
+		{
+			next = (osd_work_item *)queue->free;
+			freetail->next = next;
+		} while (compare_exchange_ptr((PVOID volatile *)&queue->free, next, freelist) != next);
+	}
+
+	// enqueue the whole thing within the critical section
+	lockslot = osd_scalable_lock_acquire(queue->lock);
+	*queue->tailptr = itemlist;
+	queue->tailptr = item_tailptr;
+	queue->listcount += numitems;
+	osd_scalable_lock_release(queue->lock, lockslot);
+
+	// increment the number of items in the queue; this also orders the
+	// list update above against our check of the parked threads below
+	atomic_add32(&queue->items, numitems);
+	add_to_stat(&queue->itemsqueued, numitems);
+
+	// wake parked threads to do the work; each one that takes a batch
+	// wakes another if there is still something left to steal
+	wake_threads(queue, 1);
+
+	// if no threads, run the queue now on this thread
+	if (queue->threads == 0)
+	{
+		end_timing(queue->thread[0].waittime);
+		helper_thread_process(queue, 0);
+		begin_timing(queue->thread[0].waittime);
+	}
+	// only return the item if it won't get released automatically
+	return (flags & WORK_ITEM_FLAG_AUTO_RELEASE) ? NULL : lastitem;
+}
+
+
+//============================================================
+//  osd_work_item_wait
+//============================================================
+
+int osd_work_item_wait(osd_work_item *item, osd_ticks_t timeout)
+{
+	// if we're done already, just return
+	if (item->done)
+		return TRUE;
+
+	// if we don't have an event, create one
+	if (item->event == NULL)
+	{
+		INT32 lockslot = osd_scalable_lock_acquire(item->queue->lock);
+		item->event = osd_event_alloc(TRUE, FALSE);     // manual reset, not signalled
+		osd_scalable_lock_release(item->queue->lock, lockslot);
+	}
+	else
+		osd_event_reset(item->event);
+
+	// if we don't have an event, we need to spin (shouldn't ever really happen)
+	if (item->event == NULL)
+	{
+		osd_ticks_t stopspin = osd_ticks() + timeout;
+		while (!item->done && osd_ticks() < stopspin)
+			spin_pause();
+	}
+
+	// otherwise, block on the event until done
+	else if (!item->done)
+		osd_event_wait(item->event, timeout);
+
+	// return TRUE if the refcount actually hit 0
+	return item->done;
+}
+
+
+//============================================================
+//  osd_work_item_result
+//============================================================
+
+void *osd_work_item_result(osd_work_item *item)
+{
+	return item->result;
+}
+
+
+//============================================================
+//  osd_work_item_release
+//============================================================
+
+void osd_work_item_release(osd_work_item *item)
+{
+	osd_work_item *next;
+
+	// make sure we're done first
+	osd_work_item_wait(item, 100 * osd_ticks_per_second());
+
+	// add us to the free list on our queue
+	do
+	{
+		next = (osd_work_item *)item->queue->free;
+		item->next = next;
+	} while (compare_exchange_ptr((PVOID volatile *)&item->queue->free, next, item) != next);
+}
+
+
+//============================================================
+//  effective_num_processors
+//============================================================
+
+static int effective_num_processors(void)
+{
+	int physprocs = osd_get_num_processors();
+
+	// osd_num_processors == 0 for 'auto'
+	if (osd_num_processors > 0)
+	{
+		return MIN(4 * physprocs, osd_num_processors);
+	}
+	else
+	{
+		char *procsoverride;
+		int numprocs = 0;
+
+		// if the OSDPROCESSORS environment variable is set, use that value if valid
+		// note that we permit more than the real number of processors for testing
+		procsoverride = osd_getenv(ENV_PROCESSORS);
+		if (procsoverride != NULL && sscanf(procsoverride, "%d", &numprocs) == 1 && numprocs > 0)
+			return MIN(4 * physprocs, numprocs);
+
+		// otherwise, return the info from the system
+		return physprocs;
+	}
+}
+
+
+//============================================================
+//  wake_threads - wake up to 'count' parked
+//  threads
+//============================================================
+
+static void wake_threads(osd_work_queue *queue, int count)
+{
+	if (queue->parked == 0)
+		return;
+
+	for (int threadnum = 0; threadnum < queue->threads && count > 0; threadnum++)
+	{
+		work_thread_info *thread = &queue->thread[threadnum];
+
+		// whoever clears the parked flag owns the wakeup
+		if (thread->parked && compare_exchange32(&thread->parked, TRUE, FALSE) == TRUE)
+		{
+			atomic_decrement32(&queue->parked);
+			osd_event_set(thread->wakeevent);
+			add_to_stat(&queue->wakeups, 1);
+			count--;
+		}
+	}
+}
+
+
+//============================================================
+//  queue_has_work - is there anything we could
+//  take or steal?
+//============================================================
+
+static bool queue_has_work(osd_work_queue *queue)
+{
+	if (queue->list != NULL)
+		return true;
+	for (int threadnum = 0; threadnum < queue->threads; threadnum++)
+		if (!deque_empty(&queue->thread[threadnum].deque))
+			return true;
+	return false;
+}
+
+
+//============================================================
+//  take_from_list - remove up to 'maxitems' from
+//  the injection list
+//============================================================
+
+static int take_from_list(osd_work_queue *queue, osd_work_item **items, int maxitems)
+{
+	int count = 0;
+
+	if (queue->list == NULL)
+		return 0;
+
+	INT32 lockslot = osd_scalable_lock_acquire(queue->lock);
+	if (maxitems > queue->listcount)
+		maxitems = queue->listcount;
+	while (count < maxitems)
+	{
+		osd_work_item *item = (osd_work_item *)queue->list;
+		queue->list = item->next;
+		items[count++] = item;
+	}
+	if (queue->list == NULL)
+		queue->tailptr = (osd_work_item **)&queue->list;
+	queue->listcount -= count;
+	osd_scalable_lock_release(queue->lock, lockslot);
+
+	return count;
+}
+
+
+//============================================================
+//  steal_item - try each other thread's deque in
+//  turn, starting with our neighbour
+//============================================================
+
+static osd_work_item *steal_item(osd_work_queue *queue, int threadid)
+{
+	for (int offset = 1; offset <= queue->threads; offset++)
+	{
+		int victim = (threadid + offset) % (queue->threads + 1);
+		if (victim == queue->threads)
+			continue;
+		osd_work_item *item = deque_steal(&queue->thread[victim].deque);
+		if (item != NULL)
+			return item;
+	}
+	return NULL;
+}
+
+
+//============================================================
+//  retire_items - take finished items off the
+//  queue count, waking a waiter if it hit zero
+//============================================================
+
+static void retire_items(osd_work_queue *queue, INT32 count)
+{
+	if (count != 0 && atomic_add32(&queue->items, -count) == 0 && queue->waiting)
+	{
+		osd_event_set(queue->doneevent);
+		add_to_stat(&queue->setevents, 1);
+	}
+}
+
+
+//============================================================
+//  execute_item - run one item and signal its
+//  completion; the caller retires it
+//============================================================
+
+static void execute_item(osd_work_item *item, work_thread_info *thread, int threadid)
+{
+	// call the callback and stash the result
+	begin_timing(thread->actruntime);
+	item->result = (*item->callback)(item->param, threadid);
+	end_timing(thread->actruntime);
+
+	atomic_exchange32(&item->done, TRUE);
+	add_to_stat(&thread->itemsdone, 1);
+
+	// if it's an auto-release item, release it
+	if (item->flags & WORK_ITEM_FLAG_AUTO_RELEASE)
+		osd_work_item_release(item);
+
+	// set the result and signal the event
+	else
+	{
+		INT32 lockslot = osd_scalable_lock_acquire(item->queue->lock);
+		if (item->event != NULL)
+		{
+			osd_event_set(item->event);
+			add_to_stat(&item->queue->setevents, 1);
+		}
+		osd_scalable_lock_release(item->queue->lock, lockslot);
+	}
+}
+
+
+//============================================================
+//  find_work - pop our own deque, refill it from
+//  the injection list, or steal
+//============================================================
+
+static osd_work_item *find_work(osd_work_queue *queue, work_thread_info *thread)
+{
+	int threadid = thread - queue->thread;
+
+	osd_work_item *item = deque_pop(&thread->deque);
+	if (item != NULL)
+		return item;
+
+	// our deque is dry; settle up the item count before looking elsewhere
+	retire_items(queue, thread->completed);
+	thread->completed = 0;
+
+	// take a fair share of the injection list: one to run now, the rest
+	// into our deque for us to pop and the others to steal
+	if (queue->list != NULL)
+	{
+		osd_work_item *batch[DEQUE_BATCH + 1];
+		int share = (queue->listcount + queue->threads) / (queue->threads + 1);
+		int count = take_from_list(queue, batch, MAX(1, MIN(share, DEQUE_BATCH + 1)));
+		if (count != 0)
+		{
+			add_to_stat(&thread->refills, 1);
+			if (count > 1)
+			{
+				deque_push(&thread->deque, &batch[1], count - 1);
+				wake_threads(queue, 1);
+			}
+			return batch[0];
+		}
+	}
+
+	// then try the other threads
+	item = steal_item(queue, threadid);
+	if (item != NULL)
+		add_to_stat(&thread->steals, 1);
+	return item;
+}
+
+
+//============================================================
+//  worker_thread_entry
+//============================================================
+
+static void *worker_thread_entry(void *param)
+{
+	work_thread_info *thread = (work_thread_info *)param;
+	osd_work_queue *queue = thread->queue;
+
+#if defined(SDLMAME_MACOSX)
+	void *arp = NewAutoreleasePool();
+#endif
+
+	// loop until we exit
+	for ( ;; )
+	{
+		// process as much as we can
+		worker_thread_process(queue, thread);
+
+		if (queue->exiting)
+			break;
+
+		// spin for a while looking for more work; grow the spin time when it
+		// pays off and shrink it when it doesn't, so bursty queues keep their
+		// threads warm while idle ones park quickly
+		begin_timing(thread->spintime);
+		osd_ticks_t stopspin = osd_ticks() + thread->spinlimit;
+		bool found = false;
+		do
+		{
+			for (int spin = 0; spin < 1000 && !(found = queue_has_work(queue)); spin++)
+				spin_pause();
+		} while (!found && !queue->exiting && osd_ticks() < stopspin);
+		end_timing(thread->spintime);
+
+		if (found)
+		{
+			thread->spinlimit = MIN(MAX(thread->spinlimit * 2, 1), queue->maxspin);
+			continue;
+		}
+		thread->spinlimit = MAX(thread->spinlimit / 2, queue->minspin);
+
+		// park: announce it first, then look once more so that a concurrent
+		// osd_work_item_queue_multiple either sees us parked or we see its work
+		atomic_exchange32(&thread->parked, TRUE);
+		atomic_increment32(&queue->parked);
+		if (queue_has_work(queue) || queue->exiting)
+		{
+			if (compare_exchange32(&thread->parked, TRUE, FALSE) == TRUE)
+				atomic_decrement32(&queue->parked);
+			continue;
+		}
+
+		add_to_stat(&thread->parks, 1);
+		begin_timing(thread->waittime);
+		osd_event_wait(thread->wakeevent, OSD_EVENT_WAIT_INFINITE);
+		end_timing(thread->waittime);
+
+		// a stale wakeup may leave us flagged as parked
+		if (compare_exchange32(&thread->parked, TRUE, FALSE) == TRUE)
+			atomic_decrement32(&queue->parked);
+
+		if (queue->exiting)
+			break;
+	}
+
+#if defined(SDLMAME_MACOSX)
+	ReleaseAutoreleasePool(arp);
+#endif
+
+	return NULL;
+}
+
+
+//============================================================
+//  worker_thread_process
+//============================================================
+
+static void worker_thread_process(osd_work_queue *queue, work_thread_info *thread)
+{
+	int threadid = thread - queue->thread;
+
+	begin_timing(thread->runtime);
+
+	// loop until there's nothing left to take or steal; find_work settles
+	// our completed count before it returns empty-handed
+	osd_work_item *item;
+	while ((item = find_work(queue, thread)) != NULL)
+	{
+		execute_item(item, thread, threadid);
+		thread->completed++;
+	}
+
+	end_timing(thread->runtime);
+}
+
+
+//============================================================
+//  helper_thread_process - process items on a
+//  thread that owns no deque: the waiter on a
+//  multi queue, or the caller when there are no
+//  worker threads
+//============================================================
+
+static void helper_thread_process(osd_work_queue *queue, int threadid)
+{
+	work_thread_info *thread = &queue->thread[threadid];
+
+	begin_timing(thread->runtime);
+
+	// loop until everything is processed
+	for ( ;; )
+	{
+		osd_work_item *item;
+
+		if (take_from_list(queue, &item, 1) == 0)
+		{
+			item = steal_item(queue, threadid);
+			if (item == NULL)
+				break;
+			add_to_stat(&thread->steals, 1);
+		}
+
+		execute_item(item, thread, threadid);
+		retire_items(queue, 1);
+	}
+
+	end_timing(thread->runtime);
+}
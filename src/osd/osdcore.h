@@ -814,6 +814,27 @@ void osd_free_executable(void *ptr, size_t size);
 void osd_break_into_debugger(const char *message);
 
 
+/*-----------------------------------------------------------------------------
+    osd_get_peak_memory_usage: return the peak amount of physical memory
+        used by the current process
+
+    Parameters:
+
+        None.
+
+    Return value:
+
+        The high-water mark of the process's resident set size in bytes,
+        or 0 if the host cannot report it.
+
+    Notes:
+
+        This is a process-wide figure; it never decreases, even if a later
+        emulation session uses less memory than an earlier one.
+-----------------------------------------------------------------------------*/
+UINT64 osd_get_peak_memory_usage(void);
+
+
 int osd_get_default_codepage(void);
 
 void set_osdcore_acp(int cp);
@@ -72,6 +72,17 @@ void osd_break_into_debugger(const char *message)
 }
 
 
+//============================================================
+//  osd_get_peak_memory_usage
+//============================================================
+
+UINT64 osd_get_peak_memory_usage(void)
+{
+	// there is no standard way to do this either
+	return 0;
+}
+
+
 //============================================================
 //  osd_get_clipboard_text
 //============================================================
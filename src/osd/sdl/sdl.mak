@@ -74,6 +74,9 @@ USE_DISPATCH_GL = 1
 # uncomment to disable implementations based on assembler code
 # NOASM = 1
 
+# uncomment to use the work stealing osd_work_queue implementation
+# WORKSTEAL = 1
+
 # change for custom OS X installations
 SDL_FRAMEWORK_PATH = /Library/Frameworks/
 
@@ -417,8 +420,12 @@ OSDCOREOBJS = \
 ifdef NOASM
 OSDCOREOBJS += $(OSDOBJ)/modules/sync/work_mini.o
 else
+ifdef WORKSTEAL
+OSDCOREOBJS += $(OSDOBJ)/modules/sync/work_steal.o
+else
 OSDCOREOBJS += $(OSDOBJ)/modules/sync/work_osd.o
 endif
+endif
 
 # any "main" must be in LIBOSD or else the build will fail!
 # for the windows build, we just add it to libocore as well.
@@ -672,8 +679,8 @@ else
 LIBS += -lSDL -static
 BASELIBS += -lSDL -static
 endif
-LIBS += -luser32 -lgdi32 -lddraw -ldsound -ldxguid -lwinmm -ladvapi32 -lcomctl32 -lshlwapi
-BASELIBS += -luser32 -lgdi32 -lddraw -ldsound -ldxguid -lwinmm -ladvapi32 -lcomctl32 -lshlwapi
+LIBS += -luser32 -lgdi32 -lddraw -ldsound -ldxguid -lwinmm -ladvapi32 -lcomctl32 -lshlwapi -lpsapi
+BASELIBS += -luser32 -lgdi32 -lddraw -ldsound -ldxguid -lwinmm -ladvapi32 -lcomctl32 -lshlwapi -lpsapi
 endif   # Win32
 
 #-------------------------------------------------
@@ -57,3 +57,13 @@ void osd_break_into_debugger(const char *message)
 {
 	printf("Ignoring MAME exception: %s\n", message);
 }
+
+//============================================================
+//  osd_get_peak_memory_usage
+//============================================================
+
+UINT64 osd_get_peak_memory_usage(void)
+{
+	// no cheap way to query this
+	return 0;
+}
@@ -10,6 +10,7 @@
 //============================================================
 
 #include <sys/mman.h>
+#include <sys/resource.h>
 #include <signal.h>
 #ifdef MAME_DEBUG
 #include <unistd.h>
@@ -64,3 +65,21 @@ void osd_break_into_debugger(const char *message)
 	printf("Ignoring MAME exception: %s\n", message);
 	#endif
 }
+
+//============================================================
+//  osd_get_peak_memory_usage
+//============================================================
+
+UINT64 osd_get_peak_memory_usage(void)
+{
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#ifdef SDLMAME_MACOSX
+	// Darwin reports the maximum resident set size in bytes
+	return (UINT64)usage.ru_maxrss;
+#else
+	// everyone else reports it in kilobytes
+	return (UINT64)usage.ru_maxrss * 1024;
+#endif
+}
@@ -15,6 +15,7 @@
 
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
+#include <psapi.h>
 
 // MAME headers
 #include "osdcore.h"
@@ -54,3 +55,15 @@ void osd_break_into_debugger(const char *message)
 		DebugBreak();
 	}
 }
+
+//============================================================
+//  osd_get_peak_memory_usage
+//============================================================
+
+UINT64 osd_get_peak_memory_usage(void)
+{
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return 0;
+	return counters.PeakWorkingSetSize;
+}
@@ -69,6 +69,9 @@
 # uncomment next line to use QT debugger
 # USE_QTDEBUG = 1
 
+# uncomment next line to use the work stealing osd_work_queue implementation
+# WORKSTEAL = 1
+
 ###########################################################################
 ##################   END USER-CONFIGURABLE OPTIONS   ######################
 ###########################################################################
@@ -322,8 +325,8 @@ ifeq ($(findstring 4.4.,$(TEST_GCC)),)
 endif
 
 # add the windows libraries
-BASELIBS += -luser32 -lgdi32 -ldsound -ldxguid -lwinmm -ladvapi32 -lcomctl32 -lshlwapi -lwsock32
-LIBS += -luser32 -lgdi32 -ldsound -ldxguid -lwinmm -ladvapi32 -lcomctl32 -lshlwapi -lwsock32
+BASELIBS += -luser32 -lgdi32 -ldsound -ldxguid -lwinmm -ladvapi32 -lcomctl32 -lshlwapi -lwsock32 -lpsapi
+LIBS += -luser32 -lgdi32 -ldsound -ldxguid -lwinmm -ladvapi32 -lcomctl32 -lshlwapi -lwsock32 -lpsapi
 
 ifdef USE_SDL
 LIBS += -lSDL.dll
@@ -354,10 +357,14 @@ OSDCOREOBJS = \
 	$(WINOBJ)/winutil.o \
 	$(WINOBJ)/winclip.o \
 	$(WINOBJ)/winsocket.o \
-	$(OSDOBJ)/modules/sync/work_osd.o \
 	$(OSDOBJ)/modules/lib/osdlib_win32.o \
 	$(WINOBJ)/winptty.o \
 
+ifdef WORKSTEAL
+OSDCOREOBJS += $(OSDOBJ)/modules/sync/work_steal.o
+else
+OSDCOREOBJS += $(OSDOBJ)/modules/sync/work_osd.o
+endif
 
 #-------------------------------------------------
 # OSD Windows library
@@ -10,6 +10,7 @@
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
 #include <tchar.h>
+#include <psapi.h>
 
 // MAME headers
 #include "osdcore.h"
@@ -62,6 +63,19 @@ void osd_break_into_debugger(const char *message)
 }
 
 
+//============================================================
+//  osd_get_peak_memory_usage
+//============================================================
+
+UINT64 osd_get_peak_memory_usage(void)
+{
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return 0;
+	return counters.PeakWorkingSetSize;
+}
+
+
 //============================================================
 //  osd_get_default_codepage
 //============================================================
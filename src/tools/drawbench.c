@@ -0,0 +1,322 @@
+/***************************************************************************
+
+    drawbench.c
+
+    Micro-benchmark for the scanline kernels in drawsimd.h, comparing
+    them against the per-pixel loops they replaced on synthetic frames.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "osdcore.h"
+#include "drawsimd.h"
+
+
+/***************************************************************************
+    CONSTANTS & DEFINES
+***************************************************************************/
+
+#define FRAME_WIDTH         384
+#define FRAME_HEIGHT        224
+#define FRAME_PIXELS        (FRAME_WIDTH * FRAME_HEIGHT)
+
+#define DEFAULT_FRAMES      500
+
+#define TRANS_PEN           0
+#define PAL_BASE            0x100
+#define MASK_MASK           0x0f
+#define MASK_VALUE          0x01
+#define PRI_AND             0xf0
+#define PRI_OR              0x02
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+struct frame_data
+{
+	UINT8   src8[FRAME_PIXELS];
+	UINT16  src16[FRAME_PIXELS];
+	UINT8   mask[FRAME_PIXELS];
+	UINT32  pens[0x10000];
+};
+
+struct frame_output
+{
+	UINT16  dest16[FRAME_PIXELS];
+	UINT32  dest32[FRAME_PIXELS];
+	UINT8   pri[FRAME_PIXELS];
+};
+
+typedef void (*row_func)(const frame_data &frame, frame_output &out, int offset, int count);
+
+struct kernel_test
+{
+	const char *    name;
+	row_func        reference;
+	row_func        kernel;
+};
+
+
+
+/***************************************************************************
+    REFERENCE ROWS
+
+    These mirror the per-pixel loops in tilemap.c and the PIXEL_OP*
+    macros in drawgfxm.h that the kernels are meant to replace.
+***************************************************************************/
+
+static void ref_priority(const frame_data &frame, frame_output &out, int offset, int count)
+{
+	UINT8 *pri = &out.pri[offset];
+	for (int i = 0; i < count; i++)
+		pri[i] = (pri[i] & PRI_AND) | PRI_OR;
+}
+
+static void ref_masked_priority(const frame_data &frame, frame_output &out, int offset, int count)
+{
+	const UINT8 *maskptr = &frame.mask[offset];
+	UINT8 *pri = &out.pri[offset];
+	for (int i = 0; i < count; i++)
+		if ((maskptr[i] & MASK_MASK) == MASK_VALUE)
+			pri[i] = (pri[i] & PRI_AND) | PRI_OR;
+}
+
+static void ref_rebase16(const frame_data &frame, frame_output &out, int offset, int count)
+{
+	const UINT16 *source = &frame.src16[offset];
+	UINT16 *dest = &out.dest16[offset];
+	for (int i = 0; i < count; i++)
+		dest[i] = source[i] + PAL_BASE;
+}
+
+static void ref_masked_rebase16(const frame_data &frame, frame_output &out, int offset, int count)
+{
+	const UINT16 *source = &frame.src16[offset];
+	const UINT8 *maskptr = &frame.mask[offset];
+	UINT16 *dest = &out.dest16[offset];
+	for (int i = 0; i < count; i++)
+		if ((maskptr[i] & MASK_MASK) == MASK_VALUE)
+			dest[i] = source[i] + PAL_BASE;
+}
+
+static void ref_rebase8(const frame_data &frame, frame_output &out, int offset, int count)
+{
+	const UINT8 *source = &frame.src8[offset];
+	UINT16 *dest = &out.dest16[offset];
+	for (int i = 0; i < count; i++)
+		dest[i] = PAL_BASE + source[i];
+}
+
+static void ref_rebase_transpen8(const frame_data &frame, frame_output &out, int offset, int count)
+{
+	const UINT8 *source = &frame.src8[offset];
+	UINT16 *dest = &out.dest16[offset];
+	for (int i = 0; i < count; i++)
+	{
+		UINT32 srcdata = source[i];
+		if (srcdata != TRANS_PEN)
+			dest[i] = PAL_BASE + srcdata;
+	}
+}
+
+static void ref_remap16(const frame_data &frame, frame_output &out, int offset, int count)
+{
+	const UINT16 *source = &frame.src16[offset];
+	UINT32 *dest = &out.dest32[offset];
+	for (int i = 0; i < count; i++)
+		dest[i] = frame.pens[source[i]];
+}
+
+static void ref_masked_remap16(const frame_data &frame, frame_output &out, int offset, int count)
+{
+	const UINT16 *source = &frame.src16[offset];
+	const UINT8 *maskptr = &frame.mask[offset];
+	UINT32 *dest = &out.dest32[offset];
+	for (int i = 0; i < count; i++)
+		if ((maskptr[i] & MASK_MASK) == MASK_VALUE)
+			dest[i] = frame.pens[source[i]];
+}
+
+static void ref_remap_transpen8(const frame_data &frame, frame_output &out, int offset, int count)
+{
+	const UINT8 *source = &frame.src8[offset];
+	UINT32 *dest = &out.dest32[offset];
+	for (int i = 0; i < count; i++)
+	{
+		UINT32 srcdata = source[i];
+		if (srcdata != TRANS_PEN)
+			dest[i] = frame.pens[srcdata];
+	}
+}
+
+
+
+/***************************************************************************
+    KERNEL ROWS
+***************************************************************************/
+
+static void simd_priority(const frame_data &frame, frame_output &out, int offset, int count)
+{
+	draw_scanline_priority(&out.pri[offset], count, PRI_AND, PRI_OR);
+}
+
+static void simd_masked_priority(const frame_data &frame, frame_output &out, int offset, int count)
+{
+	draw_scanline_masked_priority(&out.pri[offset], &frame.mask[offset], MASK_MASK, MASK_VALUE, count, PRI_AND, PRI_OR);
+}
+
+static void simd_rebase16(const frame_data &frame, frame_output &out, int offset, int count)
+{
+	draw_scanline_rebase16(&out.dest16[offset], &frame.src16[offset], count, PAL_BASE);
+}
+
+static void simd_masked_rebase16(const frame_data &frame, frame_output &out, int offset, int count)
+{
+	draw_scanline_masked_rebase16(&out.dest16[offset], &frame.src16[offset], &frame.mask[offset], MASK_MASK, MASK_VALUE, count, PAL_BASE);
+}
+
+static void simd_rebase8(const frame_data &frame, frame_output &out, int offset, int count)
+{
+	draw_scanline_rebase8(&out.dest16[offset], &frame.src8[offset], count, PAL_BASE);
+}
+
+static void simd_rebase_transpen8(const frame_data &frame, frame_output &out, int offset, int count)
+{
+	draw_scanline_rebase_transpen8(&out.dest16[offset], &frame.src8[offset], count, PAL_BASE, TRANS_PEN);
+}
+
+static void simd_remap16(const frame_data &frame, frame_output &out, int offset, int count)
+{
+	draw_scanline_remap32(&out.dest32[offset], &frame.src16[offset], count, frame.pens);
+}
+
+static void simd_masked_remap16(const frame_data &frame, frame_output &out, int offset, int count)
+{
+	draw_scanline_masked_remap32(&out.dest32[offset], &frame.src16[offset], &frame.mask[offset], MASK_MASK, MASK_VALUE, count, frame.pens);
+}
+
+static void simd_remap_transpen8(const frame_data &frame, frame_output &out, int offset, int count)
+{
+	draw_scanline_remap_transpen8(&out.dest32[offset], &frame.src8[offset], count, frame.pens, TRANS_PEN);
+}
+
+
+static const kernel_test s_tests[] =
+{
+	{ "priority",               ref_priority,           simd_priority },
+	{ "masked_priority",        ref_masked_priority,    simd_masked_priority },
+	{ "rebase16 (tilemap)",     ref_rebase16,           simd_rebase16 },
+	{ "masked_rebase16",        ref_masked_rebase16,    simd_masked_rebase16 },
+	{ "rebase8 (opaque)",       ref_rebase8,            simd_rebase8 },
+	{ "rebase_transpen8",       ref_rebase_transpen8,   simd_rebase_transpen8 },
+	{ "remap32 (tilemap)",      ref_remap16,            simd_remap16 },
+	{ "masked_remap32",         ref_masked_remap16,     simd_masked_remap16 },
+	{ "remap_transpen8",        ref_remap_transpen8,    simd_remap_transpen8 }
+};
+
+
+
+/***************************************************************************
+    IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    fill_frame - build a synthetic frame with
+    runs of transparent and masked-out pixels,
+    roughly like sprites over a tilemap
+-------------------------------------------------*/
+
+static void fill_frame(frame_data &frame)
+{
+	UINT32 seed = 0x12345678;
+	int run = 0;
+	bool transparent = false;
+
+	for (int i = 0; i < FRAME_PIXELS; i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		if (run-- == 0)
+		{
+			run = (seed >> 16) & 0x1f;
+			transparent = ((seed >> 24) & 3) == 0;
+		}
+		frame.src8[i] = transparent ? TRANS_PEN : 1 + ((seed >> 8) % 255);
+		frame.src16[i] = (seed >> 12) & 0x0fff;
+		frame.mask[i] = transparent ? 0x00 : (MASK_VALUE | ((seed >> 4) & 0xf0));
+	}
+	for (size_t i = 0; i < ARRAY_LENGTH(frame.pens); i++)
+		frame.pens[i] = 0xff000000 | ((UINT32)i * 0x010203);
+}
+
+
+/*-------------------------------------------------
+    run_frames - render a number of frames one
+    row at a time, returning the elapsed ticks
+-------------------------------------------------*/
+
+static osd_ticks_t run_frames(row_func func, const frame_data &frame, frame_output &out, int frames)
+{
+	osd_ticks_t start = osd_ticks();
+	for (int curframe = 0; curframe < frames; curframe++)
+		for (int y = 0; y < FRAME_HEIGHT; y++)
+			(*func)(frame, out, y * FRAME_WIDTH, FRAME_WIDTH);
+	return osd_ticks() - start;
+}
+
+
+/*-------------------------------------------------
+    main - main entry point
+-------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+	int frames = (argc > 1) ? atoi(argv[1]) : DEFAULT_FRAMES;
+	if (frames <= 0)
+	{
+		fprintf(stderr, "Usage:\ndrawbench [frames]\n");
+		return 1;
+	}
+
+	frame_data *frame = new frame_data;
+	frame_output *refout = new frame_output;
+	frame_output *simdout = new frame_output;
+	fill_frame(*frame);
+
+	printf("%dx%d frames, %d iterations, %s kernels\n\n", FRAME_WIDTH, FRAME_HEIGHT, frames, DRAWSIMD_SSE2 ? "SSE2" : "scalar");
+	printf("%-22s %12s %12s %8s\n", "kernel", "reference", "kernel", "speedup");
+
+	double ticks_per_ms = (double)osd_ticks_per_second() / 1000.0;
+	int failures = 0;
+	for (size_t testnum = 0; testnum < ARRAY_LENGTH(s_tests); testnum++)
+	{
+		const kernel_test &test = s_tests[testnum];
+
+		// verify a single frame from identical starting points
+		memset(refout, 0x5a, sizeof(*refout));
+		memset(simdout, 0x5a, sizeof(*simdout));
+		run_frames(test.reference, *frame, *refout, 1);
+		run_frames(test.kernel, *frame, *simdout, 1);
+		bool match = (memcmp(refout, simdout, sizeof(*refout)) == 0);
+		if (!match)
+			failures++;
+
+		// then time both
+		osd_ticks_t reftime = run_frames(test.reference, *frame, *refout, frames);
+		osd_ticks_t simdtime = run_frames(test.kernel, *frame, *simdout, frames);
+		printf("%-22s %10.2fms %10.2fms %7.2fx%s\n", test.name, (double)reftime / ticks_per_ms, (double)simdtime / ticks_per_ms,
+				(simdtime != 0) ? (double)reftime / (double)simdtime : 0.0, match ? "" : "  MISMATCH");
+	}
+
+	delete simdout;
+	delete refout;
+	delete frame;
+	return (failures == 0) ? 0 : 1;
+}
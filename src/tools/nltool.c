@@ -19,6 +19,7 @@
 #include "netlist/nl_setup.h"
 #include "netlist/nl_parser.h"
 #include "netlist/nl_util.h"
+#include "netlist/analog/nld_solver.h"
 #include "options.h"
 
 /***************************************************************************
@@ -79,6 +80,7 @@ struct options_entry oplist[] =
 	{ "logs;l",          "",    OPTION_STRING,  "colon separated list of terminals to log" },
 	{ "f",               "-",   OPTION_STRING,  "file to process (default is stdin)" },
 	{ "listdevices;ld",  "",    OPTION_BOOLEAN, "list all devices available for use" },
+	{ "benchmark;b",     "0",   OPTION_BOOLEAN, "run with dense and with sparse matrix solvers and report solves/sec" },
 	{ "help;h",          "0",   OPTION_BOOLEAN, "display help" },
 	{ NULL }
 };
@@ -136,7 +138,7 @@ public:
 		m_setup->init();
 	}
 
-	void read_netlist(const char *buffer)
+	void read_netlist(const char *buffer, int sparse = -1)
 	{
 		// read the netlist ...
 
@@ -147,6 +149,11 @@ public:
 		//m_setup->parse(buffer);
 		log_setup();
 
+		// override the solver type if requested; parameter names are relative to the netlist
+		NETLIB_NAME(solver) *solver = get_single_device<NETLIB_NAME(solver)>("solver");
+		if (sparse >= 0 && solver != NULL)
+			m_setup->register_param(solver->name().substr(name().len() + 1) + ".SPARSE", (double) sparse);
+
 		// start devices
 		m_setup->start_devices();
 		m_setup->resolve_inputs();
@@ -204,6 +211,19 @@ void usage(core_options &opts)
 	fprintf(stderr, "%s\n", opts.output_help(buffer));
 }
 
+static void print_event_stats(const netlist_tool_t &nt, double emutime)
+{
+#if (NL_KEEP_STATISTICS)
+	const netlist_queue_t &q = nt.queue();
+
+	printf("events: %llu processed (%.0f/sec) in %llu batches, %llu queued\n",
+			(unsigned long long) nt.stat_events(), (double) nt.stat_events() / emutime,
+			(unsigned long long) nt.stat_batches(), (unsigned long long) q.stat_pushes());
+	printf("queue depth: %d max, %.2f average, %d pending\n",
+			q.stat_max_depth(), q.stat_avg_depth(), q.count());
+#endif
+}
+
 static void run(core_options &opts)
 {
 	netlist_tool_t nt;
@@ -222,6 +242,43 @@ static void run(core_options &opts)
 
 	double emutime = (double) (osd_ticks() - t) / (double) osd_ticks_per_second();
 	printf("%f seconds emulation took %f real time ==> %5.2f%%\n", ttr, emutime, ttr/emutime*100.0);
+	print_event_stats(nt, emutime);
+}
+
+static void benchmark(core_options &opts)
+{
+	double ttr = opts.float_value("t");
+
+	for (int sparse = 0; sparse <= 1; sparse++)
+	{
+		netlist_tool_t nt;
+
+		nt.init();
+		nt.read_netlist(filetobuf(opts.value("f")), sparse);
+
+		osd_ticks_t t = osd_ticks();
+		nt.process_queue(netlist_time::from_double(ttr));
+		double emutime = (double) (osd_ticks() - t) / (double) osd_ticks_per_second();
+
+		printf("%s solvers: %f seconds emulation took %f real time ==> %5.2f%%\n",
+				sparse ? "sparse" : "dense", ttr, emutime, ttr/emutime*100.0);
+		print_event_stats(nt, emutime);
+		if (nt.solver() == NULL)
+		{
+			printf("no solver in this netlist\n");
+			return;
+		}
+
+		const netlist_matrix_solver_t::list_t &solvers = nt.solver()->solvers();
+		int total = 0;
+		for (int i = 0; i < solvers.count(); i++)
+		{
+			printf("  %-20s %3d nets %10d solves %12.0f solves/sec\n", solvers[i]->name().cstr(),
+					solvers[i]->net_count(), solvers[i]->solve_count(), (double) solvers[i]->solve_count() / emutime);
+			total += solvers[i]->solve_count();
+		}
+		printf("  %-29s %10d solves %12.0f solves/sec\n", "total", total, (double) total / emutime);
+	}
 }
 
 static void listdevices()
@@ -301,6 +358,10 @@ int main(int argc, char *argv[])
 	{
 		listdevices();
 	}
+	else if (opts.bool_value("b"))
+	{
+		benchmark(opts);
+	}
 	else
 	{
 		run(opts);
@@ -0,0 +1,243 @@
+/***************************************************************************
+
+    soundbench.c
+
+    Micro-benchmark for the mixing kernels in soundsimd.h, comparing
+    them against the per-sample loops they replaced on a synthetic
+    many-voice mix like a 32-voice C352 or SCSP system.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "osdcore.h"
+#include "soundsimd.h"
+
+
+/***************************************************************************
+    CONSTANTS & DEFINES
+***************************************************************************/
+
+#define UPDATE_SAMPLES      800     /* one 60Hz update at 48kHz */
+#define NUM_VOICES          32
+
+#define DEFAULT_UPDATES     20000
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+struct mix_data
+{
+	INT32   voice[NUM_VOICES][UPDATE_SAMPLES];
+	INT32   left[UPDATE_SAMPLES];
+	INT32   right[UPDATE_SAMPLES];
+};
+
+struct mix_output
+{
+	INT32   mix[UPDATE_SAMPLES];
+	INT32   left[UPDATE_SAMPLES];
+	INT32   right[UPDATE_SAMPLES];
+	INT16   final[UPDATE_SAMPLES * 2];
+};
+
+typedef void (*update_func)(const mix_data &data, mix_output &out);
+
+struct kernel_test
+{
+	const char *    name;
+	update_func     reference;
+	update_func     kernel;
+};
+
+
+
+/***************************************************************************
+    REFERENCE UPDATES
+
+    These mirror the per-sample loops in device_mixer_interface,
+    speaker_device::mix and sound_manager::update that the kernels
+    are meant to replace.
+***************************************************************************/
+
+static void ref_mixer(const mix_data &data, mix_output &out)
+{
+	memset(out.mix, 0, sizeof(out.mix));
+	for (int pos = 0; pos < UPDATE_SAMPLES; pos++)
+		for (int inp = 0; inp < NUM_VOICES; inp++)
+			out.mix[pos] += data.voice[inp][pos];
+}
+
+static void ref_speakers(const mix_data &data, mix_output &out)
+{
+	memset(out.left, 0, sizeof(out.left));
+	memset(out.right, 0, sizeof(out.right));
+	for (int inp = 0; inp < NUM_VOICES; inp++)
+		for (int sample = 0; sample < UPDATE_SAMPLES; sample++)
+		{
+			out.left[sample] += data.voice[inp][sample];
+			out.right[sample] += data.voice[inp][sample];
+		}
+}
+
+static void ref_final(const mix_data &data, mix_output &out)
+{
+	UINT32 offset = 0;
+	for (int sample = 0; sample < UPDATE_SAMPLES * 1000; sample += 1000)
+	{
+		int sampindex = sample / 1000;
+
+		INT32 samp = data.left[sampindex];
+		if (samp < -32768)
+			samp = -32768;
+		else if (samp > 32767)
+			samp = 32767;
+		out.final[offset++] = samp;
+
+		samp = data.right[sampindex];
+		if (samp < -32768)
+			samp = -32768;
+		else if (samp > 32767)
+			samp = 32767;
+		out.final[offset++] = samp;
+	}
+}
+
+
+
+/***************************************************************************
+    KERNEL UPDATES
+***************************************************************************/
+
+static void simd_mixer(const mix_data &data, mix_output &out)
+{
+	memset(out.mix, 0, sizeof(out.mix));
+	for (int inp = 0; inp < NUM_VOICES; inp++)
+		sound_mix_add(out.mix, data.voice[inp], UPDATE_SAMPLES);
+}
+
+static void simd_speakers(const mix_data &data, mix_output &out)
+{
+	memset(out.left, 0, sizeof(out.left));
+	memset(out.right, 0, sizeof(out.right));
+	for (int inp = 0; inp < NUM_VOICES; inp++)
+		sound_mix_add_stereo(out.left, out.right, data.voice[inp], UPDATE_SAMPLES);
+}
+
+static void simd_final(const mix_data &data, mix_output &out)
+{
+	sound_mix_clamp_interleave(out.final, data.left, data.right, UPDATE_SAMPLES);
+}
+
+
+static const kernel_test s_tests[] =
+{
+	{ "mixer (32 inputs)",      ref_mixer,      simd_mixer },
+	{ "speakers (32 centered)", ref_speakers,   simd_speakers },
+	{ "final clamp/interleave", ref_final,      simd_final }
+};
+
+
+
+/***************************************************************************
+    IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    fill_data - build synthetic voices with a
+    range of amplitudes, and a final mix that
+    clips now and then
+-------------------------------------------------*/
+
+static void fill_data(mix_data &data)
+{
+	UINT32 seed = 0x12345678;
+
+	for (int voice = 0; voice < NUM_VOICES; voice++)
+	{
+		int amplitude = 256 << (voice % 6);
+		for (int i = 0; i < UPDATE_SAMPLES; i++)
+		{
+			seed = seed * 1103515245 + 12345;
+			data.voice[voice][i] = (INT32)((seed >> 8) % (2 * amplitude)) - amplitude;
+		}
+	}
+	for (int i = 0; i < UPDATE_SAMPLES; i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		data.left[i] = (INT32)((seed >> 4) % 131072) - 65536;
+		seed = seed * 1103515245 + 12345;
+		data.right[i] = (INT32)((seed >> 4) % 131072) - 65536;
+	}
+}
+
+
+/*-------------------------------------------------
+    run_updates - run a number of sound updates,
+    returning the elapsed ticks
+-------------------------------------------------*/
+
+static osd_ticks_t run_updates(update_func func, const mix_data &data, mix_output &out, int updates)
+{
+	osd_ticks_t start = osd_ticks();
+	for (int update = 0; update < updates; update++)
+		(*func)(data, out);
+	return osd_ticks() - start;
+}
+
+
+/*-------------------------------------------------
+    main - main entry point
+-------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+	int updates = (argc > 1) ? atoi(argv[1]) : DEFAULT_UPDATES;
+	if (updates <= 0)
+	{
+		fprintf(stderr, "Usage:\nsoundbench [updates]\n");
+		return 1;
+	}
+
+	mix_data *data = new mix_data;
+	mix_output *refout = new mix_output;
+	mix_output *simdout = new mix_output;
+	fill_data(*data);
+
+	printf("%d samples per update, %d voices, %d iterations, %s kernels\n\n", UPDATE_SAMPLES, NUM_VOICES, updates, SOUNDSIMD_SSE2 ? "SSE2" : "scalar");
+	printf("%-24s %12s %12s %8s\n", "kernel", "reference", "kernel", "speedup");
+
+	double ticks_per_ms = (double)osd_ticks_per_second() / 1000.0;
+	int failures = 0;
+	for (size_t testnum = 0; testnum < ARRAY_LENGTH(s_tests); testnum++)
+	{
+		const kernel_test &test = s_tests[testnum];
+
+		// verify a single update from identical starting points
+		memset(refout, 0x5a, sizeof(*refout));
+		memset(simdout, 0x5a, sizeof(*simdout));
+		run_updates(test.reference, *data, *refout, 1);
+		run_updates(test.kernel, *data, *simdout, 1);
+		bool match = (memcmp(refout, simdout, sizeof(*refout)) == 0);
+		if (!match)
+			failures++;
+
+		// then time both
+		osd_ticks_t reftime = run_updates(test.reference, *data, *refout, updates);
+		osd_ticks_t simdtime = run_updates(test.kernel, *data, *simdout, updates);
+		printf("%-24s %10.2fms %10.2fms %7.2fx%s\n", test.name, (double)reftime / ticks_per_ms, (double)simdtime / ticks_per_ms,
+				(simdtime != 0) ? (double)reftime / (double)simdtime : 0.0, match ? "" : "  MISMATCH");
+	}
+
+	delete simdout;
+	delete refout;
+	delete data;
+	return (failures == 0) ? 0 : 1;
+}
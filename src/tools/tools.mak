@@ -63,6 +63,9 @@ TOOLS += \
 	split$(EXE) \
 	pngcmp$(EXE) \
 	nltool$(EXE) \
+	drawbench$(EXE) \
+	soundbench$(EXE) \
+	workbench$(EXE) \
 
 ifdef USE_SQLITE
 TOOLS += sqlite3$(EXE)
@@ -225,6 +228,39 @@ nltool$(EXE): $(NLTOOLOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
 	@echo Linking $@...
 	$(LD) $(LDFLAGS) $^ $(BASELIBS) -o $@
 
+#-------------------------------------------------
+# drawbench
+#-------------------------------------------------
+
+DRAWBENCHOBJS = \
+	$(TOOLSOBJ)/drawbench.o \
+
+drawbench$(EXE): $(DRAWBENCHOBJS) $(LIBOCORE)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(BASELIBS) -o $@
+
+#-------------------------------------------------
+# soundbench
+#-------------------------------------------------
+
+SOUNDBENCHOBJS = \
+	$(TOOLSOBJ)/soundbench.o \
+
+soundbench$(EXE): $(SOUNDBENCHOBJS) $(LIBOCORE)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(BASELIBS) -o $@
+
+#-------------------------------------------------
+# workbench
+#-------------------------------------------------
+
+WORKBENCHOBJS = \
+	$(TOOLSOBJ)/workbench.o \
+
+workbench$(EXE): $(WORKBENCHOBJS) $(LIBOCORE)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(BASELIBS) -o $@
+
 #-------------------------------------------------
 # SQLite3
 #-------------------------------------------------
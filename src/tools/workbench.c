@@ -0,0 +1,254 @@
+/***************************************************************************
+
+    workbench.c
+
+    Stress benchmark for the osd_work_queue implementation linked into
+    the OSD core library, measuring item throughput and dispatch latency
+    across a range of thread counts.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include "osdcore.h"
+
+
+/***************************************************************************
+    CONSTANTS & DEFINES
+***************************************************************************/
+
+#define DEFAULT_ITEMS       200000
+#define BATCH_ITEMS         64          /* items per osd_work_item_queue_multiple call */
+#define ITEM_WORK           200         /* inner loop iterations per item */
+#define LATENCY_SAMPLES     2000
+
+#define MAX_REQUESTED       64
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+struct item_record
+{
+	volatile UINT32     runs;           /* times the callback ran for this item */
+	volatile UINT32     value;          /* result of the busy work */
+};
+
+struct sweep_result
+{
+	int                 threads;        /* distinct thread ids seen */
+	double              itemspersec;
+	double              medianus;
+	double              maxus;
+	int                 errors;
+};
+
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+/* defined by the work queue implementation */
+extern int osd_num_processors;
+
+static volatile UINT32 s_threadseen[WORK_MAX_THREADS + 1];
+static volatile UINT32 s_badthreadid;
+
+
+
+/***************************************************************************
+    IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    note_thread - record which thread ran an item
+-------------------------------------------------*/
+
+static void note_thread(int threadid)
+{
+	if (threadid >= 0 && threadid < WORK_MAX_THREADS)
+		s_threadseen[threadid] = 1;
+	else
+		s_badthreadid = 1;
+}
+
+
+/*-------------------------------------------------
+    busy_item - callback doing a small, fixed
+    amount of arithmetic
+-------------------------------------------------*/
+
+static void *busy_item(void *param, int threadid)
+{
+	item_record *record = (item_record *)param;
+	UINT32 seed = (UINT32)(FPTR)param;
+
+	for (int i = 0; i < ITEM_WORK; i++)
+		seed = seed * 1103515245 + 12345;
+	record->value = seed;
+	record->runs++;
+	note_thread(threadid);
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    stamp_item - callback recording the time it
+    started running
+-------------------------------------------------*/
+
+static void *stamp_item(void *param, int threadid)
+{
+	*(osd_ticks_t *)param = osd_ticks();
+	note_thread(threadid);
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    run_throughput - queue 'count' auto-release
+    items in batches and wait for them all,
+    returning the elapsed ticks
+-------------------------------------------------*/
+
+static osd_ticks_t run_throughput(osd_work_queue *queue, item_record *records, int count, int &errors)
+{
+	memset(records, 0, count * sizeof(records[0]));
+
+	osd_ticks_t start = osd_ticks();
+	for (int base = 0; base < count; base += BATCH_ITEMS)
+		osd_work_item_queue_multiple(queue, busy_item, MIN(BATCH_ITEMS, count - base), &records[base], sizeof(records[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	if (!osd_work_queue_wait(queue, 100 * osd_ticks_per_second()))
+		errors++;
+	osd_ticks_t elapsed = osd_ticks() - start;
+
+	// every item must have run exactly once
+	for (int itemnum = 0; itemnum < count; itemnum++)
+		if (records[itemnum].runs != 1)
+			errors++;
+	return elapsed;
+}
+
+
+/*-------------------------------------------------
+    run_latency - queue single items on an idle
+    queue and measure how long each takes to
+    start running
+-------------------------------------------------*/
+
+static void run_latency(osd_work_queue *queue, osd_ticks_t *samples, int count, int &errors)
+{
+	for (int sample = 0; sample < count; sample++)
+	{
+		osd_ticks_t started = 0;
+		osd_ticks_t queued = osd_ticks();
+		osd_work_item *item = osd_work_item_queue(queue, stamp_item, &started, 0);
+		if (item == NULL || !osd_work_item_wait(item, 10 * osd_ticks_per_second()))
+			errors++;
+		if (item != NULL)
+			osd_work_item_release(item);
+		samples[sample] = (started > queued) ? started - queued : 0;
+
+		// leave a gap every so often so that the workers get to park
+		if ((sample & 63) == 63)
+		{
+			osd_ticks_t until = osd_ticks() + osd_ticks_per_second() / 1000;
+			while (osd_ticks() < until) { }
+		}
+	}
+}
+
+
+/*-------------------------------------------------
+    run_sweep - measure one requested processor
+    count
+-------------------------------------------------*/
+
+static void run_sweep(int requested, item_record *records, int count, osd_ticks_t *samples, sweep_result &result)
+{
+	memset((void *)s_threadseen, 0, sizeof(s_threadseen));
+	s_badthreadid = 0;
+	result.errors = 0;
+
+	// the queue sizes itself from osd_num_processors, which the
+	// implementation clamps to 4x the physical processor count
+	osd_num_processors = requested;
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+	if (queue == NULL)
+	{
+		result.errors = 1;
+		return;
+	}
+
+	// warm up, then keep the best of a few passes
+	osd_ticks_t best = run_throughput(queue, records, count, result.errors);
+	for (int pass = 0; pass < 3; pass++)
+		best = MIN(best, run_throughput(queue, records, count, result.errors));
+	result.itemspersec = (best != 0) ? (double)count * (double)osd_ticks_per_second() / (double)best : 0.0;
+
+	// latency on a separate queue so the waiter doesn't help out
+	osd_work_queue *latqueue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	if (latqueue != NULL)
+	{
+		run_latency(latqueue, samples, LATENCY_SAMPLES, result.errors);
+		osd_work_queue_free(latqueue);
+
+		std::sort(samples, samples + LATENCY_SAMPLES);
+		double ticks_per_us = (double)osd_ticks_per_second() / 1000000.0;
+		result.medianus = (double)samples[LATENCY_SAMPLES / 2] / ticks_per_us;
+		result.maxus = (double)samples[LATENCY_SAMPLES - 1] / ticks_per_us;
+	}
+	else
+		result.errors++;
+
+	osd_work_queue_free(queue);
+
+	result.threads = 0;
+	for (int threadnum = 0; threadnum < WORK_MAX_THREADS; threadnum++)
+		result.threads += s_threadseen[threadnum];
+	if (s_badthreadid)
+		result.errors++;
+}
+
+
+/*-------------------------------------------------
+    main - main entry point
+-------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+	int count = (argc > 1) ? atoi(argv[1]) : DEFAULT_ITEMS;
+	if (count <= 0)
+	{
+		fprintf(stderr, "Usage:\nworkbench [items]\n");
+		return 1;
+	}
+
+	item_record *records = new item_record[count];
+	osd_ticks_t *samples = new osd_ticks_t[LATENCY_SAMPLES];
+
+	printf("%d items of %d iterations in batches of %d, %d latency samples\n", count, ITEM_WORK, BATCH_ITEMS, LATENCY_SAMPLES);
+	printf("thread ids are limited to %d, including the waiting thread\n\n", WORK_MAX_THREADS);
+	printf("%9s %7s %14s %12s %12s %7s\n", "requested", "threads", "items/sec", "median lat", "max lat", "errors");
+
+	int failures = 0;
+	for (int requested = 1; requested <= MAX_REQUESTED; requested *= 2)
+	{
+		sweep_result result = sweep_result();
+		run_sweep(requested, records, count, samples, result);
+		printf("%9d %7d %14.0f %10.2fus %10.2fus %7d\n", requested, result.threads, result.itemspersec, result.medianus, result.maxus, result.errors);
+		failures += result.errors;
+	}
+
+	delete[] samples;
+	delete[] records;
+	return (failures == 0) ? 0 : 1;
+}